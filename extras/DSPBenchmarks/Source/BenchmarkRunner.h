@@ -0,0 +1,313 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#pragma once
+
+//==============================================================================
+/*  A single configuration of a processor to be timed. */
+struct Benchmark
+{
+    /*  The processor and method being timed, e.g. "IIR::Filter". */
+    String name;
+
+    /*  The parameters of this configuration, such as the block size and number of
+        channels. Together with the name, they identify the benchmark in the results.
+    */
+    NamedValueSet parameters;
+
+    /*  The number of samples, summed over all the channels, that are processed by
+        one call to the function returned by create(). The results are divided by this.
+    */
+    int numSamplesPerCall = 0;
+
+    /*  Allocates and prepares everything that's needed, and returns a function that
+        processes one block. This is only called when the benchmark is about to run,
+        so that a long list of benchmarks doesn't keep all their buffers alive.
+    */
+    std::function<std::function<void()>()> create;
+
+    String getID() const
+    {
+        StringArray values;
+
+        for (const auto& parameter : parameters)
+            values.add (parameter.name.toString() + "=" + parameter.value.toString());
+
+        return values.isEmpty() ? name : name + " " + values.joinIntoString (" ");
+    }
+};
+
+//==============================================================================
+/*  A summary of a set of repeated measurements. */
+struct Statistics
+{
+    double minimum = 0, median = 0, mean = 0, standardDeviation = 0;
+
+    static Statistics fromValues (std::vector<double> values)
+    {
+        Statistics result;
+
+        if (values.empty())
+            return result;
+
+        std::sort (values.begin(), values.end());
+
+        const auto size = values.size();
+        result.minimum = values.front();
+        result.median = (size % 2 != 0) ? values[size / 2]
+                                        : 0.5 * (values[size / 2 - 1] + values[size / 2]);
+        result.mean = std::accumulate (values.begin(), values.end(), 0.0) / (double) size;
+
+        double sumOfSquares = 0;
+
+        for (auto v : values)
+            sumOfSquares += (v - result.mean) * (v - result.mean);
+
+        result.standardDeviation = size > 1 ? std::sqrt (sumOfSquares / (double) (size - 1)) : 0.0;
+        return result;
+    }
+
+    Statistics operator* (double scale) const noexcept
+    {
+        return { minimum * scale, median * scale, mean * scale, standardDeviation * scale };
+    }
+};
+
+//==============================================================================
+struct BenchmarkResult
+{
+    String id, name;
+    NamedValueSet parameters;
+    int numSamplesPerCall = 0, numCallsPerRepetition = 0;
+    Statistics nanosecondsPerSample;
+};
+
+//==============================================================================
+/*  Times benchmarks by running them repeatedly, and summarises the results.
+
+    Each benchmark is first run for a short while to warm up the caches and to let
+    any parameter smoothing settle. Its function is then called in a loop for a number
+    of repetitions, each lasting at least the minimum repetition time, and the time per
+    sample of each repetition is recorded. The spread of these gives an idea of how
+    much the results can be trusted.
+*/
+class BenchmarkRunner
+{
+public:
+    struct Options
+    {
+        int numRepetitions = 15;
+        double minRepetitionTimeMs = 10.0;
+        double warmUpTimeMs = 50.0;
+    };
+
+    explicit BenchmarkRunner (const Options& optionsToUse)
+        : options (optionsToUse)
+    {}
+
+    BenchmarkResult run (const Benchmark& benchmark) const
+    {
+        ScopedNoDenormals noDenormals;
+
+        const auto process = benchmark.create();
+
+        // Warm up, and find out roughly how long a call takes
+        int numWarmUpCalls = 0;
+        const auto warmUpStart = Time::getHighResolutionTicks();
+        double warmUpSeconds = 0;
+
+        do
+        {
+            process();
+            ++numWarmUpCalls;
+            warmUpSeconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - warmUpStart);
+        }
+        while (warmUpSeconds * 1000.0 < options.warmUpTimeMs || numWarmUpCalls < 2);
+
+        const auto secondsPerCall = warmUpSeconds / numWarmUpCalls;
+        const auto numCalls = jmax (1, roundToInt (std::ceil (options.minRepetitionTimeMs * 0.001 / secondsPerCall)));
+
+        std::vector<double> nanosecondsPerSample;
+        nanosecondsPerSample.reserve ((size_t) options.numRepetitions);
+
+        for (int repetition = 0; repetition < options.numRepetitions; ++repetition)
+        {
+            const auto start = Time::getHighResolutionTicks();
+
+            for (int i = 0; i < numCalls; ++i)
+                process();
+
+            const auto seconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+            nanosecondsPerSample.push_back (seconds * 1.0e9 / ((double) numCalls * benchmark.numSamplesPerCall));
+        }
+
+        BenchmarkResult result;
+        result.id = benchmark.getID();
+        result.name = benchmark.name;
+        result.parameters = benchmark.parameters;
+        result.numSamplesPerCall = benchmark.numSamplesPerCall;
+        result.numCallsPerRepetition = numCalls;
+        result.nanosecondsPerSample = Statistics::fromValues (std::move (nanosecondsPerSample));
+        return result;
+    }
+
+    const Options& getOptions() const noexcept      { return options; }
+
+private:
+    Options options;
+};
+
+//==============================================================================
+/*  Writes a set of results, along with a description of the machine and the build, as
+    JSON that can be stored and compared against later runs.
+
+    Cycles per sample are estimated from the CPU's nominal clock speed, so they'll be
+    misleading on machines that scale their clock, but they make it easier to compare
+    results from different machines.
+*/
+struct ResultsWriter
+{
+    static String getCompilerDescription()
+    {
+       #if JUCE_CLANG
+        return "Clang " __clang_version__;
+       #elif JUCE_GCC
+        return "GCC " __VERSION__;
+       #elif JUCE_MSVC
+        return "MSVC " + String (_MSC_FULL_VER);
+       #else
+        return "Unknown";
+       #endif
+    }
+
+    static String getSIMDDescription()
+    {
+        StringArray features;
+
+        if (SystemStats::hasSSE2())     features.add ("SSE2");
+        if (SystemStats::hasAVX())      features.add ("AVX");
+        if (SystemStats::hasAVX2())     features.add ("AVX2");
+        if (SystemStats::hasAVX512F())  features.add ("AVX512F");
+        if (SystemStats::hasNeon())     features.add ("NEON");
+
+        return features.joinIntoString (" ");
+    }
+
+    static double getCyclesPerNanosecond()
+    {
+        return SystemStats::getCpuSpeedInMegahertz() * 0.001;
+    }
+
+    static void writeStatistics (JSONWriter& writer, const Statistics& statistics)
+    {
+        writer.beginObject();
+        writer.writeName ("min");       writer.writeDouble (statistics.minimum);
+        writer.writeName ("median");    writer.writeDouble (statistics.median);
+        writer.writeName ("mean");      writer.writeDouble (statistics.mean);
+        writer.writeName ("stdDev");    writer.writeDouble (statistics.standardDeviation);
+        writer.endObject();
+    }
+
+    static void write (OutputStream& stream,
+                       const std::vector<BenchmarkResult>& results,
+                       const BenchmarkRunner::Options& options,
+                       const String& label)
+    {
+        JSONWriter writer (stream);
+        const auto cyclesPerNanosecond = getCyclesPerNanosecond();
+
+        writer.beginObject();
+        writer.writeName ("formatVersion");  writer.writeInt (1);
+        writer.writeName ("label");          writer.writeString (label);
+        writer.writeName ("date");           writer.writeString (Time::getCurrentTime().toISO8601 (true));
+
+        writer.writeName ("system");
+        writer.beginObject();
+        writer.writeName ("os");             writer.writeString (SystemStats::getOperatingSystemName());
+        writer.writeName ("cpuVendor");      writer.writeString (SystemStats::getCpuVendor());
+        writer.writeName ("cpuModel");       writer.writeString (SystemStats::getCpuModel());
+        writer.writeName ("numCpus");        writer.writeInt (SystemStats::getNumCpus());
+        writer.writeName ("cpuSpeedMHz");    writer.writeInt (SystemStats::getCpuSpeedInMegahertz());
+        writer.writeName ("simd");           writer.writeString (getSIMDDescription());
+        writer.endObject();
+
+        writer.writeName ("build");
+        writer.beginObject();
+        writer.writeName ("juceVersion");    writer.writeString (SystemStats::getJUCEVersion());
+        writer.writeName ("compiler");       writer.writeString (getCompilerDescription());
+       #if JUCE_DEBUG
+        writer.writeName ("debug");          writer.writeBool (true);
+       #else
+        writer.writeName ("debug");          writer.writeBool (false);
+       #endif
+        writer.endObject();
+
+        writer.writeName ("settings");
+        writer.beginObject();
+        writer.writeName ("repetitions");           writer.writeInt (options.numRepetitions);
+        writer.writeName ("minRepetitionTimeMs");   writer.writeDouble (options.minRepetitionTimeMs);
+        writer.writeName ("warmUpTimeMs");          writer.writeDouble (options.warmUpTimeMs);
+        writer.endObject();
+
+        writer.writeName ("results");
+        writer.beginArray();
+
+        for (const auto& result : results)
+        {
+            writer.beginObject();
+            writer.writeName ("id");                    writer.writeString (result.id);
+            writer.writeName ("name");                  writer.writeString (result.name);
+
+            writer.writeName ("parameters");
+            writer.beginObject();
+
+            for (const auto& parameter : result.parameters)
+            {
+                writer.writeName (parameter.name.toString());
+                writer.writeValue (parameter.value);
+            }
+
+            writer.endObject();
+
+            writer.writeName ("samplesPerCall");        writer.writeInt (result.numSamplesPerCall);
+            writer.writeName ("callsPerRepetition");    writer.writeInt (result.numCallsPerRepetition);
+            writer.writeName ("nsPerSample");           writeStatistics (writer, result.nanosecondsPerSample);
+
+            writer.writeName ("cyclesPerSample");
+
+            if (cyclesPerNanosecond > 0)
+                writeStatistics (writer, result.nanosecondsPerSample * cyclesPerNanosecond);
+            else
+                writer.writeNull();
+
+            writer.endObject();
+        }
+
+        writer.endArray();
+        writer.endObject();
+        stream << newLine;
+    }
+};
@@ -0,0 +1,546 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#pragma once
+
+#include "BenchmarkRunner.h"
+
+//==============================================================================
+namespace Benchmarks
+{
+
+constexpr double sampleRate = 48000.0;
+
+inline const std::initializer_list<int> blockSizes    { 64, 512 };
+inline const std::initializer_list<int> channelCounts { 1, 2, 8 };
+
+inline void fillWithNoise (float* data, int numSamples, Random& random)
+{
+    for (int i = 0; i < numSamples; ++i)
+        data[i] = random.nextFloat() * 2.0f - 1.0f;
+}
+
+inline AudioBuffer<float> createNoise (int numChannels, int numSamples)
+{
+    Random random (0x1234);
+    AudioBuffer<float> buffer (numChannels, numSamples);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        fillWithNoise (buffer.getWritePointer (channel), numSamples, random);
+
+    return buffer;
+}
+
+//==============================================================================
+/*  Creates a benchmark for a processor with the usual prepare() and process() methods,
+    which processes a block of noise into a separate output buffer. The input is never
+    modified, so the signal level stays the same however long the benchmark runs.
+
+    createProcessor must return a std::unique_ptr to a processor that's ready to be
+    prepared.
+*/
+template <typename CreateProcessor>
+Benchmark createProcessorBenchmark (const String& name,
+                                    NamedValueSet parameters,
+                                    int numChannels,
+                                    int blockSize,
+                                    CreateProcessor createProcessor)
+{
+    parameters.set ("numChannels", numChannels);
+    parameters.set ("blockSize", blockSize);
+
+    return { name, parameters, numChannels * blockSize, [=]
+    {
+        using Processor = typename decltype (createProcessor())::element_type;
+
+        struct State
+        {
+            std::unique_ptr<Processor> processor;
+            AudioBuffer<float> input, output;
+        };
+
+        auto state = std::make_shared<State>();
+        state->processor = createProcessor();
+        state->input = createNoise (numChannels, blockSize);
+        state->output.setSize (numChannels, blockSize);
+        state->processor->prepare ({ sampleRate, (uint32) blockSize, (uint32) numChannels });
+
+        return std::function<void()> ([state]
+        {
+            const dsp::AudioBlock<const float> input (state->input);
+            dsp::AudioBlock<float> output (state->output);
+            state->processor->process (dsp::ProcessContextNonReplacing<float> (input, output));
+        });
+    } };
+}
+
+//==============================================================================
+/*  A high order Butterworth low-pass filter, built from a cascade of IIR::Filters. */
+struct IIRCascade
+{
+    explicit IIRCascade (int order)
+        : coefficients (dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod (5000.0f, sampleRate, order))
+    {
+        for (auto* c : coefficients)
+            stages.push_back (std::make_unique<Stage> (c));
+    }
+
+    void prepare (const dsp::ProcessSpec& spec)
+    {
+        for (auto& stage : stages)
+            stage->prepare (spec);
+    }
+
+    void process (const dsp::ProcessContextNonReplacing<float>& context)
+    {
+        stages.front()->process (context);
+
+        for (size_t i = 1; i < stages.size(); ++i)
+            stages[i]->process (dsp::ProcessContextReplacing<float> (context.getOutputBlock()));
+    }
+
+    using Stage = dsp::ProcessorDuplicator<dsp::IIR::Filter<float>, dsp::IIR::Coefficients<float>>;
+
+    ReferenceCountedArray<dsp::IIR::Coefficients<float>> coefficients;
+    std::vector<std::unique_ptr<Stage>> stages;
+};
+
+/*  A DelayLine whose delay is modulated at every sample. */
+struct ModulatedDelay
+{
+    void prepare (const dsp::ProcessSpec& spec)
+    {
+        delayLine.prepare (spec);
+        delays.resize (spec.maximumBlockSize);
+
+        for (size_t i = 0; i < delays.size(); ++i)
+            delays[i] = 500.0f + 100.0f * std::sin ((float) i * 0.01f);
+    }
+
+    void process (const dsp::ProcessContextNonReplacing<float>& context)
+    {
+        delayLine.process (context, delays.data());
+    }
+
+    dsp::DelayLine<float, dsp::DelayLineInterpolationTypes::Lagrange3rd> delayLine { 1024 };
+    std::vector<float> delays;
+};
+
+/*  Applies a function to a block of samples with one of the array methods of
+    LookupTableTransform or FastMathApproximations.
+*/
+struct ArrayFunction
+{
+    std::function<void (const float*, float*, size_t)> function;
+
+    void prepare (const dsp::ProcessSpec&) {}
+
+    void process (const dsp::ProcessContextNonReplacing<float>& context)
+    {
+        const auto& input = context.getInputBlock();
+        auto& output = context.getOutputBlock();
+
+        for (size_t channel = 0; channel < output.getNumChannels(); ++channel)
+            function (input.getChannelPointer (channel), output.getChannelPointer (channel), output.getNumSamples());
+    }
+};
+
+//==============================================================================
+inline void addFloatVectorOperationsBenchmarks (std::vector<Benchmark>& benchmarks)
+{
+    using FVO = FloatVectorOperations;
+
+    const std::pair<const char*, std::function<void (float*, const float*, const float*, int)>> operations[]
+    {
+        { "FloatVectorOperations::add",              [] (float* d, const float* s, const float*, int n)  { FVO::add (d, s, n); } },
+        { "FloatVectorOperations::multiply",         [] (float* d, const float* s, const float*, int n)  { FVO::multiply (d, s, n); } },
+        { "FloatVectorOperations::copyWithMultiply", [] (float* d, const float* s, const float*, int n)  { FVO::copyWithMultiply (d, s, 0.5f, n); } },
+        { "FloatVectorOperations::addWithMultiply",  [] (float* d, const float* s, const float* t, int n) { FVO::addWithMultiply (d, s, t, n); } },
+        { "FloatVectorOperations::clip",             [] (float* d, const float* s, const float*, int n)  { FVO::clip (d, s, -0.5f, 0.5f, n); } },
+        { "FloatVectorOperations::findMinAndMax",    [] (float* d, const float* s, const float*, int n)  { d[0] = FVO::findMinAndMax (s, n).getLength(); } },
+    };
+
+    for (const auto& [name, operation] : operations)
+    {
+        for (auto numValues : { 64, 256, 1024, 4096 })
+        {
+            NamedValueSet parameters;
+            parameters.set ("numValues", numValues);
+
+            benchmarks.push_back ({ name, parameters, numValues, [numValues, operation = operation]
+            {
+                auto buffers = std::make_shared<AudioBuffer<float>> (createNoise (3, numValues));
+
+                // Resetting the destination before each call would take as long as the
+                // operation itself, so it's allowed to drift. The runner disables denormals.
+                return std::function<void()> ([buffers, numValues, operation]
+                {
+                    operation (buffers->getWritePointer (0), buffers->getReadPointer (1), buffers->getReadPointer (2), numValues);
+                });
+            } });
+        }
+    }
+}
+
+inline void addFFTBenchmarks (std::vector<Benchmark>& benchmarks)
+{
+    for (auto order : { 6, 8, 10, 12, 14 })
+    {
+        const auto size = 1 << order;
+
+        NamedValueSet parameters;
+        parameters.set ("order", order);
+
+        struct State
+        {
+            explicit State (int fftOrder)
+                : fft (fftOrder),
+                  input (createNoise (1, 4 << fftOrder)),
+                  output (1, 4 << fftOrder)
+            {}
+
+            dsp::FFT fft;
+            AudioBuffer<float> input, output;
+        };
+
+        benchmarks.push_back ({ "FFT::perform", parameters, size, [order]
+        {
+            auto state = std::make_shared<State> (order);
+
+            return std::function<void()> ([state]
+            {
+                state->fft.perform (reinterpret_cast<const dsp::Complex<float>*> (state->input.getReadPointer (0)),
+                                    reinterpret_cast<dsp::Complex<float>*> (state->output.getWritePointer (0)),
+                                    false);
+            });
+        } });
+
+        // The real-only transforms work in place, so these include copying the input into
+        // the working buffer, which is a small fraction of the cost.
+        benchmarks.push_back ({ "FFT::performRealOnlyForwardTransform", parameters, size, [order, size]
+        {
+            auto state = std::make_shared<State> (order);
+
+            return std::function<void()> ([state, size]
+            {
+                state->output.copyFrom (0, 0, state->input, 0, 0, size);
+                state->fft.performRealOnlyForwardTransform (state->output.getWritePointer (0), true);
+            });
+        } });
+
+        benchmarks.push_back ({ "FFT::performRealOnlyInverseTransform", parameters, size, [order, size]
+        {
+            auto state = std::make_shared<State> (order);
+            state->fft.performRealOnlyForwardTransform (state->input.getWritePointer (0), true);
+
+            return std::function<void()> ([state, size]
+            {
+                state->output.copyFrom (0, 0, state->input, 0, 0, size + 2);
+                state->fft.performRealOnlyInverseTransform (state->output.getWritePointer (0));
+            });
+        } });
+    }
+}
+
+inline void addConvolutionBenchmarks (std::vector<Benchmark>& benchmarks)
+{
+    for (auto irLength : { 4096, 65536 })
+    {
+        for (auto headSize : { 0, 256 })
+        {
+            if (headSize >= irLength)
+                continue;
+
+            for (auto numChannels : { 1, 2 })
+            {
+                for (auto blockSize : blockSizes)
+                {
+                    NamedValueSet parameters;
+                    parameters.set ("irLength", irLength);
+                    parameters.set ("headSize", headSize);
+
+                    benchmarks.push_back (createProcessorBenchmark ("Convolution", parameters, numChannels, blockSize, [=]
+                    {
+                        auto convolution = headSize > 0 ? std::make_unique<dsp::Convolution> (dsp::Convolution::NonUniform { headSize })
+                                                        : std::make_unique<dsp::Convolution>();
+
+                        // Loading before preparing means that the response is ready straight away,
+                        // rather than being loaded on a background thread
+                        auto ir = createNoise (numChannels, irLength);
+                        ir.applyGainRamp (0, irLength, 1.0f, 0.0f);
+
+                        convolution->loadImpulseResponse (std::move (ir), sampleRate,
+                                                          numChannels > 1 ? dsp::Convolution::Stereo::yes : dsp::Convolution::Stereo::no,
+                                                          dsp::Convolution::Trim::no,
+                                                          dsp::Convolution::Normalise::yes);
+                        return convolution;
+                    }));
+                }
+            }
+        }
+    }
+
+    // An ambisonic to binaural decoder: 16 inputs, each with a response for both ears
+    for (auto irLength : { 512, 8192 })
+    {
+        for (auto blockSize : blockSizes)
+        {
+            NamedValueSet parameters;
+            parameters.set ("irLength", irLength);
+            parameters.set ("numOutputs", 2);
+
+            benchmarks.push_back (createProcessorBenchmark ("MatrixConvolution", parameters, 16, blockSize, [irLength]
+            {
+                std::vector<AudioBuffer<float>> impulseResponses;
+
+                for (int input = 0; input < 16; ++input)
+                {
+                    impulseResponses.push_back (createNoise (2, irLength));
+                    impulseResponses.back().applyGainRamp (0, irLength, 0.1f, 0.0f);
+                }
+
+                auto convolution = std::make_unique<dsp::MatrixConvolution>();
+                convolution->loadImpulseResponses (impulseResponses);
+                return convolution;
+            }));
+        }
+    }
+}
+
+inline void addFilterBenchmarks (std::vector<Benchmark>& benchmarks)
+{
+    for (auto order : { 2, 4, 8 })
+    {
+        NamedValueSet parameters;
+        parameters.set ("order", order);
+
+        for (auto numChannels : channelCounts)
+            for (auto blockSize : blockSizes)
+                benchmarks.push_back (createProcessorBenchmark ("IIR::Filter", parameters, numChannels, blockSize,
+                                                                [order] { return std::make_unique<IIRCascade> (order); }));
+    }
+
+    for (auto numTaps : { 16, 64, 256 })
+    {
+        NamedValueSet parameters;
+        parameters.set ("numTaps", numTaps);
+
+        for (auto numChannels : channelCounts)
+        {
+            for (auto blockSize : blockSizes)
+            {
+                benchmarks.push_back (createProcessorBenchmark ("FIR::Filter", parameters, numChannels, blockSize, [numTaps]
+                {
+                    using FIR = dsp::ProcessorDuplicator<dsp::FIR::Filter<float>, dsp::FIR::Coefficients<float>>;
+
+                    auto filter = std::make_unique<FIR>();
+                    filter->state = dsp::FilterDesign<float>::designFIRLowpassWindowMethod (5000.0f, sampleRate, (size_t) numTaps - 1,
+                                                                                            dsp::WindowingFunction<float>::hann);
+                    return filter;
+                }));
+            }
+        }
+    }
+
+    for (auto numChannels : channelCounts)
+    {
+        for (auto blockSize : blockSizes)
+        {
+            benchmarks.push_back (createProcessorBenchmark ("StateVariableTPTFilter", {}, numChannels, blockSize, []
+            {
+                auto filter = std::make_unique<dsp::StateVariableTPTFilter<float>>();
+                filter->setCutoffFrequency (2000.0f);
+                return filter;
+            }));
+
+            benchmarks.push_back (createProcessorBenchmark ("LadderFilter", {}, numChannels, blockSize, []
+            {
+                auto filter = std::make_unique<dsp::LadderFilter<float>>();
+                filter->setCutoffFrequencyHz (2000.0f);
+                filter->setResonance (0.5f);
+                return filter;
+            }));
+        }
+    }
+}
+
+inline void addOversamplingBenchmarks (std::vector<Benchmark>& benchmarks)
+{
+    using Oversampling = dsp::Oversampling<float>;
+
+    const std::pair<const char*, Oversampling::FilterType> filterTypes[]
+    {
+        { "halfBandFIREquiripple",  Oversampling::filterHalfBandFIREquiripple },
+        { "halfBandPolyphaseIIR",   Oversampling::filterHalfBandPolyphaseIIR },
+        { "polyphaseFIR",           Oversampling::filterPolyphaseFIR }
+    };
+
+    for (const auto& [filterName, filterType] : filterTypes)
+    {
+        for (auto factor : { 1, 2 })
+        {
+            for (auto numChannels : channelCounts)
+            {
+                for (auto blockSize : blockSizes)
+                {
+                    NamedValueSet parameters;
+                    parameters.set ("filter", filterName);
+                    parameters.set ("factor", 1 << factor);
+                    parameters.set ("numChannels", numChannels);
+                    parameters.set ("blockSize", blockSize);
+
+                    // Up and down sampling are timed together, as they'd be used
+                    benchmarks.push_back ({ "Oversampling", parameters, numChannels * blockSize, [=, filterType = filterType]
+                    {
+                        struct State
+                        {
+                            State (int channels, int samples, int factorOrder, Oversampling::FilterType type)
+                                : oversampling ((size_t) channels, (size_t) factorOrder, type),
+                                  buffer (createNoise (channels, samples))
+                            {
+                                oversampling.initProcessing ((size_t) samples);
+                            }
+
+                            Oversampling oversampling;
+                            AudioBuffer<float> buffer;
+                        };
+
+                        auto state = std::make_shared<State> (numChannels, blockSize, factor, filterType);
+
+                        return std::function<void()> ([state]
+                        {
+                            dsp::AudioBlock<float> block (state->buffer);
+                            state->oversampling.processSamplesUp (block);
+                            state->oversampling.processSamplesDown (block);
+                        });
+                    } });
+                }
+            }
+        }
+    }
+}
+
+inline void addWidgetBenchmarks (std::vector<Benchmark>& benchmarks)
+{
+    for (auto blockSize : blockSizes)
+    {
+        for (auto numChannels : channelCounts)
+        {
+            benchmarks.push_back (createProcessorBenchmark ("Compressor", {}, numChannels, blockSize, []
+            {
+                auto compressor = std::make_unique<dsp::Compressor<float>>();
+                compressor->setThreshold (-20.0f);
+                compressor->setRatio (4.0f);
+                return compressor;
+            }));
+
+            benchmarks.push_back (createProcessorBenchmark ("Limiter", {}, numChannels, blockSize, []
+            {
+                auto limiter = std::make_unique<dsp::Limiter<float>>();
+                limiter->setThreshold (-6.0f);
+                return limiter;
+            }));
+
+            benchmarks.push_back (createProcessorBenchmark ("DelayLine", {}, numChannels, blockSize,
+                                                            [] { return std::make_unique<ModulatedDelay>(); }));
+
+            benchmarks.push_back (createProcessorBenchmark ("Oscillator", {}, numChannels, blockSize, []
+            {
+                auto oscillator = std::make_unique<dsp::Oscillator<float>> ([] (float x) { return std::sin (x); }, 128);
+                oscillator->setFrequency (440.0f);
+                return oscillator;
+            }));
+
+            NamedValueSet tableParameters;
+            tableParameters.set ("numPoints", 1024);
+
+            benchmarks.push_back (createProcessorBenchmark ("LookupTableTransform", tableParameters, numChannels, blockSize, []
+            {
+                auto table = std::make_shared<dsp::LookupTableTransform<float>> ([] (float x) { return std::tanh (x); },
+                                                                                  -5.0f, 5.0f, 1024);
+                return std::make_unique<ArrayFunction> (ArrayFunction { [table] (const float* in, float* out, size_t n)
+                {
+                    table->process (in, out, n);
+                } });
+            }));
+
+            benchmarks.push_back (createProcessorBenchmark ("FastMathApproximations::tanh", {}, numChannels, blockSize, []
+            {
+                return std::make_unique<ArrayFunction> (ArrayFunction { [] (const float* in, float* out, size_t n)
+                {
+                    FloatVectorOperations::copy (out, in, n);
+                    dsp::FastMathApproximations::tanh (out, n);
+                } });
+            }));
+        }
+
+        // These are always stereo
+        benchmarks.push_back (createProcessorBenchmark ("Reverb", {}, 2, blockSize,
+                                                        [] { return std::make_unique<dsp::Reverb>(); }));
+
+        for (auto numDelayLines : { 8, 16, 32 })
+        {
+            NamedValueSet parameters;
+            parameters.set ("numDelayLines", numDelayLines);
+
+            benchmarks.push_back (createProcessorBenchmark ("FDNReverb", parameters, 2, blockSize,
+                                                            [numDelayLines] { return std::make_unique<dsp::FDNReverb<float>> (numDelayLines); }));
+        }
+
+        for (auto numVoices : { 8, 64 })
+        {
+            NamedValueSet parameters;
+            parameters.set ("numVoices", numVoices);
+
+            benchmarks.push_back (createProcessorBenchmark ("WavetableOscillatorBank", parameters, 2, blockSize, [numVoices]
+            {
+                auto bank = std::make_unique<dsp::WavetableOscillatorBank<float>> ([] (float x) { return x / MathConstants<float>::pi; });
+                bank->setNumVoices (numVoices);
+
+                for (int voice = 0; voice < numVoices; ++voice)
+                    bank->setFrequency (voice, 55.0f * (float) (voice + 1));
+
+                return bank;
+            }));
+        }
+    }
+}
+
+//==============================================================================
+/*  Returns the full list of benchmarks. */
+inline std::vector<Benchmark> createAll()
+{
+    std::vector<Benchmark> benchmarks;
+    addFloatVectorOperationsBenchmarks (benchmarks);
+    addFFTBenchmarks (benchmarks);
+    addConvolutionBenchmarks (benchmarks);
+    addFilterBenchmarks (benchmarks);
+    addOversamplingBenchmarks (benchmarks);
+    addWidgetBenchmarks (benchmarks);
+    return benchmarks;
+}
+
+} // namespace Benchmarks
@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#include <JuceHeader.h>
+#include "Benchmarks.h"
+
+//==============================================================================
+static String formatNumber (double value, int numDecimalPlaces, int width)
+{
+    return String (value, numDecimalPlaces).paddedLeft (' ', width);
+}
+
+static bool matchesFilter (const Benchmark& benchmark, const StringArray& filters)
+{
+    if (filters.isEmpty())
+        return true;
+
+    const auto id = benchmark.getID();
+
+    for (const auto& filter : filters)
+        if (id.containsIgnoreCase (filter))
+            return true;
+
+    return false;
+}
+
+//==============================================================================
+/*  Compares the medians of a set of results with those of an earlier run that was saved
+    as JSON, and returns the number of benchmarks that have slowed down by more than the
+    given percentage.
+*/
+static int compareWithBaseline (const std::vector<BenchmarkResult>& results, const File& baselineFile, double maxRegressionPercent)
+{
+    const auto baseline = JSON::parse (baselineFile);
+
+    if (! baseline.isObject())
+    {
+        std::cerr << "Couldn't read the baseline from " << baselineFile.getFullPathName() << std::endl;
+        return -1;
+    }
+
+    std::map<String, double> baselineMedians;
+
+    if (auto* baselineResults = baseline["results"].getArray())
+        for (const auto& result : *baselineResults)
+            baselineMedians[result["id"].toString()] = result["nsPerSample"]["median"];
+
+    std::cout << std::endl << "Comparison with " << baseline["label"].toString()
+              << " (" << baseline["date"].toString() << "):" << std::endl;
+
+    int numRegressions = 0;
+
+    for (const auto& result : results)
+    {
+        const auto it = baselineMedians.find (result.id);
+
+        if (it == baselineMedians.end() || it->second <= 0)
+            continue;
+
+        const auto changePercent = (result.nanosecondsPerSample.median / it->second - 1.0) * 100.0;
+        const auto isRegression = changePercent > maxRegressionPercent;
+
+        if (isRegression)
+            ++numRegressions;
+
+        std::cout << formatNumber (it->second, 3, 10) << " -> " << formatNumber (result.nanosecondsPerSample.median, 3, 8)
+                  << " ns/sample " << (changePercent >= 0 ? "+" : "") << String (changePercent, 1).paddedLeft (' ', 6) << "%  "
+                  << result.id << (isRegression ? "  <-- REGRESSION" : "") << std::endl;
+    }
+
+    return numRegressions;
+}
+
+//==============================================================================
+int main (int argc, char** argv)
+{
+    ArgumentList args (argc, argv);
+
+    if (args.containsOption ("--help|-h"))
+    {
+        std::cout << argv[0] << " [--help|-h] [--list] [--filter=text[,text...]]" << std::endl
+                  << "    [--repetitions=count] [--min-time-ms=ms] [--warm-up-ms=ms]" << std::endl
+                  << "    [--output=results.json] [--label=text]" << std::endl
+                  << "    [--baseline=results.json] [--max-regression=percent]" << std::endl << std::endl
+                  << "Times the juce_dsp processors over a range of settings, and optionally writes the" << std::endl
+                  << "results as JSON. If a baseline from an earlier run is given, the medians are compared" << std::endl
+                  << "with it, and the exit code is 1 if anything is slower by more than --max-regression." << std::endl;
+        return 0;
+    }
+
+    const auto filters = StringArray::fromTokens (args.getValueForOption ("--filter"), ",", {});
+
+    std::vector<Benchmark> benchmarks;
+
+    for (auto& benchmark : Benchmarks::createAll())
+        if (matchesFilter (benchmark, filters))
+            benchmarks.push_back (std::move (benchmark));
+
+    if (args.containsOption ("--list"))
+    {
+        for (const auto& benchmark : benchmarks)
+            std::cout << benchmark.getID() << std::endl;
+
+        return 0;
+    }
+
+    BenchmarkRunner::Options options;
+
+    if (args.containsOption ("--repetitions"))
+        options.numRepetitions = jmax (1, args.getValueForOption ("--repetitions").getIntValue());
+
+    if (args.containsOption ("--min-time-ms"))
+        options.minRepetitionTimeMs = jmax (0.0, args.getValueForOption ("--min-time-ms").getDoubleValue());
+
+    if (args.containsOption ("--warm-up-ms"))
+        options.warmUpTimeMs = jmax (0.0, args.getValueForOption ("--warm-up-ms").getDoubleValue());
+
+    const BenchmarkRunner runner (options);
+    const auto cyclesPerNanosecond = ResultsWriter::getCyclesPerNanosecond();
+
+    std::cout << SystemStats::getCpuModel() << ", " << SystemStats::getOperatingSystemName()
+              << ", " << ResultsWriter::getCompilerDescription() << std::endl
+              << "   ns/sample    +/-   cycles/sample" << std::endl;
+
+    std::vector<BenchmarkResult> results;
+
+    for (const auto& benchmark : benchmarks)
+    {
+        results.push_back (runner.run (benchmark));
+
+        const auto& statistics = results.back().nanosecondsPerSample;
+        const auto relativeDeviation = statistics.mean > 0 ? 100.0 * statistics.standardDeviation / statistics.mean : 0.0;
+
+        std::cout << formatNumber (statistics.median, 3, 12) << formatNumber (relativeDeviation, 1, 6) << "%"
+                  << formatNumber (statistics.median * cyclesPerNanosecond, 2, 12) << "    " << benchmark.getID() << std::endl;
+    }
+
+    if (args.containsOption ("--output"))
+    {
+        const auto file = args.getFileForOption ("--output");
+        file.deleteFile();
+        FileOutputStream stream (file);
+
+        if (! stream.openedOk())
+        {
+            std::cerr << "Couldn't write to " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+
+        ResultsWriter::write (stream, results, options, args.getValueForOption ("--label"));
+    }
+
+    if (args.containsOption ("--baseline"))
+    {
+        const auto maxRegression = args.containsOption ("--max-regression")
+                                 ? args.getValueForOption ("--max-regression").getDoubleValue()
+                                 : std::numeric_limits<double>::infinity();
+
+        const auto numRegressions = compareWithBaseline (results, args.getFileForOption ("--baseline"), maxRegression);
+
+        if (numRegressions != 0)
+            return 1;
+    }
+
+    return 0;
+}
@@ -450,6 +450,357 @@ void AudioDataConverters::deinterleaveSamples (const float* source, float** dest
                                     numSamples);
 }
 
+//==============================================================================
+namespace PackedSampleHelpers
+{
+    template <int bytesPerSample, bool isBigEndian>
+    struct Sample;
+
+    template <bool isBigEndian>
+    struct Sample<2, isBigEndian>
+    {
+        static int32 read (const uint8* p) noexcept
+        {
+            const auto v = readUnaligned<uint16> (p);
+            return (int32) ((uint32) (isBigEndian ? ByteOrder::swapIfLittleEndian (v) : ByteOrder::swapIfBigEndian (v)) << 16);
+        }
+
+        static void write (uint8* p, int32 value) noexcept
+        {
+            const auto v = (uint16) (value >> 16);
+            writeUnaligned (p, isBigEndian ? ByteOrder::swapIfLittleEndian (v) : ByteOrder::swapIfBigEndian (v));
+        }
+    };
+
+    template <bool isBigEndian>
+    struct Sample<3, isBigEndian>
+    {
+        static int32 read (const uint8* p) noexcept
+        {
+            return (int32) ((uint32) (isBigEndian ? ByteOrder::bigEndian24Bit (p) : ByteOrder::littleEndian24Bit (p)) << 8);
+        }
+
+        static void write (uint8* p, int32 value) noexcept
+        {
+            if constexpr (isBigEndian)  ByteOrder::bigEndian24BitToChars (value >> 8, p);
+            else                        ByteOrder::littleEndian24BitToChars (value >> 8, p);
+        }
+    };
+
+    template <bool isBigEndian>
+    struct Sample<4, isBigEndian>
+    {
+        static int32 read (const uint8* p) noexcept
+        {
+            const auto v = readUnaligned<uint32> (p);
+            return (int32) (isBigEndian ? ByteOrder::swapIfLittleEndian (v) : ByteOrder::swapIfBigEndian (v));
+        }
+
+        static void write (uint8* p, int32 value) noexcept
+        {
+            writeUnaligned (p, isBigEndian ? ByteOrder::swapIfLittleEndian ((uint32) value)
+                                           : ByteOrder::swapIfBigEndian ((uint32) value));
+        }
+    };
+
+    // Reads a sample that's known not to be the last one in the buffer. For little-endian
+    // 24-bit data, this loads four bytes at once and shifts the spare byte out of the bottom.
+    template <int bytesPerSample, bool isBigEndian>
+    static int32 readNotLast (const uint8* p) noexcept
+    {
+        if constexpr (bytesPerSample == 3 && ! isBigEndian && ! ByteOrder::isBigEndian())
+            return (int32) (readUnaligned<uint32> (p) << 8);
+        else
+            return Sample<bytesPerSample, isBigEndian>::read (p);
+    }
+
+   #if JUCE_USE_SSE_INTRINSICS
+    // These handle the most common mono and stereo layouts, returning the number of
+    // samples done. The caller takes care of whatever's left over.
+    template <int bytesPerSample>
+    static int deinterleaveSSE (const uint8* source, int32* left, int32* right, int numSamples) noexcept
+    {
+        int i = 0;
+
+        // SSE2 has no byte shuffle, so 24-bit samples are lined up by shifting whole
+        // registers along by multiples of 3 bytes, then picking out the bottom 32 bits of each.
+        const auto packed24 = [] (__m128i a, __m128i b, __m128i c, __m128i d)
+        {
+            return _mm_slli_epi32 (_mm_unpacklo_epi64 (_mm_unpacklo_epi32 (a, b), _mm_unpacklo_epi32 (c, d)), 8);
+        };
+
+        ignoreUnused (packed24);
+
+        if constexpr (bytesPerSample == 2)
+        {
+            const auto zero = _mm_setzero_si128();
+
+            if (right == nullptr)
+            {
+                for (; i + 8 <= numSamples; i += 8)
+                {
+                    const auto v = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (source + i * 2));
+                    _mm_storeu_si128 (reinterpret_cast<__m128i*> (left + i),     _mm_unpacklo_epi16 (zero, v));
+                    _mm_storeu_si128 (reinterpret_cast<__m128i*> (left + i + 4), _mm_unpackhi_epi16 (zero, v));
+                }
+            }
+            else
+            {
+                for (; i + 4 <= numSamples; i += 4)
+                {
+                    const auto v = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (source + i * 4));
+                    const auto a = _mm_shuffle_epi32 (_mm_unpacklo_epi16 (zero, v), _MM_SHUFFLE (3, 1, 2, 0));
+                    const auto b = _mm_shuffle_epi32 (_mm_unpackhi_epi16 (zero, v), _MM_SHUFFLE (3, 1, 2, 0));
+                    _mm_storeu_si128 (reinterpret_cast<__m128i*> (left + i),  _mm_unpacklo_epi64 (a, b));
+                    _mm_storeu_si128 (reinterpret_cast<__m128i*> (right + i), _mm_unpackhi_epi64 (a, b));
+                }
+            }
+        }
+        else if constexpr (bytesPerSample == 3)
+        {
+            if (right == nullptr)
+            {
+                for (; i * 3 + 16 <= numSamples * 3; i += 4)
+                {
+                    const auto v = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (source + i * 3));
+                    _mm_storeu_si128 (reinterpret_cast<__m128i*> (left + i),
+                                      packed24 (v, _mm_srli_si128 (v, 3), _mm_srli_si128 (v, 6), _mm_srli_si128 (v, 9)));
+                }
+            }
+            else
+            {
+                for (; i * 6 + 28 <= numSamples * 6; i += 4)
+                {
+                    const auto a = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (source + i * 6));
+                    const auto b = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (source + i * 6 + 12));
+                    _mm_storeu_si128 (reinterpret_cast<__m128i*> (left + i),
+                                      packed24 (a, _mm_srli_si128 (a, 6), b, _mm_srli_si128 (b, 6)));
+                    _mm_storeu_si128 (reinterpret_cast<__m128i*> (right + i),
+                                      packed24 (_mm_srli_si128 (a, 3), _mm_srli_si128 (a, 9), _mm_srli_si128 (b, 3), _mm_srli_si128 (b, 9)));
+                }
+            }
+        }
+        else if constexpr (bytesPerSample == 4)
+        {
+            if (right == nullptr)
+            {
+                memcpy (left, source, (size_t) numSamples * sizeof (int32));
+                i = numSamples;
+            }
+            else
+            {
+                for (; i + 4 <= numSamples; i += 4)
+                {
+                    const auto a = _mm_castsi128_ps (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (source + i * 8)));
+                    const auto b = _mm_castsi128_ps (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (source + i * 8 + 16)));
+                    _mm_storeu_si128 (reinterpret_cast<__m128i*> (left + i),  _mm_castps_si128 (_mm_shuffle_ps (a, b, _MM_SHUFFLE (2, 0, 2, 0))));
+                    _mm_storeu_si128 (reinterpret_cast<__m128i*> (right + i), _mm_castps_si128 (_mm_shuffle_ps (a, b, _MM_SHUFFLE (3, 1, 3, 1))));
+                }
+            }
+        }
+
+        return i;
+    }
+
+    template <int bytesPerSample>
+    static int interleaveSSE (const int32* left, const int32* right, uint8* dest, int numSamples) noexcept
+    {
+        int i = 0;
+
+        if constexpr (bytesPerSample == 2)
+        {
+            if (right == nullptr)
+            {
+                for (; i + 8 <= numSamples; i += 8)
+                {
+                    const auto a = _mm_srai_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (left + i)), 16);
+                    const auto b = _mm_srai_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (left + i + 4)), 16);
+                    _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + i * 2), _mm_packs_epi32 (a, b));
+                }
+            }
+            else
+            {
+                for (; i + 4 <= numSamples; i += 4)
+                {
+                    const auto l = _mm_srai_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (left + i)), 16);
+                    const auto r = _mm_srai_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (right + i)), 16);
+                    _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + i * 4), _mm_packs_epi32 (_mm_unpacklo_epi32 (l, r),
+                                                                                                  _mm_unpackhi_epi32 (l, r)));
+                }
+            }
+        }
+        else if constexpr (bytesPerSample == 4)
+        {
+            if (right == nullptr)
+            {
+                memcpy (dest, left, (size_t) numSamples * sizeof (int32));
+                i = numSamples;
+            }
+            else
+            {
+                for (; i + 4 <= numSamples; i += 4)
+                {
+                    const auto l = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (left + i));
+                    const auto r = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (right + i));
+                    _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + i * 8),      _mm_unpacklo_epi32 (l, r));
+                    _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + i * 8 + 16), _mm_unpackhi_epi32 (l, r));
+                }
+            }
+        }
+
+        return i;
+    }
+   #endif
+
+    template <int bytesPerSample, bool isBigEndian>
+    static void deinterleave (const uint8* source, int numSourceChannels,
+                              int32* const* dest, int destStartSample, int numChannels, int numSamples) noexcept
+    {
+        const auto frameSize = bytesPerSample * numSourceChannels;
+        int chan = 0;
+
+       #if JUCE_USE_SSE_INTRINSICS
+        if constexpr (! isBigEndian)
+        {
+            if (numSourceChannels <= 2 && numChannels == numSourceChannels
+                 && dest[0] != nullptr && (numChannels == 1 || dest[1] != nullptr))
+            {
+                auto* left  = dest[0] + destStartSample;
+                auto* right = numChannels == 2 ? dest[1] + destStartSample : nullptr;
+                const auto numDone = deinterleaveSSE<bytesPerSample> (source, left, right, numSamples);
+
+                for (int i = numDone; i < numSamples; ++i)
+                {
+                    left[i] = Sample<bytesPerSample, isBigEndian>::read (source + i * frameSize);
+
+                    if (right != nullptr)
+                        right[i] = Sample<bytesPerSample, isBigEndian>::read (source + i * frameSize + bytesPerSample);
+                }
+
+                chan = numChannels;
+            }
+        }
+       #endif
+
+        for (; chan < numChannels; ++chan)
+        {
+            if (auto* d = dest[chan])
+            {
+                d += destStartSample;
+                auto* s = source + chan * bytesPerSample;
+
+                for (int i = 0; i < numSamples - 1; ++i)
+                    d[i] = readNotLast<bytesPerSample, isBigEndian> (s + i * frameSize);
+
+                d[numSamples - 1] = Sample<bytesPerSample, isBigEndian>::read (s + (numSamples - 1) * frameSize);
+            }
+        }
+    }
+
+    template <int bytesPerSample, bool isBigEndian>
+    static void interleave (const int32* const* source, int sourceStartSample, int numSourceChannels,
+                            uint8* dest, int numDestChannels, int numSamples) noexcept
+    {
+        const auto frameSize = bytesPerSample * numDestChannels;
+        int i = 0;
+
+       #if JUCE_USE_SSE_INTRINSICS
+        if constexpr (! isBigEndian)
+        {
+            if (numDestChannels == 1 && numSourceChannels >= 1 && source[0] != nullptr)
+                i = interleaveSSE<bytesPerSample> (source[0] + sourceStartSample, nullptr, dest, numSamples);
+            else if (numDestChannels == 2 && numSourceChannels >= 2 && source[0] != nullptr && source[1] != nullptr)
+                i = interleaveSSE<bytesPerSample> (source[0] + sourceStartSample, source[1] + sourceStartSample, dest, numSamples);
+        }
+       #endif
+
+        if (i >= numSamples)
+            return;
+
+        for (int chan = 0; chan < numDestChannels; ++chan)
+        {
+            auto* d = dest + chan * bytesPerSample;
+
+            if (const auto* s = chan < numSourceChannels ? source[chan] : nullptr)
+            {
+                s += sourceStartSample;
+
+                for (int j = i; j < numSamples; ++j)
+                    Sample<bytesPerSample, isBigEndian>::write (d + j * frameSize, s[j]);
+            }
+            else
+            {
+                for (int j = i; j < numSamples; ++j)
+                    Sample<bytesPerSample, isBigEndian>::write (d + j * frameSize, 0);
+            }
+        }
+    }
+}
+
+void AudioData::deinterleavePackedSamples (const void* source, int numSourceChannels,
+                                           int bytesPerSample, bool sourceIsBigEndian,
+                                           int32* const* dest, int destStartSample, int numDestChannels,
+                                           int numSamples) noexcept
+{
+    using namespace PackedSampleHelpers;
+
+    if (numSamples <= 0)
+        return;
+
+    for (int i = jmax (0, numSourceChannels); i < numDestChannels; ++i)
+        if (dest[i] != nullptr)
+            zeromem (dest[i] + destStartSample, (size_t) numSamples * sizeof (int32));
+
+    const auto numChannels = jmin (numSourceChannels, numDestChannels);
+
+    if (numChannels <= 0)
+        return;
+
+    auto* src = static_cast<const uint8*> (source);
+
+    switch (bytesPerSample)
+    {
+        case 2:     if (sourceIsBigEndian) deinterleave<2, true> (src, numSourceChannels, dest, destStartSample, numChannels, numSamples);
+                    else                   deinterleave<2, false> (src, numSourceChannels, dest, destStartSample, numChannels, numSamples);
+                    break;
+        case 3:     if (sourceIsBigEndian) deinterleave<3, true> (src, numSourceChannels, dest, destStartSample, numChannels, numSamples);
+                    else                   deinterleave<3, false> (src, numSourceChannels, dest, destStartSample, numChannels, numSamples);
+                    break;
+        case 4:     if (sourceIsBigEndian) deinterleave<4, true> (src, numSourceChannels, dest, destStartSample, numChannels, numSamples);
+                    else                   deinterleave<4, false> (src, numSourceChannels, dest, destStartSample, numChannels, numSamples);
+                    break;
+        default:    jassertfalse; break;
+    }
+}
+
+void AudioData::interleavePackedSamples (const int32* const* source, int sourceStartSample, int numSourceChannels,
+                                         void* dest, int numDestChannels,
+                                         int bytesPerSample, bool destIsBigEndian,
+                                         int numSamples) noexcept
+{
+    using namespace PackedSampleHelpers;
+
+    if (numSamples <= 0 || numDestChannels <= 0)
+        return;
+
+    auto* dst = static_cast<uint8*> (dest);
+    numSourceChannels = jmax (0, numSourceChannels);
+
+    switch (bytesPerSample)
+    {
+        case 2:     if (destIsBigEndian) interleave<2, true> (source, sourceStartSample, numSourceChannels, dst, numDestChannels, numSamples);
+                    else                 interleave<2, false> (source, sourceStartSample, numSourceChannels, dst, numDestChannels, numSamples);
+                    break;
+        case 3:     if (destIsBigEndian) interleave<3, true> (source, sourceStartSample, numSourceChannels, dst, numDestChannels, numSamples);
+                    else                 interleave<3, false> (source, sourceStartSample, numSourceChannels, dst, numDestChannels, numSamples);
+                    break;
+        case 4:     if (destIsBigEndian) interleave<4, true> (source, sourceStartSample, numSourceChannels, dst, numDestChannels, numSamples);
+                    else                 interleave<4, false> (source, sourceStartSample, numSourceChannels, dst, numDestChannels, numSamples);
+                    break;
+        default:    jassertfalse; break;
+    }
+}
+
 //==============================================================================
 //==============================================================================
 #if JUCE_UNIT_TESTS
@@ -555,6 +906,88 @@ public:
         }
     };
 
+    template <class SampleFormat, class Endianness>
+    static void testPackedConversion (UnitTest& unitTest, Random& r)
+    {
+        using PackedSource = AudioData::Pointer<SampleFormat, Endianness, AudioData::Interleaved, AudioData::Const>;
+        using PackedDest   = AudioData::Pointer<SampleFormat, Endianness, AudioData::Interleaved, AudioData::NonConst>;
+        using NativeSource = AudioData::Pointer<AudioData::Int32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::Const>;
+        using NativeDest   = AudioData::Pointer<AudioData::Int32, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::NonConst>;
+
+        constexpr auto bytesPerSample = (int) SampleFormat::bytesPerSample;
+        constexpr auto isBigEndian = std::is_base_of_v<AudioData::BigEndian, Endianness>;
+        constexpr auto numSamples = 67;
+
+        for (const auto numChannels : { 1, 2, 3, 8 })
+        {
+            HeapBlock<uint8> packed ((size_t) (numChannels * numSamples * bytesPerSample));
+
+            for (size_t i = 0; i < (size_t) (numChannels * numSamples * bytesPerSample); ++i)
+                packed[i] = (uint8) r.nextInt (256);
+
+            // one destination channel more than the source has, and one of them null
+            std::vector<std::vector<int32>> expected ((size_t) numChannels + 1, std::vector<int32> (numSamples + 3)),
+                                            actual   ((size_t) numChannels + 1, std::vector<int32> (numSamples + 3));
+
+            std::vector<int32*> expectedChans, actualChans;
+
+            for (size_t ch = 0; ch < expected.size(); ++ch)
+            {
+                const auto isNull = numChannels > 2 && ch == 1;
+                expectedChans.push_back (isNull ? nullptr : expected[ch].data() + 3);
+                actualChans.push_back (isNull ? nullptr : actual[ch].data());
+            }
+
+            for (int ch = 0; ch <= numChannels; ++ch)
+            {
+                if (expectedChans[(size_t) ch] == nullptr)
+                    continue;
+
+                const NativeDest dest (expectedChans[(size_t) ch]);
+
+                if (ch < numChannels)
+                    dest.convertSamples (PackedSource (packed + ch * bytesPerSample, numChannels), numSamples);
+                else
+                    dest.clearSamples (numSamples);
+            }
+
+            AudioData::deinterleavePackedSamples (packed.get(), numChannels, bytesPerSample, isBigEndian,
+                                                  actualChans.data(), 3, numChannels + 1, numSamples);
+
+            unitTest.expect (expected == actual);
+
+            // ..and back again, to one more channel than the source has
+            HeapBlock<uint8> expectedPacked ((size_t) ((numChannels + 1) * numSamples * bytesPerSample), true),
+                             actualPacked   ((size_t) ((numChannels + 1) * numSamples * bytesPerSample), true);
+
+            std::vector<const int32*> sourceChans;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                sourceChans.push_back (expected[(size_t) ch].data() + 3);
+
+            for (int ch = 0; ch <= numChannels; ++ch)
+            {
+                const PackedDest dest (expectedPacked + ch * bytesPerSample, numChannels + 1);
+
+                if (ch < numChannels)
+                    dest.convertSamples (NativeSource (sourceChans[(size_t) ch]), numSamples);
+                else
+                    dest.clearSamples (numSamples);
+            }
+
+            sourceChans.clear();
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                sourceChans.push_back (expected[(size_t) ch].data());
+
+            AudioData::interleavePackedSamples (sourceChans.data(), 3, numChannels,
+                                                actualPacked.get(), numChannels + 1, bytesPerSample, isBigEndian,
+                                                numSamples);
+
+            unitTest.expect (memcmp (expectedPacked.get(), actualPacked.get(), (size_t) ((numChannels + 1) * numSamples * bytesPerSample)) == 0);
+        }
+    }
+
     template <class FormatType>
     struct Test1
     {
@@ -602,6 +1035,16 @@ public:
                     expectEquals (destBuffer.getSample (0, ch + (i * numChannels)), sourceBuffer.getSample (ch, i));
         }
 
+        beginTest ("Packed sample conversion matches the generic conversion");
+        {
+            testPackedConversion<AudioData::Int16, AudioData::LittleEndian> (*this, r);
+            testPackedConversion<AudioData::Int16, AudioData::BigEndian>    (*this, r);
+            testPackedConversion<AudioData::Int24, AudioData::LittleEndian> (*this, r);
+            testPackedConversion<AudioData::Int24, AudioData::BigEndian>    (*this, r);
+            testPackedConversion<AudioData::Int32, AudioData::LittleEndian> (*this, r);
+            testPackedConversion<AudioData::Int32, AudioData::BigEndian>    (*this, r);
+        }
+
         beginTest ("Deinterleaving");
         {
             constexpr auto numChannels = 4;
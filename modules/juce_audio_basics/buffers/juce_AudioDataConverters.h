@@ -784,6 +784,57 @@ public:
             }
         }
     }
+
+    //==============================================================================
+    /** Converts interleaved 16, 24 or 32-bit packed samples into non-interleaved, native-endian
+        32-bit integers.
+
+        This produces the same results as converting from an interleaved Int16, Int24 or Int32
+        source to a non-interleaved Int32 destination, so the samples end up left-justified in
+        the 32-bit range. But it's written for the bulk conversions done when reading audio
+        files, and uses SIMD instructions for the most common layouts.
+        When bytesPerSample is 4 the bits are copied unchanged, so this also deinterleaves
+        32-bit float data.
+
+        Any null destination channels are skipped, and any destination channels beyond
+        numSourceChannels are cleared.
+
+        @param source               the interleaved source data
+        @param numSourceChannels    the number of channels interleaved in the source data
+        @param bytesPerSample       the size of each source sample: this must be 2, 3 or 4
+        @param sourceIsBigEndian    the byte order of the source samples
+        @param dest                 an array of numDestChannels destination channel pointers
+        @param destStartSample      the index within each destination channel to start writing at
+        @param numDestChannels      the number of destination channels
+        @param numSamples           the number of samples to convert in each channel
+    */
+    static void deinterleavePackedSamples (const void* source, int numSourceChannels,
+                                           int bytesPerSample, bool sourceIsBigEndian,
+                                           int32* const* dest, int destStartSample, int numDestChannels,
+                                           int numSamples) noexcept;
+
+    /** Converts non-interleaved, native-endian 32-bit integers into interleaved 16, 24 or
+        32-bit packed samples.
+
+        This is the reverse of deinterleavePackedSamples(). The source values are truncated
+        to the destination's bit depth in the same way as the Int16, Int24 and Int32 formats do.
+
+        Any destination channels with a null source channel, or beyond numSourceChannels,
+        are cleared.
+
+        @param source               an array of numSourceChannels source channel pointers
+        @param sourceStartSample    the index within each source channel to start reading at
+        @param numSourceChannels    the number of source channels
+        @param dest                 the interleaved destination data
+        @param numDestChannels      the number of channels to interleave in the destination
+        @param bytesPerSample       the size of each destination sample: this must be 2, 3 or 4
+        @param destIsBigEndian      the byte order of the destination samples
+        @param numSamples           the number of samples to convert in each channel
+    */
+    static void interleavePackedSamples (const int32* const* source, int sourceStartSample, int numSourceChannels,
+                                         void* dest, int numDestChannels,
+                                         int bytesPerSample, bool destIsBigEndian,
+                                         int numSamples) noexcept;
 };
 
 //==============================================================================
@@ -208,13 +208,12 @@ namespace MidiFileHelpers
         }
     }
 
-    static MidiMessageSequence readTrack (const uint8* data, int size)
+    template <typename Callback>
+    static void forEachEventInTrack (const uint8* data, int size, Callback&& callback)
     {
         double time = 0;
         uint8 lastStatusByte = 0;
 
-        MidiMessageSequence result;
-
         while (size > 0)
         {
             const auto delay = MidiMessage::readVariableLengthValue (data, (int) size);
@@ -238,14 +237,69 @@ namespace MidiFileHelpers
             size -= messSize;
             data += messSize;
 
-            result.addEvent (mm);
+            callback (mm);
 
             auto firstByte = *(mm.getRawData());
 
             if ((firstByte & 0xf0) != 0xf0)
                 lastStatusByte = firstByte;
         }
+    }
 
+    static MidiMessageSequence readTrack (const uint8* data, int size)
+    {
+        MidiMessageSequence result;
+        forEachEventInTrack (data, size, [&] (const MidiMessage& m) { result.addEvent (m); });
+        return result;
+    }
+
+    struct TrackChunks
+    {
+        HeaderDetails header;
+        Array<Span<const uint8>> tracks;
+        bool allChunksValid = false;
+    };
+
+    // Finds the MTrk chunks without decoding them. If the file is malformed, this returns
+    // the chunks that were found before the error.
+    static Optional<TrackChunks> findTrackChunks (const uint8* d, size_t size)
+    {
+        const auto optHeader = parseMidiHeader (d, size);
+
+        if (! optHeader.hasValue())
+            return {};
+
+        TrackChunks result;
+        result.header = *optHeader;
+
+        d += result.header.bytesRead;
+        size -= (size_t) result.header.bytesRead;
+
+        for (int track = 0; track < result.header.numberOfTracks; ++track)
+        {
+            const auto optChunkType = tryRead<uint32> (d, size);
+
+            if (! optChunkType.hasValue())
+                return result;
+
+            const auto optChunkSize = tryRead<uint32> (d, size);
+
+            if (! optChunkSize.hasValue())
+                return result;
+
+            const auto chunkSize = *optChunkSize;
+
+            if (size < chunkSize)
+                return result;
+
+            if (*optChunkType == ByteOrder::bigEndianInt ("MTrk"))
+                result.tracks.add ({ d, (size_t) chunkSize });
+
+            size -= chunkSize;
+            d += chunkSize;
+        }
+
+        result.allChunksValid = (size == 0);
         return result;
     }
 }
@@ -356,53 +410,104 @@ bool MidiFile::readFrom (InputStream& sourceStream,
     if (! sourceStream.readIntoMemoryBlock (data, maxSensibleMidiFileSize))
         return false;
 
-    auto size = data.getSize();
-    auto d = static_cast<const uint8*> (data.getData());
+    return readFrom (data.getData(), data.getSize(), createMatchingNoteOffs, fileType);
+}
+
+bool MidiFile::readFrom (const File& file,
+                         bool createMatchingNoteOffs,
+                         int* fileType,
+                         ThreadPool* threadPoolToUse)
+{
+    MemoryMappedFile mappedFile (file, MemoryMappedFile::readOnly);
+
+    if (mappedFile.getData() != nullptr)
+        return readFrom (mappedFile.getData(), mappedFile.getSize(), createMatchingNoteOffs, fileType, threadPoolToUse);
+
+    clear();
+
+    if (auto in = file.createInputStream())
+        return readFrom (*in, createMatchingNoteOffs, fileType);
+
+    return false;
+}
+
+bool MidiFile::readFrom (const void* data,
+                         size_t numBytes,
+                         bool createMatchingNoteOffs,
+                         int* fileType,
+                         ThreadPool* threadPoolToUse)
+{
+    clear();
 
-    const auto optHeader = MidiFileHelpers::parseMidiHeader (d, size);
+    const auto chunks = MidiFileHelpers::findTrackChunks (static_cast<const uint8*> (data), numBytes);
 
-    if (! optHeader.hasValue())
+    if (! chunks.hasValue())
         return false;
 
-    const auto header = *optHeader;
-    timeFormat = header.timeFormat;
+    timeFormat = chunks->header.timeFormat;
 
-    d += header.bytesRead;
-    size -= (size_t) header.bytesRead;
+    for (int i = 0; i < chunks->tracks.size(); ++i)
+        tracks.add (new MidiMessageSequence());
 
-    for (int track = 0; track < header.numberOfTracks; ++track)
+    if (threadPoolToUse != nullptr && chunks->tracks.size() > 1)
     {
-        const auto optChunkType = MidiFileHelpers::tryRead<uint32> (d, size);
+        struct TrackReaderJob final : public ThreadPoolJob
+        {
+            TrackReaderJob (MidiMessageSequence& dest, Span<const uint8> chunkToRead, bool matchNoteOffs)
+                : ThreadPoolJob ("MidiFile track reader"), sequence (dest), chunk (chunkToRead), createMatchingNoteOffs (matchNoteOffs) {}
 
-        if (! optChunkType.hasValue())
-            return false;
+            JobStatus runJob() override
+            {
+                sequence = readTrack (chunk.data(), (int) chunk.size(), createMatchingNoteOffs);
+                return jobHasFinished;
+            }
 
-        const auto optChunkSize = MidiFileHelpers::tryRead<uint32> (d, size);
+            MidiMessageSequence& sequence;
+            Span<const uint8> chunk;
+            bool createMatchingNoteOffs;
+        };
 
-        if (! optChunkSize.hasValue())
-            return false;
+        OwnedArray<TrackReaderJob> jobs;
 
-        const auto chunkSize = *optChunkSize;
+        for (int i = 0; i < chunks->tracks.size(); ++i)
+            threadPoolToUse->addJob (jobs.add (new TrackReaderJob (*tracks.getUnchecked (i), chunks->tracks.getReference (i), createMatchingNoteOffs)), false);
 
-        if (size < chunkSize)
-            return false;
+        for (auto* job : jobs)
+            threadPoolToUse->waitForJobToFinish (job, -1);
+    }
+    else
+    {
+        for (int i = 0; i < chunks->tracks.size(); ++i)
+        {
+            auto& chunk = chunks->tracks.getReference (i);
+            *tracks.getUnchecked (i) = readTrack (chunk.data(), (int) chunk.size(), createMatchingNoteOffs);
+        }
+    }
 
-        if (*optChunkType == ByteOrder::bigEndianInt ("MTrk"))
-            readNextTrack (d, (int) chunkSize, createMatchingNoteOffs);
+    if (chunks->allChunksValid && fileType != nullptr)
+        *fileType = chunks->header.fileType;
 
-        size -= chunkSize;
-        d += chunkSize;
-    }
+    return chunks->allChunksValid;
+}
 
-    const auto successful = (size == 0);
+bool MidiFile::readEvents (const void* data, size_t numBytes,
+                           const std::function<void (int, const MidiMessage&)>& callback)
+{
+    const auto chunks = MidiFileHelpers::findTrackChunks (static_cast<const uint8*> (data), numBytes);
+
+    if (! chunks.hasValue())
+        return false;
 
-    if (successful && fileType != nullptr)
-        *fileType = header.fileType;
+    for (int i = 0; i < chunks->tracks.size(); ++i)
+    {
+        auto& chunk = chunks->tracks.getReference (i);
+        MidiFileHelpers::forEachEventInTrack (chunk.data(), (int) chunk.size(), [&] (const MidiMessage& m) { callback (i, m); });
+    }
 
-    return successful;
+    return chunks->allChunksValid;
 }
 
-void MidiFile::readNextTrack (const uint8* data, int size, bool createMatchingNoteOffs)
+MidiMessageSequence MidiFile::readTrack (const uint8* data, int size, bool createMatchingNoteOffs)
 {
     auto sequence = MidiFileHelpers::readTrack (data, size);
 
@@ -423,7 +528,7 @@ void MidiFile::readNextTrack (const uint8* data, int size, bool createMatchingNo
     if (createMatchingNoteOffs)
         sequence.updateMatchedPairs();
 
-    addTrack (sequence);
+    return sequence;
 }
 
 //==============================================================================
@@ -741,6 +846,70 @@ struct MidiFileTest final : public UnitTest
                 expectEquals (track.getEventPointer (0)->message.getTimeStamp(), (double) 0x0f);
             }
         }
+
+        beginTest ("Read from memory in parallel");
+        {
+            MidiFile original;
+            auto random = getRandom();
+
+            for (int t = 0; t < 8; ++t)
+            {
+                MidiMessageSequence track;
+
+                for (int i = 0; i < 500; ++i)
+                {
+                    const auto note = random.nextInt (128);
+                    track.addEvent (MidiMessage::noteOn (1 + t, note, (uint8) 100), i * 10);
+                    track.addEvent (MidiMessage::noteOff (1 + t, note), i * 10 + random.nextInt (30));
+                }
+
+                track.addEvent (MidiMessage::endOfTrack(), 6000);
+                track.updateMatchedPairs();
+                original.addTrack (track);
+            }
+
+            MemoryOutputStream os;
+            expect (original.writeTo (os));
+
+            MidiFile fromStream, fromMemory;
+            MemoryInputStream is (os.getData(), os.getDataSize(), false);
+            expect (fromStream.readFrom (is));
+
+            ThreadPool pool (ThreadPoolOptions{}.withNumberOfThreads (4));
+            int fileType = -1;
+            expect (fromMemory.readFrom (os.getData(), os.getDataSize(), true, &fileType, &pool));
+            expectEquals (fileType, 1);
+            expectEquals (fromMemory.getNumTracks(), fromStream.getNumTracks());
+
+            for (int t = 0; t < fromStream.getNumTracks(); ++t)
+            {
+                auto& a = *fromStream.getTrack (t);
+                auto& b = *fromMemory.getTrack (t);
+                expectEquals (a.getNumEvents(), b.getNumEvents());
+
+                for (int i = 0; i < jmin (a.getNumEvents(), b.getNumEvents()); ++i)
+                {
+                    expect (a.getEventPointer (i)->message.getDescription() == b.getEventPointer (i)->message.getDescription());
+                    expectEquals (a.getEventPointer (i)->message.getTimeStamp(), b.getEventPointer (i)->message.getTimeStamp());
+                    expectEquals (a.getIndexOfMatchingKeyUp (i), b.getIndexOfMatchingKeyUp (i));
+                }
+            }
+
+            // readEvents() doesn't add any note-offs, so compare it with a file that was read without them
+            MidiFile unmatched;
+            expect (unmatched.readFrom (os.getData(), os.getDataSize(), false));
+
+            Array<int> eventsPerTrack;
+            eventsPerTrack.insertMultiple (0, 0, unmatched.getNumTracks());
+
+            expect (MidiFile::readEvents (os.getData(), os.getDataSize(), [&] (int track, const MidiMessage&)
+            {
+                eventsPerTrack.getReference (track)++;
+            }));
+
+            for (int t = 0; t < unmatched.getNumTracks(); ++t)
+                expectEquals (eventsPerTrack[t], unmatched.getTrack (t)->getNumEvents());
+        }
     }
 
     template <typename Fn>
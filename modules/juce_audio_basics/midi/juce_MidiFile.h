@@ -166,6 +166,59 @@ public:
                    bool createMatchingNoteOffs = true,
                    int* midiFileType = nullptr);
 
+    /** Reads a midi file, memory-mapping it rather than loading it into memory.
+
+        This behaves like the other readFrom() methods. If the file can't be mapped, it'll
+        be read with a normal stream instead.
+
+        @see readFrom
+    */
+    bool readFrom (const File& file,
+                   bool createMatchingNoteOffs = true,
+                   int* midiFileType = nullptr,
+                   ThreadPool* threadPoolToUse = nullptr);
+
+    /** Reads a midi file from a block of memory, such as a memory-mapped file.
+
+        This is like readFrom (InputStream&), but doesn't need to copy the data. The positions
+        of the track chunks are found first, so if a ThreadPool is supplied, the tracks are
+        then decoded in parallel by its threads. This method blocks until all the tracks have
+        been read, so it must not be called from one of the pool's own jobs.
+
+        @param data                     the contents of the midi file
+        @param numBytes                 the size of the data, in bytes
+        @param createMatchingNoteOffs   if true, any missing note-offs for previous note-ons will
+                                        be automatically added by calling
+                                        MidiMessageSequence::updateMatchedPairs on each track
+        @param midiFileType             if not nullptr, the integer at this address will be set
+                                        to 0, 1, or 2 depending on the type of the midi file
+        @param threadPoolToUse          an optional pool to use to decode the tracks
+
+        @returns true if the data was read successfully
+    */
+    bool readFrom (const void* data,
+                   size_t numBytes,
+                   bool createMatchingNoteOffs = true,
+                   int* midiFileType = nullptr,
+                   ThreadPool* threadPoolToUse = nullptr);
+
+    /** Decodes the events in a midi file without building any MidiMessageSequences.
+
+        The callback is called for each event in the order in which it appears in the file,
+        along with the index of the track that contains it. The message's timestamp is its
+        position in midi ticks. The MidiMessage is only valid during the callback, and it only
+        allocates memory for sysex and meta events that are too long to be stored inline, so
+        channel events can be copied into a preallocated MidiBuffer, or converted to Universal
+        MIDI Packets with ump::Conversion::toMidi1(), without any allocation per event.
+
+        Unlike readFrom(), this doesn't sort the events of each track or add any note-offs.
+
+        @returns true if the data was a valid midi file
+    */
+    static bool readEvents (const void* data,
+                            size_t numBytes,
+                            const std::function<void (int trackIndex, const MidiMessage&)>& callback);
+
     /** Writes the midi tracks as a standard midi file.
         The midiFileType value is written as the file's format type, which can be 0, 1
         or 2 - see the midi file spec for more info about that.
@@ -189,7 +242,7 @@ private:
     OwnedArray<MidiMessageSequence> tracks;
     short timeFormat;
 
-    void readNextTrack (const uint8*, int, bool);
+    static MidiMessageSequence readTrack (const uint8*, int, bool);
     bool writeTrack (OutputStream&, const MidiMessageSequence&) const;
 
     JUCE_LEAK_DETECTOR (MidiFile)
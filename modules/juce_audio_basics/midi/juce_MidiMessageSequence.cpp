@@ -35,13 +35,15 @@ MidiMessageSequence::MidiMessageSequence (const MidiMessageSequence& other)
 {
     list.addCopiesOf (other.list);
 
+    std::unordered_map<const MidiEventHolder*, MidiEventHolder*> copies;
+    copies.reserve ((size_t) list.size());
+
     for (int i = 0; i < list.size(); ++i)
-    {
-        auto noteOffIndex = other.getIndexOfMatchingKeyUp (i);
+        copies[other.list.getUnchecked (i)] = list.getUnchecked (i);
 
-        if (noteOffIndex >= 0)
-            list.getUnchecked (i)->noteOffObject = list.getUnchecked (noteOffIndex);
-    }
+    for (auto* meh : list)
+        if (meh->noteOffObject != nullptr)
+            meh->noteOffObject = copies[meh->noteOffObject];
 }
 
 MidiMessageSequence& MidiMessageSequence::operator= (const MidiMessageSequence& other)
@@ -120,14 +122,10 @@ int MidiMessageSequence::getIndexOf (const MidiEventHolder* event) const noexcep
 
 int MidiMessageSequence::getNextIndexAtTime (double timeStamp) const noexcept
 {
-    auto numEvents = list.size();
-    int i;
+    const auto iter = std::lower_bound (list.begin(), list.end(), timeStamp,
+                                        [] (const MidiEventHolder* meh, double t) { return meh->message.getTimeStamp() < t; });
 
-    for (i = 0; i < numEvents; ++i)
-        if (list.getUnchecked (i)->message.getTimeStamp() >= timeStamp)
-            break;
-
-    return i;
+    return (int) std::distance (list.begin(), iter);
 }
 
 //==============================================================================
@@ -225,42 +223,57 @@ void MidiMessageSequence::sort() noexcept
 
 void MidiMessageSequence::updateMatchedPairs() noexcept
 {
+    // This makes a single pass through the list, keeping track of the note-on on each key
+    // that's still waiting for its note-off. A note-on that's followed by another note-on
+    // on the same key gets a new note-off inserted just before the second one.
+    MidiEventHolder* waitingNoteOns[16][128] = {};
+    OwnedArray<MidiEventHolder> newList;
+
     for (int i = 0; i < list.size(); ++i)
     {
         auto* meh = list.getUnchecked (i);
-        auto& m1 = meh->message;
+        auto& m = meh->message;
+        const auto isNoteOn = m.isNoteOn();
 
-        if (m1.isNoteOn())
+        if (isNoteOn || m.isNoteOff())
         {
-            meh->noteOffObject = nullptr;
-            auto note = m1.getNoteNumber();
-            auto chan = m1.getChannel();
-            auto len = list.size();
+            auto chan = m.getChannel();
+            auto note = m.getNoteNumber();
+            auto& waiting = waitingNoteOns[chan - 1][note];
 
-            for (int j = i + 1; j < len; ++j)
+            if (isNoteOn)
             {
-                auto* meh2 = list.getUnchecked (j);
-                auto& m = meh2->message;
-
-                if (m.getNoteNumber() == note && m.getChannel() == chan)
+                if (waiting != nullptr)
                 {
-                    if (m.isNoteOff())
+                    if (newList.isEmpty())
                     {
-                        meh->noteOffObject = meh2;
-                        break;
+                        newList.ensureStorageAllocated (list.size() + list.size() / 8);
+                        newList.addArray (list, 0, i);
                     }
 
-                    if (m.isNoteOn())
-                    {
-                        auto newEvent = new MidiEventHolder (MidiMessage::noteOff (chan, note));
-                        list.insert (j, newEvent);
-                        newEvent->message.setTimeStamp (m.getTimeStamp());
-                        meh->noteOffObject = newEvent;
-                        break;
-                    }
+                    auto* newEvent = newList.add (new MidiEventHolder (MidiMessage::noteOff (chan, note)));
+                    newEvent->message.setTimeStamp (m.getTimeStamp());
+                    waiting->noteOffObject = newEvent;
                 }
+
+                meh->noteOffObject = nullptr;
+                waiting = meh;
+            }
+            else if (waiting != nullptr)
+            {
+                waiting->noteOffObject = meh;
+                waiting = nullptr;
             }
         }
+
+        if (! newList.isEmpty())
+            newList.add (meh);
+    }
+
+    if (! newList.isEmpty())
+    {
+        list.clear (false);
+        list.swapWith (newList);
     }
 }
 
@@ -529,6 +542,36 @@ struct MidiMessageSequenceTest final : public UnitTest
         expectEquals (s.getIndexOfMatchingKeyUp (0), -1); // Truncated note, should be no note off
         expectEquals (s.getTimeOfMatchingKeyUp (1), 5.0);
 
+        beginTest ("Matching overlapping notes");
+        {
+            MidiMessageSequence s3;
+            s3.addEvent (MidiMessage::noteOn  (1, 60, 0.5f).withTimeStamp (0.0));
+            s3.addEvent (MidiMessage::noteOn  (2, 60, 0.5f).withTimeStamp (0.5));
+            s3.addEvent (MidiMessage::noteOn  (1, 60, 0.5f).withTimeStamp (1.0));
+            s3.addEvent (MidiMessage::noteOff (1, 60, 0.5f).withTimeStamp (2.0));
+            s3.addEvent (MidiMessage::noteOff (1, 60, 0.5f).withTimeStamp (3.0));
+            s3.addEvent (MidiMessage::noteOff (2, 60, 0.5f).withTimeStamp (4.0));
+            s3.updateMatchedPairs();
+
+            // a note-off is inserted to end the first note when the second one starts
+            expectEquals (s3.getNumEvents(), 7);
+            expect (s3.getEventPointer (2)->message.isNoteOff());
+            expectEquals (s3.getIndexOfMatchingKeyUp (0), 2);
+            expectEquals (s3.getTimeOfMatchingKeyUp (0), 1.0);
+            expectEquals (s3.getIndexOfMatchingKeyUp (1), 6);
+            expectEquals (s3.getIndexOfMatchingKeyUp (3), 4);
+            expectEquals (s3.getIndexOfMatchingKeyUp (5), -1);
+
+            const MidiMessageSequence copy (s3);
+
+            for (int i = 0; i < copy.getNumEvents(); ++i)
+                expectEquals (copy.getIndexOfMatchingKeyUp (i), s3.getIndexOfMatchingKeyUp (i));
+
+            expectEquals (s3.getNextIndexAtTime (1.0), 2);
+            expectEquals (s3.getNextIndexAtTime (1.5), 4);
+            expectEquals (s3.getNextIndexAtTime (-1.0), 0);
+        }
+
         struct ControlValue { int control, value; };
 
         struct DataEntry
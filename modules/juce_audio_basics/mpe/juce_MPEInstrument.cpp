@@ -33,14 +33,64 @@ namespace
     {
         std::fill (std::begin (range), std::end (range), value);
     }
+
+    int getNoteSlotIndex (int midiChannel, int midiNoteNumber) noexcept
+    {
+        if (isPositiveAndBelow (midiChannel - 1, 16) && isPositiveAndBelow (midiNoteNumber, 128))
+            return ((midiChannel - 1) << 7) + midiNoteNumber;
+
+        return -1;
+    }
 }
 
+//==============================================================================
+/*  Wraps every change to the playing notes. While the outermost update is in
+    progress, the version number is odd, which tells the lock-free readers to retry.
+    Listener callbacks are only made once the outermost update has finished.
+*/
+class MPEInstrument::ScopedUpdate
+{
+public:
+    explicit ScopedUpdate (MPEInstrument& instrumentToUpdate)
+        : instrument (instrumentToUpdate), sl (instrumentToUpdate.lock)
+    {
+        if (instrument.updateDepth++ == 0)
+        {
+            instrument.notesVersion.store (instrument.notesVersion.load (std::memory_order_relaxed) + 1,
+                                           std::memory_order_relaxed);
+            std::atomic_thread_fence (std::memory_order_release);
+        }
+    }
+
+    ~ScopedUpdate()
+    {
+        if (--instrument.updateDepth == 0)
+        {
+            instrument.publishChangedNotes();
+            instrument.notesVersion.store (instrument.notesVersion.load (std::memory_order_relaxed) + 1,
+                                           std::memory_order_release);
+            instrument.dispatchPendingNotifications();
+        }
+    }
+
+private:
+    MPEInstrument& instrument;
+    const ScopedLock sl;
+
+    JUCE_DECLARE_NON_COPYABLE (ScopedUpdate)
+};
+
 //==============================================================================
 MPEInstrument::MPEInstrument() noexcept
+    : slots ((size_t) maxNumNotes),
+      slotsToPublish ((size_t) maxNumNotes),
+      pendingNotifications ((size_t) maxNumNotes + 16)
 {
     mpeInstrumentFill (lastPressureLowerBitReceivedOnChannel, noLSBValueReceived);
     mpeInstrumentFill (lastTimbreLowerBitReceivedOnChannel, noLSBValueReceived);
     mpeInstrumentFill (isMemberChannelSustained, false);
+    mpeInstrumentFill (firstNoteOnChannel, (int16) -1);
+    mpeInstrumentFill (lastNoteOnChannel, (int16) -1);
 
     pitchbendDimension.value = &MPENote::pitchbend;
     pressureDimension.value  = &MPENote::pressure;
@@ -84,15 +134,15 @@ void MPEInstrument::resetLastReceivedValues()
 
 void MPEInstrument::setZoneLayout (MPEZoneLayout newLayout)
 {
-    releaseAllNotes();
+    const ScopedUpdate update (*this);
 
-    const ScopedLock sl (lock);
+    releaseAllNotes();
     legacyMode.isEnabled = false;
 
     if (zoneLayout != newLayout)
     {
         zoneLayout = newLayout;
-        listeners.call ([=] (Listener& l) { l.zoneLayoutChanged(); });
+        notifyListeners (NotificationType::zoneLayoutChanged, {});
     }
 }
 
@@ -102,16 +152,16 @@ void MPEInstrument::enableLegacyMode (int pitchbendRange, Range<int> channelRang
     if (legacyMode.isEnabled)
         return;
 
-    releaseAllNotes();
+    const ScopedUpdate update (*this);
 
-    const ScopedLock sl (lock);
+    releaseAllNotes();
 
     legacyMode.isEnabled = true;
     legacyMode.pitchbendRange = pitchbendRange;
     legacyMode.channelRange = channelRange;
 
     zoneLayout.clearAllZones();
-    listeners.call ([=] (Listener& l) { l.zoneLayoutChanged(); });
+    notifyListeners (NotificationType::zoneLayoutChanged, {});
 }
 
 bool MPEInstrument::isLegacyModeEnabled() const noexcept
@@ -128,13 +178,14 @@ void MPEInstrument::setLegacyModeChannelRange (Range<int> channelRange)
 {
     jassert (allChannels.contains (channelRange));
 
+    const ScopedUpdate update (*this);
+
     releaseAllNotes();
-    const ScopedLock sl (lock);
 
     if (legacyMode.channelRange != channelRange)
     {
         legacyMode.channelRange = channelRange;
-        listeners.call ([=] (Listener& l) { l.zoneLayoutChanged(); });
+        notifyListeners (NotificationType::zoneLayoutChanged, {});
     }
 }
 
@@ -147,13 +198,14 @@ void MPEInstrument::setLegacyModePitchbendRange (int pitchbendRange)
 {
     jassert (pitchbendRange >= 0 && pitchbendRange <= 96);
 
+    const ScopedUpdate update (*this);
+
     releaseAllNotes();
-    const ScopedLock sl (lock);
 
     if (legacyMode.pitchbendRange != pitchbendRange)
     {
         legacyMode.pitchbendRange = pitchbendRange;
-        listeners.call ([=] (Listener& l) { l.zoneLayoutChanged(); });
+        notifyListeners (NotificationType::zoneLayoutChanged, {});
     }
 }
 
@@ -184,6 +236,229 @@ void MPEInstrument::removeListener (Listener* listenerToRemove)
     listeners.remove (listenerToRemove);
 }
 
+//==============================================================================
+void MPEInstrument::notifyListeners (NotificationType type, const MPENote& note)
+{
+    // The queue can hold a notification for every possible note, so it can only fill
+    // up if a listener keeps changing the instrument from inside its callbacks.
+    if (numPendingNotifications == (int) pendingNotifications.size())
+    {
+        jassertfalse;
+        return;
+    }
+
+    auto index = (firstPendingNotification + numPendingNotifications) % (int) pendingNotifications.size();
+    pendingNotifications[(size_t) index] = { type, note };
+    ++numPendingNotifications;
+}
+
+void MPEInstrument::dispatchPendingNotifications()
+{
+    // If a listener changes the instrument, its notifications are appended to the
+    // queue and delivered by the loop that is already running further up the stack.
+    if (isDispatchingNotifications)
+        return;
+
+    const ScopedValueSetter<bool> dispatching (isDispatchingNotifications, true);
+
+    while (numPendingNotifications > 0)
+    {
+        const auto notification = pendingNotifications[(size_t) firstPendingNotification];
+        firstPendingNotification = (firstPendingNotification + 1) % (int) pendingNotifications.size();
+        --numPendingNotifications;
+
+        const auto& note = notification.note;
+
+        switch (notification.type)
+        {
+            case NotificationType::noteAdded:             listeners.call ([&] (Listener& l) { l.noteAdded (note); });            break;
+            case NotificationType::notePressureChanged:   listeners.call ([&] (Listener& l) { l.notePressureChanged (note); });  break;
+            case NotificationType::notePitchbendChanged:  listeners.call ([&] (Listener& l) { l.notePitchbendChanged (note); }); break;
+            case NotificationType::noteTimbreChanged:     listeners.call ([&] (Listener& l) { l.noteTimbreChanged (note); });    break;
+            case NotificationType::noteKeyStateChanged:   listeners.call ([&] (Listener& l) { l.noteKeyStateChanged (note); });  break;
+            case NotificationType::noteReleased:          listeners.call ([&] (Listener& l) { l.noteReleased (note); });         break;
+            case NotificationType::zoneLayoutChanged:     listeners.call ([] (Listener& l) { l.zoneLayoutChanged(); });          break;
+        }
+    }
+}
+
+//==============================================================================
+MPENote& MPEInstrument::addNote (const MPENote& newNote)
+{
+    const auto index = (int16) getNoteSlotIndex (newNote.midiChannel, newNote.initialNote);
+    auto& slot = slots[(size_t) index];
+    jassert (! slot.isPlaying);
+
+    slot.note = newNote;
+    slot.isPlaying = true;
+
+    slot.previous = lastNote;
+    slot.next = -1;
+
+    if (lastNote >= 0)
+        slots[(size_t) lastNote].next = index;
+    else
+        firstNote = index;
+
+    lastNote = index;
+
+    const auto channel = newNote.midiChannel - 1;
+    slot.previousOnChannel = lastNoteOnChannel[channel];
+    slot.nextOnChannel = -1;
+
+    if (lastNoteOnChannel[channel] >= 0)
+        slots[(size_t) lastNoteOnChannel[channel]].nextOnChannel = index;
+    else
+        firstNoteOnChannel[channel] = index;
+
+    lastNoteOnChannel[channel] = index;
+
+    numNotes.store (numNotes.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return *markNoteChanged (&slot.note);
+}
+
+void MPEInstrument::removeNote (const MPENote& note)
+{
+    const auto index = getNoteSlotIndex (note.midiChannel, note.initialNote);
+    auto& slot = slots[(size_t) index];
+    jassert (slot.isPlaying);
+
+    if (slot.previous >= 0)  slots[(size_t) slot.previous].next = slot.next;
+    else                     firstNote = slot.next;
+
+    if (slot.next >= 0)      slots[(size_t) slot.next].previous = slot.previous;
+    else                     lastNote = slot.previous;
+
+    const auto channel = note.midiChannel - 1;
+
+    if (slot.previousOnChannel >= 0)  slots[(size_t) slot.previousOnChannel].nextOnChannel = slot.nextOnChannel;
+    else                              firstNoteOnChannel[channel] = slot.nextOnChannel;
+
+    if (slot.nextOnChannel >= 0)      slots[(size_t) slot.nextOnChannel].previousOnChannel = slot.previousOnChannel;
+    else                              lastNoteOnChannel[channel] = slot.previousOnChannel;
+
+    slot.isPlaying = false;
+    slot.previous = slot.next = slot.previousOnChannel = slot.nextOnChannel = -1;
+
+    numNotes.store (numNotes.load (std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+}
+
+void MPEInstrument::releaseNote (MPENote& note)
+{
+    note.keyState = MPENote::off;
+    note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
+    notifyListeners (NotificationType::noteReleased, note);
+    removeNote (note);
+}
+
+// Every path that hands out a note the writer might change goes through here, so that
+// the note is copied to the queries' side when the update finishes.
+MPENote* MPEInstrument::markNoteChanged (MPENote* note) noexcept
+{
+    jassert (updateDepth > 0);
+
+    if (note != nullptr)
+    {
+        const auto index = getNoteSlotIndex (note->midiChannel, note->initialNote);
+        auto& slot = slots[(size_t) index];
+        jassert (note == &slot.note);
+
+        if (! slot.needsPublishing)
+        {
+            slot.needsPublishing = true;
+            slotsToPublish[(size_t) numSlotsToPublish++] = (int16) index;
+        }
+    }
+
+    return note;
+}
+
+void MPEInstrument::publishChangedNotes() noexcept
+{
+    for (int i = 0; i < numSlotsToPublish; ++i)
+    {
+        auto& slot = slots[(size_t) slotsToPublish[(size_t) i]];
+        slot.publishNote();
+        slot.needsPublishing = false;
+    }
+
+    numSlotsToPublish = 0;
+}
+
+static_assert (std::is_trivially_copyable_v<MPENote> && sizeof (MPENote) % sizeof (uint32) == 0,
+               "The notes are published to the queries one word at a time");
+
+void MPEInstrument::NoteSlot::publishNote() noexcept
+{
+    uint32 words[numNoteWords];
+    std::memcpy (words, &note, sizeof (words));
+
+    for (size_t i = 0; i < numNoteWords; ++i)
+        publishedNote[i] = words[i];
+}
+
+MPENote MPEInstrument::NoteSlot::readPublishedNote() const noexcept
+{
+    uint32 words[numNoteWords];
+
+    for (size_t i = 0; i < numNoteWords; ++i)
+        words[i] = publishedNote[i];
+
+    MPENote result;
+    std::memcpy (&result, words, sizeof (words));
+    return result;
+}
+
+// Visits the notes from the most to the least recently added one. The callback may remove
+// the note that it's given, but no other notes.
+template <typename Callback>
+void MPEInstrument::forEachNote (Callback&& callback)
+{
+    for (int index = lastNote; index >= 0;)
+    {
+        auto& slot = slots[(size_t) index];
+        index = slot.previous;
+        callback (*markNoteChanged (&slot.note));
+    }
+}
+
+template <typename Callback>
+void MPEInstrument::forEachNoteOnChannel (int midiChannel, Callback&& callback)
+{
+    if (! isPositiveAndBelow (midiChannel - 1, 16))
+        return;
+
+    for (int index = lastNoteOnChannel[midiChannel - 1]; index >= 0;)
+    {
+        auto& slot = slots[(size_t) index];
+        index = slot.previousOnChannel;
+        callback (*markNoteChanged (&slot.note));
+    }
+}
+
+// Runs a query without taking the lock. If the notes were changed while the query was
+// running, it's repeated. Because the writer might be in the middle of an update, the
+// query must check every link it follows and must never loop more than maxNumNotes times.
+template <typename Callback>
+auto MPEInstrument::readNotes (Callback&& callback) const noexcept
+{
+    for (;;)
+    {
+        const auto version = notesVersion.load (std::memory_order_acquire);
+
+        if ((version & 1) == 0)
+        {
+            const auto result = callback();
+            std::atomic_thread_fence (std::memory_order_acquire);
+
+            if (notesVersion.load (std::memory_order_relaxed) == version)
+                return result;
+        }
+
+        Thread::yield();
+    }
+}
+
 //==============================================================================
 void MPEInstrument::processNextMidiEvent (const MidiMessage& message)
 {
@@ -263,38 +538,22 @@ void MPEInstrument::processMidiResetAllControllersMessage (const MidiMessage& me
     // in MPE mode, "reset all controllers" is per-zone and expected on the master channel;
     // in legacy mode, it is per MIDI channel (within the channel range used).
 
+    const ScopedUpdate update (*this);
+
     if (legacyMode.isEnabled && legacyMode.channelRange.contains (message.getChannel()))
     {
-        for (int i = notes.size(); --i >= 0;)
-        {
-            auto& note = notes.getReference (i);
-
-            if (note.midiChannel == message.getChannel())
-            {
-                note.keyState = MPENote::off;
-                note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
-                listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-                notes.remove (i);
-            }
-        }
+        forEachNoteOnChannel (message.getChannel(), [this] (MPENote& note) { releaseNote (note); });
     }
     else if (isMasterChannel (message.getChannel()))
     {
         auto zone = (message.getChannel() == 1 ? zoneLayout.getLowerZone()
                                                : zoneLayout.getUpperZone());
 
-        for (int i = notes.size(); --i >= 0;)
+        forEachNote ([&] (MPENote& note)
         {
-            auto& note = notes.getReference (i);
-
             if (zone.isUsing (note.midiChannel))
-            {
-                note.keyState = MPENote::off;
-                note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
-                listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-                notes.remove (i);
-            }
-        }
+                releaseNote (note);
+        });
     }
 }
 
@@ -342,6 +601,8 @@ void MPEInstrument::noteOn (int midiChannel,
     if (! isUsingChannel (midiChannel))
         return;
 
+    const ScopedUpdate update (*this);
+
     MPENote newNote (midiChannel,
                      midiNoteNumber,
                      midiNoteOnVelocity,
@@ -350,20 +611,13 @@ void MPEInstrument::noteOn (int midiChannel,
                      getInitialValueForNewNote (midiChannel, timbreDimension),
                      isMemberChannelSustained[midiChannel - 1] ? MPENote::keyDownAndSustained : MPENote::keyDown);
 
-    const ScopedLock sl (lock);
     updateNoteTotalPitchbend (newNote);
 
+    // pathological case: second note-on received for same note -> retrigger it
     if (auto* alreadyPlayingNote = getNotePtr (midiChannel, midiNoteNumber))
-    {
-        // pathological case: second note-on received for same note -> retrigger it
-        alreadyPlayingNote->keyState = MPENote::off;
-        alreadyPlayingNote->noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
-        listeners.call ([=] (Listener& l) { l.noteReleased (*alreadyPlayingNote); });
-        notes.remove (alreadyPlayingNote);
-    }
+        releaseNote (*alreadyPlayingNote);
 
-    notes.add (newNote);
-    listeners.call ([&] (Listener& l) { l.noteAdded (newNote); });
+    notifyListeners (NotificationType::noteAdded, addNote (newNote));
 }
 
 //==============================================================================
@@ -371,9 +625,9 @@ void MPEInstrument::noteOff (int midiChannel,
                              int midiNoteNumber,
                              MPEValue midiNoteOffVelocity)
 {
-    const ScopedLock sl (lock);
+    const ScopedUpdate update (*this);
 
-    if (notes.isEmpty() || ! isUsingChannel (midiChannel))
+    if (numNotes.load (std::memory_order_relaxed) == 0 || ! isUsingChannel (midiChannel))
         return;
 
     if (auto* note = getNotePtr (midiChannel, midiNoteNumber))
@@ -391,12 +645,12 @@ void MPEInstrument::noteOff (int midiChannel,
 
         if (note->keyState == MPENote::off)
         {
-            listeners.call ([=] (Listener& l) { l.noteReleased (*note); });
-            notes.remove (note);
+            notifyListeners (NotificationType::noteReleased, *note);
+            removeNote (*note);
         }
         else
         {
-            listeners.call ([=] (Listener& l) { l.noteKeyStateChanged (*note); });
+            notifyListeners (NotificationType::noteKeyStateChanged, *note);
         }
     }
 }
@@ -404,36 +658,32 @@ void MPEInstrument::noteOff (int midiChannel,
 //==============================================================================
 void MPEInstrument::pitchbend (int midiChannel, MPEValue value)
 {
-    const ScopedLock sl (lock);
+    const ScopedUpdate update (*this);
     updateDimension (midiChannel, pitchbendDimension, value);
 }
 
 void MPEInstrument::pressure (int midiChannel, MPEValue value)
 {
-    const ScopedLock sl (lock);
+    const ScopedUpdate update (*this);
     updateDimension (midiChannel, pressureDimension, value);
 }
 
 void MPEInstrument::timbre (int midiChannel, MPEValue value)
 {
-    const ScopedLock sl (lock);
+    const ScopedUpdate update (*this);
     updateDimension (midiChannel, timbreDimension, value);
 }
 
 void MPEInstrument::polyAftertouch (int midiChannel, int midiNoteNumber, MPEValue value)
 {
-    const ScopedLock sl (lock);
+    const ScopedUpdate update (*this);
 
-    for (int i = notes.size(); --i >= 0;)
+    if (auto* note = getNotePtr (midiChannel, midiNoteNumber))
     {
-        auto& note = notes.getReference (i);
-
-        if (note.midiChannel == midiChannel
-            && note.initialNote == midiNoteNumber
-            && pressureDimension.getValue (note) != value)
+        if (pressureDimension.getValue (*note) != value)
         {
-            pressureDimension.getValue (note) = value;
-            callListenersDimensionChanged (note, pressureDimension);
+            pressureDimension.getValue (*note) = value;
+            callListenersDimensionChanged (*note, pressureDimension);
         }
     }
 }
@@ -451,20 +701,17 @@ void MPEInstrument::updateDimension (int midiChannel, MPEDimension& dimension, M
 {
     dimension.lastValueReceivedOnChannel[midiChannel - 1] = value;
 
-    if (notes.isEmpty())
+    if (numNotes.load (std::memory_order_relaxed) == 0)
         return;
 
     if (isMemberChannel (midiChannel))
     {
         if (dimension.trackingMode == allNotesOnChannel)
         {
-            for (int i = notes.size(); --i >= 0;)
+            forEachNoteOnChannel (midiChannel, [&] (MPENote& note)
             {
-                auto& note = notes.getReference (i);
-
-                if (note.midiChannel == midiChannel)
-                    updateDimensionForNote (note, dimension, value);
-            }
+                updateDimensionForNote (note, dimension, value);
+            });
         }
         else
         {
@@ -487,26 +734,24 @@ void MPEInstrument::updateDimensionMaster (bool isLowerZone, MPEDimension& dimen
     if (! zone.isActive())
         return;
 
-    for (int i = notes.size(); --i >= 0;)
+    forEachNote ([&] (MPENote& note)
     {
-        auto& note = notes.getReference (i);
-
         if (! zone.isUsing (note.midiChannel))
-            continue;
+            return;
 
         if (&dimension == &pitchbendDimension)
         {
             // master pitchbend is a special case: we don't change the note's own pitchbend,
             // instead we have to update its total (master + note) pitchbend.
             updateNoteTotalPitchbend (note);
-            listeners.call ([&] (Listener& l) { l.notePitchbendChanged (note); });
+            notifyListeners (NotificationType::notePitchbendChanged, note);
         }
         else if (dimension.getValue (note) != value)
         {
             dimension.getValue (note) = value;
             callListenersDimensionChanged (note, dimension);
         }
-    }
+    });
 }
 
 //==============================================================================
@@ -526,9 +771,9 @@ void MPEInstrument::updateDimensionForNote (MPENote& note, MPEDimension& dimensi
 //==============================================================================
 void MPEInstrument::callListenersDimensionChanged (const MPENote& note, const MPEDimension& dimension)
 {
-    if (&dimension == &pressureDimension)  { listeners.call ([&] (Listener& l) { l.notePressureChanged  (note); }); return; }
-    if (&dimension == &timbreDimension)    { listeners.call ([&] (Listener& l) { l.noteTimbreChanged    (note); }); return; }
-    if (&dimension == &pitchbendDimension) { listeners.call ([&] (Listener& l) { l.notePitchbendChanged (note); }); return; }
+    if (&dimension == &pressureDimension)  { notifyListeners (NotificationType::notePressureChanged,  note); return; }
+    if (&dimension == &timbreDimension)    { notifyListeners (NotificationType::noteTimbreChanged,    note); return; }
+    if (&dimension == &pitchbendDimension) { notifyListeners (NotificationType::notePitchbendChanged, note); return; }
 }
 
 //==============================================================================
@@ -574,13 +819,13 @@ void MPEInstrument::updateNoteTotalPitchbend (MPENote& note)
 //==============================================================================
 void MPEInstrument::sustainPedal (int midiChannel, bool isDown)
 {
-    const ScopedLock sl (lock);
+    const ScopedUpdate update (*this);
     handleSustainOrSostenuto (midiChannel, isDown, false);
 }
 
 void MPEInstrument::sostenutoPedal (int midiChannel, bool isDown)
 {
-    const ScopedLock sl (lock);
+    const ScopedUpdate update (*this);
     handleSustainOrSostenuto (midiChannel, isDown, true);
 }
 
@@ -596,10 +841,8 @@ void MPEInstrument::handleSustainOrSostenuto (int midiChannel, bool isDown, bool
     auto zone = (midiChannel == 1 ? zoneLayout.getLowerZone()
                                   : zoneLayout.getUpperZone());
 
-    for (int i = notes.size(); --i >= 0;)
+    forEachNote ([&] (MPENote& note)
     {
-        auto& note = notes.getReference (i);
-
         if (legacyMode.isEnabled ? (note.midiChannel == midiChannel) : zone.isUsing (note.midiChannel))
         {
             if (note.keyState == MPENote::keyDown && isDown)
@@ -611,15 +854,15 @@ void MPEInstrument::handleSustainOrSostenuto (int midiChannel, bool isDown, bool
 
             if (note.keyState == MPENote::off)
             {
-                listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-                notes.remove (i);
+                notifyListeners (NotificationType::noteReleased, note);
+                removeNote (note);
             }
             else
             {
-                listeners.call ([&] (Listener& l) { l.noteKeyStateChanged (note); });
+                notifyListeners (NotificationType::noteKeyStateChanged, note);
             }
         }
-    }
+    });
 
     if (! isSostenuto)
     {
@@ -675,72 +918,108 @@ bool MPEInstrument::isUsingChannel (int midiChannel) const noexcept
 //==============================================================================
 int MPEInstrument::getNumPlayingNotes() const noexcept
 {
-    return notes.size();
+    return numNotes.load (std::memory_order_relaxed);
 }
 
 MPENote MPEInstrument::getNote (int midiChannel, int midiNoteNumber) const noexcept
 {
-    if (auto* note = getNotePtr (midiChannel, midiNoteNumber))
-        return *note;
+    const auto index = getNoteSlotIndex (midiChannel, midiNoteNumber);
+
+    if (index < 0)
+        return {};
 
-    return {};
+    return readNotes ([&]
+    {
+        const auto& slot = slots[(size_t) index];
+        return slot.isPlaying ? slot.readPublishedNote() : MPENote();
+    });
 }
 
 MPENote MPEInstrument::getNote (int index) const noexcept
 {
-    return notes[index];
+    return readNotes ([&]
+    {
+        const auto numToSkip = numNotes.load (std::memory_order_relaxed) - 1 - index;
+
+        if (index < 0 || numToSkip < 0)
+            return MPENote();
+
+        const auto isValidSlot = [] (int slot) { return isPositiveAndBelow (slot, maxNumNotes); };
+
+        // walk from whichever end of the list is closer
+        auto slot = (int) (index <= numToSkip ? firstNote : lastNote);
+
+        for (auto i = jmin (index, numToSkip); --i >= 0 && isValidSlot (slot);)
+            slot = index <= numToSkip ? slots[(size_t) slot].next : slots[(size_t) slot].previous;
+
+        return isValidSlot (slot) ? slots[(size_t) slot].readPublishedNote() : MPENote();
+    });
 }
 
 MPENote MPEInstrument::getNoteWithID (uint16 noteID) const noexcept
 {
-    const ScopedLock sl (lock);
-
-    for (auto& note : notes)
-        if (note.noteID == noteID)
-            return note;
-
-    return {};
+    // A note's ID is derived from its channel and initial note number
+    return getNote (noteID >> 7, noteID & 0x7f);
 }
 
 //==============================================================================
 MPENote MPEInstrument::getMostRecentNote (int midiChannel) const noexcept
 {
-    if (auto* note = getLastNotePlayedPtr (midiChannel))
-        return *note;
+    if (! isPositiveAndBelow (midiChannel - 1, 16))
+        return {};
+
+    return readNotes ([&]
+    {
+        auto slot = (int) lastNoteOnChannel[midiChannel - 1];
 
-    return {};
+        for (int i = 0; i < maxNumNotes && isPositiveAndBelow (slot, maxNumNotes); ++i)
+        {
+            const auto note = slots[(size_t) slot].readPublishedNote();
+
+            if (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
+                return note;
+
+            slot = slots[(size_t) slot].previousOnChannel;
+        }
+
+        return MPENote();
+    });
 }
 
 MPENote MPEInstrument::getMostRecentNoteOtherThan (MPENote otherThanThisNote) const noexcept
 {
-    for (auto i = notes.size(); --i >= 0;)
+    return readNotes ([&]
     {
-        auto& note = notes.getReference (i);
+        auto slot = (int) lastNote;
 
-        if (note != otherThanThisNote)
-            return note;
-    }
+        for (int i = 0; i < maxNumNotes && isPositiveAndBelow (slot, maxNumNotes); ++i)
+        {
+            const auto note = slots[(size_t) slot].readPublishedNote();
 
-    return {};
+            if (note != otherThanThisNote)
+                return note;
+
+            slot = slots[(size_t) slot].previous;
+        }
+
+        return MPENote();
+    });
 }
 
 //==============================================================================
 const MPENote* MPEInstrument::getNotePtr (int midiChannel, int midiNoteNumber) const noexcept
 {
-    for (int i = 0; i < notes.size(); ++i)
-    {
-        auto& note = notes.getReference (i);
+    const auto index = getNoteSlotIndex (midiChannel, midiNoteNumber);
 
-        if (note.midiChannel == midiChannel && note.initialNote == midiNoteNumber)
-            return &note;
-    }
+    if (index >= 0 && slots[(size_t) index].isPlaying)
+        return &slots[(size_t) index].note;
 
     return nullptr;
 }
 
 MPENote* MPEInstrument::getNotePtr (int midiChannel, int midiNoteNumber) noexcept
 {
-    return const_cast<MPENote*> (static_cast<const MPEInstrument&> (*this).getNotePtr (midiChannel, midiNoteNumber));
+    return markNoteChanged (const_cast<MPENote*> (static_cast<const MPEInstrument&> (*this).getNotePtr (midiChannel, midiNoteNumber)));
 }
 
 //==============================================================================
@@ -759,20 +1038,20 @@ const MPENote* MPEInstrument::getNotePtr (int midiChannel, TrackingMode mode) co
 
 MPENote* MPEInstrument::getNotePtr (int midiChannel, TrackingMode mode) noexcept
 {
-    return const_cast<MPENote*> (static_cast<const MPEInstrument&> (*this).getNotePtr (midiChannel, mode));
+    return markNoteChanged (const_cast<MPENote*> (static_cast<const MPEInstrument&> (*this).getNotePtr (midiChannel, mode)));
 }
 
 //==============================================================================
 const MPENote* MPEInstrument::getLastNotePlayedPtr (int midiChannel) const noexcept
 {
-    const ScopedLock sl (lock);
+    if (! isPositiveAndBelow (midiChannel - 1, 16))
+        return nullptr;
 
-    for (auto i = notes.size(); --i >= 0;)
+    for (int i = lastNoteOnChannel[midiChannel - 1]; i >= 0; i = slots[(size_t) i].previousOnChannel)
     {
-        auto& note = notes.getReference (i);
+        auto& note = slots[(size_t) i].note;
 
-        if (note.midiChannel == midiChannel
-             && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained))
+        if (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
             return &note;
     }
 
@@ -781,21 +1060,23 @@ const MPENote* MPEInstrument::getLastNotePlayedPtr (int midiChannel) const noexc
 
 MPENote* MPEInstrument::getLastNotePlayedPtr (int midiChannel) noexcept
 {
-    return const_cast<MPENote*> (static_cast<const MPEInstrument&> (*this).getLastNotePlayedPtr (midiChannel));
+    return markNoteChanged (const_cast<MPENote*> (static_cast<const MPEInstrument&> (*this).getLastNotePlayedPtr (midiChannel)));
 }
 
 //==============================================================================
 const MPENote* MPEInstrument::getHighestNotePtr (int midiChannel) const noexcept
 {
+    if (! isPositiveAndBelow (midiChannel - 1, 16))
+        return nullptr;
+
     int initialNoteMax = -1;
     const MPENote* result = nullptr;
 
-    for (auto i = notes.size(); --i >= 0;)
+    for (int i = lastNoteOnChannel[midiChannel - 1]; i >= 0; i = slots[(size_t) i].previousOnChannel)
     {
-        auto& note = notes.getReference (i);
+        auto& note = slots[(size_t) i].note;
 
-        if (note.midiChannel == midiChannel
-             && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
+        if ((note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
              && note.initialNote > initialNoteMax)
         {
             result = &note;
@@ -808,20 +1089,22 @@ const MPENote* MPEInstrument::getHighestNotePtr (int midiChannel) const noexcept
 
 MPENote* MPEInstrument::getHighestNotePtr (int midiChannel) noexcept
 {
-    return const_cast<MPENote*> (static_cast<const MPEInstrument&> (*this).getHighestNotePtr (midiChannel));
+    return markNoteChanged (const_cast<MPENote*> (static_cast<const MPEInstrument&> (*this).getHighestNotePtr (midiChannel)));
 }
 
 const MPENote* MPEInstrument::getLowestNotePtr (int midiChannel) const noexcept
 {
+    if (! isPositiveAndBelow (midiChannel - 1, 16))
+        return nullptr;
+
     int initialNoteMin = 128;
     const MPENote* result = nullptr;
 
-    for (auto i = notes.size(); --i >= 0;)
+    for (int i = lastNoteOnChannel[midiChannel - 1]; i >= 0; i = slots[(size_t) i].previousOnChannel)
     {
-        auto& note = notes.getReference (i);
+        auto& note = slots[(size_t) i].note;
 
-        if (note.midiChannel == midiChannel
-             && (note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
+        if ((note.keyState == MPENote::keyDown || note.keyState == MPENote::keyDownAndSustained)
              && note.initialNote < initialNoteMin)
         {
             result = &note;
@@ -834,23 +1117,14 @@ const MPENote* MPEInstrument::getLowestNotePtr (int midiChannel) const noexcept
 
 MPENote* MPEInstrument::getLowestNotePtr (int midiChannel) noexcept
 {
-    return const_cast<MPENote*> (static_cast<const MPEInstrument&> (*this).getLowestNotePtr (midiChannel));
+    return markNoteChanged (const_cast<MPENote*> (static_cast<const MPEInstrument&> (*this).getLowestNotePtr (midiChannel)));
 }
 
 //==============================================================================
 void MPEInstrument::releaseAllNotes()
 {
-    const ScopedLock sl (lock);
-
-    for (auto i = notes.size(); --i >= 0;)
-    {
-        auto& note = notes.getReference (i);
-        note.keyState = MPENote::off;
-        note.noteOffVelocity = MPEValue::from7BitInt (64); // some reasonable number
-        listeners.call ([&] (Listener& l) { l.noteReleased (note); });
-    }
-
-    notes.clear();
+    const ScopedUpdate update (*this);
+    forEachNote ([this] (MPENote& note) { releaseNote (note); });
 }
 
 //==============================================================================
@@ -2193,6 +2467,114 @@ public:
                 expectEquals (test.getNumPlayingNotes(), 0);
             }
         }
+
+        beginTest ("Listeners see the state after each change");
+        {
+            struct QueryingListener final : public MPEInstrument::Listener
+            {
+                explicit QueryingListener (MPEInstrument& i) : instrument (i) {}
+
+                void noteAdded (MPENote newNote) override
+                {
+                    addedNoteWasPlaying = instrument.getNote (newNote.midiChannel, newNote.initialNote).isValid();
+                }
+
+                void noteReleased (MPENote) override
+                {
+                    numPlayingNotesWhenReleased = instrument.getNumPlayingNotes();
+                }
+
+                MPEInstrument& instrument;
+                bool addedNoteWasPlaying = false;
+                int numPlayingNotesWhenReleased = -1;
+            };
+
+            MPEInstrument test;
+            test.setZoneLayout (testLayout);
+
+            QueryingListener listener (test);
+            test.addListener (&listener);
+
+            test.noteOn (3, 60, MPEValue::from7BitInt (100));
+            expect (listener.addedNoteWasPlaying);
+
+            // retriggering releases the old note and adds the new one in a single change
+            test.noteOn (3, 60, MPEValue::from7BitInt (100));
+            expectEquals (listener.numPlayingNotesWhenReleased, 1);
+
+            test.noteOff (3, 60, MPEValue::from7BitInt (100));
+            expectEquals (listener.numPlayingNotesWhenReleased, 0);
+
+            test.removeListener (&listener);
+        }
+
+        beginTest ("Every possible note can play at once");
+        {
+            UnitTestInstrument test;
+            test.enableLegacyMode();
+
+            for (int channel = 1; channel <= 16; ++channel)
+                for (int note = 0; note < 128; ++note)
+                    test.noteOn (channel, note, MPEValue::from7BitInt (100));
+
+            expectEquals (test.getNumPlayingNotes(), 16 * 128);
+            expectNote (test.getNote (0), 100, 0, 8192, 64, MPENote::keyDown);
+            expectEquals ((int) test.getNote (16 * 128 - 1).midiChannel, 16);
+            expectEquals ((int) test.getNote (16 * 128 - 1).initialNote, 127);
+            expectEquals ((int) test.getNoteWithID (test.getNote (1000).noteID).initialNote, 1000 % 128);
+            expectEquals ((int) test.getMostRecentNote (7).initialNote, 127);
+
+            test.releaseAllNotes();
+            expectEquals (test.getNumPlayingNotes(), 0);
+            expectEquals (test.noteReleasedCallCounter, 16 * 128);
+        }
+
+        beginTest ("Notes can be read while they are being changed");
+        {
+            MPEInstrument test;
+            test.enableLegacyMode (2);
+
+            std::atomic<bool> finished { false };
+            std::atomic<int> numInconsistentNotes { 0 };
+
+            std::thread reader ([&]
+            {
+                while (! finished)
+                {
+                    for (int i = 0; i < test.getNumPlayingNotes(); ++i)
+                    {
+                        const auto note = test.getNote (i);
+
+                        // the total pitchbend is updated along with the note's own pitchbend
+                        if (note.isValid() && ! approximatelyEqual (note.totalPitchbendInSemitones,
+                                                                    (double) note.pitchbend.asSignedFloat() * 2.0))
+                            ++numInconsistentNotes;
+                    }
+                }
+            });
+
+            Random random (1234);
+
+            for (int i = 0; i < 20000; ++i)
+            {
+                const auto channel = random.nextInt ({ 1, 17 });
+
+                if (random.nextInt (8) == 0)
+                {
+                    test.noteOff (channel, 60, MPEValue::from7BitInt (100));
+                    test.noteOn (channel, 60, MPEValue::from7BitInt (100));
+                }
+                else
+                {
+                    test.pitchbend (channel, MPEValue::from14BitInt (random.nextInt (16384)));
+                }
+            }
+
+            finished = true;
+            reader.join();
+
+            expectEquals (numInconsistentNotes.load(), 0);
+        }
     }
     JUCE_END_IGNORE_WARNINGS_MSVC
 
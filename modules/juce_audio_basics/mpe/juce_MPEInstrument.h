@@ -42,6 +42,10 @@ namespace juce
     state changes and trigger some functionality for your application.
     For example, you can use this class to write an MPE visualiser.
 
+    The methods that query the playing notes (getNumPlayingNotes, getNote etc.)
+    don't take any locks and never block the thread that is feeding the instrument
+    with MIDI, so they can safely be called from a UI thread while notes are playing.
+
     If you want to write a real-time audio synth with MPE functionality,
     you should instead use the classes MPESynthesiserBase, which adds
     the ability to render audio and to manage voices.
@@ -251,10 +255,14 @@ public:
     /** Derive from this class to be informed about any changes in the MPE notes played
         by this instrument, and any changes to its zone layout.
 
-        Note: This listener type receives its callbacks immediately, and not
+        Note: This listener type receives its callbacks synchronously, and not
         via the message thread (so you might be for example in the MIDI thread).
         Therefore you should never do heavy work such as graphics rendering etc.
         inside those callbacks.
+
+        The callbacks are delivered in order once the instrument has finished
+        handling the method call or MIDI message that caused them, so when a
+        callback queries the instrument, it sees the state after all of the changes.
     */
     class JUCE_API  Listener
     {
@@ -357,11 +365,84 @@ public:
 
 protected:
     //==============================================================================
+    /** Serialises the methods that change the instrument's state. The methods that
+        only query the playing notes never take this lock.
+    */
     CriticalSection lock;
 
 private:
     //==============================================================================
-    Array<MPENote> notes;
+    /* The fields that the lock-free queries read while the writer may be changing them.
+       The ordering comes from notesVersion, so these only need to be free of data races.
+    */
+    template <typename Type>
+    struct RelaxedAtomic
+    {
+        RelaxedAtomic (Type initialValue = {}) noexcept : value (initialValue) {}
+
+        operator Type() const noexcept                                { return value.load (std::memory_order_relaxed); }
+        RelaxedAtomic& operator= (Type newValue) noexcept             { value.store (newValue, std::memory_order_relaxed); return *this; }
+        RelaxedAtomic& operator= (const RelaxedAtomic& other) noexcept  { return *this = (Type) other; }
+
+        std::atomic<Type> value;
+    };
+
+    /* Every playing note has a fixed slot, indexed by its channel and initial note.
+       The slots are linked into one list in the order in which the notes were added,
+       and into one list per channel, so that no lookup ever scans all the notes.
+
+       The writer changes the note in place, and copies it into publishedNote when the
+       update that changed it has finished. The queries only ever read publishedNote.
+    */
+    struct NoteSlot
+    {
+        static constexpr size_t numNoteWords = sizeof (MPENote) / sizeof (uint32);
+
+        MPENote note;
+        RelaxedAtomic<uint32> publishedNote[numNoteWords];
+        RelaxedAtomic<int16> previous { -1 }, next { -1 };
+        RelaxedAtomic<int16> previousOnChannel { -1 }, nextOnChannel { -1 };
+        RelaxedAtomic<bool> isPlaying { false };
+        bool needsPublishing = false;
+
+        void publishNote() noexcept;
+        MPENote readPublishedNote() const noexcept;
+    };
+
+    enum class NotificationType : uint8
+    {
+        noteAdded,
+        notePressureChanged,
+        notePitchbendChanged,
+        noteTimbreChanged,
+        noteKeyStateChanged,
+        noteReleased,
+        zoneLayoutChanged
+    };
+
+    struct PendingNotification
+    {
+        NotificationType type;
+        MPENote note;
+    };
+
+    class ScopedUpdate;
+
+    static constexpr int maxNumNotes = 16 * 128;
+
+    std::vector<NoteSlot> slots;
+    std::vector<int16> slotsToPublish;
+    int numSlotsToPublish = 0;
+    RelaxedAtomic<int16> firstNote { -1 }, lastNote { -1 };
+    RelaxedAtomic<int16> firstNoteOnChannel[16], lastNoteOnChannel[16];
+    std::atomic<int> numNotes { 0 };
+    std::atomic<uint32> notesVersion { 0 };
+    int updateDepth = 0;
+
+    std::vector<PendingNotification> pendingNotifications;
+    int firstPendingNotification = 0, numPendingNotifications = 0;
+    bool isDispatchingNotifications = false;
+
     MPEZoneLayout zoneLayout;
     ListenerList<Listener> listeners;
 
@@ -420,6 +501,18 @@ private:
     MPENote* getLowestNotePtr (int midiChannel) noexcept;
     void updateNoteTotalPitchbend (MPENote&);
 
+    MPENote& addNote (const MPENote&);
+    void removeNote (const MPENote&);
+    void releaseNote (MPENote&);
+    MPENote* markNoteChanged (MPENote*) noexcept;
+    void publishChangedNotes() noexcept;
+    template <typename Callback> void forEachNote (Callback&&);
+    template <typename Callback> void forEachNoteOnChannel (int midiChannel, Callback&&);
+    template <typename Callback> auto readNotes (Callback&&) const noexcept;
+
+    void notifyListeners (NotificationType, const MPENote&);
+    void dispatchPendingNotifications();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MPEInstrument)
 };
 
@@ -67,8 +67,7 @@ void BufferingAudioSource::prepareToPlay (int samplesPerBlockExpected, double ne
 
         const ScopedLock sl (bufferRangeLock);
 
-        bufferValidStart = 0;
-        bufferValidEnd = 0;
+        setValidBufferRange (0, 0);
 
         backgroundThread.addTimeSliceClient (this);
 
@@ -238,8 +237,7 @@ bool BufferingAudioSource::readNextBufferChunk()
         if (wasSourceLooping != isLooping())
         {
             wasSourceLooping = isLooping();
-            bufferValidStart = 0;
-            bufferValidEnd = 0;
+            setValidBufferRange (0, 0);
         }
 
         newBVS = jmax ((int64) 0, nextPlayPos.load());
@@ -247,28 +245,31 @@ bool BufferingAudioSource::readNextBufferChunk()
         sectionToReadStart = 0;
         sectionToReadEnd = 0;
 
-        constexpr int maxChunkSize = 2048;
+        // After a seek, a small read gets playback going again quickly. Otherwise, the
+        // buffer is left to drain a little and then topped up with one larger read, which
+        // costs far fewer seeks and calls into the source than lots of small ones.
+        constexpr int initialChunkSize = 2048;
+        const auto refillThreshold = jmax (512, buffer.getNumSamples() / 8);
+        const auto maxRefillSize = jmax (initialChunkSize, buffer.getNumSamples() / 4);
 
         if (newBVS < bufferValidStart || newBVS >= bufferValidEnd)
         {
-            newBVE = jmin (newBVE, newBVS + maxChunkSize);
+            newBVE = jmin (newBVE, newBVS + initialChunkSize);
 
             sectionToReadStart = newBVS;
             sectionToReadEnd = newBVE;
 
-            bufferValidStart = 0;
-            bufferValidEnd = 0;
+            setValidBufferRange (0, 0);
         }
-        else if (std::abs ((int) (newBVS - bufferValidStart)) > 512
-                  || std::abs ((int) (newBVE - bufferValidEnd)) > 512)
+        else if (std::abs ((int) (newBVS - bufferValidStart)) > refillThreshold
+                  || std::abs ((int) (newBVE - bufferValidEnd)) > refillThreshold)
         {
-            newBVE = jmin (newBVE, bufferValidEnd + maxChunkSize);
+            newBVE = jmin (newBVE, bufferValidEnd + maxRefillSize);
 
             sectionToReadStart = bufferValidEnd;
             sectionToReadEnd = newBVE;
 
-            bufferValidStart = newBVS;
-            bufferValidEnd = jmin (bufferValidEnd, newBVE);
+            setValidBufferRange (newBVS, jmin (bufferValidEnd, newBVE));
         }
     }
 
@@ -302,8 +303,7 @@ bool BufferingAudioSource::readNextBufferChunk()
     {
         const ScopedLock sl2 (bufferRangeLock);
 
-        bufferValidStart = newBVS;
-        bufferValidEnd = newBVE;
+        setValidBufferRange (newBVS, newBVE);
     }
 
     bufferReadyEvent.signal();
@@ -321,9 +321,128 @@ void BufferingAudioSource::readBufferSection (int64 start, int length, int buffe
     source->getNextAudioBlock (info);
 }
 
+void BufferingAudioSource::setValidBufferRange (int64 start, int64 end)
+{
+    bufferValidStart = start;
+    bufferValidEnd = end;
+    validEndForScheduling = end;
+}
+
+int BufferingAudioSource::getMillisecondsUntilNextRead() const
+{
+    const auto bufferSize = buffer.getNumSamples();
+
+    if (bufferSize <= 0 || sampleRate <= 0)
+        return 100;
+
+    const auto buffered = jlimit ((int64) 0, (int64) bufferSize, validEndForScheduling - nextPlayPos);
+    const auto samplesUntilRefill = buffered - (bufferSize - jmax (512, bufferSize / 8));
+
+    return jlimit (1, 100, (int) ((double) samplesUntilRefill * 1000.0 / sampleRate));
+}
+
 int BufferingAudioSource::useTimeSlice()
 {
-    return readNextBufferChunk() ? 1 : 100;
+    return readNextBufferChunk() ? 1 : getMillisecondsUntilNextRead();
 }
 
+int BufferingAudioSource::getTimeSlicePriority() const
+{
+    // Playback needs its data before background jobs such as thumbnails do, and the
+    // sources that are closest to running out of buffered audio go first. This reads
+    // the atomic copy of the valid range because it's called with the thread's list
+    // locked, and setNextReadPosition() takes those locks in the opposite order.
+    const auto bufferSize = buffer.getNumSamples();
+
+    if (bufferSize <= 0)
+        return 1;
+
+    const auto buffered = jlimit ((int64) 0, (int64) bufferSize, validEndForScheduling - nextPlayPos);
+    return 1 + (int) (((int64) bufferSize - buffered) * 8 / bufferSize);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct BufferingAudioSourceTests final : public UnitTest
+{
+    BufferingAudioSourceTests()  : UnitTest ("BufferingAudioSource", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        constexpr int blockSize = 512;
+        constexpr int totalLength = 48000;
+
+        AudioBuffer<float> ramp { 1, totalLength };
+
+        for (int i = 0; i < totalLength; ++i)
+            ramp.setSample (0, i, (float) i / (float) totalLength);
+
+        beginTest ("Several sources sharing a thread each play back their source exactly");
+        {
+            TimeSliceThread thread ("BufferingAudioSource test", 2);
+            thread.startThread();
+
+            OwnedArray<BufferingAudioSource> sources;
+
+            for (int i = 0; i < 4; ++i)
+            {
+                sources.add (new BufferingAudioSource (new MemoryAudioSource (ramp, false), thread, true, 8192, 1));
+                sources.getLast()->prepareToPlay (blockSize, 44100.0);
+            }
+
+            AudioBuffer<float> output { 1, blockSize };
+            AudioSourceChannelInfo info { output };
+            bool allCorrect = true;
+
+            for (int start = 0; start + blockSize <= totalLength; start += blockSize)
+            {
+                for (auto* source : sources)
+                {
+                    expect (source->waitForNextAudioBlockReady (info, 5000));
+                    source->getNextAudioBlock (info);
+
+                    for (int i = 0; i < blockSize; ++i)
+                        allCorrect = allCorrect && exactlyEqual (output.getSample (0, i), ramp.getSample (0, start + i));
+                }
+            }
+
+            expect (allCorrect);
+
+            sources.clear();
+            thread.stopThread (5000);
+        }
+
+        beginTest ("Playback resumes at the new position after a seek");
+        {
+            TimeSliceThread thread ("BufferingAudioSource test", 1);
+            thread.startThread();
+
+            BufferingAudioSource source (new MemoryAudioSource (ramp, false), thread, true, 8192, 1);
+            source.prepareToPlay (blockSize, 44100.0);
+
+            AudioBuffer<float> output { 1, blockSize };
+            AudioSourceChannelInfo info { output };
+
+            for (const auto position : { 30000, 1000, 40000 })
+            {
+                source.setNextReadPosition (position);
+                expect (source.waitForNextAudioBlockReady (info, 5000));
+                source.getNextAudioBlock (info);
+
+                expectEquals (output.getSample (0, 0), ramp.getSample (0, position));
+                expectEquals (output.getSample (0, blockSize - 1), ramp.getSample (0, position + blockSize - 1));
+            }
+
+            source.releaseResources();
+            thread.stopThread (5000);
+        }
+    }
+};
+
+static BufferingAudioSourceTests bufferingAudioSourceTests;
+
+#endif
+
 } // namespace juce
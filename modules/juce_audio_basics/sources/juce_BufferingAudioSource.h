@@ -31,6 +31,12 @@ namespace juce
     a background thread to smooth out playback. You can either create one of these
     directly, or use it indirectly using an AudioTransportSource.
 
+    Many sources can share the same TimeSliceThread. The sources with the least audio
+    buffered ahead of their play positions are served first, and each one tops up its
+    buffer with a few large reads rather than many small ones. When streaming a lot of
+    tracks, give the TimeSliceThread several threads so that the sources can read in
+    parallel.
+
     @see PositionableAudioSource, AudioTransportSource
 
     @tags{Audio}
@@ -102,7 +108,10 @@ private:
     Range<int> getValidBufferRange (int numSamples) const;
     bool readNextBufferChunk();
     void readBufferSection (int64 start, int length, int bufferOffset);
+    void setValidBufferRange (int64 start, int64 end);
+    int getMillisecondsUntilNextRead() const;
     int useTimeSlice() override;
+    int getTimeSlicePriority() const override;
 
     //==============================================================================
     OptionalScopedPointer<PositionableAudioSource> source;
@@ -112,6 +121,7 @@ private:
     CriticalSection callbackLock, bufferRangeLock;
     WaitableEvent bufferReadyEvent;
     int64 bufferValidStart = 0, bufferValidEnd = 0;
+    std::atomic<int64> validEndForScheduling { 0 };
     std::atomic<int64> nextPlayPos { 0 };
     double sampleRate = 0;
     bool wasSourceLooping = false, isPrepared = false;
@@ -963,6 +963,15 @@ Array<int> AiffAudioFormat::getPossibleBitDepths()
 bool AiffAudioFormat::canDoStereo() { return true; }
 bool AiffAudioFormat::canDoMono()   { return true; }
 
+bool AiffAudioFormat::mightBeAbleToRead (const void* headerData, size_t headerSize)
+{
+    auto* header = static_cast<const char*> (headerData);
+
+    return headerSize >= 12
+            && memcmp (header, "FORM", 4) == 0
+            && (memcmp (header + 8, "AIFF", 4) == 0 || memcmp (header + 8, "AIFC", 4) == 0);
+}
+
 #if JUCE_MAC
 bool AiffAudioFormat::canHandleFile (const File& f)
 {
@@ -67,6 +67,7 @@ public:
     Array<int> getPossibleBitDepths() override;
     bool canDoStereo() override;
     bool canDoMono() override;
+    bool mightBeAbleToRead (const void* headerData, size_t headerSize) override;
 
    #if JUCE_MAC
     bool canHandleFile (const File& fileToTest) override;
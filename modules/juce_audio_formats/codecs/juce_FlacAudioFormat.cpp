@@ -578,6 +578,15 @@ bool FlacAudioFormat::canDoStereo()     { return true; }
 bool FlacAudioFormat::canDoMono()       { return true; }
 bool FlacAudioFormat::isCompressed()    { return true; }
 
+bool FlacAudioFormat::mightBeAbleToRead (const void* headerData, size_t headerSize)
+{
+    // the decoder will skip over an ID3v2 tag at the start of the stream
+    auto* header = static_cast<const char*> (headerData);
+
+    return (headerSize >= 4 && memcmp (header, "fLaC", 4) == 0)
+        || (headerSize >= 3 && memcmp (header, "ID3", 3) == 0);
+}
+
 AudioFormatReader* FlacAudioFormat::createReaderFor (InputStream* in, const bool deleteStreamIfOpeningFails)
 {
     std::unique_ptr<FlacReader> r (new FlacReader (in));
@@ -438,6 +438,14 @@ bool OggVorbisAudioFormat::canDoStereo()    { return true; }
 bool OggVorbisAudioFormat::canDoMono()      { return true; }
 bool OggVorbisAudioFormat::isCompressed()   { return true; }
 
+bool OggVorbisAudioFormat::mightBeAbleToRead (const void* headerData, size_t headerSize)
+{
+    auto* header = static_cast<const char*> (headerData);
+
+    return (headerSize >= 4 && memcmp (header, "OggS", 4) == 0)
+        || (headerSize >= 3 && memcmp (header, "ID3", 3) == 0);
+}
+
 AudioFormatReader* OggVorbisAudioFormat::createReaderFor (InputStream* in, bool deleteStreamIfOpeningFails)
 {
     std::unique_ptr<OggReader> r (new OggReader (in));
@@ -51,6 +51,7 @@ public:
     bool canDoStereo() override;
     bool canDoMono() override;
     bool isCompressed() override;
+    bool mightBeAbleToRead (const void* headerData, size_t headerSize) override;
     StringArray getQualityOptions() override;
 
     //==============================================================================
@@ -1957,6 +1957,15 @@ Array<int> WavAudioFormat::getPossibleBitDepths()
 bool WavAudioFormat::canDoStereo()  { return true; }
 bool WavAudioFormat::canDoMono()    { return true; }
 
+bool WavAudioFormat::mightBeAbleToRead (const void* headerData, size_t headerSize)
+{
+    auto* header = static_cast<const char*> (headerData);
+
+    return headerSize >= 12
+            && (memcmp (header, "RIFF", 4) == 0 || memcmp (header, "RF64", 4) == 0)
+            && memcmp (header + 8, "WAVE", 4) == 0;
+}
+
 bool WavAudioFormat::isChannelLayoutSupported (const AudioChannelSet& channelSet)
 {
     auto channelTypes = channelSet.getChannelTypes();
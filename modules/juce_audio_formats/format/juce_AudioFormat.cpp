@@ -49,6 +49,11 @@ bool AudioFormat::canHandleFile (const File& f)
     return false;
 }
 
+bool AudioFormat::mightBeAbleToRead (const void*, size_t)
+{
+    return true;
+}
+
 const String& AudioFormat::getFormatName() const                { return formatName; }
 StringArray AudioFormat::getFileExtensions() const              { return fileExtensions; }
 bool AudioFormat::isCompressed()                                { return false; }
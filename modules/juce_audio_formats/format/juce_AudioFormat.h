@@ -63,6 +63,20 @@ public:
     */
     virtual bool canHandleFile (const File& fileToTest);
 
+    /** Returns false if the first few bytes of a stream show that it definitely isn't
+        in this format.
+
+        AudioFormatManager calls this with the start of a stream before asking the format
+        to open it, so that it can skip the formats which can't possibly read it. Subclasses
+        should only look for a signature here, and must return true if there's any chance
+        that they could read the stream. The base class implementation always returns true.
+
+        @param headerData   the bytes at the start of the stream
+        @param headerSize   the number of bytes that are available, which will be fewer
+                            than usual if the stream is very short
+    */
+    virtual bool mightBeAbleToRead (const void* headerData, size_t headerSize);
+
     /** Returns a set of sample rates that the format can read and write. */
     virtual Array<int> getPossibleSampleRates() = 0;
 
@@ -26,6 +26,93 @@
 namespace juce
 {
 
+namespace AudioFormatManagerHelpers
+{
+    // Enough for the signatures of all the built-in formats
+    constexpr int headerSize = 16;
+
+    template <typename Formats>
+    AudioFormatReader* createReaderFor (std::unique_ptr<InputStream>& stream, const Formats& formats)
+    {
+        auto originalStreamPos = stream->getPosition();
+
+        char header[headerSize] = {};
+        auto numHeaderBytes = (size_t) jmax (0, stream->read (header, headerSize));
+        stream->setPosition (originalStreamPos);
+
+        for (auto* af : formats)
+        {
+            if (! af->mightBeAbleToRead (header, numHeaderBytes))
+                continue;
+
+            if (auto* r = af->createReaderFor (stream.get(), false))
+            {
+                stream.release();
+                return r;
+            }
+
+            stream->setPosition (originalStreamPos);
+
+            // the stream that is passed-in must be capable of being repositioned so
+            // that all the formats can have a go at opening it.
+            jassert (stream->getPosition() == originalStreamPos);
+        }
+
+        return nullptr;
+    }
+}
+
+//==============================================================================
+struct AudioFormatManager::CachedReader
+{
+    File file;
+    Time modificationTime;
+    int64 fileSize;
+    std::unique_ptr<AudioFormatReader> reader;
+    CriticalSection lock;
+};
+
+/*  A reader that shares a reader held by the cache. It stays usable after its entry
+    has been removed from the cache, because it keeps the entry alive.
+*/
+class AudioFormatManager::SharedReader final : public AudioFormatReader
+{
+public:
+    explicit SharedReader (std::shared_ptr<CachedReader> entryToUse)
+        : AudioFormatReader (nullptr, entryToUse->reader->getFormatName()),
+          entry (std::move (entryToUse))
+    {
+        auto& source = *entry->reader;
+
+        sampleRate = source.sampleRate;
+        bitsPerSample = source.bitsPerSample;
+        lengthInSamples = source.lengthInSamples;
+        numChannels = source.numChannels;
+        usesFloatingPointData = source.usesFloatingPointData;
+        metadataValues = source.metadataValues;
+    }
+
+    bool readSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                      int64 startSampleInFile, int numSamples) override
+    {
+        const ScopedLock sl (entry->lock);
+        return entry->reader->readSamples (destSamples, numDestChannels, startOffsetInDestBuffer,
+                                           startSampleInFile, numSamples);
+    }
+
+    AudioChannelSet getChannelLayout() override
+    {
+        const ScopedLock sl (entry->lock);
+        return entry->reader->getChannelLayout();
+    }
+
+private:
+    std::shared_ptr<CachedReader> entry;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedReader)
+};
+
+//==============================================================================
 AudioFormatManager::AudioFormatManager() {}
 AudioFormatManager::~AudioFormatManager() {}
 
@@ -79,6 +166,7 @@ void AudioFormatManager::registerBasicFormats()
 
 void AudioFormatManager::clearFormats()
 {
+    clearReaderCache();
     knownFormats.clear();
     defaultFormatIndex = 0;
 }
@@ -123,13 +211,25 @@ AudioFormatReader* AudioFormatManager::createReaderFor (const File& file)
     // use them to open a file!
     jassert (getNumKnownFormats() > 0);
 
+    if (maxNumCachedReaders > 0)
+        return createCachedReaderFor (file);
+
+    return openReaderFor (file).release();
+}
+
+std::unique_ptr<AudioFormatReader> AudioFormatManager::openReaderFor (const File& file)
+{
+    Array<AudioFormat*> candidates;
+
     for (auto* af : knownFormats)
         if (af->canHandleFile (file))
-            if (auto in = file.createInputStream())
-                if (auto* r = af->createReaderFor (in.release(), true))
-                    return r;
+            candidates.add (af);
 
-    return nullptr;
+    if (! candidates.isEmpty())
+        if (std::unique_ptr<InputStream> in = file.createInputStream())
+            return std::unique_ptr<AudioFormatReader> (AudioFormatManagerHelpers::createReaderFor (in, candidates));
+
+    return {};
 }
 
 AudioFormatReader* AudioFormatManager::createReaderFor (std::unique_ptr<InputStream> audioFileStream)
@@ -139,26 +239,206 @@ AudioFormatReader* AudioFormatManager::createReaderFor (std::unique_ptr<InputStr
     jassert (getNumKnownFormats() > 0);
 
     if (audioFileStream != nullptr)
+        return AudioFormatManagerHelpers::createReaderFor (audioFileStream, knownFormats);
+
+    return nullptr;
+}
+
+//==============================================================================
+void AudioFormatManager::setReaderCacheSize (int maxNumFilesToKeepOpen)
+{
+    jassert (maxNumFilesToKeepOpen >= 0);
+
+    const ScopedLock sl (readerCacheLock);
+    maxNumCachedReaders = jmax (0, maxNumFilesToKeepOpen);
+
+    if (readerCache.size() > (size_t) maxNumCachedReaders)
+        readerCache.resize ((size_t) maxNumCachedReaders);
+}
+
+void AudioFormatManager::clearReaderCache()
+{
+    const ScopedLock sl (readerCacheLock);
+    readerCache.clear();
+}
+
+AudioFormatReader* AudioFormatManager::createCachedReaderFor (const File& file)
+{
+    const auto modificationTime = file.getLastModificationTime();
+    const auto fileSize = file.getSize();
+
+    const auto removeEntryForFile = [&]
     {
-        auto originalStreamPos = audioFileStream->getPosition();
+        const auto iter = std::find_if (readerCache.begin(), readerCache.end(),
+                                        [&] (const auto& e) { return e->file == file; });
 
-        for (auto* af : knownFormats)
+        if (iter == readerCache.end())
+            return std::shared_ptr<CachedReader>();
+
+        auto entry = *iter;
+        readerCache.erase (iter);
+        return entry;
+    };
+
+    {
+        const ScopedLock sl (readerCacheLock);
+
+        if (auto entry = removeEntryForFile())
         {
-            if (auto* r = af->createReaderFor (audioFileStream.get(), false))
+            if (entry->modificationTime == modificationTime && entry->fileSize == fileSize)
             {
-                audioFileStream.release();
-                return r;
+                readerCache.insert (readerCache.begin(), entry);
+                return new SharedReader (std::move (entry));
             }
+        }
+    }
 
-            audioFileStream->setPosition (originalStreamPos);
+    // The file is opened without holding the lock, so that other files can be
+    // found in the cache in the meantime.
+    auto reader = openReaderFor (file);
 
-            // the stream that is passed-in must be capable of being repositioned so
-            // that all the formats can have a go at opening it.
-            jassert (audioFileStream->getPosition() == originalStreamPos);
-        }
+    if (reader == nullptr)
+        return nullptr;
+
+    auto entry = std::make_shared<CachedReader>();
+    entry->file = file;
+    entry->modificationTime = modificationTime;
+    entry->fileSize = fileSize;
+    entry->reader = std::move (reader);
+
+    const ScopedLock sl (readerCacheLock);
+
+    if (maxNumCachedReaders > 0)
+    {
+        removeEntryForFile();
+        readerCache.insert (readerCache.begin(), entry);
+
+        if (readerCache.size() > (size_t) maxNumCachedReaders)
+            readerCache.resize ((size_t) maxNumCachedReaders);
     }
 
-    return nullptr;
+    return new SharedReader (std::move (entry));
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioFormatManagerTests final : public UnitTest
+{
+public:
+    AudioFormatManagerTests()
+        : UnitTest ("AudioFormatManager", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Formats that can't read a stream aren't tried");
+        {
+            AudioFormatManager manager;
+            auto* wav  = new CountingFormat<WavAudioFormat>();
+            auto* aiff = new CountingFormat<AiffAudioFormat>();
+            manager.registerFormat (wav, true);
+            manager.registerFormat (aiff, false);
+
+            const auto aiffData = createFileData (AiffAudioFormat(), 100);
+            std::unique_ptr<AudioFormatReader> reader (manager.createReaderFor (std::make_unique<MemoryInputStream> (aiffData, false)));
+
+            expect (reader != nullptr);
+            expectEquals (reader->lengthInSamples, (int64) 100);
+            expectEquals (wav->numAttempts, 0);
+            expectEquals (aiff->numAttempts, 1);
+
+            const MemoryBlock junk (256, true);
+            expect (manager.createReaderFor (std::make_unique<MemoryInputStream> (junk, false)) == nullptr);
+            expectEquals (wav->numAttempts + aiff->numAttempts, 1);
+        }
+
+        beginTest ("Cached readers are reused until the file changes");
+        {
+            AudioFormatManager manager;
+            auto* wav = new CountingFormat<WavAudioFormat>();
+            manager.registerFormat (wav, true);
+            manager.setReaderCacheSize (1);
+
+            const TemporaryFile firstFile (".wav"), secondFile (".wav");
+            writeFile (firstFile.getFile(), 100);
+            writeFile (secondFile.getFile(), 200);
+
+            std::unique_ptr<AudioFormatReader> first (manager.createReaderFor (firstFile.getFile()));
+            std::unique_ptr<AudioFormatReader> again (manager.createReaderFor (firstFile.getFile()));
+
+            expect (first != nullptr && again != nullptr);
+            expectEquals (wav->numAttempts, 1);
+            expectReadsRamp (*first, 100);
+            expectReadsRamp (*again, 100);
+
+            writeFile (firstFile.getFile(), 150);
+            std::unique_ptr<AudioFormatReader> changed (manager.createReaderFor (firstFile.getFile()));
+            expectEquals (wav->numAttempts, 2);
+            expectReadsRamp (*changed, 150);
+
+            // opening another file evicts the least recently used one
+            std::unique_ptr<AudioFormatReader> second (manager.createReaderFor (secondFile.getFile()));
+            changed.reset (manager.createReaderFor (firstFile.getFile()));
+            expectEquals (wav->numAttempts, 4);
+
+            // readers stay usable after their files have been closed by the cache
+            manager.clearReaderCache();
+            expectReadsRamp (*second, 200);
+            expectReadsRamp (*changed, 150);
+        }
+    }
+
+private:
+    template <typename Format>
+    struct CountingFormat final : public Format
+    {
+        AudioFormatReader* createReaderFor (InputStream* sourceStream, bool deleteStreamIfOpeningFails) override
+        {
+            ++numAttempts;
+            return Format::createReaderFor (sourceStream, deleteStreamIfOpeningFails);
+        }
+
+        int numAttempts = 0;
+    };
+
+    static MemoryBlock createFileData (AudioFormat&& format, int numSamples)
+    {
+        AudioBuffer<float> buffer (1, numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+            buffer.setSample (0, i, (float) i / (float) numSamples);
+
+        MemoryBlock data;
+
+        {
+            std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (new MemoryOutputStream (data, false),
+                                                                               44100.0, 1, 16, {}, 0));
+            writer->writeFromAudioSampleBuffer (buffer, 0, numSamples);
+        }
+
+        return data;
+    }
+
+    static void writeFile (const File& file, int numSamples)
+    {
+        const auto data = createFileData (WavAudioFormat(), numSamples);
+        file.replaceWithData (data.getData(), data.getSize());
+    }
+
+    void expectReadsRamp (AudioFormatReader& reader, int numSamples)
+    {
+        expectEquals (reader.lengthInSamples, (int64) numSamples);
+
+        AudioBuffer<float> buffer (1, numSamples);
+        expect (reader.read (&buffer, 0, numSamples, 0, true, false));
+        expectWithinAbsoluteError (buffer.getSample (0, numSamples / 2), 0.5f, 0.001f);
+    }
+};
+
+static AudioFormatManagerTests audioFormatManagerTests;
+
+#endif
+
 } // namespace juce
@@ -120,8 +120,14 @@ public:
     /** Searches through the known formats to try to create a suitable reader for
         this file.
 
+        The file is only opened once: its first few bytes are used to skip the formats
+        that can't read it (see AudioFormat::mightBeAbleToRead()), and the remaining
+        formats which can handle the file's extension are tried in turn.
+
         If none of the registered formats can open the file, it'll return nullptr.
         It's the caller's responsibility to delete the reader that is returned.
+
+        @see setReaderCacheSize
     */
     AudioFormatReader* createReaderFor (const File& audioFile);
 
@@ -132,18 +138,50 @@ public:
         reader that is returned, so the caller should not keep any references to it.
 
         The stream that is passed-in must be capable of being repositioned so
-        that all the formats can have a go at opening it.
+        that all the formats can have a go at opening it. Formats that can tell
+        from the start of the stream that they can't read it aren't tried.
 
         If none of the registered formats can open the stream, it'll return nullptr.
         If it returns a reader, it's the caller's responsibility to delete the reader.
     */
     AudioFormatReader* createReaderFor (std::unique_ptr<InputStream> audioFileStream);
 
+    //==============================================================================
+    /** Keeps up to the given number of files open, so that opening one of them again
+        with createReaderFor (const File&) doesn't have to parse its header again.
+
+        While the cache is enabled, the readers returned for files are lightweight
+        objects which share an open reader held by the cache. A cached reader is only
+        reused while the file's size and modification time are unchanged, and the least
+        recently used files are closed when the cache is full. Readers that share a file
+        take turns to read from it, so the cache suits code that keeps reopening the same
+        files, such as a sample browser, rather than streaming one file on several threads.
+
+        A size of 0 disables the cache, which is the default.
+    */
+    void setReaderCacheSize (int maxNumFilesToKeepOpen);
+
+    /** Closes all the files that are held open by the reader cache.
+
+        Readers that have already been returned will keep working.
+    */
+    void clearReaderCache();
+
 private:
     //==============================================================================
+    struct CachedReader;
+    class SharedReader;
+
     OwnedArray<AudioFormat> knownFormats;
     int defaultFormatIndex = 0;
 
+    CriticalSection readerCacheLock;
+    std::vector<std::shared_ptr<CachedReader>> readerCache; // most recently used first
+    int maxNumCachedReaders = 0;
+
+    std::unique_ptr<AudioFormatReader> openReaderFor (const File&);
+    AudioFormatReader* createCachedReaderFor (const File&);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioFormatManager)
 };
 
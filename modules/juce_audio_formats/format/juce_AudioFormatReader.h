@@ -283,21 +283,40 @@ protected:
         using DestType   = AudioData::Pointer<DestSampleType,   AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::NonConst>;
         using SourceType = AudioData::Pointer<SourceSampleType, SourceEndianness, AudioData::Interleaved, AudioData::Const>;
 
+        // packed integer samples, and float-to-float copies, have a faster bulk converter
+        static constexpr bool isPacked = std::is_same_v<SourceSampleType, AudioData::Int16>
+                                      || std::is_same_v<SourceSampleType, AudioData::Int24>
+                                      || std::is_same_v<SourceSampleType, AudioData::Int32>;
+
+        static constexpr bool canUsePackedConversion = (std::is_same_v<DestSampleType, AudioData::Int32> && isPacked)
+                                                    || (std::is_same_v<DestSampleType, AudioData::Float32>
+                                                         && std::is_same_v<SourceSampleType, AudioData::Float32>);
+
         template <typename TargetType>
         static void read (TargetType* const* destData, int destOffset, int numDestChannels,
                           const void* sourceData, int numSourceChannels, int numSamples) noexcept
         {
-            for (int i = 0; i < numDestChannels; ++i)
+            if constexpr (canUsePackedConversion && sizeof (TargetType) == sizeof (int32))
             {
-                if (void* targetChan = destData[i])
+                AudioData::deinterleavePackedSamples (sourceData, numSourceChannels, SourceType::getBytesPerSample(),
+                                                      std::is_base_of_v<AudioData::BigEndian, SourceEndianness>,
+                                                      reinterpret_cast<int32* const*> (destData), destOffset, numDestChannels,
+                                                      numSamples);
+            }
+            else
+            {
+                for (int i = 0; i < numDestChannels; ++i)
                 {
-                    DestType dest (targetChan);
-                    dest += destOffset;
-
-                    if (i < numSourceChannels)
-                        dest.convertSamples (SourceType (addBytesToPointer (sourceData, i * SourceType::getBytesPerSample()), numSourceChannels), numSamples);
-                    else
-                        dest.clearSamples (numSamples);
+                    if (void* targetChan = destData[i])
+                    {
+                        DestType dest (targetChan);
+                        dest += destOffset;
+
+                        if (i < numSourceChannels)
+                            dest.convertSamples (SourceType (addBytesToPointer (sourceData, i * SourceType::getBytesPerSample()), numSourceChannels), numSamples);
+                        else
+                            dest.clearSamples (numSamples);
+                    }
                 }
             }
         }
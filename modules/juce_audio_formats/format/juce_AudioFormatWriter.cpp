@@ -157,11 +157,14 @@ bool AudioFormatWriter::writeFromFloatArrays (const float* const* channels, int
     if (isFloatingPoint())
         return write ((const int**) channels, numSamples);
 
+    // convert in large blocks, so that each call to write() stays efficient, but keep
+    // the scratch space to 64K samples in total however many channels there are
+    const int maxSamples = jmin (numSamples, 16384, jmax (1, 65536 / numSourceChannels));
+
     std::vector<int*> chans (256);
-    std::vector<int> scratch (4096);
+    std::vector<int> scratch ((size_t) (maxSamples * numSourceChannels));
 
     jassert (numSourceChannels < (int) chans.size());
-    const int maxSamples = (int) scratch.size() / numSourceChannels;
 
     for (int i = 0; i < numSourceChannels; ++i)
         chans[(size_t) i] = scratch.data() + (i * maxSamples);
@@ -243,7 +246,11 @@ public:
         fifo.prepareToWrite (numSamples, start1, size1, start2, size2);
 
         if (size1 + size2 < numSamples)
+        {
+            ++numOverruns;
+            numSamplesDropped += numSamples;
             return false;
+        }
 
         for (int i = buffer.getNumChannels(); --i >= 0;)
         {
@@ -252,7 +259,15 @@ public:
         }
 
         fifo.finishedWrite (size1 + size2);
-        timeSliceThread.notify();
+
+        const auto numReady = fifo.getNumReady();
+
+        if (numReady > maxNumSamplesBuffered)
+            maxNumSamplesBuffered = numReady;
+
+        if (numReady >= writeBlockSize)
+            timeSliceThread.notify();
+
         return true;
     }
 
@@ -261,10 +276,30 @@ public:
         return writePendingData();
     }
 
+    int getTimeSlicePriority() const override
+    {
+        // A recording that falls behind loses data, so it goes before background jobs,
+        // and the writers whose FIFOs are fullest go first.
+        return 1 + fifo.getNumReady() * 8 / fifo.getTotalSize();
+    }
+
     int writePendingData()
     {
         auto numToDo = fifo.getTotalSize() / 4;
 
+        if (isRunning)
+        {
+            if (const auto blockSize = writeBlockSize.load(); blockSize > 0)
+            {
+                const auto numReady = fifo.getNumReady();
+
+                if (numReady < blockSize)
+                    return 10;
+
+                numToDo = (jmin (numReady, jmax (numToDo, blockSize)) / blockSize) * blockSize;
+            }
+        }
+
         int start1, size1, start2, size2;
         fifo.prepareToRead (numToDo, start1, size1, start2, size2);
 
@@ -321,6 +356,22 @@ public:
         samplesPerFlush = numSamples;
     }
 
+    void setWriteBlockSize (int numSamples) noexcept
+    {
+        writeBlockSize = jlimit (0, fifo.getTotalSize() / 2, numSamples);
+    }
+
+    Statistics getStatistics() const noexcept
+    {
+        Statistics s;
+        s.numSamplesBuffered = fifo.getNumReady();
+        s.maxNumSamplesBuffered = maxNumSamplesBuffered;
+        s.bufferSize = fifo.getTotalSize();
+        s.numOverruns = numOverruns;
+        s.numSamplesDropped = numSamplesDropped;
+        return s;
+    }
+
 private:
     AbstractFifo fifo;
     AudioBuffer<float> buffer;
@@ -330,6 +381,8 @@ private:
     IncomingDataReceiver* receiver = {};
     int64 samplesWritten = 0;
     int samplesPerFlush = 0, flushSampleCounter = 0;
+    std::atomic<int> writeBlockSize { 0 }, maxNumSamplesBuffered { 0 }, numOverruns { 0 };
+    std::atomic<int64> numSamplesDropped { 0 };
     std::atomic<bool> isRunning { true };
 
     JUCE_DECLARE_NON_COPYABLE (Buffer)
@@ -359,4 +412,135 @@ void AudioFormatWriter::ThreadedWriter::setFlushInterval (int numSamplesPerFlush
     buffer->setFlushInterval (numSamplesPerFlush);
 }
 
+void AudioFormatWriter::ThreadedWriter::setWriteBlockSize (int numSamples) noexcept
+{
+    buffer->setWriteBlockSize (numSamples);
+}
+
+AudioFormatWriter::ThreadedWriter::Statistics AudioFormatWriter::ThreadedWriter::getStatistics() const noexcept
+{
+    return buffer->getStatistics();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct ThreadedWriterTests final : public UnitTest
+{
+    ThreadedWriterTests()  : UnitTest ("AudioFormatWriter::ThreadedWriter", UnitTestCategories::audio)  {}
+
+    struct RecordingWriter final : public AudioFormatWriter
+    {
+        RecordingWriter (Array<int>& sizes, double& total, WaitableEvent* gate = nullptr)
+            : AudioFormatWriter (nullptr, "Recording", 44100.0, 1u, 32u),
+              writeSizes (sizes), sampleTotal (total), writeGate (gate)
+        {
+            usesFloatingPointData = true;
+        }
+
+        bool write (const int** data, int numSamples) override
+        {
+            if (writeGate != nullptr)
+                writeGate->wait();
+
+            writeSizes.add (numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+                sampleTotal += reinterpret_cast<const float*> (data[0])[i];
+
+            return true;
+        }
+
+        Array<int>& writeSizes;
+        double& sampleTotal;
+        WaitableEvent* writeGate;
+    };
+
+    void runTest() override
+    {
+        constexpr int blockSize = 64;
+        HeapBlock<float> block (blockSize);
+
+        for (int i = 0; i < blockSize; ++i)
+            block[i] = (float) i;
+
+        const float* channels[] = { block.get() };
+
+        beginTest ("Small incoming blocks are written in whole write blocks");
+        {
+            Array<int> writeSizes;
+            double total = 0;
+            int numBlocksPushed = 0;
+
+            TimeSliceThread thread ("ThreadedWriter test");
+            thread.startThread();
+
+            {
+                AudioFormatWriter::ThreadedWriter writer (new RecordingWriter (writeSizes, total), thread, 16384);
+                writer.setWriteBlockSize (1024);
+
+                for (int i = 0; i < 500; ++i)
+                {
+                    while (! writer.write (channels, blockSize))
+                        Thread::sleep (1);
+
+                    ++numBlocksPushed;
+                }
+            }
+
+            thread.stopThread (5000);
+
+            expect (writeSizes.size() > 1);
+
+            for (int i = 0; i < writeSizes.size() - 1; ++i)
+                expectEquals (writeSizes[i] % 1024, 0);
+
+            int numWritten = 0;
+
+            for (auto size : writeSizes)
+                numWritten += size;
+
+            expectEquals (numWritten, numBlocksPushed * blockSize);
+            expectEquals (total, (double) numBlocksPushed * (blockSize * (blockSize - 1) / 2));
+        }
+
+        beginTest ("Overruns are counted when the disk falls behind");
+        {
+            Array<int> writeSizes;
+            double total = 0;
+            WaitableEvent gate (true);
+
+            TimeSliceThread thread ("ThreadedWriter test");
+            thread.startThread();
+
+            {
+                AudioFormatWriter::ThreadedWriter writer (new RecordingWriter (writeSizes, total, &gate), thread, 1024);
+
+                int numFailed = 0;
+
+                for (int i = 0; i < 100; ++i)
+                    if (! writer.write (channels, blockSize))
+                        ++numFailed;
+
+                const auto stats = writer.getStatistics();
+
+                expect (numFailed > 0);
+                expectEquals (stats.numOverruns, numFailed);
+                expectEquals (stats.numSamplesDropped, (int64) numFailed * blockSize);
+                expect (stats.maxNumSamplesBuffered >= stats.numSamplesBuffered);
+                expect (stats.maxNumSamplesBuffered < stats.bufferSize);
+
+                gate.signal();
+            }
+
+            thread.stopThread (5000);
+        }
+    }
+};
+
+static ThreadedWriterTests threadedWriterTests;
+
+#endif
+
 } // namespace juce
@@ -179,6 +179,12 @@ public:
     /**
         Provides a FIFO for an AudioFormatWriter, allowing you to push incoming
         data into a buffer which will be flushed to disk by a background thread.
+
+        When recording many tracks at once, all their ThreadedWriters can share one
+        TimeSliceThread. The writers whose FIFOs are fullest are serviced first, and if
+        the thread was created with several threads, the writers are flushed in parallel.
+        Use setWriteBlockSize() to make each writer write fewer, larger blocks, and
+        getStatistics() to find out whether the disk is falling behind.
     */
     class ThreadedWriter
     {
@@ -237,6 +243,47 @@ public:
         */
         void setFlushInterval (int numSamplesPerFlush) noexcept;
 
+        /** Sets the number of samples that the background thread should write in one go.
+
+            The background thread will wait until at least this many samples are in the
+            FIFO, and then write a whole number of blocks of this size. This turns a
+            stream of small incoming blocks into a few large writes, which is much
+            kinder to the disk when many files are being recorded at once. Any remaining
+            samples are written when the ThreadedWriter is deleted.
+
+            The size is limited to half of the FIFO's size. Set this to 0 to write the
+            data as soon as it arrives (this is the default).
+        */
+        void setWriteBlockSize (int numSamples) noexcept;
+
+        /** Describes how well the background thread has been keeping up with the data
+            being written.
+        */
+        struct Statistics
+        {
+            /** The number of samples that are waiting in the FIFO to be written. */
+            int numSamplesBuffered = 0;
+
+            /** The largest value that numSamplesBuffered has reached. */
+            int maxNumSamplesBuffered = 0;
+
+            /** The size of the FIFO. */
+            int bufferSize = 0;
+
+            /** The number of calls to write() that failed because the FIFO was full. */
+            int numOverruns = 0;
+
+            /** The total number of samples that were passed to those failed calls. */
+            int64 numSamplesDropped = 0;
+        };
+
+        /** Returns the current statistics for this writer.
+
+            This can be called from any thread. If maxNumSamplesBuffered approaches
+            bufferSize, the disk isn't keeping up and data will soon be lost.
+        */
+        Statistics getStatistics() const noexcept;
+
     private:
         class Buffer;
         std::unique_ptr<Buffer> buffer;
@@ -269,21 +316,42 @@ protected:
         using DestType   = AudioData::Pointer <DestSampleType,   DestEndianness,          AudioData::Interleaved,    AudioData::NonConst>;
         using SourceType = AudioData::Pointer <SourceSampleType, AudioData::NativeEndian, AudioData::NonInterleaved, AudioData::Const>;
 
+        // writing to packed integer samples has a faster bulk converter
+        static constexpr bool canUsePackedConversion = std::is_same_v<SourceSampleType, AudioData::Int32>
+                                                    && (std::is_same_v<DestSampleType, AudioData::Int16>
+                                                         || std::is_same_v<DestSampleType, AudioData::Int24>
+                                                         || std::is_same_v<DestSampleType, AudioData::Int32>);
+
         static void write (void* destData, int numDestChannels, const int* const* source,
                            int numSamples, const int sourceOffset = 0) noexcept
         {
-            for (int i = 0; i < numDestChannels; ++i)
+            if constexpr (canUsePackedConversion)
             {
-                const DestType dest (addBytesToPointer (destData, i * DestType::getBytesPerSample()), numDestChannels);
+                int numSourceChannels = 0;
 
-                if (*source != nullptr)
-                {
-                    dest.convertSamples (SourceType (*source + sourceOffset), numSamples);
-                    ++source;
-                }
-                else
+                while (numSourceChannels < numDestChannels && source[numSourceChannels] != nullptr)
+                    ++numSourceChannels;
+
+                AudioData::interleavePackedSamples (source, sourceOffset, numSourceChannels,
+                                                    destData, numDestChannels, DestType::getBytesPerSample(),
+                                                    std::is_base_of_v<AudioData::BigEndian, DestEndianness>,
+                                                    numSamples);
+            }
+            else
+            {
+                for (int i = 0; i < numDestChannels; ++i)
                 {
-                    dest.clearSamples (numSamples);
+                    const DestType dest (addBytesToPointer (destData, i * DestType::getBytesPerSample()), numDestChannels);
+
+                    if (*source != nullptr)
+                    {
+                        dest.convertSamples (SourceType (*source + sourceOffset), numSamples);
+                        ++source;
+                    }
+                    else
+                    {
+                        dest.clearSamples (numSamples);
+                    }
                 }
             }
         }
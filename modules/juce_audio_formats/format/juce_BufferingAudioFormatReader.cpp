@@ -134,6 +134,12 @@ int BufferingAudioReader::useTimeSlice()
     return readNextBufferChunk() ? 1 : 100;
 }
 
+int BufferingAudioReader::getTimeSlicePriority() const
+{
+    // playback needs its data before background jobs such as thumbnails do
+    return 1;
+}
+
 bool BufferingAudioReader::readNextBufferChunk()
 {
     auto pos = (nextReadPosition.load() / samplesPerBlock) * samplesPerBlock;
@@ -77,6 +77,7 @@ private:
     };
 
     int useTimeSlice() override;
+    int getTimeSlicePriority() const override;
     BufferedBlock* getBlockContaining (int64 pos) const noexcept;
     bool readNextBufferChunk();
 
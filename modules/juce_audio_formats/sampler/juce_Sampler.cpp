@@ -40,12 +40,42 @@ SamplerSound::SamplerSound (const String& soundName,
 {
     if (sourceSampleRate > 0 && source.lengthInSamples > 0)
     {
-        length = jmin ((int) source.lengthInSamples,
-                       (int) (maxSampleLengthSeconds * sourceSampleRate));
+        preloadLength = jmin ((int) source.lengthInSamples,
+                              (int) (maxSampleLengthSeconds * sourceSampleRate));
+        length = preloadLength;
 
-        data.reset (new AudioBuffer<float> (jmin (2, (int) source.numChannels), length + 4));
+        data.reset (new AudioBuffer<float> ((int) source.numChannels, preloadLength + 4));
 
-        source.read (data.get(), 0, length + 4, 0, true, true);
+        source.read (data->getArrayOfWritePointers(), data->getNumChannels(), 0, preloadLength + 4);
+
+        params.attack  = static_cast<float> (attackTimeSecs);
+        params.release = static_cast<float> (releaseTimeSecs);
+    }
+}
+
+SamplerSound::SamplerSound (const String& soundName,
+                            std::unique_ptr<AudioFormatReader> source,
+                            const BigInteger& notes,
+                            int midiNoteForNormalPitch,
+                            double attackTimeSecs,
+                            double releaseTimeSecs,
+                            double preloadLengthSeconds)
+    : name (soundName),
+      sourceSampleRate (source != nullptr ? source->sampleRate : 0.0),
+      midiNotes (notes),
+      midiRootNote (midiNoteForNormalPitch)
+{
+    if (sourceSampleRate > 0 && source->lengthInSamples > 0)
+    {
+        length = source->lengthInSamples;
+        preloadLength = (int) jmin (length, (int64) (preloadLengthSeconds * sourceSampleRate));
+
+        data.reset (new AudioBuffer<float> ((int) source->numChannels, preloadLength + 4));
+
+        source->read (data->getArrayOfWritePointers(), data->getNumChannels(), 0, preloadLength + 4);
+
+        if (preloadLength < length)
+            reader = std::move (source);
 
         params.attack  = static_cast<float> (attackTimeSecs);
         params.release = static_cast<float> (releaseTimeSecs);
@@ -66,18 +96,201 @@ bool SamplerSound::appliesToChannel (int /*midiChannel*/)
     return true;
 }
 
+void SamplerSound::readStreamedSamples (float* const* dest, int numChannels, int64 startSample, int numSamples)
+{
+    const ScopedLock sl (readerLock);
+    reader->read (dest, numChannels, startSample, numSamples);
+}
+
+//==============================================================================
+/*  Reads ahead from a streamed SamplerSound into a ring buffer, on a TimeSliceThread.
+
+    The audio thread and the disk thread pass the stream back and forth using the state
+    variable: the audio thread only changes the sound while the stream is idle, and the
+    disk thread only sets up the ring buffer while a new stream has been requested, so
+    neither of them ever has to wait for the other.
+*/
+struct SamplerVoice::DiskStream final : private TimeSliceClient
+{
+    DiskStream (TimeSliceThread& t, int samplesToBuffer)
+        : thread (t),
+          fifo (nextPowerOfTwo (jmax (1024, samplesToBuffer)))
+    {
+        thread.addTimeSliceClient (this);
+    }
+
+    ~DiskStream() override
+    {
+        thread.removeTimeSliceClient (this);
+    }
+
+    //==============================================================================
+    // These are called on the audio thread..
+    void start (SamplerSound& soundToStream)
+    {
+        nextSound = &soundToStream;
+        stop();
+        update();
+    }
+
+    void stop() noexcept
+    {
+        auto current = state.load();
+
+        while ((current == requested || current == streaming)
+                 && ! state.compare_exchange_weak (current, stopping))
+        {}
+    }
+
+    void update()
+    {
+        if (state.load() == idle)
+        {
+            sound = std::move (nextSound);
+
+            if (sound != nullptr)
+            {
+                readPosition = static_cast<SamplerSound&> (*sound).preloadLength;
+                state = requested;
+            }
+        }
+    }
+
+    void prepareToRead() noexcept
+    {
+        int start2, size2;
+        numReady = 0;
+
+        if (state.load() == streaming)
+        {
+            fifo.prepareToRead (fifo.getNumReady(), readStart, numReady, start2, size2);
+            numReady += size2;
+        }
+    }
+
+    float getSample (int channel, int64 index) const noexcept
+    {
+        const auto offset = index - readPosition;
+
+        if (isPositiveAndBelow (offset, (int64) numReady))
+            return buffer.getSample (channel, (readStart + (int) offset) & (fifo.getTotalSize() - 1));
+
+        return 0.0f;
+    }
+
+    void discardSamplesBefore (int64 index) noexcept
+    {
+        const auto numToDiscard = (int) jlimit ((int64) 0, (int64) numReady, index - readPosition);
+        fifo.finishedRead (numToDiscard);
+        readPosition += numToDiscard;
+    }
+
+private:
+    //==============================================================================
+    // ..and these on the disk thread
+    int getTimeSlicePriority() const override
+    {
+        return 1;
+    }
+
+    int useTimeSlice() override
+    {
+        switch (state.load())
+        {
+            case stopping:
+                state = idle;
+                return 1;
+
+            case requested:
+            {
+                auto& s = static_cast<SamplerSound&> (*sound);
+                const auto numChannels = s.data->getNumChannels();
+
+                buffer.setSize (numChannels, fifo.getTotalSize(), false, false, true);
+                channelPointers.realloc ((size_t) numChannels);
+                fifo.reset();
+                writePosition = s.preloadLength;
+
+                auto expected = requested;
+                state.compare_exchange_strong (expected, streaming);
+                return 0;
+            }
+
+            case streaming:
+                return readNextChunk() ? 1 : 5;
+
+            case idle:
+            default:
+                return 10;
+        }
+    }
+
+    bool readNextChunk()
+    {
+        auto& s = static_cast<SamplerSound&> (*sound);
+        const auto numToRead = (int) jmin ((int64) jmin (fifo.getFreeSpace(), maxSamplesPerRead),
+                                           s.length + 4 - writePosition);
+
+        if (numToRead <= 0)
+            return false;
+
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite (numToRead, start1, size1, start2, size2);
+
+        for (auto [start, size] : { std::make_pair (start1, size1), std::make_pair (start2, size2) })
+        {
+            if (size > 0)
+            {
+                for (int i = 0; i < buffer.getNumChannels(); ++i)
+                    channelPointers[i] = buffer.getWritePointer (i, start);
+
+                s.readStreamedSamples (channelPointers, buffer.getNumChannels(), writePosition, size);
+                writePosition += size;
+            }
+        }
+
+        fifo.finishedWrite (size1 + size2);
+        return true;
+    }
+
+    //==============================================================================
+    enum State { idle, requested, streaming, stopping };
+    static constexpr int maxSamplesPerRead = 8192;
+
+    TimeSliceThread& thread;
+    std::atomic<State> state { idle };
+    SynthesiserSound::Ptr sound, nextSound;
+
+    AbstractFifo fifo;
+    AudioBuffer<float> buffer;
+    HeapBlock<float*> channelPointers;
+    int64 readPosition = 0, writePosition = 0;
+    int readStart = 0, numReady = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DiskStream)
+};
+
 //==============================================================================
 SamplerVoice::SamplerVoice() {}
+
+SamplerVoice::SamplerVoice (TimeSliceThread& diskThread, int samplesToBuffer)
+    : stream (std::make_unique<DiskStream> (diskThread, samplesToBuffer))
+{
+}
+
 SamplerVoice::~SamplerVoice() {}
 
 bool SamplerVoice::canPlaySound (SynthesiserSound* sound)
 {
-    return dynamic_cast<const SamplerSound*> (sound) != nullptr;
+    if (auto* samplerSound = dynamic_cast<const SamplerSound*> (sound))
+        return stream != nullptr || ! samplerSound->isStreaming();
+
+    return false;
 }
 
 void SamplerVoice::startNote (int midiNoteNumber, float velocity, SynthesiserSound* s, int /*currentPitchWheelPosition*/)
 {
-    if (auto* sound = dynamic_cast<const SamplerSound*> (s))
+    if (auto* sound = dynamic_cast<SamplerSound*> (s))
     {
         pitchRatio = std::pow (2.0, (midiNoteNumber - sound->midiRootNote) / 12.0)
                         * sound->sourceSampleRate / getSampleRate();
@@ -90,6 +303,12 @@ void SamplerVoice::startNote (int midiNoteNumber, float velocity, SynthesiserSou
         adsr.setParameters (sound->params);
 
         adsr.noteOn();
+
+        if (sound->isStreaming())
+        {
+            jassert (stream != nullptr); // this voice needs a disk thread to play streamed sounds!
+            stream->start (*sound);
+        }
     }
     else
     {
@@ -107,6 +326,9 @@ void SamplerVoice::stopNote (float /*velocity*/, bool allowTailOff)
     {
         clearCurrentNote();
         adsr.reset();
+
+        if (stream != nullptr)
+            stream->stop();
     }
 }
 
@@ -114,52 +336,231 @@ void SamplerVoice::pitchWheelMoved (int /*newValue*/) {}
 void SamplerVoice::controllerMoved (int /*controllerNumber*/, int /*newValue*/) {}
 
 //==============================================================================
+static float interpolateCatmullRom (float y0, float y1, float y2, float y3, float offset) noexcept
+{
+    auto halfY0 = 0.5f * y0;
+    auto halfY3 = 0.5f * y3;
+
+    return y1 + offset * ((0.5f * y2 - halfY0)
+              + (offset * (((y0 + 2.0f * y2) - (halfY3 + 2.5f * y1))
+              + (offset * ((halfY3 + 1.5f * y1) - (halfY0 + 1.5f * y2))))));
+}
+
 void SamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
 {
+    if (stream != nullptr)
+        stream->update();
+
     if (auto* playingSound = static_cast<SamplerSound*> (getCurrentlyPlayingSound().get()))
     {
         auto& data = *playingSound->data;
-        const float* const inL = data.getReadPointer (0);
-        const float* const inR = data.getNumChannels() > 1 ? data.getReadPointer (1) : nullptr;
+        const auto numSourceChannels = data.getNumChannels();
+        const auto numOutputChannels = outputBuffer.getNumChannels();
+        const auto numInMemory = (int64) data.getNumSamples();
+        auto* diskStream = playingSound->isStreaming() ? stream.get() : nullptr;
+        const auto useCatmullRom = playingSound->interpolation == SamplerSound::Interpolation::catmullRom;
 
-        float* outL = outputBuffer.getWritePointer (0, startSample);
-        float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
+        if (diskStream != nullptr)
+            diskStream->prepareToRead();
 
-        while (--numSamples >= 0)
+        auto getSample = [&] (int channel, int64 index)
         {
-            auto pos = (int) sourceSamplePosition;
-            auto alpha = (float) (sourceSamplePosition - pos);
-            auto invAlpha = 1.0f - alpha;
+            if (index < numInMemory)
+                return data.getSample (channel, (int) index);
 
-            // just using a very simple linear interpolation here..
-            float l = (inL[pos] * invAlpha + inL[pos + 1] * alpha);
-            float r = (inR != nullptr) ? (inR[pos] * invAlpha + inR[pos + 1] * alpha)
-                                       : l;
+            return diskStream != nullptr ? diskStream->getSample (channel, index) : 0.0f;
+        };
 
-            auto envelopeValue = adsr.getNextSample();
+        auto endPosition = sourceSamplePosition;
+        auto numToRender = 0;
+        auto reachedEnd = false;
 
-            l *= lgain * envelopeValue;
-            r *= rgain * envelopeValue;
+        while (numToRender < numSamples && ! reachedEnd)
+        {
+            ++numToRender;
+            endPosition += pitchRatio;
+            reachedEnd = endPosition > (double) playingSound->length;
+        }
 
-            if (outR != nullptr)
+        auto renderChannel = [&] (int sourceChannel, int outputChannel, float gain)
+        {
+            auto* out = outputBuffer.getWritePointer (outputChannel, startSample);
+            auto envelope = adsr;
+            auto position = sourceSamplePosition;
+
+            for (int i = 0; i < numToRender; ++i)
             {
-                *outL++ += l;
-                *outR++ += r;
+                const auto index = (int64) position;
+                const auto offset = (float) (position - (double) index);
+
+                const auto y1 = getSample (sourceChannel, index);
+                const auto y2 = getSample (sourceChannel, index + 1);
+
+                const auto value = useCatmullRom ? interpolateCatmullRom (getSample (sourceChannel, jmax ((int64) 0, index - 1)),
+                                                                          y1, y2,
+                                                                          getSample (sourceChannel, index + 2),
+                                                                          offset)
+                                                 : y1 * (1.0f - offset) + y2 * offset;
+
+                out[i] += value * gain * envelope.getNextSample();
+                position += pitchRatio;
             }
-            else
+        };
+
+        if (numOutputChannels == 1)
+        {
+            for (int i = 0; i < numSourceChannels; ++i)
+                renderChannel (i, 0, (i == 0 ? lgain : rgain) / (float) numSourceChannels);
+        }
+        else if (numSourceChannels == 1)
+        {
+            renderChannel (0, 0, lgain);
+            renderChannel (0, 1, rgain);
+        }
+        else
+        {
+            for (int i = 0; i < jmin (numSourceChannels, numOutputChannels); ++i)
+                renderChannel (i, i, i == 0 ? lgain : rgain);
+        }
+
+        for (int i = 0; i < numToRender; ++i)
+            adsr.getNextSample();
+
+        sourceSamplePosition = endPosition;
+
+        if (diskStream != nullptr)
+            diskStream->discardSamplesBefore ((int64) sourceSamplePosition - 1);
+
+        if (reachedEnd)
+            stopNote (0.0f, false);
+    }
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SamplerTests final : public UnitTest
+{
+public:
+    SamplerTests()  : UnitTest ("Sampler", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        TimeSliceThread thread ("TestDiskThread");
+        thread.startThread (Thread::Priority::normal);
+
+        auto random = getRandom();
+        AudioBuffer<float> source (3, 20000);
+
+        for (int channel = 0; channel < source.getNumChannels(); ++channel)
+            for (int sample = 0; sample < source.getNumSamples(); ++sample)
+                source.setSample (channel, sample, random.nextFloat() * 2.0f - 1.0f);
+
+        BigInteger notes;
+        notes.setRange (0, 128, true);
+
+        TestAudioFormatReader memoryReader (&source);
+        SynthesiserSound::Ptr inMemory = new SamplerSound ("memory", memoryReader, notes, 60, 0.0, 0.1, 10.0);
+        SynthesiserSound::Ptr streamed = new SamplerSound ("streamed", std::make_unique<TestAudioFormatReader> (&source),
+                                                           notes, 60, 0.0, 0.1, 0.1);
+
+        beginTest ("Sounds keep all their channels");
+        {
+            expectEquals (static_cast<SamplerSound&> (*inMemory).getAudioData()->getNumChannels(), 3);
+            expectEquals (static_cast<SamplerSound&> (*streamed).getAudioData()->getNumChannels(), 3);
+            expect (! static_cast<SamplerSound&> (*inMemory).isStreaming());
+            expect (static_cast<SamplerSound&> (*streamed).isStreaming());
+        }
+
+        beginTest ("Streamed sounds need a voice with a disk thread");
+        {
+            SamplerVoice voice;
+            expect (voice.canPlaySound (inMemory.get()));
+            expect (! voice.canPlaySound (streamed.get()));
+        }
+
+        beginTest ("Sounds use linear interpolation by default");
+        {
+            expect (static_cast<SamplerSound&> (*inMemory).getInterpolation() == SamplerSound::Interpolation::linear);
+
+            Synthesiser synth;
+            synth.addVoice (new SamplerVoice());
+            synth.addSound (inMemory);
+            synth.setCurrentPlaybackSampleRate (44100.0);
+            synth.noteOn (1, 62, 1.0f);
+
+            AudioBuffer<float> output (3, 256);
+            output.clear();
+            MidiBuffer midi;
+            synth.renderNextBlock (output, midi, 0, 256);
+
+            const auto pitchRatio = std::pow (2.0, 2.0 / 12.0);
+            auto maxError = 0.0f;
+
+            for (int i = 0; i < 256; ++i)
             {
-                *outL++ += (l + r) * 0.5f;
+                const auto position = i * pitchRatio;
+                const auto index = (int) position;
+                const auto alpha = (float) (position - index);
+                const auto expected = source.getSample (0, index) * (1.0f - alpha) + source.getSample (0, index + 1) * alpha;
+                maxError = jmax (maxError, std::abs (output.getSample (0, i) - expected));
             }
 
-            sourceSamplePosition += pitchRatio;
+            expectLessThan (maxError, 1.0e-5f);
+        }
+
+        for (auto interpolation : { SamplerSound::Interpolation::linear, SamplerSound::Interpolation::catmullRom })
+        {
+            static_cast<SamplerSound&> (*inMemory).setInterpolation (interpolation);
+            static_cast<SamplerSound&> (*streamed).setInterpolation (interpolation);
 
-            if (sourceSamplePosition > playingSound->length)
+            beginTest (String ("Streamed and in-memory sounds produce the same output, with ")
+                         + (interpolation == SamplerSound::Interpolation::linear ? "linear" : "Catmull-Rom")
+                         + " interpolation");
+
+            for (auto note : { 60, 62, 55 })
             {
-                stopNote (0.0f, false);
-                break;
+                Synthesiser memorySynth, streamingSynth;
+                memorySynth.addVoice (new SamplerVoice());
+                memorySynth.addSound (inMemory);
+                streamingSynth.addVoice (new SamplerVoice (thread, 4096));
+                streamingSynth.addSound (streamed);
+
+                AudioBuffer<float> expected (3, 256), actual (3, 256);
+                MidiBuffer midi;
+
+                for (auto* synth : { &memorySynth, &streamingSynth })
+                {
+                    synth->setCurrentPlaybackSampleRate (44100.0);
+                    synth->noteOn (1, note, 1.0f);
+                }
+
+                auto matches = true, anySound = false;
+
+                for (int block = 0; block < 100; ++block)
+                {
+                    // gives the disk thread time to read ahead, as it would in real time
+                    Thread::sleep (5);
+
+                    expected.clear();
+                    actual.clear();
+                    memorySynth.renderNextBlock (expected, midi, 0, 256);
+                    streamingSynth.renderNextBlock (actual, midi, 0, 256);
+
+                    matches = matches && expected == actual;
+                    anySound = anySound || expected.getMagnitude (2, 0, 256) > 0.0f;
+                }
+
+                expect (matches);
+                expect (anySound);
             }
         }
     }
-}
+};
+
+static SamplerTests samplerTests;
+
+#endif
 
 } // namespace juce
@@ -30,8 +30,9 @@ namespace juce
 /**
     A subclass of SynthesiserSound that represents a sampled audio clip.
 
-    This is a pretty basic sampler, and just attempts to load the whole audio stream
-    into memory.
+    A sound can either be loaded into memory in its entirety, or it can keep just the
+    start of the sample in memory and stream the rest from disk while it's playing, which
+    lets an instrument use far more sample data than would fit in memory.
 
     To use it, create a Synthesiser, add some SamplerVoice objects to it, then
     give it some SampledSound objects to play.
@@ -70,6 +71,38 @@ public:
                   double releaseTimeSecs,
                   double maxSampleLengthSeconds);
 
+    /** Creates a sampled sound that streams its audio from a reader while it plays.
+
+        Only the first preloadLengthSeconds of the audio are read into memory here, and the
+        rest is read by the disk threads of the SamplerVoices that play it. The preloaded
+        section is played while a voice's disk thread starts reading, so it needs to be
+        longer than the worst-case time that it takes a disk thread to respond - something
+        like 100ms or more is usually a sensible choice.
+
+        Streamed sounds can only be played by SamplerVoices that were given a TimeSliceThread.
+
+        @param name         a name for the sample
+        @param source       the audio to stream. This object takes ownership of the reader, and it
+                            will be used by the voices' disk threads, which take turns to use it.
+                            A MemoryMappedAudioFormatReader which has mapped the whole file is a
+                            good choice, because it can read from any position without seeking
+        @param midiNotes    the set of midi keys that this sound should be played on. This
+                            is used by the SynthesiserSound::appliesToNote() method
+        @param midiNoteForNormalPitch   the midi note at which the sample should be played
+                                        with its natural rate. All other notes will be pitched
+                                        up or down relative to this one
+        @param attackTimeSecs   the attack (fade-in) time, in seconds
+        @param releaseTimeSecs  the decay (fade-out) time, in seconds
+        @param preloadLengthSeconds     the length of audio to keep in memory, in seconds
+    */
+    SamplerSound (const String& name,
+                  std::unique_ptr<AudioFormatReader> source,
+                  const BigInteger& midiNotes,
+                  int midiNoteForNormalPitch,
+                  double attackTimeSecs,
+                  double releaseTimeSecs,
+                  double preloadLengthSeconds);
+
     /** Destructor. */
     ~SamplerSound() override;
 
@@ -78,14 +111,36 @@ public:
     const String& getName() const noexcept                  { return name; }
 
     /** Returns the audio sample data.
-        This could return nullptr if there was a problem loading the data.
+        This could return nullptr if there was a problem loading the data. For a streamed
+        sound, this only contains the section that was preloaded.
     */
     AudioBuffer<float>* getAudioData() const noexcept       { return data.get(); }
 
+    /** Returns true if this sound streams its audio rather than holding it all in memory. */
+    bool isStreaming() const noexcept                       { return reader != nullptr; }
+
     //==============================================================================
     /** Changes the parameters of the ADSR envelope which will be applied to the sample. */
     void setEnvelopeParameters (ADSR::Parameters parametersToUse)    { params = parametersToUse; }
 
+    //==============================================================================
+    /** The kinds of interpolation that a SamplerVoice can use to play a sound at a
+        different pitch.
+    */
+    enum class Interpolation
+    {
+        linear,     /**< Linear interpolation between neighbouring samples. This is the default. */
+        catmullRom  /**< 4-point Catmull-Rom interpolation, which loses less of the high
+                         frequencies and aliases less than linear interpolation, but costs a
+                         little more. */
+    };
+
+    /** Changes the interpolation that voices will use when they play this sound. */
+    void setInterpolation (Interpolation newInterpolation) noexcept  { interpolation = newInterpolation; }
+
+    /** Returns the interpolation that voices will use when they play this sound. */
+    Interpolation getInterpolation() const noexcept                   { return interpolation; }
+
     //==============================================================================
     bool appliesToNote (int midiNoteNumber) override;
     bool appliesToChannel (int midiChannel) override;
@@ -96,11 +151,17 @@ private:
 
     String name;
     std::unique_ptr<AudioBuffer<float>> data;
+    std::unique_ptr<AudioFormatReader> reader;
+    CriticalSection readerLock;
     double sourceSampleRate;
     BigInteger midiNotes;
-    int length = 0, midiRootNote = 0;
+    int64 length = 0;
+    int preloadLength = 0, midiRootNote = 0;
+
+    void readStreamedSamples (float* const*, int numChannels, int64 startSample, int numSamples);
 
     ADSR::Parameters params;
+    Interpolation interpolation = Interpolation::linear;
 
     JUCE_LEAK_DETECTOR (SamplerSound)
 };
@@ -121,9 +182,21 @@ class JUCE_API  SamplerVoice    : public SynthesiserVoice
 {
 public:
     //==============================================================================
-    /** Creates a SamplerVoice. */
+    /** Creates a SamplerVoice which can only play SamplerSounds that are held in memory. */
     SamplerVoice();
 
+    /** Creates a SamplerVoice which can also play streamed SamplerSounds.
+
+        @param diskThread       the thread that will read ahead from the sounds that this voice
+                                plays. Make sure that it's running, and that it won't be deleted
+                                while this voice still exists. Many voices can share a thread, or
+                                they can be spread across a few of them so that disk reads for
+                                different voices can overlap.
+        @param samplesToBuffer  the number of samples that the voice can read ahead of the
+                                playback position. This will be rounded up to a power of two.
+    */
+    explicit SamplerVoice (TimeSliceThread& diskThread, int samplesToBuffer = 32768);
+
     /** Destructor. */
     ~SamplerVoice() override;
 
@@ -141,6 +214,9 @@ public:
 
 private:
     //==============================================================================
+    struct DiskStream;
+    std::unique_ptr<DiskStream> stream;
+
     double pitchRatio = 0;
     double sourceSamplePosition = 0;
     float lgain = 0, rgain = 0;
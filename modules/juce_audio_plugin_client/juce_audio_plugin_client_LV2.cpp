@@ -153,31 +153,26 @@ public:
 
     void setValueFromHost (LV2_URID urid, float value) noexcept
     {
-        const auto it = uridToIndexMap.find (urid);
-
-        if (it == uridToIndexMap.end())
-        {
-            // No such parameter.
-            jassertfalse;
-            return;
-        }
+        if (auto* param = getParamForUrid (urid))
+            setNormalisedValueFromHost (*param, getNormalisedValue (*param, value));
+    }
 
-        if (auto* param = legacyParameters.getParamForIndex ((int) it->second))
-        {
-            const auto scaledValue = [&]
-            {
-                if (auto* rangedParam = dynamic_cast<RangedAudioParameter*> (param))
-                    return rangedParam->convertTo0to1 (value);
+    /*  Used instead of setValueFromHost for changes that happen part-way through a block,
+        when the processor supports sample-accurate automation.
+    */
+    void addEventFromHost (LV2_URID urid, float value, int sampleOffset, ParameterEventList& events)
+    {
+        if (auto* param = getParamForUrid (urid))
+            events.addEvent (*param, getNormalisedValue (*param, value), sampleOffset);
+    }
 
-                return value;
-            }();
+    /*  Leaves each parameter in the list at the value of its last event. */
+    void applyEventsFromHost (ParameterEventList& events) noexcept
+    {
+        for (const auto& event : events)
+            setNormalisedValueFromHost (*event.parameter, event.value);
 
-            if (! approximatelyEqual (scaledValue, param->getValue()))
-            {
-                ScopedValueSetter<bool> scope (ignoreCallbacks, true);
-                param->setValueNotifyingHost (scaledValue);
-            }
-        }
+        events.clear();
     }
 
     struct Options
@@ -205,6 +200,37 @@ public:
     }
 
 private:
+    AudioProcessorParameter* getParamForUrid (LV2_URID urid) const noexcept
+    {
+        const auto it = uridToIndexMap.find (urid);
+
+        if (it == uridToIndexMap.end())
+        {
+            // No such parameter.
+            jassertfalse;
+            return nullptr;
+        }
+
+        return legacyParameters.getParamForIndex ((int) it->second);
+    }
+
+    static float getNormalisedValue (AudioProcessorParameter& param, float value) noexcept
+    {
+        if (auto* rangedParam = dynamic_cast<RangedAudioParameter*> (&param))
+            return rangedParam->convertTo0to1 (value);
+
+        return value;
+    }
+
+    void setNormalisedValueFromHost (AudioProcessorParameter& param, float scaledValue) noexcept
+    {
+        if (! approximatelyEqual (scaledValue, param.getValue()))
+        {
+            ScopedValueSetter<bool> scope (ignoreCallbacks, true);
+            param.setValueNotifyingHost (scaledValue);
+        }
+    }
+
     void audioProcessorParameterChanged (AudioProcessor*, int parameterIndex, float value) override
     {
         if (! ignoreCallbacks)
@@ -540,24 +566,35 @@ public:
         playHead.invalidate();
         audio.setSize (audio.getNumChannels(), static_cast<int> (numSteps), true, false, true);
 
+        const auto sampleAccurate = processor->supportsSampleAccurateAutomation();
+        auto& parameterEvents = processor->getParameterEvents();
+
         ports.forEachInputEvent ([&] (const LV2_Atom_Event* event)
         {
             struct Callback
             {
-                explicit Callback (LV2PluginInstance& s) : self (s) {}
+                Callback (LV2PluginInstance& s, ParameterEventList* e, int64_t frame)
+                    : self (s), events (e), sampleOffset (static_cast<int> (frame)) {}
 
-                void setParameter (LV2_URID property, float value) const noexcept
+                void setParameter (LV2_URID property, float value) const
                 {
-                    self.parameters.setValueFromHost (property, value);
+                    if (events != nullptr && sampleOffset > 0)
+                        self.parameters.addEventFromHost (property, value, sampleOffset, *events);
+                    else
+                        self.parameters.setValueFromHost (property, value);
                 }
 
                 // The host probably shouldn't send us 'touched' messages.
                 void gesture (LV2_URID, bool) const noexcept {}
 
                 LV2PluginInstance& self;
+                ParameterEventList* events;
+                int sampleOffset;
             };
 
-            patchSetHelper.processPatchSet (event, Callback { *this });
+            patchSetHelper.processPatchSet (event, Callback { *this,
+                                                              sampleAccurate ? &parameterEvents : nullptr,
+                                                              event->time.frames });
 
             playHead.readNewInfo (event);
 
@@ -603,6 +640,8 @@ public:
             }
         }
 
+        parameters.applyEventsFromHost (parameterEvents);
+
         for (auto i = 0, end = processor->getTotalNumOutputChannels(); i < end; ++i)
         {
             const auto src = audio.getReadPointer (i);
@@ -3483,6 +3483,8 @@ public:
         };
 
         const auto numParamsChanged = paramChanges.getParameterCount();
+        const auto sampleAccurate = pluginInstance->supportsSampleAccurateAutomation();
+        auto& parameterEvents = pluginInstance->getParameterEvents();
 
         for (Steinberg::int32 i = 0; i < numParamsChanged; ++i)
         {
@@ -3502,15 +3504,42 @@ public:
                 }
                 else
                #endif
-                if (const auto change = getPointFromQueue (paramQueue, numPoints - 1))
+                if (auto* param = comPluginInstance->getParamForVSTParamID (vstParamID))
                 {
-                    if (auto* param = comPluginInstance->getParamForVSTParamID (vstParamID))
+                    if (sampleAccurate)
+                    {
+                        // Apply the changes at the start of the block now, and pass the rest on
+                        for (Steinberg::int32 point = 0; point < numPoints; ++point)
+                        {
+                            if (const auto change = getPointFromQueue (paramQueue, point))
+                            {
+                                if (change->offsetSamples <= 0)
+                                    setValueAndNotifyIfChanged (*param, (float) change->value);
+                                else
+                                    parameterEvents.addEvent (*param, (float) change->value, change->offsetSamples);
+                            }
+                        }
+                    }
+                    else if (const auto change = getPointFromQueue (paramQueue, numPoints - 1))
+                    {
                         setValueAndNotifyIfChanged (*param, (float) change->value);
+                    }
                 }
             }
         }
     }
 
+    void applyParameterEvents()
+    {
+        auto& parameterEvents = pluginInstance->getParameterEvents();
+
+        // Leave each parameter at the value of its last automation point
+        for (const auto& event : parameterEvents)
+            setValueAndNotifyIfChanged (*event.parameter, event.value);
+
+        parameterEvents.clear();
+    }
+
     void addParameterChangeToMidiBuffer (const Steinberg::int32 offsetSamples, const Vst::ParamID id, const double value)
     {
         // If the parameter is mapped to a MIDI CC message then insert it into the midiBuffer.
@@ -3573,7 +3602,10 @@ public:
 
             if ((pluginInstance->getTotalNumInputChannels() + pluginInstance->getTotalNumOutputChannels()) > 0
                  && (numInputChans + numOutputChans) == 0)
+            {
+                applyParameterEvents();
                 return kResultFalse;
+            }
         }
 
         // If all of these are zero, the host is attempting to flush parameters without processing audio.
@@ -3584,6 +3616,8 @@ public:
             else jassertfalse;
         }
 
+        applyParameterEvents();
+
         if (auto* changes = data.outputParameterChanges)
         {
             comPluginInstance->forAllChangedParameters ([&] (Vst::ParamID paramID, float value)
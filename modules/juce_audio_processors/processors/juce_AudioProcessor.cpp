@@ -368,6 +368,10 @@ void AudioProcessor::setRateAndBufferSizeDetails (double newSampleRate, int newB
 {
     currentSampleRate = newSampleRate;
     blockSize = newBlockSize;
+
+    // Leave room for a few automation points per parameter, so that hosts can fill
+    // the list without allocating on the audio thread.
+    parameterEvents.ensureSize (jmax (128, flatParameterList.size() * 4));
 }
 
 //==============================================================================
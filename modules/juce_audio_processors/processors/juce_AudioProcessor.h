@@ -727,6 +727,48 @@ public:
     */
     AudioPlayHead* getPlayHead() const noexcept                 { return playHead; }
 
+    //==============================================================================
+    /** Returns true if the processor wants to receive every automation point that
+        the host sends during a block, rather than just the final value.
+
+        If this returns false (the default), the plugin wrappers set each automated
+        parameter to its last value before calling processBlock(), as they always have.
+
+        If it returns true, the wrappers only apply the changes that happen at the very
+        start of the block before calling processBlock(). The later changes are put into
+        the list returned by getParameterEvents(), and it's up to processBlock() to apply
+        them at the right positions, e.g. by using ParameterEventList::forEachSubBlock().
+        Once processBlock() has returned, the wrapper sets the parameters to their final
+        values, so you shouldn't change the parameters yourself.
+
+        This lets a processor run with large blocks without losing automation resolution.
+
+        @see getParameterEvents
+    */
+    virtual bool supportsSampleAccurateAutomation() const       { return false; }
+
+    /** Returns the parameter changes that happen during the block that's currently
+        being processed.
+
+        You can ONLY use this from your processBlock() method. The list's sample positions
+        are relative to the start of the buffer passed to processBlock(). Unless
+        supportsSampleAccurateAutomation() returns true, it'll normally be empty.
+
+        If you're hosting a processor, you can add events to this list before calling
+        processBlock(). In that case, you need to clear it again afterwards, and set the
+        parameters to their final values yourself. An AudioProcessorGraph passes any
+        events for its nodes' parameters on to those nodes.
+
+        @see supportsSampleAccurateAutomation, ParameterEventList
+    */
+    ParameterEventList& getParameterEvents() noexcept                   { return parameterEvents; }
+
+    /** Returns the parameter changes that happen during the block that's currently
+        being processed.
+        @see supportsSampleAccurateAutomation, ParameterEventList
+    */
+    const ParameterEventList& getParameterEvents() const noexcept       { return parameterEvents; }
+
     //==============================================================================
     /** Returns the total number of input channels.
 
@@ -1538,6 +1580,7 @@ private:
 
     AudioProcessorParameterGroup parameterTree;
     Array<AudioProcessorParameter*> flatParameterList;
+    ParameterEventList parameterEvents;
 
     AudioProcessorParameter* getParamChecked (int) const;
 
@@ -513,9 +513,13 @@ struct GraphRenderSequence
         GlobalIO globalIO;
         AudioPlayHead* audioPlayHead;
         int numSamples;
+        const ParameterEventList& parameterEvents;
     };
 
-    void perform (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages, AudioPlayHead* audioPlayHead)
+    void perform (AudioBuffer<FloatType>& buffer,
+                  MidiBuffer& midiMessages,
+                  const ParameterEventList& parameterEvents,
+                  AudioPlayHead* audioPlayHead)
     {
         auto numSamples = buffer.getNumSamples();
         auto maxSamples = renderingBuffer.getNumSamples();
@@ -531,10 +535,12 @@ struct GraphRenderSequence
                 AudioBuffer<FloatType> audioChunk (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), chunkStartSample, chunkSize);
                 midiChunk.clear();
                 midiChunk.addEvents (midiMessages, chunkStartSample, chunkSize, -chunkStartSample);
+                parameterEventChunk.clear();
+                parameterEventChunk.addEvents (parameterEvents, chunkStartSample, chunkSize, -chunkStartSample);
 
                 // Splitting up the buffer like this will cause the play head and host time to be
                 // invalid for all but the first chunk...
-                perform (audioChunk, midiChunk, audioPlayHead);
+                perform (audioChunk, midiChunk, parameterEventChunk, audioPlayHead);
 
                 chunkStartSample += maxSamples;
             }
@@ -552,7 +558,8 @@ struct GraphRenderSequence
                                       midiMessages,
                                       currentMidiOutputBuffer },
                                     audioPlayHead,
-                                    numSamples };
+                                    numSamples,
+                                    parameterEvents };
 
             for (const auto& op : renderOps)
                 op->process (context);
@@ -804,6 +811,8 @@ struct GraphRenderSequence
         for (auto&& m : midiBuffers)
             m.ensureSize (defaultMIDIBufferSize);
 
+        parameterEventChunk.ensureSize (128);
+
         for (const auto& op : renderOps)
             op->prepare (renderingBuffer.getArrayOfWritePointers(), midiBuffers.data());
     }
@@ -816,6 +825,7 @@ struct GraphRenderSequence
 
     Array<MidiBuffer> midiBuffers;
     MidiBuffer midiChunk;
+    ParameterEventList parameterEventChunk;
 
 private:
     //==============================================================================
@@ -871,11 +881,33 @@ private:
             }
             else
             {
+                const auto hasParameterEvents = addParameterEventsForNode (c.parameterEvents);
                 const auto bypass = node->isBypassed() && processor.getBypassParameter() == nullptr;
                 processWithBuffer (c.globalIO, bypass, buffer, *midiBuffer);
+
+                if (hasParameterEvents)
+                    processor.getParameterEvents().clear();
             }
         }
 
+        /*  Passes on the graph's events for this node's parameters. Setting the parameters'
+            final values is left to whoever filled in the graph's list.
+        */
+        bool addParameterEventsForNode (const ParameterEventList& graphEvents)
+        {
+            if (graphEvents.isEmpty())
+                return false;
+
+            auto& nodeEvents = processor.getParameterEvents();
+            const auto& nodeParameters = processor.getParameters();
+
+            for (const auto& event : graphEvents)
+                if (nodeParameters[event.parameter->getParameterIndex()] == event.parameter)
+                    nodeEvents.addEvent (event);
+
+            return ! nodeEvents.isEmpty();
+        }
+
         virtual void processWithBuffer (const GlobalIO&, bool bypass, AudioBuffer<FloatType>& audio, MidiBuffer& midi) = 0;
 
         const Node::Ptr node;
@@ -1518,10 +1550,10 @@ public:
     }
 
     template <typename FloatType>
-    void process (AudioBuffer<FloatType>& audio, MidiBuffer& midi, AudioPlayHead* playHead)
+    void process (AudioBuffer<FloatType>& audio, MidiBuffer& midi, const ParameterEventList& parameterEvents, AudioPlayHead* playHead)
     {
         if (auto* s = std::get_if<GraphRenderSequence<FloatType>> (&sequence.sequence))
-            s->perform (audio, midi, playHead);
+            s->perform (audio, midi, parameterEvents, playHead);
         else
             jassertfalse; // Not prepared for this audio format!
     }
@@ -1864,7 +1896,7 @@ public:
         // Only process if the graph has the correct blockSize, sampleRate etc.
         if (state != nullptr && state->getSettings() == nodeStates.getLastRequestedSettings())
         {
-            state->process (audio, midi, playHead);
+            state->process (audio, midi, owner->getParameterEvents(), playHead);
         }
         else
         {
@@ -2233,6 +2265,30 @@ public:
             // this graph, so we just want to make sure that we finish the test without timing out.
             logMessage ("render sequence built in " + String (duration) + " ms");
         }
+
+        beginTest ("parameter events are passed on to the nodes that own the parameters");
+        {
+            AudioProcessorGraph graph;
+            auto* recorder = new EventRecordingProcessor;
+            graph.addNode (std::unique_ptr<AudioProcessor> (recorder));
+            graph.prepareToPlay (44100.0, 32);
+
+            AudioParameterFloat unrelated { "unrelated", "Unrelated", 0.0f, 1.0f, 0.0f };
+
+            auto& events = graph.getParameterEvents();
+            events.addEvent (*recorder->param, 0.25f, 4);
+            events.addEvent (unrelated, 0.5f, 10);
+            events.addEvent (*recorder->param, 0.75f, 40);
+
+            AudioBuffer<float> audio (2, 64);
+            MidiBuffer midi;
+            graph.processBlock (audio, midi);
+            events.clear();
+
+            // The block is bigger than the graph was prepared for, so it's rendered in two halves
+            expect (recorder->received == std::vector<std::pair<int, float>> { { 4, 0.25f }, { 8, 0.75f } });
+            expect (recorder->getParameterEvents().isEmpty());
+        }
     }
 
 private:
@@ -2291,6 +2347,46 @@ private:
         MidiIn midiIn;
         MidiOut midiOut;
     };
+
+    class EventRecordingProcessor final : public AudioProcessor
+    {
+    public:
+        EventRecordingProcessor()
+        {
+            addParameter (param = new AudioParameterFloat ("param", "Param", 0.0f, 1.0f, 0.0f));
+        }
+
+        const String getName() const override                         { return "Event Recorder"; }
+        double getTailLengthSeconds() const override                  { return {}; }
+        bool acceptsMidi() const override                             { return {}; }
+        bool producesMidi() const override                            { return {}; }
+        AudioProcessorEditor* createEditor() override                 { return {}; }
+        bool hasEditor() const override                               { return {}; }
+        int getNumPrograms() override                                 { return 1; }
+        int getCurrentProgram() override                              { return {}; }
+        void setCurrentProgram (int) override                         {}
+        const String getProgramName (int) override                    { return {}; }
+        void changeProgramName (int, const String&) override          {}
+        void getStateInformation (juce::MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override          {}
+        void prepareToPlay (double, int) override                     {}
+        void releaseResources() override                              {}
+        bool supportsSampleAccurateAutomation() const override        { return true; }
+
+        void processBlock (AudioBuffer<float>& audio, MidiBuffer&) override
+        {
+            getParameterEvents().forEachSubBlock (audio.getNumSamples(), [&] (const auto& subBlock)
+            {
+                for (const auto& event : subBlock)
+                    received.emplace_back (subBlock.startSample, event.value);
+            });
+        }
+
+        using AudioProcessor::processBlock;
+
+        AudioParameterFloat* param = nullptr;
+        std::vector<std::pair<int, float>> received;
+    };
 };
 
 static AudioProcessorGraphTests audioProcessorGraphTests;
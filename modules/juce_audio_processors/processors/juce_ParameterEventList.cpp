@@ -0,0 +1,245 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+const ParameterEventList::Event& ParameterEventList::getEvent (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, getNumEvents()));
+    sortIfNeeded();
+    return events[(size_t) index];
+}
+
+void ParameterEventList::addEvent (AudioProcessorParameter& parameter, float newValue, int sampleOffset)
+{
+    addEvent ({ &parameter, newValue, sampleOffset });
+}
+
+void ParameterEventList::addEvent (const Event& event)
+{
+    // Events can't happen before the start of the block!
+    jassert (event.sampleOffset >= 0);
+    jassert (event.parameter != nullptr);
+
+    if (events.size() >= events.capacity())
+    {
+        // The list is full, so this event has been lost! If you're filling the list
+        // yourself, call ensureSize() with a bigger number before processing starts.
+        jassertfalse;
+        return;
+    }
+
+    if (! events.empty() && event.sampleOffset < events.back().sampleOffset)
+        needsSorting = true;
+
+    events.push_back (event);
+}
+
+void ParameterEventList::addEvents (const ParameterEventList& otherList,
+                                    int startSample,
+                                    int numSamples,
+                                    int sampleDeltaToAdd)
+{
+    for (const auto& event : otherList)
+    {
+        if (event.sampleOffset < startSample)
+            continue;
+
+        if (numSamples >= 0 && event.sampleOffset >= startSample + numSamples)
+            break;
+
+        addEvent ({ event.parameter, event.value, event.sampleOffset + sampleDeltaToAdd });
+    }
+}
+
+void ParameterEventList::ensureSize (int maxNumEvents)
+{
+    events.reserve ((size_t) jmax (0, maxNumEvents));
+    scratch.resize (events.capacity());
+}
+
+void ParameterEventList::sortIfNeeded() const noexcept
+{
+    if (! needsSorting)
+        return;
+
+    needsSorting = false;
+
+    // This is a natural merge sort, which is stable and only needs the preallocated
+    // scratch space. Hosts send the points for each parameter in order, so the list is
+    // made of a few sorted runs, and each pass halves the number of them.
+    const auto num = events.size();
+    const auto compare = [] (const Event& a, const Event& b) { return a.sampleOffset < b.sampleOffset; };
+
+    const auto findEndOfRun = [&] (const Event* list, size_t start)
+    {
+        auto end = jmin (start + 1, num);
+
+        while (end < num && ! compare (list[end], list[end - 1]))
+            ++end;
+
+        return end;
+    };
+
+    jassert (scratch.size() >= num);
+    auto* source = events.data();
+    auto* dest = scratch.data();
+
+    for (;;)
+    {
+        int numRuns = 0;
+
+        for (size_t start = 0; start < num; ++numRuns)
+        {
+            const auto middle = findEndOfRun (source, start);
+            const auto end = findEndOfRun (source, middle);
+
+            std::merge (source + start, source + middle, source + middle, source + end, dest + start, compare);
+            start = end;
+        }
+
+        std::swap (source, dest);
+
+        if (numRuns <= 1)
+            break;
+    }
+
+    if (source != events.data())
+        std::copy (source, source + num, events.data());
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ParameterEventListTests final : public UnitTest
+{
+public:
+    ParameterEventListTests()
+        : UnitTest ("ParameterEventList", UnitTestCategories::audioProcessorParameters)
+    {}
+
+    void runTest() override
+    {
+        AudioParameterFloat a { "a", "A", 0.0f, 1.0f, 0.0f },
+                            b { "b", "B", 0.0f, 1.0f, 0.0f };
+
+        beginTest ("Events are kept in order of position");
+        {
+            ParameterEventList list;
+            list.ensureSize (8);
+
+            list.addEvent (a, 0.1f, 100);
+            list.addEvent (b, 0.2f, 10);
+            list.addEvent (a, 0.3f, 100);
+            list.addEvent (b, 0.4f, 0);
+
+            expectEquals (list.getNumEvents(), 4);
+            expectEquals (list.getEvent (0).sampleOffset, 0);
+            expectEquals (list.getEvent (1).sampleOffset, 10);
+            expectEquals (list.getEvent (2).value, 0.1f);
+            expectEquals (list.getEvent (3).value, 0.3f);
+
+            ParameterEventList chunk;
+            chunk.ensureSize (8);
+            chunk.addEvents (list, 10, 90, -10);
+            expectEquals (chunk.getNumEvents(), 1);
+            expect (chunk.getEvent (0).parameter == &b);
+            expectEquals (chunk.getEvent (0).sampleOffset, 0);
+
+            list.clear();
+            expect (list.isEmpty());
+        }
+
+        beginTest ("Events added in runs, like a host's parameter queues, are merged in order");
+        {
+            ParameterEventList list;
+            list.ensureSize (200);
+
+            Random random (12345);
+
+            for (int run = 0; run < 7; ++run)
+                for (int position = random.nextInt (10); position < 500; position += 10 + random.nextInt (50))
+                    list.addEvent (run % 2 == 0 ? a : b, (float) run / 10.0f, position);
+
+            expectGreaterThan (list.getNumEvents(), 40);
+
+            // Events at the same position keep the order in which they were added
+            for (int i = 1; i < list.getNumEvents(); ++i)
+            {
+                const auto& previous = list.getEvent (i - 1);
+                const auto& event = list.getEvent (i);
+
+                expect (previous.sampleOffset < event.sampleOffset
+                         || (previous.sampleOffset == event.sampleOffset && previous.value <= event.value));
+            }
+        }
+
+        beginTest ("Sub-blocks cover the block and start at the events");
+        {
+            ParameterEventList list;
+            list.ensureSize (8);
+            list.addEvent (a, 0.5f, 16);
+            list.addEvent (b, 0.5f, 16);
+            list.addEvent (a, 1.0f, 20);
+            list.addEvent (a, 0.0f, 200);
+
+            Array<int> starts, lengths, counts;
+
+            const auto collect = [&] (const ParameterEventList::SubBlock& subBlock)
+            {
+                starts.add (subBlock.startSample);
+                lengths.add (subBlock.numSamples);
+                counts.add ((int) std::distance (subBlock.begin(), subBlock.end()));
+
+                for (const auto& event : subBlock)
+                    expect (event.sampleOffset >= subBlock.startSample);
+            };
+
+            list.forEachSubBlock (64, collect);
+            expect (starts  == Array<int> { 0, 16, 20 });
+            expect (lengths == Array<int> { 16, 4, 44 });
+            expect (counts  == Array<int> { 0, 2, 1 });
+
+            starts.clear(); lengths.clear(); counts.clear();
+            list.forEachSubBlock (64, collect, 8);
+            expect (starts  == Array<int> { 0, 16 });
+            expect (lengths == Array<int> { 16, 48 });
+            expect (counts  == Array<int> { 0, 3 });
+
+            starts.clear(); lengths.clear(); counts.clear();
+            ParameterEventList().forEachSubBlock (64, collect);
+            expect (starts  == Array<int> { 0 });
+            expect (lengths == Array<int> { 64 });
+        }
+    }
+};
+
+static ParameterEventListTests parameterEventListTests;
+
+#endif
+
+} // namespace juce
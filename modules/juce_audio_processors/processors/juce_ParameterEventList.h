@@ -0,0 +1,208 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A time-ordered list of parameter changes that happen during one audio block.
+
+    Each AudioProcessor has one of these, which is returned by
+    AudioProcessor::getParameterEvents(). If the processor returns true from
+    AudioProcessor::supportsSampleAccurateAutomation(), the plugin wrappers use it to
+    pass on every automation point that the host sends, rather than just the last one,
+    so that the processor can apply each change at the right sample.
+
+    The easiest way to use the events is to let forEachSubBlock() split the block up
+    at the points where parameters change:
+
+    @code
+    void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+    {
+        getParameterEvents().forEachSubBlock (buffer.getNumSamples(), [&] (const auto& subBlock)
+        {
+            for (auto& event : subBlock)
+                if (event.parameter == gainParameter)
+                    gain = gainParameter->convertFrom0to1 (event.value);
+
+            buffer.applyGain (subBlock.startSample, subBlock.numSamples, gain);
+        });
+    }
+    @endcode
+
+    The storage is preallocated when the processor is prepared, and adding events never
+    allocates, so the list can be filled on the audio thread.
+
+    @see AudioProcessor::getParameterEvents, AudioProcessor::supportsSampleAccurateAutomation
+
+    @tags{Audio}
+*/
+class JUCE_API  ParameterEventList
+{
+public:
+    //==============================================================================
+    /** A change to a parameter's value. */
+    struct Event
+    {
+        /** The parameter that changes. */
+        AudioProcessorParameter* parameter = nullptr;
+
+        /** The new normalised value, in the range 0 to 1. */
+        float value = 0.0f;
+
+        /** The position in the block at which the parameter takes the new value. */
+        int sampleOffset = 0;
+    };
+
+    /** A section of a block, and the events that happen at its start.
+        @see forEachSubBlock
+    */
+    struct SubBlock
+    {
+        /** The position of the section within the block. */
+        int startSample = 0;
+
+        /** The length of the section. */
+        int numSamples = 0;
+
+        /** The events that should be applied before processing the section. */
+        const Event* begin() const noexcept     { return firstEvent; }
+        const Event* end() const noexcept       { return lastEvent; }
+
+        const Event* firstEvent = nullptr;
+        const Event* lastEvent = nullptr;
+    };
+
+    //==============================================================================
+    /** Creates an empty list. */
+    ParameterEventList() = default;
+
+    /** Removes all the events. This doesn't free the list's storage. */
+    void clear() noexcept                           { events.clear(); needsSorting = false; }
+
+    /** Returns true if there are no events in the list. */
+    bool isEmpty() const noexcept                   { return events.empty(); }
+
+    /** Returns the number of events in the list. */
+    int getNumEvents() const noexcept               { return (int) events.size(); }
+
+    /** Returns one of the events. The index must be in range. */
+    const Event& getEvent (int index) const noexcept;
+
+    /** Adds an event to the list.
+
+        The events are read back in order of sample position. If the new event has the
+        same position as events that are already in the list, it comes after them.
+
+        This never allocates. If the list already holds as many events as ensureSize()
+        made room for, the new event is dropped.
+    */
+    void addEvent (AudioProcessorParameter& parameter, float newValue, int sampleOffset);
+
+    /** Adds an event to the list. @see addEvent */
+    void addEvent (const Event& event);
+
+    /** Adds some of the events from another list to this one.
+
+        @param otherList            the list containing the events you want to add
+        @param startSample          events before this position are ignored
+        @param numSamples           events at or after (startSample + numSamples) are ignored.
+                                    If this is less than 0, all events after startSample are taken
+        @param sampleDeltaToAdd     a value which is added to the positions of the events
+                                    that are added to this list
+    */
+    void addEvents (const ParameterEventList& otherList,
+                    int startSample,
+                    int numSamples,
+                    int sampleDeltaToAdd);
+
+    /** Preallocates room for a number of events. This is the most that the list can
+        hold, as adding events never allocates any memory.
+    */
+    void ensureSize (int maxNumEvents);
+
+    //==============================================================================
+    /** Splits a block into sections at the points where parameters change, and calls
+        a function for each of them in turn.
+
+        The callback is passed a SubBlock, which gives the range of samples to process
+        and the events to apply before processing them. The sections are contiguous and
+        cover the whole block, so the first section is the one before the first event,
+        and its list of events will usually be empty.
+
+        @param numSamples           the length of the block
+        @param callback             a function taking a const SubBlock&
+        @param minimumSubBlockSize  if this is greater than 1, events that fall closer than
+                                    this to the start of a section are moved to the start
+                                    of that section, so that no section (apart from the
+                                    last one) is shorter than this. This keeps the
+                                    per-section overhead down when there's dense
+                                    automation, at the expense of some timing accuracy.
+    */
+    template <typename Callback>
+    void forEachSubBlock (int numSamples, Callback&& callback, int minimumSubBlockSize = 1) const
+    {
+        sortIfNeeded();
+
+        const auto* event = events.data();
+        const auto* const lastEvent = event + events.size();
+        const auto stride = jmax (1, minimumSubBlockSize);
+
+        for (int start = 0; start < numSamples;)
+        {
+            const auto* const first = event;
+
+            while (event != lastEvent && event->sampleOffset < start + stride)
+                ++event;
+
+            const auto next = event != lastEvent ? jmin (event->sampleOffset, numSamples)
+                                                 : numSamples;
+
+            callback (SubBlock { start, next - start, first, event });
+            start = next;
+        }
+    }
+
+    //==============================================================================
+    /** Returns a pointer to the first event. */
+    const Event* begin() const noexcept             { sortIfNeeded(); return events.data(); }
+
+    /** Returns a pointer just past the last event. */
+    const Event* end() const noexcept               { return events.data() + events.size(); }
+
+private:
+    //==============================================================================
+    void sortIfNeeded() const noexcept;
+
+    // Events are appended as they arrive, and only sorted the first time they're read
+    // after one has been added out of order, so the lists are mutable
+    mutable std::vector<Event> events, scratch;
+    mutable bool needsSorting = false;
+
+    JUCE_LEAK_DETECTOR (ParameterEventList)
+};
+
+} // namespace juce
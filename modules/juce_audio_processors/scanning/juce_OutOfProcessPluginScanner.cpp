@@ -0,0 +1,381 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+static const char* const pluginScanWorkerID = "jucePluginScanWorker";
+
+//==============================================================================
+class OutOfProcessPluginScanner::WorkerConnection final : private ChildProcessCoordinator
+{
+public:
+    WorkerConnection() = default;
+
+    bool launch (const File& executable)
+    {
+        // The worker's output isn't read, so don't let it fill up a pipe
+        return launchWorkerProcess (executable, pluginScanWorkerID, 0, 0);
+    }
+
+    bool sendRequest (const String& formatName, const String& fileOrIdentifier)
+    {
+        {
+            const std::lock_guard<std::mutex> lock (mutex);
+            response.reset();
+        }
+
+        MemoryBlock block;
+
+        {
+            MemoryOutputStream stream (block, false);
+            stream.writeString (formatName);
+            stream.writeString (fileOrIdentifier);
+        }
+
+        return ! connectionLost && sendMessageToWorker (block);
+    }
+
+    enum class State { waiting, gotResponse, connectionLost };
+
+    /*  Waits up to the given time for the worker to reply to the last request. */
+    State waitForResponse (int timeoutMs, std::unique_ptr<XmlElement>& responseXml)
+    {
+        std::unique_lock<std::mutex> lock (mutex);
+
+        if (! condition.wait_for (lock, std::chrono::milliseconds (timeoutMs), [this] { return response != nullptr || connectionLost; }))
+            return State::waiting;
+
+        if (response != nullptr)
+        {
+            responseXml = std::move (response);
+            return State::gotResponse;
+        }
+
+        return State::connectionLost;
+    }
+
+    bool isConnected() const noexcept       { return ! connectionLost; }
+
+private:
+    void handleMessageFromWorker (const MemoryBlock& block) override
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+        response = parseXMLIfTagMatches (block.toString(), "RESULT");
+        condition.notify_all();
+    }
+
+    void handleConnectionLost() override
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+        connectionLost = true;
+        condition.notify_all();
+    }
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::unique_ptr<XmlElement> response;
+    std::atomic<bool> connectionLost { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WorkerConnection)
+};
+
+//==============================================================================
+OutOfProcessPluginScanner::OutOfProcessPluginScanner()
+    : OutOfProcessPluginScanner (Options())
+{
+}
+
+OutOfProcessPluginScanner::OutOfProcessPluginScanner (const Options& optionsToUse)
+    : options (optionsToUse)
+{
+    if (options.cacheFile.existsAsFile())
+        cache.loadFromFile (options.cacheFile);
+}
+
+OutOfProcessPluginScanner::~OutOfProcessPluginScanner()
+{
+    scanFinished();
+}
+
+bool OutOfProcessPluginScanner::findPluginTypesFor (AudioPluginFormat& format,
+                                                    OwnedArray<PluginDescription>& result,
+                                                    const String& fileOrIdentifier)
+{
+    auto scanResult = cache.getResult (format.getName(), fileOrIdentifier);
+
+    // a crash or a timeout might just have been bad luck, so never trust those results
+    if (scanResult.has_value() && scanResult->wasInterrupted)
+        scanResult.reset();
+
+    if (scanResult.has_value())
+    {
+        for (const auto& type : scanResult->types)
+        {
+            if (! format.doesPluginStillExist (type))
+            {
+                scanResult.reset();
+                break;
+            }
+        }
+    }
+
+    if (! scanResult.has_value())
+    {
+        auto worker = acquireWorker();
+
+        if (worker == nullptr)
+        {
+            // The worker process couldn't be launched! Make sure that your executable creates
+            // an OutOfProcessPluginScanner::Worker and calls its initialiseFromCommandLine()
+            // method when it starts up.
+            jassertfalse;
+            format.findAllTypesForFile (result, fileOrIdentifier);
+            return true;
+        }
+
+        scanResult = scanInWorker (*worker, format, fileOrIdentifier);
+
+        // Only hang on to workers that are still in a fit state to be reused
+        const auto keepWorker = scanResult.has_value() && scanResult->succeeded && worker->isConnected();
+        releaseWorker (keepWorker ? std::move (worker) : nullptr);
+
+        if (! scanResult.has_value())
+            return true;
+
+        cache.addResult (format.getName(), fileOrIdentifier, *scanResult);
+    }
+
+    for (const auto& type : scanResult->types)
+        result.add (new PluginDescription (type));
+
+    return scanResult->succeeded;
+}
+
+std::optional<PluginScanCache::Result> OutOfProcessPluginScanner::scanInWorker (WorkerConnection& worker,
+                                                                                 AudioPluginFormat& format,
+                                                                                 const String& fileOrIdentifier)
+{
+    PluginScanCache::Result interrupted;
+    interrupted.wasInterrupted = true;
+
+    if (! worker.sendRequest (format.getName(), fileOrIdentifier))
+        return interrupted;
+
+    const auto startTime = Time::getMillisecondCounter();
+
+    for (;;)
+    {
+        if (shouldExit())
+            return {};
+
+        std::unique_ptr<XmlElement> xml;
+
+        switch (worker.waitForResponse (50, xml))
+        {
+            case WorkerConnection::State::gotResponse:
+            {
+                PluginScanCache::Result result;
+                result.succeeded = true;
+
+                for (auto* typeXml : xml->getChildIterator())
+                {
+                    PluginDescription type;
+
+                    if (type.loadFromXml (*typeXml))
+                        result.types.add (type);
+                }
+
+                return result;
+            }
+
+            case WorkerConnection::State::connectionLost:
+                return interrupted;
+
+            case WorkerConnection::State::waiting:
+                if ((int) (Time::getMillisecondCounter() - startTime) > options.timeoutMs)
+                    return interrupted;
+
+                break;
+        }
+    }
+}
+
+std::unique_ptr<OutOfProcessPluginScanner::WorkerConnection> OutOfProcessPluginScanner::acquireWorker()
+{
+    {
+        std::unique_lock<std::mutex> lock (workerMutex);
+
+        workerAvailable.wait (lock, [this]
+        {
+            return ! idleWorkers.empty() || numWorkersInUse < jmax (1, options.maxNumWorkers);
+        });
+
+        ++numWorkersInUse;
+
+        while (! idleWorkers.empty())
+        {
+            auto worker = std::move (idleWorkers.back());
+            idleWorkers.pop_back();
+
+            if (worker->isConnected())
+                return worker;
+        }
+    }
+
+    auto worker = std::make_unique<WorkerConnection>();
+
+    if (worker->launch (options.workerExecutable))
+        return worker;
+
+    releaseWorker (nullptr);
+    return nullptr;
+}
+
+void OutOfProcessPluginScanner::releaseWorker (std::unique_ptr<WorkerConnection> worker)
+{
+    {
+        const std::lock_guard<std::mutex> lock (workerMutex);
+        --numWorkersInUse;
+
+        if (worker != nullptr)
+            idleWorkers.push_back (std::move (worker));
+    }
+
+    workerAvailable.notify_one();
+}
+
+void OutOfProcessPluginScanner::scanFinished()
+{
+    std::vector<std::unique_ptr<WorkerConnection>> workersToShutDown;
+
+    {
+        const std::lock_guard<std::mutex> lock (workerMutex);
+        std::swap (workersToShutDown, idleWorkers);
+    }
+
+    workersToShutDown.clear();
+
+    if (options.cacheFile != File())
+        cache.saveToFile (options.cacheFile);
+}
+
+//==============================================================================
+OutOfProcessPluginScanner::Worker::Worker()
+{
+    formatManager.addDefaultFormats();
+}
+
+OutOfProcessPluginScanner::Worker::~Worker()
+{
+    cancelPendingUpdate();
+}
+
+bool OutOfProcessPluginScanner::Worker::initialiseFromCommandLine (const String& commandLine)
+{
+    return ChildProcessWorker::initialiseFromCommandLine (commandLine, pluginScanWorkerID);
+}
+
+void OutOfProcessPluginScanner::Worker::handleMessageFromCoordinator (const MemoryBlock& block)
+{
+    if (block.isEmpty())
+        return;
+
+    const auto formatName = MemoryInputStream (block, false).readString();
+
+    for (auto* format : formatManager.getFormats())
+    {
+        if (format->getName() == formatName)
+        {
+            if (MessageManager::getInstance()->isThisTheMessageThread()
+                 || format->requiresUnblockedMessageThreadDuringCreation ({}))
+            {
+                scanAndReply (block);
+                return;
+            }
+
+            break;
+        }
+    }
+
+    // Most formats need to be loaded on the message thread
+    {
+        const std::lock_guard<std::mutex> lock (mutex);
+        pendingRequests.push (block);
+    }
+
+    triggerAsyncUpdate();
+}
+
+void OutOfProcessPluginScanner::Worker::handleAsyncUpdate()
+{
+    for (;;)
+    {
+        MemoryBlock block;
+
+        {
+            const std::lock_guard<std::mutex> lock (mutex);
+
+            if (pendingRequests.empty())
+                return;
+
+            block = std::move (pendingRequests.front());
+            pendingRequests.pop();
+        }
+
+        scanAndReply (block);
+    }
+}
+
+void OutOfProcessPluginScanner::Worker::scanAndReply (const MemoryBlock& block)
+{
+    MemoryInputStream stream (block, false);
+    const auto formatName = stream.readString();
+    const auto fileOrIdentifier = stream.readString();
+
+    OwnedArray<PluginDescription> types;
+
+    for (auto* format : formatManager.getFormats())
+        if (format->getName() == formatName)
+            format->findAllTypesForFile (types, fileOrIdentifier);
+
+    XmlElement xml ("RESULT");
+
+    for (auto* type : types)
+        xml.addChildElement (type->createXml().release());
+
+    const auto text = xml.toString (XmlElement::TextFormat().singleLine());
+    sendMessageToCoordinator ({ text.toRawUTF8(), text.getNumBytesAsUTF8() });
+}
+
+void OutOfProcessPluginScanner::Worker::handleConnectionLost()
+{
+    // The scanner has either finished with this worker, or given up on it because a
+    // plugin has hung. In the second case the message thread may be stuck inside the
+    // plugin, so there's no point trying to shut down cleanly.
+    Process::terminate();
+}
+
+} // namespace juce
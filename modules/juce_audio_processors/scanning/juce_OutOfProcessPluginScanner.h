@@ -0,0 +1,173 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A KnownPluginList::CustomScanner that loads each plugin in a separate worker
+    process, so that plugins which crash or hang can't take the host down with them.
+
+    The scanner keeps a pool of worker processes. Each call to findPluginTypesFor()
+    borrows an idle worker, or launches a new one if fewer than the maximum are
+    running, so when a KnownPluginList is scanned from several threads at once (e.g.
+    by a PluginListComponent with more than one scanning thread, or by several threads
+    calling PluginDirectoryScanner::scanNextFile()), that many plugins are loaded in
+    parallel. A worker that crashes, or takes longer than the timeout, is discarded
+    and the plugin is blacklisted. That plugin is scanned again the next time the
+    scanner is asked about it, because the problem may only have been caused by the
+    machine being busy.
+
+    Results are stored in a PluginScanCache, so that plugins whose files haven't
+    changed since they were last scanned are never loaded again.
+
+    The worker processes are normally started from the host's own executable, which
+    needs to check its command line on startup and run as a worker if asked to:
+
+    @code
+    void initialise (const String& commandLine) override
+    {
+        auto worker = std::make_unique<OutOfProcessPluginScanner::Worker>();
+
+        if (worker->initialiseFromCommandLine (commandLine))
+        {
+            scannerWorker = std::move (worker);
+            return;
+        }
+
+        // ...normal startup...
+        knownPluginList.setCustomScanner (std::make_unique<OutOfProcessPluginScanner>());
+    }
+    @endcode
+
+    @tags{Audio}
+*/
+class JUCE_API  OutOfProcessPluginScanner  : public KnownPluginList::CustomScanner
+{
+public:
+    //==============================================================================
+    /** The settings for a scanner. */
+    struct Options
+    {
+        /** The executable to launch as a worker. It must create a Worker and call its
+            initialiseFromCommandLine() method when it starts up.
+        */
+        File workerExecutable = File::getSpecialLocation (File::currentExecutableFile);
+
+        /** The maximum number of worker processes to run at once. */
+        int maxNumWorkers = SystemStats::getNumCpus();
+
+        /** How long a worker can spend on one plugin before it's considered to have hung. */
+        int timeoutMs = 30000;
+
+        /** If this isn't File(), the cache is loaded from this file when the scanner is
+            created, and saved to it whenever a scan finishes.
+        */
+        File cacheFile;
+    };
+
+    //==============================================================================
+    /** Creates a scanner with the default options. */
+    OutOfProcessPluginScanner();
+
+    /** Creates a scanner. */
+    explicit OutOfProcessPluginScanner (const Options& options);
+
+    /** Destructor. This shuts down any workers, and saves the cache. */
+    ~OutOfProcessPluginScanner() override;
+
+    //==============================================================================
+    /** Returns the cache of previous results. */
+    PluginScanCache& getCache() noexcept                { return cache; }
+
+    /** @internal */
+    bool findPluginTypesFor (AudioPluginFormat&, OwnedArray<PluginDescription>&, const String&) override;
+    /** @internal */
+    void scanFinished() override;
+
+    //==============================================================================
+    /**
+        The part of the scanner that runs in each worker process.
+
+        @see OutOfProcessPluginScanner
+
+        @tags{Audio}
+    */
+    class JUCE_API  Worker  : private ChildProcessWorker,
+                              private AsyncUpdater
+    {
+    public:
+        /** Creates a worker that can scan all the default plugin formats. */
+        Worker();
+
+        /** Destructor. */
+        ~Worker() override;
+
+        /** Returns the format manager used for scanning. You can use this to add any
+            custom formats that your host supports.
+        */
+        AudioPluginFormatManager& getFormatManager() noexcept      { return formatManager; }
+
+        /** Checks whether this process was launched as a scanning worker, and if so,
+            connects to the scanner that launched it and returns true. In that case
+            your app should do nothing but keep this object alive, and the process will
+            quit when the scanner shuts it down.
+        */
+        bool initialiseFromCommandLine (const String& commandLine);
+
+    private:
+        void handleMessageFromCoordinator (const MemoryBlock&) override;
+        void handleConnectionLost() override;
+        void handleAsyncUpdate() override;
+        void scanAndReply (const MemoryBlock&);
+
+        AudioPluginFormatManager formatManager;
+        std::mutex mutex;
+        std::queue<MemoryBlock> pendingRequests;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+    };
+
+private:
+    //==============================================================================
+    class WorkerConnection;
+
+    std::unique_ptr<WorkerConnection> acquireWorker();
+    void releaseWorker (std::unique_ptr<WorkerConnection>);
+    std::optional<PluginScanCache::Result> scanInWorker (WorkerConnection&, AudioPluginFormat&, const String&);
+
+    const Options options;
+    PluginScanCache cache;
+
+    std::mutex workerMutex;
+    std::condition_variable workerAvailable;
+    std::vector<std::unique_ptr<WorkerConnection>> idleWorkers;
+    int numWorkersInUse = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OutOfProcessPluginScanner)
+};
+
+} // namespace juce
@@ -95,15 +95,21 @@ bool PluginDirectoryScanner::scanNextFile (bool dontRescanIfAlreadyInList,
 
             OwnedArray<PluginDescription> typesFound;
 
-            // Add this plugin to the end of the dead-man's pedal list in case it crashes...
-            auto crashedPlugins = readDeadMansPedalFile (deadMansPedalFile);
-            crashedPlugins.removeString (file);
-            crashedPlugins.add (file);
-            setDeadMansPedalFile (crashedPlugins);
+            {
+                // Add this plugin to the end of the dead-man's pedal list in case it crashes...
+                const ScopedLock sl (resultsLock);
+                auto crashedPlugins = readDeadMansPedalFile (deadMansPedalFile);
+                crashedPlugins.removeString (file);
+                crashedPlugins.add (file);
+                setDeadMansPedalFile (crashedPlugins);
+            }
 
             list.scanAndAddFile (file, dontRescanIfAlreadyInList, typesFound, format);
 
+            const ScopedLock sl (resultsLock);
+
             // Managed to load without crashing, so remove it from the dead-man's-pedal..
+            auto crashedPlugins = readDeadMansPedalFile (deadMansPedalFile);
             crashedPlugins.removeString (file);
             setDeadMansPedalFile (crashedPlugins);
 
@@ -31,7 +31,9 @@ namespace juce
     Scans a directory for plugins, and adds them to a KnownPluginList.
 
     To use one of these, create it and call scanNextFile() repeatedly, until
-    it returns false.
+    it returns false. scanNextFile() can be called from several threads at once
+    to scan more than one file at a time, which is most useful when the list is
+    using an OutOfProcessPluginScanner.
 
     @tags{Audio}
 */
@@ -125,6 +127,7 @@ private:
     StringArray filesOrIdentifiersToScan;
     File deadMansPedalFile;
     StringArray failedFiles;
+    CriticalSection resultsLock;
     Atomic<int> nextIndex;
     std::atomic<float> progress { 0.0f };
     const bool allowAsync;
@@ -0,0 +1,253 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+PluginScanCache::PluginScanCache() = default;
+PluginScanCache::~PluginScanCache() = default;
+
+//==============================================================================
+PluginScanCache::Fingerprint PluginScanCache::getFingerprint (const String& fileOrIdentifier)
+{
+    if (! File::isAbsolutePath (fileOrIdentifier))
+        return {};
+
+    const File file (fileOrIdentifier);
+
+    if (file.isDirectory())
+    {
+        // A bundle changes if any of the files inside it do
+        Fingerprint result { 0, file.getLastModificationTime().toMilliseconds() };
+
+        for (const auto& entry : RangedDirectoryIterator (file, true, "*", File::findFiles))
+        {
+            result.size += entry.getFileSize();
+            result.modificationTime = jmax (result.modificationTime, entry.getModificationTime().toMilliseconds());
+        }
+
+        return result;
+    }
+
+    if (file.existsAsFile())
+        return { file.getSize(), file.getLastModificationTime().toMilliseconds() };
+
+    return {};
+}
+
+String PluginScanCache::getKey (const String& formatName, const String& fileOrIdentifier)
+{
+    return formatName + ":" + fileOrIdentifier;
+}
+
+//==============================================================================
+std::optional<PluginScanCache::Result> PluginScanCache::getResult (const String& formatName,
+                                                                   const String& fileOrIdentifier) const
+{
+    const auto fingerprint = getFingerprint (fileOrIdentifier);
+
+    const ScopedLock sl (lock);
+    const auto it = entries.find (getKey (formatName, fileOrIdentifier));
+
+    if (it == entries.end() || ! (it->second.fingerprint == fingerprint))
+        return {};
+
+    return it->second.result;
+}
+
+void PluginScanCache::addResult (const String& formatName, const String& fileOrIdentifier, const Result& result)
+{
+    Entry entry { getFingerprint (fileOrIdentifier), result };
+
+    const ScopedLock sl (lock);
+    entries[getKey (formatName, fileOrIdentifier)] = std::move (entry);
+}
+
+void PluginScanCache::removeResult (const String& formatName, const String& fileOrIdentifier)
+{
+    const ScopedLock sl (lock);
+    entries.erase (getKey (formatName, fileOrIdentifier));
+}
+
+void PluginScanCache::clear()
+{
+    const ScopedLock sl (lock);
+    entries.clear();
+}
+
+int PluginScanCache::getNumResults() const
+{
+    const ScopedLock sl (lock);
+    return (int) entries.size();
+}
+
+//==============================================================================
+std::unique_ptr<XmlElement> PluginScanCache::createXml() const
+{
+    auto xml = std::make_unique<XmlElement> ("PLUGINSCANCACHE");
+
+    const ScopedLock sl (lock);
+
+    for (const auto& [key, entry] : entries)
+    {
+        auto* e = xml->createNewChildElement ("ENTRY");
+        e->setAttribute ("key", key);
+        e->setAttribute ("size", String (entry.fingerprint.size));
+        e->setAttribute ("modified", String::toHexString (entry.fingerprint.modificationTime));
+        e->setAttribute ("succeeded", entry.result.succeeded);
+
+        if (entry.result.wasInterrupted)
+            e->setAttribute ("interrupted", true);
+
+        for (const auto& type : entry.result.types)
+            e->addChildElement (type.createXml().release());
+    }
+
+    return xml;
+}
+
+void PluginScanCache::loadFromXml (const XmlElement& xml)
+{
+    std::map<String, Entry> newEntries;
+
+    if (xml.hasTagName ("PLUGINSCANCACHE"))
+    {
+        for (auto* e : xml.getChildWithTagNameIterator ("ENTRY"))
+        {
+            Entry entry;
+            entry.fingerprint.size = e->getStringAttribute ("size").getLargeIntValue();
+            entry.fingerprint.modificationTime = e->getStringAttribute ("modified").getHexValue64();
+            entry.result.succeeded = e->getBoolAttribute ("succeeded");
+            entry.result.wasInterrupted = e->getBoolAttribute ("interrupted");
+
+            for (auto* typeXml : e->getChildIterator())
+            {
+                PluginDescription type;
+
+                if (type.loadFromXml (*typeXml))
+                    entry.result.types.add (type);
+            }
+
+            newEntries[e->getStringAttribute ("key")] = std::move (entry);
+        }
+    }
+
+    const ScopedLock sl (lock);
+    entries = std::move (newEntries);
+}
+
+bool PluginScanCache::saveToFile (const File& file) const
+{
+    return createXml()->writeTo (file);
+}
+
+bool PluginScanCache::loadFromFile (const File& file)
+{
+    if (auto xml = parseXMLIfTagMatches (file, "PLUGINSCANCACHE"))
+    {
+        loadFromXml (*xml);
+        return true;
+    }
+
+    return false;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class PluginScanCacheTests final : public UnitTest
+{
+public:
+    PluginScanCacheTests()
+        : UnitTest ("PluginScanCache", UnitTestCategories::audioProcessors)
+    {}
+
+    void runTest() override
+    {
+        const TemporaryFile bundleDir, cacheFile;
+        const auto bundle = bundleDir.getFile();
+        bundle.getChildFile ("Contents/x86_64-linux").createDirectory();
+        bundle.getChildFile ("Contents/x86_64-linux/plugin.so").replaceWithText ("binary");
+
+        PluginDescription type;
+        type.name = "Test Plugin";
+        type.pluginFormatName = "VST3";
+        type.fileOrIdentifier = bundle.getFullPathName();
+
+        beginTest ("Results are only returned while the file is unchanged");
+        {
+            PluginScanCache cache;
+            expect (! cache.getResult ("VST3", bundle.getFullPathName()).has_value());
+
+            cache.addResult ("VST3", bundle.getFullPathName(), { true, { type } });
+            cache.addResult ("VST3", "/does/not/exist.vst3", { false, {} });
+
+            auto result = cache.getResult ("VST3", bundle.getFullPathName());
+            expect (result.has_value() && result->succeeded);
+            expectEquals (result->types.size(), 1);
+            expect (! cache.getResult ("LV2", bundle.getFullPathName()).has_value());
+
+            result = cache.getResult ("VST3", "/does/not/exist.vst3");
+            expect (result.has_value() && ! result->succeeded);
+
+            bundle.getChildFile ("Contents/x86_64-linux/plugin.so").replaceWithText ("a different binary");
+            expect (! cache.getResult ("VST3", bundle.getFullPathName()).has_value());
+        }
+
+        beginTest ("Results survive a round trip through a file");
+        {
+            PluginScanCache cache;
+            cache.addResult ("VST3", bundle.getFullPathName(), { true, { type } });
+            cache.addResult ("LV2", "urn:test:plugin", { true, {} });
+            cache.addResult ("LV2", "urn:test:hung", { false, {}, true });
+            expect (cache.saveToFile (cacheFile.getFile()));
+
+            PluginScanCache reloaded;
+            expect (reloaded.loadFromFile (cacheFile.getFile()));
+            expectEquals (reloaded.getNumResults(), 3);
+
+            const auto result = reloaded.getResult ("VST3", bundle.getFullPathName());
+            expect (result.has_value() && result->succeeded);
+            expect (result->types.size() == 1 && result->types[0].name == type.name);
+            expect (! result->wasInterrupted);
+            expect (reloaded.getResult ("LV2", "urn:test:plugin").has_value());
+
+            const auto hung = reloaded.getResult ("LV2", "urn:test:hung");
+            expect (hung.has_value() && ! hung->succeeded && hung->wasInterrupted);
+
+            reloaded.removeResult ("LV2", "urn:test:plugin");
+            expectEquals (reloaded.getNumResults(), 2);
+        }
+
+        bundle.deleteRecursively();
+    }
+};
+
+static PluginScanCacheTests pluginScanCacheTests;
+
+#endif
+
+} // namespace juce
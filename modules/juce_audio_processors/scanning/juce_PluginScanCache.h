@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Remembers the results of scanning plugin files, so that files which haven't
+    changed don't need to be loaded again.
+
+    Each result is stored along with the size and modification time of the file
+    (or, for bundles, of all the files inside the bundle), and it's only returned
+    while these still match. Scans that were cut short because the plugin crashed
+    or hung are remembered too, but they're marked as interrupted, and
+    OutOfProcessPluginScanner scans those plugins again the next time it's asked to
+    rather than trusting the result.
+
+    For formats that use identifiers rather than files, such as LV2, there's nothing
+    to compare, so those results are kept until they're removed or the cache is
+    cleared.
+
+    All the methods are thread-safe.
+
+    @see OutOfProcessPluginScanner
+
+    @tags{Audio}
+*/
+class JUCE_API  PluginScanCache
+{
+public:
+    //==============================================================================
+    /** Creates an empty cache. */
+    PluginScanCache();
+
+    /** Destructor. */
+    ~PluginScanCache();
+
+    //==============================================================================
+    /** Describes a cached scan. */
+    struct Result
+    {
+        /** True if the plugin was scanned successfully. */
+        bool succeeded = false;
+
+        /** The types that were found. */
+        Array<PluginDescription> types;
+
+        /** True if the scan didn't finish, because the process scanning the plugin
+            crashed or took too long. This might only have been bad luck, e.g. on a busy
+            machine, so the plugin should be scanned again rather than the result being
+            trusted.
+        */
+        bool wasInterrupted = false;
+    };
+
+    /** Looks for a result that is still valid for the given file or identifier. */
+    std::optional<Result> getResult (const String& formatName, const String& fileOrIdentifier) const;
+
+    /** Stores the result of scanning a file or identifier, replacing any previous result. */
+    void addResult (const String& formatName, const String& fileOrIdentifier, const Result& result);
+
+    /** Forgets the result for a file or identifier. */
+    void removeResult (const String& formatName, const String& fileOrIdentifier);
+
+    /** Forgets all the results. */
+    void clear();
+
+    /** Returns the number of results in the cache. */
+    int getNumResults() const;
+
+    //==============================================================================
+    /** Creates an XML representation of the cache. */
+    std::unique_ptr<XmlElement> createXml() const;
+
+    /** Replaces the cache's contents with a previously saved XML representation. */
+    void loadFromXml (const XmlElement& xml);
+
+    /** Writes the cache to a file. Returns true on success. */
+    bool saveToFile (const File& file) const;
+
+    /** Replaces the cache's contents with those of a file that was written by
+        saveToFile(). Returns true on success.
+    */
+    bool loadFromFile (const File& file);
+
+private:
+    //==============================================================================
+    struct Fingerprint
+    {
+        int64 size = -1, modificationTime = 0;
+
+        bool operator== (const Fingerprint& other) const noexcept
+        {
+            return size == other.size && modificationTime == other.modificationTime;
+        }
+    };
+
+    struct Entry
+    {
+        Fingerprint fingerprint;
+        Result result;
+    };
+
+    static Fingerprint getFingerprint (const String& fileOrIdentifier);
+    static String getKey (const String& formatName, const String& fileOrIdentifier);
+
+    std::map<String, Entry> entries;
+    CriticalSection lock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginScanCache)
+};
+
+} // namespace juce
@@ -0,0 +1,511 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+class OfflineAudioRenderer::PlayHead final : public AudioPlayHead
+{
+public:
+    explicit PlayHead (const Options& o)
+        : sampleRate (o.sampleRate), bpm (o.bpm), timeSignature (o.timeSignature)
+    {
+    }
+
+    void setPosition (int64 newPosition) noexcept   { position = newPosition; }
+
+    Optional<PositionInfo> getPosition() const override
+    {
+        const auto seconds = (double) position / sampleRate;
+        const auto ppq = seconds * bpm / 60.0;
+        const auto quarterNotesPerBar = timeSignature.numerator * 4.0 / timeSignature.denominator;
+        const auto bar = std::floor (ppq / quarterNotesPerBar);
+
+        PositionInfo info;
+        info.setIsPlaying (true);
+        info.setTimeInSamples (position);
+        info.setTimeInSeconds (seconds);
+        info.setBpm (bpm);
+        info.setTimeSignature (timeSignature);
+        info.setPpqPosition (ppq);
+        info.setBarCount ((int64_t) bar);
+        info.setPpqPositionOfLastBarStart (bar * quarterNotesPerBar);
+        return info;
+    }
+
+private:
+    const double sampleRate, bpm;
+    const TimeSignature timeSignature;
+    int64 position = 0;
+};
+
+//==============================================================================
+/*  Passes everything on to another writer, and notes whether any of the writes failed.
+    The ThreadedWriter ignores what its writer returns, so this is the only way to find
+    out about a full disk or an I/O error.
+*/
+class OfflineAudioRenderer::CheckedWriter final : public AudioFormatWriter
+{
+public:
+    CheckedWriter (AudioFormatWriter* writerToUse, std::atomic<bool>& failureFlag)
+        : AudioFormatWriter (nullptr, writerToUse->getFormatName(), writerToUse->getSampleRate(),
+                             (unsigned int) writerToUse->getNumChannels(), (unsigned int) writerToUse->getBitsPerSample()),
+          writer (writerToUse), failed (failureFlag)
+    {
+        usesFloatingPointData = writer->isFloatingPoint();
+    }
+
+    bool write (const int** samplesToWrite, int numSamples) override
+    {
+        if (writer->write (samplesToWrite, numSamples))
+            return true;
+
+        failed = true;
+        return false;
+    }
+
+    bool flush() override
+    {
+        return writer->flush();
+    }
+
+private:
+    std::unique_ptr<AudioFormatWriter> writer;
+    std::atomic<bool>& failed;
+};
+
+//==============================================================================
+class OfflineAudioRenderer::RenderJob final : public ThreadPoolJob
+{
+public:
+    RenderJob (OfflineAudioRenderer& r, Job& j, TimeSliceThread& thread)
+        : ThreadPoolJob ("Offline render"), renderer (r), job (j), writerThread (thread)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        result = renderer.renderJob (job, writerThread);
+        return jobHasFinished;
+    }
+
+    OfflineAudioRenderer& renderer;
+    Job& job;
+    TimeSliceThread& writerThread;
+    JobResult result;
+};
+
+//==============================================================================
+double OfflineAudioRenderer::JobResult::getRealtimeFactor() const noexcept
+{
+    if (secondsTaken <= 0 || sampleRate <= 0)
+        return 0;
+
+    return ((double) numSamplesRendered / sampleRate) / secondsTaken;
+}
+
+OfflineAudioRenderer::OfflineAudioRenderer()  : OfflineAudioRenderer (Options())
+{
+}
+
+OfflineAudioRenderer::OfflineAudioRenderer (const Options& o)  : options (o)
+{
+    jassert (options.sampleRate > 0 && options.blockSize > 0);
+}
+
+OfflineAudioRenderer::~OfflineAudioRenderer() = default;
+
+void OfflineAudioRenderer::addJob (Job job)
+{
+    jassert (job.processor != nullptr && job.writer != nullptr);
+
+    // each job needs a processor of its own, as they're rendered in parallel
+    jassert (std::none_of (jobs.begin(), jobs.end(), [&] (const Job& j) { return j.processor == job.processor; }));
+
+    jobs.push_back (std::move (job));
+}
+
+int OfflineAudioRenderer::getNumJobs() const noexcept
+{
+    return (int) jobs.size();
+}
+
+std::vector<OfflineAudioRenderer::JobResult> OfflineAudioRenderer::render (int numThreads)
+{
+    ThreadPool pool (ThreadPoolOptions{}.withThreadName ("Offline render")
+                                        .withNumberOfThreads (jmax (1, numThreads)));
+    return render (pool);
+}
+
+std::vector<OfflineAudioRenderer::JobResult> OfflineAudioRenderer::render (ThreadPool& threadPoolToUse)
+{
+    totalSamplesRendered = 0;
+    totalSamplesToRender = std::accumulate (jobs.begin(), jobs.end(), (int64) 0,
+                                            [] (int64 total, const Job& j) { return total + j.lengthInSamples; });
+
+    // The processors produce audio much faster than a disk can take lots of small writes,
+    // so their output is queued up and written in large blocks by a few shared threads.
+    TimeSliceThread writerThread ("Offline render writer", jmax (1, threadPoolToUse.getNumThreads() / 2));
+    writerThread.startThread (Thread::Priority::high);
+
+    OwnedArray<RenderJob> renderJobs;
+
+    for (auto& job : jobs)
+        threadPoolToUse.addJob (renderJobs.add (new RenderJob (*this, job, writerThread)), false);
+
+    std::vector<JobResult> results;
+
+    for (auto* renderJob : renderJobs)
+    {
+        threadPoolToUse.waitForJobToFinish (renderJob, -1);
+        results.push_back (renderJob->result);
+    }
+
+    writerThread.stopThread (10000);
+    jobs.clear();
+    shouldCancel = false;
+    return results;
+}
+
+double OfflineAudioRenderer::getProgress() const noexcept
+{
+    const auto total = totalSamplesToRender.load();
+    return total > 0 ? jlimit (0.0, 1.0, (double) totalSamplesRendered.load() / (double) total) : 0.0;
+}
+
+void OfflineAudioRenderer::cancel() noexcept
+{
+    shouldCancel = true;
+}
+
+OfflineAudioRenderer::JobResult OfflineAudioRenderer::renderJob (Job& job, TimeSliceThread& writerThread)
+{
+    JobResult jobResult;
+    jobResult.name = job.name;
+    jobResult.sampleRate = options.sampleRate;
+
+    const auto startTime = Time::getMillisecondCounterHiRes();
+    auto& processor = *job.processor;
+    const auto blockSize = options.blockSize;
+    const auto numWriterChannels = (int) job.writer->getNumChannels();
+    const auto numChannels = jmax (processor.getTotalNumInputChannels(),
+                                   processor.getTotalNumOutputChannels(),
+                                   numWriterChannels);
+
+    PlayHead playHead (options);
+    std::atomic<bool> writeFailed { false };
+
+    processor.setNonRealtime (true);
+    processor.setProcessingPrecision (AudioProcessor::singlePrecision);
+    processor.setRateAndBufferSizeDetails (options.sampleRate, blockSize);
+    processor.prepareToPlay (options.sampleRate, blockSize);
+    processor.setPlayHead (&playHead);
+
+    {
+        AudioFormatWriter::ThreadedWriter writer (new CheckedWriter (job.writer.release(), writeFailed), writerThread,
+                                                  jmax (options.writerBufferSize, blockSize * 4));
+        writer.setWriteBlockSize (options.writeBlockSize);
+
+        AudioBuffer<float> buffer (numChannels, blockSize);
+        MidiBuffer midi;
+        std::vector<const float*> channelsToWrite ((size_t) numWriterChannels);
+
+        // The first latencySamples of output are the processor's delay, so they're dropped,
+        // and the processor is run for that much longer to make up for them.
+        const auto latency = (int64) processor.getLatencySamples();
+        const auto numSamplesToProcess = job.lengthInSamples + latency;
+        int nextMidiEvent = 0;
+
+        for (int64 position = 0; position < numSamplesToProcess; position += blockSize)
+        {
+            if (shouldCancel)
+            {
+                jobResult.result = Result::fail ("The render was cancelled");
+                break;
+            }
+
+            if (writeFailed)
+                break;
+
+            const auto numThisTime = (int) jmin ((int64) blockSize, numSamplesToProcess - position);
+            AudioBuffer<float> block (buffer.getArrayOfWritePointers(), numChannels, numThisTime);
+            block.clear();
+
+            midi.clear();
+
+            for (; nextMidiEvent < job.midi.getNumEvents(); ++nextMidiEvent)
+            {
+                const auto& message = job.midi.getEventPointer (nextMidiEvent)->message;
+                const auto time = (int64) message.getTimeStamp();
+
+                if (time >= position + numThisTime)
+                    break;
+
+                midi.addEvent (message, (int) jmax ((int64) 0, time - position));
+            }
+
+            playHead.setPosition (position);
+
+            {
+                const ScopedLock sl (processor.getCallbackLock());
+                processor.processBlock (block, midi);
+            }
+
+            const auto numToSkip = (int) jlimit ((int64) 0, (int64) numThisTime, latency - position);
+            const auto numToWrite = numThisTime - numToSkip;
+
+            if (numToWrite <= 0)
+                continue;
+
+            for (int i = 0; i < numWriterChannels; ++i)
+                channelsToWrite[(size_t) i] = block.getReadPointer (i, numToSkip);
+
+            // Nothing's allowed to be lost offline, so if the disk is behind, wait for it.
+            while (! writer.write (channelsToWrite.data(), numToWrite))
+            {
+                writerThread.notify();
+                Thread::sleep (1);
+            }
+
+            jobResult.numSamplesRendered += numToWrite;
+            totalSamplesRendered += numToWrite;
+        }
+    }
+
+    // The ThreadedWriter has written everything that was left by now
+    if (writeFailed && jobResult.result.wasOk())
+        jobResult.result = Result::fail ("The audio couldn't be written");
+
+    processor.setPlayHead (nullptr);
+    processor.releaseResources();
+    processor.setNonRealtime (false);
+
+    jobResult.secondsTaken = (Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+    return jobResult;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct OfflineAudioRendererTests final : public UnitTest
+{
+    OfflineAudioRendererTests()
+        : UnitTest ("OfflineAudioRenderer", UnitTestCategories::audio) {}
+
+    // Outputs the timeline position that each sample represents on its first channel, and
+    // the note number of each incoming note on its second, both delayed by its latency.
+    struct PositionProcessor final : public AudioProcessor
+    {
+        explicit PositionProcessor (int latency)
+            : AudioProcessor (BusesProperties().withOutput ("Output", AudioChannelSet::stereo()))
+        {
+            setLatencySamples (latency);
+        }
+
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer& midi) override
+        {
+            const auto position = getPlayHead()->getPosition()->getTimeInSamples().orFallback (0);
+            const auto latency = getLatencySamples();
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (0, i, (float) (position + i - latency));
+
+            for (const auto metadata : midi)
+                pendingNotes.push_back ({ position + metadata.samplePosition + latency, metadata.getMessage().getNoteNumber() });
+
+            for (const auto& [time, note] : pendingNotes)
+                if (position <= time && time < position + buffer.getNumSamples())
+                    buffer.setSample (1, (int) (time - position), (float) note);
+        }
+
+        const String getName() const override                           { return "Position"; }
+        void prepareToPlay (double, int) override                       { pendingNotes.clear(); }
+        void releaseResources() override                                {}
+        using AudioProcessor::processBlock;
+        double getTailLengthSeconds() const override                    { return 0; }
+        bool acceptsMidi() const override                               { return true; }
+        bool producesMidi() const override                              { return false; }
+        AudioProcessorEditor* createEditor() override                   { return nullptr; }
+        bool hasEditor() const override                                 { return false; }
+        int getNumPrograms() override                                   { return 1; }
+        int getCurrentProgram() override                                { return 0; }
+        void setCurrentProgram (int) override                           {}
+        const String getProgramName (int) override                      { return {}; }
+        void changeProgramName (int, const String&) override            {}
+        void getStateInformation (MemoryBlock&) override                {}
+        void setStateInformation (const void*, int) override            {}
+
+        std::vector<std::pair<int64, int>> pendingNotes;
+    };
+
+    struct RecordingWriter final : public AudioFormatWriter
+    {
+        explicit RecordingWriter (AudioBuffer<float>& dest, int maxSamplesToWrite = std::numeric_limits<int>::max())
+            : AudioFormatWriter (nullptr, "Recording", 44100.0, 2u, 32u), recorded (dest), maxSamples (maxSamplesToWrite)
+        {
+            usesFloatingPointData = true;
+        }
+
+        bool write (const int** data, int numSamples) override
+        {
+            // Behaves like a disk that's full after maxSamples
+            if (recorded.getNumSamples() + numSamples > maxSamples)
+                return false;
+
+            const auto start = recorded.getNumSamples();
+            recorded.setSize (2, start + numSamples, true);
+
+            for (int ch = 0; ch < 2; ++ch)
+                recorded.copyFrom (ch, start, reinterpret_cast<const float*> (data[ch]), numSamples);
+
+            return true;
+        }
+
+        AudioBuffer<float>& recorded;
+        const int maxSamples;
+    };
+
+    void runTest() override
+    {
+        beginTest ("Jobs rendered in parallel line up with the timeline");
+        {
+            constexpr int length = 20000;
+            const int latencies[] { 0, 100, 1000 };
+
+            OwnedArray<PositionProcessor> processors;
+            std::vector<AudioBuffer<float>> outputs (std::size (latencies));
+
+            OfflineAudioRenderer::Options options;
+            options.blockSize = 300;
+            OfflineAudioRenderer renderer (options);
+
+            for (size_t i = 0; i < std::size (latencies); ++i)
+            {
+                OfflineAudioRenderer::Job job;
+                job.processor = processors.add (new PositionProcessor (latencies[i]));
+                job.writer = std::make_unique<RecordingWriter> (outputs[i]);
+                job.lengthInSamples = length;
+                job.midi.addEvent (MidiMessage::noteOn (1, 60, 1.0f), 1234.0);
+                job.midi.addEvent (MidiMessage::noteOn (1, 72, 1.0f), 5678.0);
+                job.name = String (latencies[i]);
+                renderer.addJob (std::move (job));
+            }
+
+            const auto results = renderer.render (2);
+
+            expectEquals ((int) results.size(), (int) std::size (latencies));
+            expectEquals (renderer.getNumJobs(), 0);
+            expectEquals (renderer.getProgress(), 1.0);
+
+            for (size_t i = 0; i < results.size(); ++i)
+            {
+                expect (results[i].result.wasOk());
+                expectEquals (results[i].name, String (latencies[i]));
+                expectEquals (results[i].numSamplesRendered, (int64) length);
+                expect (results[i].getRealtimeFactor() > 0);
+
+                const auto& output = outputs[i];
+                expectEquals (output.getNumSamples(), length);
+
+                bool timelineCorrect = true;
+
+                for (int s = 0; s < output.getNumSamples(); ++s)
+                    timelineCorrect = timelineCorrect && exactlyEqual (output.getSample (0, s), (float) s);
+
+                expect (timelineCorrect);
+
+                expectEquals (output.getSample (1, 1234), 60.0f);
+                expectEquals (output.getSample (1, 5678), 72.0f);
+            }
+        }
+
+        beginTest ("A cancelled render stops early");
+        {
+            PositionProcessor processor (0);
+            AudioBuffer<float> output;
+
+            OfflineAudioRenderer renderer;
+            OfflineAudioRenderer::Job job;
+            job.processor = &processor;
+            job.writer = std::make_unique<RecordingWriter> (output);
+            job.lengthInSamples = std::numeric_limits<int64>::max() / 2;
+            renderer.addJob (std::move (job));
+
+            WaitableEvent cancelled;
+            Thread::launch ([&] { Thread::sleep (50); renderer.cancel(); cancelled.signal(); });
+
+            const auto results = renderer.render (1);
+            expect (results.size() == 1 && results[0].result.failed());
+            expect (renderer.getProgress() < 1.0);
+            cancelled.wait();
+        }
+
+        beginTest ("A render cancelled before it starts doesn't run");
+        {
+            PositionProcessor processor (0);
+            AudioBuffer<float> output;
+
+            OfflineAudioRenderer renderer;
+            renderer.cancel();
+
+            for (auto shouldBeCancelled : { true, false })
+            {
+                OfflineAudioRenderer::Job job;
+                job.processor = &processor;
+                job.writer = std::make_unique<RecordingWriter> (output);
+                job.lengthInSamples = 1000;
+                renderer.addJob (std::move (job));
+
+                const auto results = renderer.render (1);
+                expect (results.size() == 1 && results[0].result.failed() == shouldBeCancelled);
+            }
+        }
+
+        beginTest ("A job fails if its writer can't write everything");
+        {
+            PositionProcessor processor (0);
+            AudioBuffer<float> output;
+
+            OfflineAudioRenderer renderer;
+            OfflineAudioRenderer::Job job;
+            job.processor = &processor;
+            job.writer = std::make_unique<RecordingWriter> (output, 5000);
+            job.lengthInSamples = 20000;
+            renderer.addJob (std::move (job));
+
+            const auto results = renderer.render (1);
+            expect (results.size() == 1 && results[0].result.failed());
+            expectLessThan (output.getNumSamples(), 20000);
+        }
+    }
+};
+
+static OfflineAudioRendererTests offlineAudioRendererTests;
+
+#endif
+
+} // namespace juce
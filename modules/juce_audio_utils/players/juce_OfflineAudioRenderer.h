@@ -0,0 +1,198 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Renders AudioProcessors into AudioFormatWriters, as fast as the processors can go.
+
+    Add a job for each processor that you want to render, e.g. one for each stem of a
+    mix, and then call render(). The jobs are independent, so they're rendered in
+    parallel on a ThreadPool, and while the processors are busy, the audio they've
+    already produced is written out by background threads.
+
+    Each processor is driven by a play head that reports a playing transport, starting
+    at sample 0, with the tempo and time signature given in the Options. The processor's
+    latency is compensated for, so that the rendered audio lines up with the timeline.
+
+    @code
+    OfflineAudioRenderer renderer;
+
+    for (auto& stem : stems)
+        renderer.addJob ({ stem.processor.get(), stem.createWriter(), lengthInSamples, stem.midi, stem.name });
+
+    for (auto& result : renderer.render (4))
+        DBG (result.name << ": " << result.getRealtimeFactor() << "x realtime");
+    @endcode
+
+    @see AudioProcessorPlayer
+
+    @tags{Audio}
+*/
+class JUCE_API  OfflineAudioRenderer
+{
+public:
+    //==============================================================================
+    /** The settings used for all the jobs in a render. */
+    struct Options
+    {
+        /** The sample rate to run the processors at. */
+        double sampleRate = 44100.0;
+
+        /** The number of samples to pass to each processBlock() call. */
+        int blockSize = 512;
+
+        /** The tempo that the play head reports. */
+        double bpm = 120.0;
+
+        /** The time signature that the play head reports. */
+        AudioPlayHead::TimeSignature timeSignature;
+
+        /** The number of samples of rendered audio that each job can queue up while
+            its writer catches up.
+        */
+        int writerBufferSize = 1 << 17;
+
+        /** The number of samples that the background threads write in one go.
+            @see AudioFormatWriter::ThreadedWriter::setWriteBlockSize
+        */
+        int writeBlockSize = 1 << 14;
+    };
+
+    /** Describes a processor to render, and where to put the result. */
+    struct Job
+    {
+        /** The processor to render. This isn't owned by the renderer, and it can't be
+            used by any other job, or played anywhere else, while the render is running.
+            It will be prepared and released again by the renderer.
+        */
+        AudioProcessor* processor = nullptr;
+
+        /** The writer to send the audio to. The writer's number of channels decides how many
+            of the processor's output channels are written. It'll be deleted, and so its
+            file will be finished, as soon as this job is done.
+        */
+        std::unique_ptr<AudioFormatWriter> writer;
+
+        /** The number of samples to render. */
+        int64 lengthInSamples = 0;
+
+        /** Any MIDI to send to the processor. The timestamps are in samples. */
+        MidiMessageSequence midi;
+
+        /** A name for the job, which is copied into its JobResult. */
+        String name;
+    };
+
+    /** Describes how a job went. */
+    struct JobResult
+    {
+        /** The job's name. */
+        String name;
+
+        /** Whether the job succeeded, and if not, why not. A job fails if it's cancelled,
+            or if its writer fails to write any of the audio, e.g. because the disk is full.
+        */
+        Result result = Result::ok();
+
+        /** The number of samples that were written. */
+        int64 numSamplesRendered = 0;
+
+        /** The sample rate the job was rendered at. */
+        double sampleRate = 0;
+
+        /** The time the job took, in seconds. */
+        double secondsTaken = 0;
+
+        /** Returns how many times faster than realtime the job was rendered. */
+        double getRealtimeFactor() const noexcept;
+    };
+
+    //==============================================================================
+    /** Creates a renderer with the default options. */
+    OfflineAudioRenderer();
+
+    /** Creates a renderer with some options. */
+    explicit OfflineAudioRenderer (const Options& options);
+
+    /** Destructor. */
+    ~OfflineAudioRenderer();
+
+    //==============================================================================
+    /** Adds a job to be rendered by the next call to render(). */
+    void addJob (Job job);
+
+    /** Returns the number of jobs waiting to be rendered. */
+    int getNumJobs() const noexcept;
+
+    //==============================================================================
+    /** Renders all the jobs that have been added, using a ThreadPool to run them in
+        parallel, and returns their results in the order they were added.
+
+        This blocks until all the jobs have finished or the render is cancelled. The
+        pool must not be the one that's running the calling thread's job, or it may
+        deadlock. Once it's done, the list of jobs is cleared.
+    */
+    std::vector<JobResult> render (ThreadPool& threadPoolToUse);
+
+    /** Renders all the jobs that have been added, using a temporary ThreadPool with
+        the given number of threads.
+
+        @see render (ThreadPool&)
+    */
+    std::vector<JobResult> render (int numThreads);
+
+    /** Returns the progress of the current render, from 0 to 1.
+        This can be called from any thread.
+    */
+    double getProgress() const noexcept;
+
+    /** Stops the current render as soon as possible.
+
+        This can be called from any thread. The jobs that haven't finished will return
+        a failed Result, and their writers will contain whatever had been rendered so far.
+        If no render is running, the next one is cancelled as soon as it starts.
+    */
+    void cancel() noexcept;
+
+private:
+    //==============================================================================
+    class PlayHead;
+    class RenderJob;
+    class CheckedWriter;
+
+    JobResult renderJob (Job&, TimeSliceThread&);
+
+    Options options;
+    std::vector<Job> jobs;
+    std::atomic<int64> totalSamplesToRender { 0 }, totalSamplesRendered { 0 };
+    std::atomic<bool> shouldCancel { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OfflineAudioRenderer)
+};
+
+} // namespace juce
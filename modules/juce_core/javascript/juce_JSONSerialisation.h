@@ -456,6 +456,733 @@ private:
     };
 };
 
+//==============================================================================
+/**
+    Allows writing an object of arbitrary type directly to JSON, without building an
+    intermediate var.
+
+    The type must be set up for serialisation in exactly the same way as for ToVar,
+    and the output is identical to the text produced by passing the result of
+    ToVar::convert() to JSON::writeToStream(). The difference is that each item is
+    written to the stream as soon as it is visited, so even very large structures
+    can be written with almost no additional memory.
+
+    If conversion fails part-way through, the stream may contain partial output.
+
+    @see FromJSON, ToVar, JSONWriter
+
+    @tags{Core}
+*/
+class ToJSON
+{
+public:
+    using Options = ToVarOptions;
+
+    /** Attempts to write the argument to a JSONWriter using the serialisation utilities
+        specified for that type.
+
+        Returns true if conversion succeeded.
+    */
+    template <typename T>
+    static bool write (JSONWriter& writer, const T& t, const Options& options = {})
+    {
+        return Visitor::write (writer, t, options);
+    }
+
+    /** Attempts to write the argument as JSON to an OutputStream, using the serialisation
+        utilities specified for that type.
+
+        Returns true if conversion succeeded.
+    */
+    template <typename T>
+    static bool write (OutputStream& stream,
+                       const T& t,
+                       const JSON::FormatOptions& format = {},
+                       const Options& options = {})
+    {
+        JSONWriter writer (stream, format);
+        return write (writer, t, options);
+    }
+
+    /** Attempts to convert the argument to a JSON string using the serialisation utilities
+        specified for that type.
+
+        This will return a non-null optional if conversion succeeds, or nullopt if conversion fails.
+    */
+    template <typename T>
+    static std::optional<String> toString (const T& t,
+                                           const JSON::FormatOptions& format = {},
+                                           const Options& options = {})
+    {
+        MemoryOutputStream mo { 1024 };
+
+        if (write (mo, t, format, options))
+            return mo.toUTF8();
+
+        return std::nullopt;
+    }
+
+private:
+    class Visitor
+    {
+    public:
+        template <typename T>
+        static bool write (JSONWriter& writer, const T& t, const Options& options)
+        {
+            constexpr auto fallbackVersion = detail::ForwardingSerialisationTraits<T>::marshallingVersion;
+            const auto versionToUse = options.getExplicitVersion()
+                                             .value_or (fallbackVersion);
+
+            if (versionToUse > fallbackVersion)
+            {
+                // The requested explicit version is higher than the declared version of the type.
+                return false;
+            }
+
+            Visitor visitor { writer, versionToUse, options.getVersionIncluded() };
+            detail::doSave (visitor, t);
+            return visitor.finish();
+        }
+
+        std::optional<int> getVersion() const { return version; }
+
+        template <typename... Ts>
+        void operator() (Ts&&... ts)
+        {
+            (visit (std::forward<Ts> (ts)), ...);
+        }
+
+    private:
+        enum class State { empty, scalar, object, array, failed };
+
+        Visitor (JSONWriter& w, const std::optional<int>& explicitVersion, bool includeVersion)
+            : writer (w), version (explicitVersion), versionIncluded (includeVersion)
+        {
+            if (version.has_value() && includeVersion)
+            {
+                writer.beginObject();
+                writer.writeName ("__version__");
+                writer.writeInt (*version);
+                state = State::object;
+            }
+        }
+
+        template <typename T>
+        void visit (const T& t)
+        {
+            if constexpr (std::is_integral_v<T>)
+                push ([&] { writer.writeInt ((int64) t); return true; });
+            else if constexpr (std::is_floating_point_v<T>)
+                push ([&] { writer.writeDouble ((double) t); return true; });
+            else
+                push ([&] { return write (writer, t, Options{}.withVersionIncluded (versionIncluded)); });
+        }
+
+        template <typename T>
+        void visit (const Named<T>& named)
+        {
+            if (state == State::failed)
+                return;
+
+            if (state == State::empty)
+            {
+                writer.beginObject();
+                state = State::object;
+            }
+
+            if (state != State::object)
+            {
+                // Serialisation failure! This may be caused by archiving a primitive or
+                // SerialisationSize, and then attempting to archive a named pair to the same
+                // archive instance.
+                // When using named pairs, *all* items serialised with a particular archiver must be
+                // named pairs.
+                jassertfalse;
+
+                state = State::failed;
+                return;
+            }
+
+            writer.writeName (named.name.data(), named.name.size());
+
+            if (! write (writer, named.value, Options{}.withVersionIncluded (versionIncluded)))
+                state = State::failed;
+        }
+
+        template <typename T>
+        void visit (const SerialisationSize<T>&)
+        {
+            if (state == State::empty)
+            {
+                writer.beginArray();
+                state = State::array;
+                return;
+            }
+
+            push ([&] { writer.beginArray(); writer.endArray(); return true; });
+        }
+
+        void visit (const bool& t)
+        {
+            push ([&] { writer.writeBool (t); return true; });
+        }
+
+        void visit (const String& t)
+        {
+            push ([&] { writer.writeString (t); return true; });
+        }
+
+        void visit (const var& t)
+        {
+            push ([&] { writer.writeValue (t); return true; });
+        }
+
+        template <typename Fn>
+        void push (Fn&& writeItem)
+        {
+            if (state == State::empty)
+                state = State::scalar;
+            else if (state != State::array)
+                state = State::failed;
+
+            if (state != State::failed && ! writeItem())
+                state = State::failed;
+        }
+
+        bool finish()
+        {
+            switch (state)
+            {
+                case State::empty:   writer.writeNull(); return true;
+                case State::scalar:  return true;
+                case State::object:  writer.endObject(); return true;
+                case State::array:   writer.endArray(); return true;
+                case State::failed:  break;
+            }
+
+            return false;
+        }
+
+        JSONWriter& writer;
+        std::optional<int> version;
+        bool versionIncluded = true;
+        State state = State::empty;
+    };
+};
+
+//==============================================================================
+/**
+    Allows reading an object of arbitrary type directly from JSON, without building an
+    intermediate var.
+
+    The type must be set up for serialisation in exactly the same way as for FromVar,
+    and the result of conversion is the same as passing the result of JSON::parse() to
+    FromVar::convert(). The difference is that values are read straight from a
+    JSONReader into the destination object, so no DynamicObject, NamedValueSet or Array
+    is ever created.
+
+    Object members are expected to appear in the same order in which they are visited
+    by the type's serialisation function (which is the order produced by ToJSON and
+    ToVar). Members that appear out of order are still found, but their text must be
+    set aside until it is requested. Similarly, the "__version__" member written for
+    versioned types is expected to be the first member of an object.
+
+    When reading from a stream, the text of each array is buffered so that the number
+    of elements can be determined before loading its contents. When reading from memory
+    (including from a File, which will be memory-mapped where possible), nothing is
+    copied.
+
+    @see ToJSON, FromVar, JSONReader
+
+    @tags{Core}
+*/
+class FromJSON
+{
+public:
+    /** Attempts to read the next value from a JSONReader as an instance of type T.
+
+        This will return a non-null optional if conversion succeeds, or nullopt if conversion fails.
+    */
+    template <typename T>
+    static std::optional<T> convert (JSONReader& reader)
+    {
+        return Visitor::convert<T> (reader);
+    }
+
+    /** Attempts to parse the contents of a stream as an instance of type T. */
+    template <typename T>
+    static std::optional<T> convert (InputStream& stream)
+    {
+        JSONReader reader (stream);
+        return convert<T> (reader);
+    }
+
+    /** Attempts to parse some JSON-formatted text as an instance of type T. */
+    template <typename T>
+    static std::optional<T> convert (const String& text)
+    {
+        JSONReader reader (text.toRawUTF8(), text.getNumBytesAsUTF8());
+        return convert<T> (reader);
+    }
+
+    /** Attempts to parse the contents of a file as an instance of type T.
+
+        The file will be memory-mapped if possible, so that it is parsed in-place.
+    */
+    template <typename T>
+    static std::optional<T> convert (const File& file)
+    {
+        MemoryMappedFile mapped (file, MemoryMappedFile::readOnly);
+
+        if (mapped.getData() != nullptr)
+        {
+            JSONReader reader (mapped.getData(), mapped.getSize());
+            return convert<T> (reader);
+        }
+
+        FileInputStream stream (file);
+
+        if (! stream.openedOk())
+            return std::nullopt;
+
+        return convert<T> (stream);
+    }
+
+private:
+    class Visitor
+    {
+    public:
+        template <typename T>
+        static std::optional<T> convert (JSONReader& reader)
+        {
+            Visitor visitor { reader };
+
+            // Primitives (including var) consume their input in a single visit, so only
+            // other types need to look inside objects for version information.
+            if constexpr (detail::serialisationKind<T> != detail::SerialisationKind::primitive)
+                if (! visitor.start (std::optional<int> (detail::ForwardingSerialisationTraits<T>::marshallingVersion).has_value()))
+                    return std::nullopt;
+
+            return visitor.load<T>();
+        }
+
+        std::optional<int> getVersion() const { return version; }
+
+        template <typename... Ts>
+        void operator() (Ts&&... ts)
+        {
+            (visit (std::forward<Ts> (ts)), ...);
+        }
+
+    private:
+        using Token = JSONReader::Token;
+
+        enum class Mode { unstarted, object, array, consumed };
+
+        explicit Visitor (JSONReader& r) : reader (r) {}
+
+        /*  Takes over the partially-read object of another visitor. This happens when a
+            type forwards its whole input to another type without naming it.
+        */
+        Visitor (JSONReader& r, Visitor&& parent)
+            : reader (r),
+              pendingMembers (std::move (parent.pendingMembers)),
+              version (parent.version),
+              mode (Mode::object),
+              hasCurrentName (parent.hasCurrentName),
+              objectFinished (parent.objectFinished)
+        {
+            parent.mode = Mode::consumed;
+        }
+
+        template <typename T>
+        std::optional<T> load()
+        {
+            T t{};
+            detail::doLoad (*this, t);
+
+            if (! failed)
+                finish();
+
+            return ! failed ? std::optional<T> (std::move (t))
+                            : std::nullopt;
+        }
+
+        bool start (bool typeIsVersioned)
+        {
+            const auto token = reader.peek();
+
+            if (token == Token::error)
+                return false;
+
+            if (token != Token::beginObject)
+                return true;
+
+            reader.next();
+            mode = Mode::object;
+
+            if (! readNextName())
+                return false;
+
+            while (hasCurrentName)
+            {
+                if (reader.getStringView() == "__version__")
+                {
+                    hasCurrentName = false;
+                    const auto versionToken = reader.next();
+
+                    if (versionToken != Token::integer && versionToken != Token::floatingPoint)
+                        return false;
+
+                    version = (int) reader.getDouble();
+                    return true;
+                }
+
+                // Only versioned types need to go looking for a version that isn't at the
+                // start of the object.
+                if (! typeIsVersioned || ! bufferCurrentMember() || ! readNextName())
+                    return ! failed;
+            }
+
+            return true;
+        }
+
+        template <typename T>
+        void visit (T& t)
+        {
+            if constexpr (std::is_integral_v<T>)
+            {
+                readPrimitive (std::in_place_type<int64>, t);
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                readPrimitive (std::in_place_type<double>, t);
+            }
+            else
+            {
+                if (failed)
+                    return;
+
+                auto converted = [&]() -> std::optional<T>
+                {
+                    switch (mode)
+                    {
+                        case Mode::unstarted:
+                            mode = Mode::consumed;
+                            return convert<T> (reader);
+
+                        case Mode::object:
+                        {
+                            Visitor child { reader, std::move (*this) };
+                            return child.load<T>();
+                        }
+
+                        case Mode::array:
+                            if (auto* source = getNextElementSource())
+                                return convert<T> (*source);
+
+                            break;
+
+                        case Mode::consumed:
+                            break;
+                    }
+
+                    return std::nullopt;
+                }();
+
+                if (converted.has_value())
+                    t = std::move (*converted);
+                else
+                    failed = true;
+            }
+        }
+
+        template <typename T>
+        void visit (const Named<T>& named)
+        {
+            if (failed)
+                return;
+
+            if (mode != Mode::object)
+            {
+                failed = true;
+                return;
+            }
+
+            const auto assign = [&] (std::optional<std::remove_const_t<T>> converted)
+            {
+                if (converted.has_value())
+                    named.value = std::move (*converted);
+                else
+                    failed = true;
+            };
+
+            for (auto it = pendingMembers.begin(); it != pendingMembers.end(); ++it)
+            {
+                if (it->first == named.name)
+                {
+                    auto memberReader = std::move (it->second);
+                    pendingMembers.erase (it);
+                    assign (convert<std::remove_const_t<T>> (memberReader));
+                    return;
+                }
+            }
+
+            while (! objectFinished)
+            {
+                if (! hasCurrentName)
+                {
+                    if (! readNextName())
+                        return;
+
+                    continue;
+                }
+
+                hasCurrentName = false;
+
+                if (reader.getStringView() == named.name)
+                {
+                    assign (convert<std::remove_const_t<T>> (reader));
+                    return;
+                }
+
+                hasCurrentName = true;
+
+                if (! bufferCurrentMember())
+                    return;
+            }
+
+            failed = true;
+        }
+
+        template <typename T>
+        void visit (const SerialisationSize<T>& t)
+        {
+            if (failed)
+                return;
+
+            if (mode != Mode::unstarted || reader.peek() != Token::beginArray)
+            {
+                failed = true;
+                return;
+            }
+
+            auto size = reader.getNextArraySize();
+
+            if (! size.has_value())
+            {
+                // Streams can't be scanned ahead, so the array must be set aside first
+                bufferedArray = reader.readValueAsReader();
+                size = bufferedArray.has_value() ? bufferedArray->getNextArraySize() : std::nullopt;
+            }
+
+            if (! size.has_value())
+            {
+                failed = true;
+                return;
+            }
+
+            getArrayReader().next();
+            t.size = static_cast<T> (*size);
+            mode = Mode::array;
+        }
+
+        void visit (bool& t)
+        {
+            readPrimitive (std::in_place_type<bool>, t);
+        }
+
+        void visit (String& t)
+        {
+            readPrimitive (std::in_place_type<String>, t);
+        }
+
+        void visit (var& t)
+        {
+            if (auto* source = getNextValueSource())
+            {
+                if (auto parsed = source->readValueAsVar())
+                {
+                    t = std::move (*parsed);
+                    return;
+                }
+            }
+
+            failed = true;
+        }
+
+        static std::optional<double> pullTyped (std::in_place_type_t<double>, JSONReader& source)
+        {
+            return source.next() == Token::floatingPoint ? std::optional<double> (source.getDouble()) : std::nullopt;
+        }
+
+        static std::optional<int64> pullTyped (std::in_place_type_t<int64>, JSONReader& source)
+        {
+            return source.next() == Token::integer ? std::optional<int64> (source.getInt64()) : std::nullopt;
+        }
+
+        static std::optional<bool> pullTyped (std::in_place_type_t<bool>, JSONReader& source)
+        {
+            switch (source.peek())
+            {
+                case Token::boolean:        source.next(); return source.getBool();
+                case Token::integer:
+                case Token::floatingPoint:  source.next(); return ! exactlyEqual (source.getDouble(), 0.0);
+                case Token::null:           source.next(); return false;
+                case Token::string:         source.next(); return (bool) var (source.getString());
+
+                case Token::beginObject:
+                case Token::endObject:
+                case Token::beginArray:
+                case Token::endArray:
+                case Token::propertyName:
+                case Token::endOfInput:
+                case Token::error:
+                    break;
+            }
+
+            return std::nullopt;
+        }
+
+        static std::optional<String> pullTyped (std::in_place_type_t<String>, JSONReader& source)
+        {
+            return source.next() == Token::string ? std::optional<String> (source.getString()) : std::nullopt;
+        }
+
+        template <typename TypeToRead, typename T>
+        void readPrimitive (std::in_place_type_t<TypeToRead> tag, T& t)
+        {
+            if (failed)
+                return;
+
+            auto* source = getNextValueSource();
+            auto typed = source != nullptr ? pullTyped (tag, *source) : std::nullopt;
+
+            if (typed.has_value())
+                t = static_cast<T> (*typed);
+            else
+                failed = true;
+        }
+
+        JSONReader& getArrayReader()
+        {
+            return bufferedArray.has_value() ? *bufferedArray : reader;
+        }
+
+        JSONReader* getNextElementSource()
+        {
+            auto& source = getArrayReader();
+
+            if (source.peek() != Token::endArray)
+                return &source;
+
+            failed = true;
+            return nullptr;
+        }
+
+        JSONReader* getNextValueSource()
+        {
+            switch (mode)
+            {
+                case Mode::unstarted:   mode = Mode::consumed; return &reader;
+                case Mode::array:       return getNextElementSource();
+                case Mode::object:
+                case Mode::consumed:    break;
+            }
+
+            failed = true;
+            return nullptr;
+        }
+
+        bool readNextName()
+        {
+            switch (reader.next())
+            {
+                case Token::propertyName:   hasCurrentName = true;  return true;
+                case Token::endObject:      objectFinished = true;  return true;
+
+                case Token::beginObject:
+                case Token::beginArray:
+                case Token::endArray:
+                case Token::null:
+                case Token::boolean:
+                case Token::integer:
+                case Token::floatingPoint:
+                case Token::string:
+                case Token::endOfInput:
+                case Token::error:
+                    break;
+            }
+
+            failed = true;
+            return false;
+        }
+
+        bool bufferCurrentMember()
+        {
+            std::string name (reader.getStringView());
+            auto memberReader = reader.readValueAsReader();
+            hasCurrentName = false;
+
+            if (! memberReader.has_value())
+            {
+                failed = true;
+                return false;
+            }
+
+            pendingMembers.emplace_back (std::move (name), std::move (*memberReader));
+            return true;
+        }
+
+        void finish()
+        {
+            switch (mode)
+            {
+                case Mode::unstarted:
+                    failed = ! reader.skipValue();
+                    break;
+
+                case Mode::object:
+                    while (! failed && ! objectFinished)
+                    {
+                        if (hasCurrentName)
+                        {
+                            hasCurrentName = false;
+                            failed = ! reader.skipValue();
+                        }
+                        else
+                        {
+                            readNextName();
+                        }
+                    }
+
+                    break;
+
+                case Mode::array:
+                {
+                    auto& source = getArrayReader();
+
+                    while (! failed && source.peek() != Token::endArray)
+                        failed = ! source.skipValue();
+
+                    failed = failed || source.next() != Token::endArray;
+                    break;
+                }
+
+                case Mode::consumed:
+                    break;
+            }
+        }
+
+        JSONReader& reader;
+        std::optional<JSONReader> bufferedArray;
+        std::vector<std::pair<std::string, JSONReader>> pendingMembers;
+        std::optional<int> version;
+        Mode mode = Mode::unstarted;
+        bool hasCurrentName = false, objectFinished = false, failed = false;
+    };
+};
+
 //==============================================================================
 /**
     This template-overloaded class can be used to convert between var and custom types.
@@ -592,6 +592,133 @@ public:
                 expect (FromVar::convert<TypeWithInnerVar> (objectWithPayload) == TypeWithInnerVar { 404, payload });
             }
         }
+
+        beginTest ("ToJSON");
+        {
+            const auto check = [this] (const auto& value)
+            {
+                const auto asVar = ToVar::convert (value);
+
+                for (auto spacing : { JSON::Spacing::none, JSON::Spacing::singleLine, JSON::Spacing::multiLine })
+                {
+                    const auto format = JSON::FormatOptions{}.withSpacing (spacing);
+                    const auto asText = ToJSON::toString (value, format);
+                    expect (asText.has_value() && asVar.has_value());
+                    expectEquals (asText.value_or (String()), JSON::toString (asVar.value_or (var()), format));
+                }
+            };
+
+            check (false);
+            check (1);
+            check (5.0f);
+            check (String ("hello world"));
+            check (std::vector<int> { 1, 2, 3 });
+            check (std::vector<std::vector<int>> { {}, { 1 }, { 2, 3 } });
+            check (TypeWithExternalUnifiedSerialisation { 7, "hello world", { 5, 6, 7 }, { { "foo", 4 }, { "bar", 5 } } });
+            check (TypeWithInternalUnifiedSerialisation { 7.89, 4.321f, "custom string", { "foo", "bar", "baz" } });
+            check (TypeWithExternalSplitSerialisation { "string", { 1, 2, 3 } });
+            check (TypeWithExternalSplitSerialisation { std::nullopt, {} });
+            check (TypeWithInternalSplitSerialisation { "string", { 16, 32, 48 } });
+            check (TypeWithVersionedSerialisation { 1, 2, 3, 4 });
+            check (TypeWithRawVarFirst { 200, "success", JSONUtils::makeObject ({ { "status", 123.456 }, { "extended", true } }) });
+            check (TypeWithInnerVar { 404, var (Array<var> { 1, "two", var() }) });
+
+            expectEquals (ToJSON::toString (TypeWithVersionedSerialisation { 1, 2, 3, 4 },
+                                            JSON::FormatOptions{}.withSpacing (JSON::Spacing::none),
+                                            ToJSON::Options{}.withExplicitVersion (1)).value_or (String()),
+                          String ("{\"__version__\":1,\"a\":1,\"b\":2}"));
+            expect (! ToJSON::toString (TypeWithVersionedSerialisation { 1, 2, 3, 4 }, {}, ToJSON::Options{}.withExplicitVersion (4)).has_value());
+
+            expect (! ToJSON::toString (TypeWithBrokenObjectSerialisation { 1, 2 }).has_value());
+            expect (! ToJSON::toString (TypeWithBrokenPrimitiveSerialisation { 1, 2 }).has_value());
+            expect (! ToJSON::toString (TypeWithBrokenArraySerialisation {}).has_value());
+            expect (! ToJSON::toString (TypeWithBrokenNestedSerialisation {}).has_value());
+        }
+
+        beginTest ("FromJSON");
+        {
+            const auto roundTrip = [this] (const auto& value)
+            {
+                using Type = std::decay_t<decltype (value)>;
+                const auto text = ToJSON::toString (value).value_or (String());
+
+                expect (FromJSON::convert<Type> (text) == value);
+
+                MemoryInputStream stream (text.toRawUTF8(), text.getNumBytesAsUTF8(), false);
+                JSONReader reader (stream, 7);
+                expect (FromJSON::convert<Type> (reader) == value);
+                expect (reader.next() == JSONReader::Token::endOfInput);
+            };
+
+            roundTrip (true);
+            roundTrip (42);
+            roundTrip (String ("hello world"));
+            roundTrip (std::vector<int> { 1, 2, 3 });
+            roundTrip (std::vector<std::vector<int>> { {}, { 1 }, { 2, 3 } });
+            roundTrip (std::map<std::string, std::vector<String>> { { "a", { "x", "y" } }, { "b", {} } });
+            roundTrip (TypeWithExternalUnifiedSerialisation { 7, "hello world", { 5, 6, 7 }, { { "foo", 4 }, { "bar", 5 } } });
+            roundTrip (TypeWithInternalUnifiedSerialisation { 7.89, 4.321f, "custom string", { "foo", "bar", "baz" } });
+            roundTrip (TypeWithExternalSplitSerialisation { "string", { 1, 2, 3 } });
+            roundTrip (TypeWithInternalSplitSerialisation { "string", { 16, 32, 48 } });
+            roundTrip (TypeWithVersionedSerialisation { 1, 2, 3, 4 });
+            roundTrip (TypeWithRawVarLast { 200, "success", "another string" });
+            roundTrip (TypeWithRawVarFirst { 200, "success", "another string" });
+
+            expect (FromJSON::convert<bool> (String ("1")) == true);
+            expect (FromJSON::convert<int> (String ("1.5")) == std::nullopt);
+            expect (FromJSON::convert<double> (String ("1.5")) == 1.5);
+            expect (FromJSON::convert<std::vector<int>> (String ("[1, 2, \"3\"]")) == std::nullopt);
+
+            // Members in a different order to the one in which they're visited
+            expect (FromJSON::convert<TypeWithExternalUnifiedSerialisation> (String (R"({ "d": [{ "second": 5, "first": "bar" }], "c": [5], "__version__": 2, "b": "hello", "a": 7 })"))
+                    == TypeWithExternalUnifiedSerialisation { 7, "hello", { 5 }, { { "bar", 5 } } });
+
+            // Versions are detected even when they don't come first
+            for (const auto* text : { R"({ "a": 1, "b": 2, "__version__": 1, "c": 3, "d": 4 })",
+                                      R"({ "__version__": 1, "a": 1, "b": 2, "c": 3, "d": 4 })" })
+            {
+                const String asString (text);
+                expect (FromJSON::convert<TypeWithVersionedSerialisation> (asString) == TypeWithVersionedSerialisation { 1, 2, 0, 0 });
+                expect (FromJSON::convert<TypeWithVersionedSerialisation> (asString)
+                        == FromVar::convert<TypeWithVersionedSerialisation> (JSON::parse (asString)));
+            }
+
+            // Unused members and trailing array elements are skipped
+            {
+                const String text (R"([{ "eventId": 1, "unused": [1, 2, { "x": 3 }], "payload": { "foo": [1] } }, 2] [3])");
+                JSONReader reader (text.toRawUTF8(), text.getNumBytesAsUTF8());
+                const auto payload = JSON::parse (R"({ "foo": [1] })");
+
+                reader.next();
+                const auto converted = FromJSON::convert<TypeWithInnerVar> (reader);
+                expect (converted.has_value() && converted->eventId == 1);
+                expectDeepEqual (converted.has_value() ? converted->payload : var(), payload);
+                expect (reader.next() == JSONReader::Token::integer);
+                expect (reader.next() == JSONReader::Token::endArray);
+                expect (FromJSON::convert<std::vector<int>> (reader) == std::vector<int> { 3 });
+            }
+
+            expect (FromJSON::convert<TypeWithInternalUnifiedSerialisation> (String (R"({ "a": 7.89, "b": 4.321 })")) == std::nullopt);
+            expect (FromJSON::convert<TypeWithBrokenObjectSerialisation> (String ("null")) == std::nullopt);
+            expect (FromJSON::convert<TypeWithBrokenPrimitiveSerialisation> (String ("null")) == std::nullopt);
+            expect (FromJSON::convert<TypeWithBrokenArraySerialisation> (String ("null")) == std::nullopt);
+            expect (FromJSON::convert<TypeWithBrokenNestedSerialisation> (String ("null")) == std::nullopt);
+            expect (FromJSON::convert<TypeWithBrokenDynamicSerialisation> (String ("null")) == std::nullopt);
+            expect (FromJSON::convert<TypeWithExternalUnifiedSerialisation> (String (R"({ "a": 7, "b": "x", "c": [1, )")) == std::nullopt);
+        }
+
+        beginTest ("FromJSON file");
+        {
+            const TypeWithExternalUnifiedSerialisation value { 7, "hello world", { 5, 6, 7 }, { { "foo", 4 } } };
+            TemporaryFile temp;
+
+            {
+                FileOutputStream out (temp.getFile());
+                expect (out.openedOk() && ToJSON::write (out, value));
+            }
+
+            expect (FromJSON::convert<TypeWithExternalUnifiedSerialisation> (temp.getFile()) == value);
+        }
     }
 
 private:
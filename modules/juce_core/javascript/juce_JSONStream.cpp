@@ -0,0 +1,1135 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+JSONReader::JSONReader() = default;
+
+JSONReader::JSONReader (InputStream& source, size_t blockSizeToUse)
+    : stream (&source),
+      streamBuffer (jmax ((size_t) 16, blockSizeToUse)),
+      blockSize (jmax ((size_t) 16, blockSizeToUse))
+{
+    start = position = end = streamBuffer.get();
+}
+
+JSONReader::JSONReader (const void* utf8Data, size_t numBytes)
+    : start (static_cast<const char*> (utf8Data)),
+      position (start),
+      end (start + numBytes)
+{
+    if (numBytes >= 3 && CharPointer_UTF8::isByteOrderMark (start))
+    {
+        position += 3;
+        lineStartOffset = 3;
+    }
+}
+
+JSONReader::~JSONReader() = default;
+JSONReader::JSONReader (JSONReader&&) = default;
+JSONReader& JSONReader::operator= (JSONReader&&) = default;
+
+//==============================================================================
+bool JSONReader::refill()
+{
+    if (stream == nullptr)
+        return false;
+
+    const auto isFirstBlock = (bytesBeforeBlock == 0 && end == streamBuffer.get());
+    bytesBeforeBlock += (int64) (end - start);
+
+    const auto numRead = stream->read (streamBuffer, (int) blockSize);
+    start = position = streamBuffer.get();
+    end = start + jmax (0, numRead);
+
+    if (isFirstBlock && numRead >= 3 && CharPointer_UTF8::isByteOrderMark (start))
+    {
+        position += 3;
+        lineStartOffset = 3;
+    }
+
+    return position < end;
+}
+
+int JSONReader::peekByte()
+{
+    if (position == end && ! refill())
+        return -1;
+
+    return (uint8) *position;
+}
+
+int JSONReader::readByte()
+{
+    if (position == end && ! refill())
+        return -1;
+
+    return (uint8) *position++;
+}
+
+void JSONReader::skipWhitespace()
+{
+    for (;;)
+    {
+        switch (peekByte())
+        {
+            case ' ':
+            case '\t':
+            case '\r':
+                ++position;
+                break;
+
+            case '\n':
+                ++position;
+                ++line;
+                lineStartOffset = bytesBeforeBlock + (int64) (position - start);
+                break;
+
+            default:
+                return;
+        }
+    }
+}
+
+JSONReader::Token JSONReader::fail (const char* message)
+{
+    if (! failed)
+    {
+        failed = true;
+        errorMessage = message;
+        errorLine = line;
+        errorColumn = (int) (bytesBeforeBlock + (int64) (position - start) - lineStartOffset) + 1;
+    }
+
+    return Token::error;
+}
+
+Result JSONReader::getResult() const
+{
+    if (! failed)
+        return Result::ok();
+
+    return Result::fail (String (errorLine) + ":" + String (errorColumn) + ": error: " + errorMessage);
+}
+
+String JSONReader::getString() const
+{
+    return String::fromUTF8 (stringValue.data(), (int) stringValue.size());
+}
+
+//==============================================================================
+JSONReader::Token JSONReader::next()
+{
+    if (failed)
+        return Token::error;
+
+    if (peeked.has_value())
+    {
+        const auto result = *peeked;
+        peeked.reset();
+        return result;
+    }
+
+    return readToken();
+}
+
+JSONReader::Token JSONReader::peek()
+{
+    if (failed)
+        return Token::error;
+
+    if (! peeked.has_value())
+        peeked = readToken();
+
+    return *peeked;
+}
+
+JSONReader::Token JSONReader::readToken()
+{
+    skipWhitespace();
+    const auto c = peekByte();
+    tokenStart = position;
+
+    if (stack.empty())
+    {
+        if (c < 0)
+            return Token::endOfInput;
+
+        ++position;
+        return readValueToken (c);
+    }
+
+    auto& frame = stack.back();
+
+    switch (frame.expect)
+    {
+        case Expect::firstValueOrEnd:
+            if (c == ']')
+            {
+                ++position;
+                stack.pop_back();
+                return Token::endArray;
+            }
+
+            JUCE_FALLTHROUGH
+
+        case Expect::value:
+            if (c < 0)
+                return fail ("Unexpected EOF");
+
+            ++position;
+            frame.expect = Expect::commaOrEnd;
+            return readValueToken (c);
+
+        case Expect::commaOrEnd:
+            if (c == (frame.isObject ? '}' : ']'))
+            {
+                const auto wasObject = frame.isObject;
+                ++position;
+                stack.pop_back();
+                return wasObject ? Token::endObject : Token::endArray;
+            }
+
+            if (c == ',')
+            {
+                ++position;
+                frame.expect = frame.isObject ? Expect::name : Expect::value;
+                return readToken();
+            }
+
+            if (c < 0)
+                return fail (frame.isObject ? "Unexpected EOF in object declaration" : "Unexpected EOF in array declaration");
+
+            return fail (frame.isObject ? "Expected ',' or '}'" : "Expected ',' or ']'");
+
+        case Expect::firstNameOrEnd:
+            if (c == '}')
+            {
+                ++position;
+                stack.pop_back();
+                return Token::endObject;
+            }
+
+            JUCE_FALLTHROUGH
+
+        case Expect::name:
+        {
+            if (c != '"')
+                return fail (c < 0 ? "Unexpected EOF in object declaration"
+                                   : "Expected a property name in double-quotes");
+
+            ++position;
+
+            if (readStringToken ('"', Token::propertyName) == Token::error)
+                return Token::error;
+
+            skipWhitespace();
+
+            if (peekByte() != ':')
+                return fail ("Expected ':'");
+
+            ++position;
+            frame.expect = Expect::value;
+            return Token::propertyName;
+        }
+    }
+
+    return fail ("Syntax error");
+}
+
+JSONReader::Token JSONReader::readValueToken (int firstByte)
+{
+    switch (firstByte)
+    {
+        case '{':   stack.push_back ({ true, Expect::firstNameOrEnd }); return Token::beginObject;
+        case '[':   stack.push_back ({ false, Expect::firstValueOrEnd }); return Token::beginArray;
+        case '"':   return readStringToken ('"', Token::string);
+        case '\'':  return readStringToken ('\'', Token::string);
+        case 't':   intValue = 1; return readLiteral ("rue", Token::boolean);
+        case 'f':   intValue = 0; return readLiteral ("alse", Token::boolean);
+        case 'n':   return readLiteral ("ull", Token::null);
+
+        case '-':
+        case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+            return readNumberToken (firstByte);
+
+        default:
+            break;
+    }
+
+    return fail ("Syntax error");
+}
+
+JSONReader::Token JSONReader::readLiteral (const char* rest, Token type)
+{
+    while (*rest != 0)
+        if (readByte() != *rest++)
+            return fail ("Syntax error");
+
+    return type;
+}
+
+void JSONReader::appendUTF8 (juce_wchar c)
+{
+    char buffer[4];
+    const auto numBytes = CharPointer_UTF8::getBytesRequiredFor (c);
+    CharPointer_UTF8 (buffer).write (c);
+    scratch.insert (scratch.end(), buffer, buffer + numBytes);
+}
+
+JSONReader::Token JSONReader::readStringToken (int quote, Token type)
+{
+    // When reading from memory, strings without escape sequences can be
+    // returned directly from the source text.
+    if (stream == nullptr)
+    {
+        for (auto* p = position; p < end; ++p)
+        {
+            if (*p == (char) quote)
+            {
+                stringValue = std::string_view (position, (size_t) (p - position));
+                position = p + 1;
+                return type;
+            }
+
+            if (*p == '\\')
+                break;
+        }
+    }
+
+    scratch.clear();
+    juce_wchar pendingHighSurrogate = 0;
+
+    const auto flushSurrogate = [&]
+    {
+        if (pendingHighSurrogate != 0)
+            appendUTF8 (std::exchange (pendingHighSurrogate, 0));
+    };
+
+    for (;;)
+    {
+        auto c = readByte();
+
+        if (c < 0)
+            return fail ("Unexpected EOF in string constant");
+
+        if (c == quote)
+            break;
+
+        if (c != '\\')
+        {
+            flushSurrogate();
+            scratch.push_back ((char) c);
+            continue;
+        }
+
+        c = readByte();
+
+        if (c == 'u')
+        {
+            juce_wchar unit = 0;
+
+            for (int i = 0; i < 4; ++i)
+            {
+                const auto digitValue = CharacterFunctions::getHexDigitValue ((juce_wchar) readByte());
+
+                if (digitValue < 0)
+                    return fail ("Syntax error in unicode escape sequence");
+
+                unit = (juce_wchar) ((unit << 4) + (juce_wchar) digitValue);
+            }
+
+            if (pendingHighSurrogate != 0 && unit >= 0xdc00 && unit < 0xe000)
+            {
+                appendUTF8 (0x10000 + ((pendingHighSurrogate - 0xd800) << 10) + (unit - 0xdc00));
+                pendingHighSurrogate = 0;
+                continue;
+            }
+
+            flushSurrogate();
+
+            if (unit >= 0xd800 && unit < 0xdc00)
+                pendingHighSurrogate = unit;
+            else
+                appendUTF8 (unit);
+
+            continue;
+        }
+
+        flushSurrogate();
+
+        switch (c)
+        {
+            case -1:   return fail ("Unexpected EOF in string constant");
+            case 'a':  c = '\a'; break;
+            case 'b':  c = '\b'; break;
+            case 'f':  c = '\f'; break;
+            case 'n':  c = '\n'; break;
+            case 'r':  c = '\r'; break;
+            case 't':  c = '\t'; break;
+            default:   break;
+        }
+
+        scratch.push_back ((char) c);
+    }
+
+    flushSurrogate();
+    stringValue = std::string_view (scratch.data(), scratch.size());
+    return type;
+}
+
+JSONReader::Token JSONReader::readNumberToken (int firstByte)
+{
+    numberLength = 0;
+    numberText[numberLength++] = (char) firstByte;
+    auto isFloat = false;
+
+    for (;;)
+    {
+        const auto c = peekByte();
+
+        if ((c >= '0' && c <= '9') || c == '-' || c == '+')
+        {
+        }
+        else if (c == '.' || c == 'e' || c == 'E')
+        {
+            isFloat = true;
+        }
+        else if (c < 0 || c == ',' || c == '}' || c == ']' || CharacterFunctions::isWhitespace ((char) c))
+        {
+            break;
+        }
+        else
+        {
+            return fail ("Syntax error in number");
+        }
+
+        if (numberLength >= (int) numElementsInArray (numberText) - 1)
+            return fail ("Syntax error in number");
+
+        numberText[numberLength++] = (char) c;
+        ++position;
+    }
+
+    numberText[numberLength] = 0;
+
+    // Check that the text follows the JSON number grammar before converting it
+    {
+        auto* p = numberText;
+        const auto skipDigits = [&p] { auto* s = p; while (*p >= '0' && *p <= '9') ++p; return p != s; };
+
+        if (*p == '-')
+            ++p;
+
+        auto valid = skipDigits();
+
+        if (valid && *p == '.')
+        {
+            ++p;
+            valid = skipDigits();
+        }
+
+        if (valid && (*p == 'e' || *p == 'E'))
+        {
+            ++p;
+
+            if (*p == '+' || *p == '-')
+                ++p;
+
+            valid = skipDigits();
+        }
+
+        if (! valid || *p != 0)
+            return fail ("Syntax error in number");
+    }
+
+    if (! isFloat)
+    {
+        const auto isNegative = numberText[0] == '-';
+        const auto limit = (uint64) std::numeric_limits<int64>::max() + (isNegative ? 1 : 0);
+        uint64 magnitude = 0;
+        auto overflowed = false;
+
+        for (auto* p = numberText + (isNegative ? 1 : 0); *p != 0; ++p)
+        {
+            const auto digit = (uint64) (*p - '0');
+
+            if (magnitude > (limit - digit) / 10)
+            {
+                overflowed = true;
+                break;
+            }
+
+            magnitude = magnitude * 10 + digit;
+        }
+
+        if (! overflowed)
+        {
+            intValue = isNegative ? (int64) (0 - magnitude) : (int64) magnitude;
+            doubleValue = (double) intValue;
+            return Token::integer;
+        }
+    }
+
+    CharPointer_ASCII text (numberText);
+    doubleValue = CharacterFunctions::readDoubleValue (text);
+    return Token::floatingPoint;
+}
+
+//==============================================================================
+bool JSONReader::skipValue()
+{
+    if (peek() == Token::propertyName)
+        next();
+
+    switch (next())
+    {
+        case Token::beginObject:
+        case Token::beginArray:
+        {
+            const auto depth = getDepth();
+
+            for (;;)
+            {
+                const auto token = next();
+
+                if (token == Token::error || token == Token::endOfInput)
+                    return false;
+
+                if (getDepth() < depth)
+                    return true;
+            }
+        }
+
+        case Token::string:
+        case Token::integer:
+        case Token::floatingPoint:
+        case Token::boolean:
+        case Token::null:
+            return true;
+
+        case Token::propertyName:
+        case Token::endObject:
+        case Token::endArray:
+        case Token::endOfInput:
+        case Token::error:
+            break;
+    }
+
+    return false;
+}
+
+std::optional<size_t> JSONReader::getNextArraySize()
+{
+    if (stream != nullptr || peek() != Token::beginArray)
+        return std::nullopt;
+
+    JSONReader lookahead (tokenStart, (size_t) (end - tokenStart));
+    lookahead.next();
+
+    size_t numElements = 0;
+
+    while (lookahead.peek() != Token::endArray)
+    {
+        if (! lookahead.skipValue())
+            return std::nullopt;
+
+        ++numElements;
+    }
+
+    return numElements;
+}
+
+bool JSONReader::readRawValue (MemoryOutputStream& dest)
+{
+    JSONWriter writer (dest, JSON::FormatOptions{}.withSpacing (JSON::Spacing::none));
+
+    do
+    {
+        switch (next())
+        {
+            case Token::beginObject:    writer.beginObject(); break;
+            case Token::endObject:      writer.endObject(); break;
+            case Token::beginArray:     writer.beginArray(); break;
+            case Token::endArray:       writer.endArray(); break;
+            case Token::propertyName:   writer.writeName (stringValue.data(), stringValue.size()); break;
+            case Token::string:         writer.writeString (getString()); break;
+            case Token::integer:        writer.writeInt (intValue); break;
+            case Token::floatingPoint:  writer.writeDouble (doubleValue); break;
+            case Token::boolean:        writer.writeBool (getBool()); break;
+            case Token::null:           writer.writeNull(); break;
+
+            case Token::endOfInput:
+            case Token::error:
+                fail ("Unexpected EOF");
+                return false;
+        }
+    }
+    while (writer.getDepth() > 0);
+
+    return true;
+}
+
+std::optional<JSONReader> JSONReader::readValueAsReader()
+{
+    if (peek() == Token::propertyName)
+        next();
+
+    switch (peek())
+    {
+        case Token::endObject:
+        case Token::endArray:
+        case Token::endOfInput:
+        case Token::error:
+        case Token::propertyName:
+            return std::nullopt;
+
+        case Token::beginObject:
+        case Token::beginArray:
+        case Token::string:
+        case Token::integer:
+        case Token::floatingPoint:
+        case Token::boolean:
+        case Token::null:
+            break;
+    }
+
+    if (stream == nullptr)
+    {
+        auto* valueStart = tokenStart;
+
+        if (! skipValue())
+            return std::nullopt;
+
+        return JSONReader (valueStart, (size_t) (position - valueStart));
+    }
+
+    MemoryOutputStream raw;
+
+    if (! readRawValue (raw))
+        return std::nullopt;
+
+    JSONReader result;
+    result.ownedData = raw.getMemoryBlock();
+    result.start = result.position = static_cast<const char*> (result.ownedData.getData());
+    result.end = result.start + result.ownedData.getSize();
+    return result;
+}
+
+std::optional<var> JSONReader::readValueAsVar()
+{
+    if (peek() == Token::propertyName)
+        next();
+
+    switch (next())
+    {
+        case Token::beginObject:
+        {
+            auto* object = new DynamicObject();
+            var result (object);
+
+            for (;;)
+            {
+                const auto token = next();
+
+                if (token == Token::endObject)
+                    return result;
+
+                if (token != Token::propertyName)
+                    return std::nullopt;
+
+                const Identifier name (getString());
+
+                if (! name.isValid())
+                {
+                    fail ("Invalid property name");
+                    return std::nullopt;
+                }
+
+                auto value = readValueAsVar();
+
+                if (! value.has_value())
+                    return std::nullopt;
+
+                object->setProperty (name, std::move (*value));
+            }
+        }
+
+        case Token::beginArray:
+        {
+            Array<var> array;
+
+            while (peek() != Token::endArray)
+            {
+                auto value = readValueAsVar();
+
+                if (! value.has_value())
+                    return std::nullopt;
+
+                array.add (std::move (*value));
+            }
+
+            next();
+            return var (std::move (array));
+        }
+
+        case Token::string:         return var (getString());
+        case Token::floatingPoint:  return var (doubleValue);
+        case Token::boolean:        return var (getBool());
+        case Token::null:           return var();
+
+        case Token::integer:
+            return (intValue >= -0x7fffffff && intValue <= 0x7fffffff) ? var ((int) intValue)
+                                                                       : var (intValue);
+
+        case Token::propertyName:
+        case Token::endObject:
+        case Token::endArray:
+        case Token::endOfInput:
+        case Token::error:
+            break;
+    }
+
+    return std::nullopt;
+}
+
+//==============================================================================
+JSONWriter::JSONWriter (OutputStream& destination, const JSON::FormatOptions& formatToUse)
+    : out (destination), format (formatToUse)
+{
+}
+
+JSONWriter::~JSONWriter() = default;
+
+void JSONWriter::writeSeparator (const Frame& frame)
+{
+    const auto spacing = format.getSpacing();
+
+    if (frame.numItems > 0)
+    {
+        out << ',';
+
+        if (spacing == JSON::Spacing::singleLine)
+            out << ' ';
+        else if (spacing == JSON::Spacing::multiLine)
+            out << newLine;
+    }
+    else if (! frame.isObject && spacing == JSON::Spacing::multiLine)
+    {
+        out << newLine;
+    }
+
+    if (spacing == JSON::Spacing::multiLine)
+        JSONFormatter::writeSpaces (out, frame.indent + JSONFormatter::indentSize);
+}
+
+int JSONWriter::prepareForValue()
+{
+    if (stack.empty())
+    {
+        if (numTopLevelValues++ > 0)
+            out << newLine;
+
+        return format.getIndentLevel();
+    }
+
+    auto& frame = stack.back();
+
+    if (frame.isObject)
+    {
+        // Each member of an object must be preceded by a call to writeName()!
+        jassert (frame.hasName);
+        frame.hasName = false;
+    }
+    else
+    {
+        writeSeparator (frame);
+        ++frame.numItems;
+    }
+
+    return frame.indent + JSONFormatter::indentSize;
+}
+
+void JSONWriter::beginObject()
+{
+    const auto indent = prepareForValue();
+    out << '{';
+
+    if (format.getSpacing() == JSON::Spacing::multiLine)
+        out << newLine;
+
+    stack.push_back ({ true, 0, indent, false });
+}
+
+void JSONWriter::endObject()
+{
+    // endObject() must match a call to beginObject(), and can't follow a writeName()
+    jassert (! stack.empty() && stack.back().isObject && ! stack.back().hasName);
+
+    const auto frame = stack.back();
+    stack.pop_back();
+
+    if (format.getSpacing() == JSON::Spacing::multiLine)
+    {
+        if (frame.numItems > 0)
+            out << newLine;
+
+        JSONFormatter::writeSpaces (out, frame.indent);
+    }
+
+    out << '}';
+}
+
+void JSONWriter::beginArray()
+{
+    const auto indent = prepareForValue();
+    out << '[';
+    stack.push_back ({ false, 0, indent, false });
+}
+
+void JSONWriter::endArray()
+{
+    // endArray() must match a call to beginArray()
+    jassert (! stack.empty() && ! stack.back().isObject);
+
+    const auto frame = stack.back();
+    stack.pop_back();
+
+    if (frame.numItems > 0 && format.getSpacing() == JSON::Spacing::multiLine)
+    {
+        out << newLine;
+        JSONFormatter::writeSpaces (out, frame.indent);
+    }
+
+    out << ']';
+}
+
+void JSONWriter::beginName()
+{
+    // Names can only be written inside an object, and each name must be followed by a value
+    jassert (! stack.empty() && stack.back().isObject && ! stack.back().hasName);
+
+    auto& frame = stack.back();
+    writeSeparator (frame);
+    ++frame.numItems;
+    frame.hasName = true;
+
+    out << '"';
+}
+
+void JSONWriter::endName()
+{
+    out << "\":";
+
+    if (format.getSpacing() != JSON::Spacing::none)
+        out << ' ';
+}
+
+void JSONWriter::writeName (StringRef name)
+{
+    beginName();
+    JSONFormatter::writeString (out, name.text);
+    endName();
+}
+
+void JSONWriter::writeName (const char* utf8Text, size_t numBytes)
+{
+    const auto needsEscaping = std::any_of (utf8Text, utf8Text + numBytes, [] (char c)
+    {
+        return c < 32 || c >= 127 || c == '"' || c == '\\';
+    });
+
+    if (needsEscaping)
+    {
+        writeName (String::fromUTF8 (utf8Text, (int) numBytes));
+        return;
+    }
+
+    beginName();
+    out.write (utf8Text, numBytes);
+    endName();
+}
+
+void JSONWriter::writeNull()
+{
+    prepareForValue();
+    out << "null";
+}
+
+void JSONWriter::writeBool (bool value)
+{
+    prepareForValue();
+    out << (value ? "true" : "false");
+}
+
+void JSONWriter::writeInt (int64 value)
+{
+    prepareForValue();
+    out << value;
+}
+
+void JSONWriter::writeDouble (double value)
+{
+    prepareForValue();
+
+    if (juce_isfinite (value))
+        out << serialiseDouble (value);
+    else
+        out << "null";
+}
+
+void JSONWriter::writeString (StringRef value)
+{
+    prepareForValue();
+    out << '"';
+    JSONFormatter::writeString (out, value.text);
+    out << '"';
+}
+
+void JSONWriter::writeValue (const var& value)
+{
+    const auto indent = prepareForValue();
+    JSON::writeToStream (out, value, format.withIndentLevel (indent));
+}
+
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class JSONStreamTests final : public UnitTest
+{
+public:
+    JSONStreamTests()
+        : UnitTest ("JSONStream", UnitTestCategories::json)
+    {}
+
+    static void copyTokens (JSONReader& reader, JSONWriter& writer)
+    {
+        for (;;)
+        {
+            switch (reader.next())
+            {
+                case JSONReader::Token::beginObject:    writer.beginObject(); break;
+                case JSONReader::Token::endObject:      writer.endObject(); break;
+                case JSONReader::Token::beginArray:     writer.beginArray(); break;
+                case JSONReader::Token::endArray:       writer.endArray(); break;
+                case JSONReader::Token::propertyName:   writer.writeName (reader.getString()); break;
+                case JSONReader::Token::string:         writer.writeString (reader.getString()); break;
+                case JSONReader::Token::integer:        writer.writeInt (reader.getInt64()); break;
+                case JSONReader::Token::floatingPoint:  writer.writeDouble (reader.getDouble()); break;
+                case JSONReader::Token::boolean:        writer.writeBool (reader.getBool()); break;
+                case JSONReader::Token::null:           writer.writeNull(); break;
+
+                case JSONReader::Token::endOfInput:
+                case JSONReader::Token::error:
+                    return;
+            }
+        }
+    }
+
+    static String reformat (const String& text, const JSON::FormatOptions& format, int blockSize)
+    {
+        MemoryOutputStream result;
+        JSONWriter writer (result, format);
+
+        if (blockSize > 0)
+        {
+            MemoryInputStream stream (text.toRawUTF8(), text.getNumBytesAsUTF8(), false);
+            JSONReader reader (stream, (size_t) blockSize);
+            copyTokens (reader, writer);
+        }
+        else
+        {
+            JSONReader reader (text.toRawUTF8(), text.getNumBytesAsUTF8());
+            copyTokens (reader, writer);
+        }
+
+        return result.toUTF8();
+    }
+
+    static Result getErrorFor (const String& text)
+    {
+        JSONReader reader (text.toRawUTF8(), text.getNumBytesAsUTF8());
+
+        for (;;)
+        {
+            const auto token = reader.next();
+
+            if (token == JSONReader::Token::endOfInput || token == JSONReader::Token::error)
+                return reader.getResult();
+        }
+    }
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        const JSON::FormatOptions formats[] { JSON::FormatOptions{}.withSpacing (JSON::Spacing::none),
+                                              JSON::FormatOptions{}.withSpacing (JSON::Spacing::singleLine),
+                                              JSON::FormatOptions{}.withSpacing (JSON::Spacing::multiLine) };
+
+        beginTest ("Writer output matches JSON::toString");
+        {
+            for (int i = 0; i < 50; ++i)
+            {
+                const auto v = JSONTests::createRandomVar (r, 0);
+
+                for (const auto& format : formats)
+                {
+                    MemoryOutputStream mo;
+
+                    {
+                        JSONWriter writer (mo, format);
+                        writer.writeValue (v);
+                    }
+
+                    const auto expected = JSON::toString (v, format);
+                    expectEquals (mo.toUTF8(), expected);
+
+                    for (auto blockSize : { 0, 1, 7, 4096 })
+                        expectEquals (reformat (expected, format, blockSize), expected);
+                }
+            }
+        }
+
+        beginTest ("Reader produces vars");
+        {
+            for (int i = 0; i < 50; ++i)
+            {
+                const auto oneLine = r.nextBool();
+                const auto text = JSON::toString (JSONTests::createRandomVar (r, 0), oneLine);
+
+                JSONReader memoryReader (text.toRawUTF8(), text.getNumBytesAsUTF8());
+                const auto fromMemory = memoryReader.readValueAsVar();
+                expect (fromMemory.has_value() && JSON::toString (*fromMemory, oneLine) == text);
+                expect (memoryReader.next() == JSONReader::Token::endOfInput);
+
+                MemoryInputStream stream (text.toRawUTF8(), text.getNumBytesAsUTF8(), false);
+                JSONReader streamReader (stream, 3);
+                const auto fromStream = streamReader.readValueAsVar();
+                expect (fromStream.has_value() && JSON::toString (*fromStream, oneLine) == text);
+                expect (streamReader.next() == JSONReader::Token::endOfInput);
+            }
+        }
+
+        beginTest ("Tokens");
+        {
+            const String text (CharPointer_UTF8 ("\xef\xbb\xbf{ \"a\": [1, -2, 3.5e2, true, false, null], \"b\" : { }, \"c\": \"x\\n\\u00e9\\ud83d\\ude00\" }"));
+            JSONReader reader (text.toRawUTF8(), text.getNumBytesAsUTF8());
+
+            using Token = JSONReader::Token;
+            expect (reader.next() == Token::beginObject);
+            expect (reader.next() == Token::propertyName && reader.getStringView() == "a");
+            expect (reader.getNextArraySize() == std::optional<size_t> (6));
+            expect (reader.next() == Token::beginArray);
+            expect (reader.next() == Token::integer && reader.getInt64() == 1);
+            expect (reader.next() == Token::integer && reader.getInt64() == -2);
+            expect (reader.next() == Token::floatingPoint && exactlyEqual (reader.getDouble(), 350.0));
+            expect (reader.next() == Token::boolean && reader.getBool());
+            expect (reader.peek() == Token::boolean && ! reader.getBool());
+            expect (reader.next() == Token::boolean && ! reader.getBool());
+            expect (reader.next() == Token::null);
+            expect (reader.next() == Token::endArray);
+            expect (reader.skipValue());
+            expect (reader.next() == Token::propertyName && reader.getString() == "c");
+            expect (reader.next() == Token::string && reader.getString() == String (CharPointer_UTF8 ("x\n\xc3\xa9\xf0\x9f\x98\x80")));
+            expect (reader.next() == Token::endObject);
+            expect (reader.getDepth() == 0);
+            expect (reader.next() == Token::endOfInput);
+            expect (reader.getResult().wasOk());
+        }
+
+        beginTest ("Large integers");
+        {
+            const String text ("[9223372036854775807, -9223372036854775808, 9223372036854775808]");
+            JSONReader reader (text.toRawUTF8(), text.getNumBytesAsUTF8());
+
+            using Token = JSONReader::Token;
+            expect (reader.next() == Token::beginArray);
+            expect (reader.next() == Token::integer && reader.getInt64() == std::numeric_limits<int64>::max());
+            expect (reader.next() == Token::integer && reader.getInt64() == std::numeric_limits<int64>::min());
+            expect (reader.next() == Token::floatingPoint);
+        }
+
+        beginTest ("Multiple top-level values");
+        {
+            const String text ("{\"a\": 1}\n[2]\n3\n");
+
+            for (auto blockSize : { 0, 2 })
+                expectEquals (reformat (text, formats[0], blockSize), "{\"a\":1}" + String (newLine) + "[2]" + String (newLine) + "3");
+        }
+
+        beginTest ("Reading sub-values");
+        {
+            const String text ("{\"skip\": [1, {\"x\": [2, 3]}], \"keep\": {\"y\": [4, 5, 6]}}");
+            MemoryInputStream stream (text.toRawUTF8(), text.getNumBytesAsUTF8(), false);
+
+            JSONReader memoryReader (text.toRawUTF8(), text.getNumBytesAsUTF8());
+            JSONReader streamReader (stream, 5);
+
+            for (auto* reader : { &memoryReader, &streamReader })
+            {
+                expect (reader->next() == JSONReader::Token::beginObject);
+                expect (reader->skipValue());
+                expect (reader->next() == JSONReader::Token::propertyName);
+
+                auto sub = reader->readValueAsReader();
+                expect (sub.has_value());
+                expect (reader->next() == JSONReader::Token::endObject);
+
+                expect (sub->next() == JSONReader::Token::beginObject);
+                expect (sub->next() == JSONReader::Token::propertyName);
+                expect (sub->getNextArraySize() == std::optional<size_t> (3));
+                expect (sub->skipValue());
+                expect (sub->next() == JSONReader::Token::endObject);
+                expect (sub->next() == JSONReader::Token::endOfInput);
+            }
+        }
+
+        beginTest ("Errors");
+        {
+            expect (getErrorFor ("[1, 2").getErrorMessage().contains ("Unexpected EOF"));
+            expectEquals (getErrorFor ("[1,\n 2 3]").getErrorMessage(), String ("2:4: error: Expected ',' or ']'"));
+            expectEquals (getErrorFor ("{\"a\" 1}").getErrorMessage(), String ("1:6: error: Expected ':'"));
+            expect (getErrorFor ("{1: 2}").getErrorMessage().contains ("Expected a property name in double-quotes"));
+            expect (getErrorFor ("[1.2.3]").getErrorMessage().contains ("Syntax error in number"));
+            expect (getErrorFor ("[-]").getErrorMessage().contains ("Syntax error in number"));
+            expect (getErrorFor ("[tru]").getErrorMessage().contains ("Syntax error"));
+            expect (getErrorFor ("[\"\\u12x4\"]").getErrorMessage().contains ("unicode escape"));
+            expect (getErrorFor ("[\"abc").getErrorMessage().contains ("Unexpected EOF in string constant"));
+
+            JSONReader reader ("]", 1);
+            expect (reader.next() == JSONReader::Token::error);
+            expect (reader.next() == JSONReader::Token::error);
+            expect (! reader.readValueAsVar().has_value());
+        }
+    }
+};
+
+static JSONStreamTests jsonStreamTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,350 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A pull-based tokeniser for JSON-formatted text.
+
+    Unlike JSON::parse(), which builds a complete tree of var objects, a JSONReader
+    hands back one token at a time, so arbitrarily large documents can be processed
+    without holding more than a small read buffer in memory.
+
+    The reader can either pull data from an InputStream in fixed-size blocks, or it
+    can read directly from a block of memory (for example, the contents of a
+    MemoryMappedFile), in which case the text is never copied at all.
+
+    The input is expected to be UTF-8 encoded. Several top-level values may follow
+    one another in the same input (e.g. newline-delimited JSON), in which case
+    next() will simply continue with the next value, and will only return
+    Token::endOfInput once all of the input has been consumed.
+
+    @code
+    JSONReader reader (inputStream);
+
+    for (auto token = reader.next(); token != JSONReader::Token::endOfInput; token = reader.next())
+    {
+        if (token == JSONReader::Token::error)
+        {
+            DBG (reader.getResult().getErrorMessage());
+            break;
+        }
+
+        if (token == JSONReader::Token::propertyName && reader.getStringView() == "gain")
+            if (reader.next() == JSONReader::Token::floatingPoint)
+                gain = reader.getDouble();
+    }
+    @endcode
+
+    @see JSONWriter, JSON, FromJSON
+
+    @tags{Core}
+*/
+class JUCE_API  JSONReader
+{
+public:
+    //==============================================================================
+    /** The different kinds of token that the reader can produce. */
+    enum class Token
+    {
+        beginObject,    ///< The start of an object, i.e. '{'
+        endObject,      ///< The end of an object, i.e. '}'
+        beginArray,     ///< The start of an array, i.e. '['
+        endArray,       ///< The end of an array, i.e. ']'
+        propertyName,   ///< The name of an object property. Use getStringView() or getString() to retrieve it
+        string,         ///< A string value. Use getStringView() or getString() to retrieve it
+        integer,        ///< A number with no fractional part or exponent. Use getInt64() to retrieve it
+        floatingPoint,  ///< A number with a fractional part or exponent. Use getDouble() to retrieve it
+        boolean,        ///< Either 'true' or 'false'. Use getBool() to retrieve it
+        null,           ///< The 'null' literal
+        endOfInput,     ///< All of the input has been consumed
+        error           ///< The input was malformed. Use getResult() to find out what went wrong
+    };
+
+    //==============================================================================
+    /** Creates a reader that pulls its text from an InputStream.
+
+        The stream must remain valid for the lifetime of the reader. Data is read from
+        the stream in blocks of the given size, and no more than a single block will be
+        held in memory at any time.
+    */
+    explicit JSONReader (InputStream& source, size_t blockSizeToUse = 16384);
+
+    /** Creates a reader that parses a block of UTF-8 text directly from memory.
+
+        The data is not copied, so it must remain valid for the lifetime of the reader.
+        This is the fastest way to parse large files that have been opened with a
+        MemoryMappedFile.
+    */
+    JSONReader (const void* utf8Data, size_t numBytes);
+
+    /** Destructor. */
+    ~JSONReader();
+
+    JSONReader (JSONReader&&);
+    JSONReader& operator= (JSONReader&&);
+
+    //==============================================================================
+    /** Reads and returns the next token.
+
+        Once this has returned Token::error, all subsequent calls will also return
+        Token::error.
+    */
+    Token next();
+
+    /** Returns the next token without consuming it.
+
+        Calling next() after this will return the same token again, and the value
+        accessors will refer to the peeked token.
+    */
+    Token peek();
+
+    /** Skips over the next complete value, including any nested objects and arrays.
+
+        If the next token is a propertyName, both the name and its value are skipped.
+        Returns false if the input was malformed.
+    */
+    bool skipValue();
+
+    /** Consumes the next complete value, and returns a new reader that will read only
+        that value.
+
+        If this reader reads from memory, the returned reader refers directly to the
+        same data, so nothing is copied. If this reader reads from a stream, the
+        text of the value is copied into a block owned by the returned reader.
+        Returns nullopt if the input was malformed.
+    */
+    std::optional<JSONReader> readValueAsReader();
+
+    /** Consumes the next complete value, and returns it as a var.
+        This is handy for handing off small sub-trees of a large document to code that
+        expects a var. Returns nullopt if the input was malformed.
+    */
+    std::optional<var> readValueAsVar();
+
+    /** If the next value is an array, returns the number of elements that it contains,
+        without consuming anything.
+
+        This works by scanning ahead through the text of the array, so it is only
+        available for readers that read from memory, or readers returned by
+        readValueAsReader(). For readers that pull from a stream, this returns nullopt.
+    */
+    std::optional<size_t> getNextArraySize();
+
+    //==============================================================================
+    /** Returns the text of the most recent propertyName or string token.
+
+        The returned view is only valid until the next call to next(), peek() or
+        skipValue(). When reading from memory, strings containing no escape sequences
+        point directly into the source data.
+    */
+    std::string_view getStringView() const noexcept     { return stringValue; }
+
+    /** Returns the text of the most recent propertyName or string token as a String. */
+    String getString() const;
+
+    /** Returns the value of the most recent integer token. */
+    int64 getInt64() const noexcept                     { return intValue; }
+
+    /** Returns the value of the most recent integer or floatingPoint token. */
+    double getDouble() const noexcept                   { return doubleValue; }
+
+    /** Returns the value of the most recent boolean token. */
+    bool getBool() const noexcept                       { return intValue != 0; }
+
+    /** Returns the number of container levels that are currently open. */
+    int getDepth() const noexcept                       { return (int) stack.size(); }
+
+    /** Returns Result::ok() unless an error has been encountered, in which case the
+        result describes the error and the line and column at which it occurred.
+    */
+    Result getResult() const;
+
+private:
+    //==============================================================================
+    enum class Expect : uint8 { value, firstValueOrEnd, commaOrEnd, firstNameOrEnd, name };
+
+    struct Frame
+    {
+        bool isObject;
+        Expect expect;
+    };
+
+    JSONReader();
+
+    bool refill();
+    int peekByte();
+    int readByte();
+    void skipWhitespace();
+    Token readToken();
+    Token readValueToken (int firstByte);
+    Token readStringToken (int quote, Token type);
+    Token readNumberToken (int firstByte);
+    Token readLiteral (const char* rest, Token type);
+    Token fail (const char* message);
+    void appendUTF8 (juce_wchar);
+    bool readRawValue (MemoryOutputStream&);
+
+    InputStream* stream = nullptr;
+    HeapBlock<char> streamBuffer;
+    MemoryBlock ownedData;
+    size_t blockSize = 0;
+    const char* start = nullptr;
+    const char* position = nullptr;
+    const char* end = nullptr;
+    int64 bytesBeforeBlock = 0, lineStartOffset = 0;
+    int line = 1;
+
+    std::vector<Frame> stack;
+    Expect topLevel = Expect::value;
+    std::vector<char> scratch;
+    std::string_view stringValue;
+    char numberText[64] = {};
+    int numberLength = 0;
+    int64 intValue = 0;
+    double doubleValue = 0;
+    const char* tokenStart = nullptr;
+    std::optional<Token> peeked;
+    String errorMessage;
+    int errorLine = 0, errorColumn = 0;
+    bool failed = false;
+
+    JUCE_DECLARE_NON_COPYABLE (JSONReader)
+};
+
+//==============================================================================
+/**
+    Writes JSON-formatted text directly to an OutputStream, one item at a time.
+
+    This lets you produce large JSON documents without first building a tree of var
+    objects. The output uses exactly the same layout as JSON::writeToStream() for the
+    given FormatOptions, so the two can be freely mixed: writeValue() can be used to
+    embed an existing var at any point in the output.
+
+    @code
+    JSONWriter writer (outputStream);
+
+    writer.beginObject();
+    writer.writeName ("name");
+    writer.writeString ("preset");
+    writer.writeName ("values");
+    writer.beginArray();
+
+    for (auto v : values)
+        writer.writeDouble (v);
+
+    writer.endArray();
+    writer.endObject();
+    @endcode
+
+    @see JSONReader, JSON, ToJSON
+
+    @tags{Core}
+*/
+class JUCE_API  JSONWriter
+{
+public:
+    //==============================================================================
+    /** Creates a writer which will write to the given stream.
+        The stream must remain valid for the lifetime of the writer.
+    */
+    explicit JSONWriter (OutputStream& destination,
+                         const JSON::FormatOptions& formatToUse = {});
+
+    /** Destructor. */
+    ~JSONWriter();
+
+    //==============================================================================
+    /** Opens a new object. Each member must be written as a call to writeName() followed
+        by a single value.
+    */
+    void beginObject();
+
+    /** Closes the innermost object. */
+    void endObject();
+
+    /** Opens a new array. */
+    void beginArray();
+
+    /** Closes the innermost array. */
+    void endArray();
+
+    /** Writes the name of the next member of the current object. */
+    void writeName (StringRef name);
+
+    /** Writes the name of the next member of the current object, taken from a block
+        of UTF-8 text which doesn't need to be null-terminated.
+    */
+    void writeName (const char* utf8Text, size_t numBytes);
+
+    //==============================================================================
+    /** Writes a null value. */
+    void writeNull();
+
+    /** Writes a boolean value. */
+    void writeBool (bool value);
+
+    /** Writes an integer value. */
+    void writeInt (int64 value);
+
+    /** Writes a floating point value. Non-finite values are written as null. */
+    void writeDouble (double value);
+
+    /** Writes a string value. */
+    void writeString (StringRef value);
+
+    /** Writes a complete var, formatted as JSON::writeToStream() would format it. */
+    void writeValue (const var& value);
+
+    //==============================================================================
+    /** Returns the number of containers that are currently open. */
+    int getDepth() const noexcept               { return (int) stack.size(); }
+
+    /** Returns the stream that this writer writes to. */
+    OutputStream& getOutputStream() noexcept    { return out; }
+
+private:
+    //==============================================================================
+    struct Frame
+    {
+        bool isObject;
+        int numItems;
+        int indent;
+        bool hasName;
+    };
+
+    int prepareForValue();
+    void writeSeparator (const Frame&);
+    void beginName();
+    void endName();
+
+    OutputStream& out;
+    JSON::FormatOptions format;
+    std::vector<Frame> stack;
+    int numTopLevelValues = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (JSONWriter)
+};
+
+} // namespace juce
@@ -179,6 +179,7 @@
 #include "containers/juce_Variant.cpp"
 #include "javascript/juce_JSON.cpp"
 #include "javascript/juce_JSONUtils.cpp"
+#include "javascript/juce_JSONStream.cpp"
 #include "javascript/juce_Javascript.cpp"
 #include "containers/juce_DynamicObject.cpp"
 #include "xml/juce_XmlDocument.cpp"
@@ -23,8 +23,47 @@
 namespace juce
 {
 
-TimeSliceThread::TimeSliceThread (const String& name)  : Thread (name)
+class TimeSliceThread::HelperThread final : public Thread
 {
+public:
+    HelperThread (TimeSliceThread& ownerToUse, const String& name)
+        : Thread (name), owner (ownerToUse)
+    {
+        worker.thread = this;
+    }
+
+    ~HelperThread() override
+    {
+        stopThread (2000);
+    }
+
+    void run() override
+    {
+        owner.runWorker (worker);
+    }
+
+    TimeSliceThread& owner;
+    Worker worker;
+
+    JUCE_DECLARE_NON_COPYABLE (HelperThread)
+};
+
+//==============================================================================
+TimeSliceThread::TimeSliceThread (const String& name)
+    : TimeSliceThread (name, 1)
+{
+}
+
+TimeSliceThread::TimeSliceThread (const String& name, int numThreadsToUse)
+    : Thread (name)
+{
+    jassert (numThreadsToUse > 0);
+
+    worker.thread = this;
+    workers.add (&worker);
+
+    for (int i = 1; i < numThreadsToUse; ++i)
+        workers.add (&helperThreads.add (new HelperThread (*this, name + " " + String (i + 1)))->worker);
 }
 
 TimeSliceThread::~TimeSliceThread()
@@ -39,8 +78,14 @@ void TimeSliceThread::addTimeSliceClient (TimeSliceClient* const client, int mil
     {
         const ScopedLock sl (listLock);
         client->nextCallTime = Time::getCurrentTime() + RelativeTime::milliseconds (millisecondsBeforeStarting);
-        clients.addIfNotAlreadyThere (client);
-        notify();
+
+        if (! clients.contains (client))
+        {
+            client->numTimeSlices = client->totalLatenessMs = client->maxLatenessMs = 0;
+            clients.add (client);
+        }
+
+        notifyWaitingWorkers();
     }
 }
 
@@ -49,20 +94,28 @@ void TimeSliceThread::removeTimeSliceClient (TimeSliceClient* const client)
     const ScopedLock sl1 (listLock);
 
     // if there's a chance we're in the middle of calling this client, we need to
-    // also lock the outer lock..
-    if (clientBeingCalled == client)
+    // also lock the outer lock of the thread that's calling it..
+    while (auto* callingWorker = getWorkerCalling (client))
     {
+        // a client that removes itself from its own time slice can't wait for that call
+        // to finish, but the calling thread already holds its callback lock anyway
+        if (callingWorker->thread == Thread::getCurrentThread())
+            break;
+
         const ScopedUnlock ul (listLock); // unlock first to get the order right..
 
-        const ScopedLock sl2 (callbackLock);
+        const ScopedLock sl2 (callingWorker->callbackLock);
         const ScopedLock sl3 (listLock);
 
-        clients.removeFirstMatchingValue (client);
-    }
-    else
-    {
-        clients.removeFirstMatchingValue (client);
+        // ..but another thread may have picked up the client while the list was unlocked
+        if (getWorkerCalling (client) == nullptr)
+        {
+            clients.removeFirstMatchingValue (client);
+            return;
+        }
     }
+
+    clients.removeFirstMatchingValue (client);
 }
 
 void TimeSliceThread::removeAllClients()
@@ -83,7 +136,7 @@ void TimeSliceThread::moveToFrontOfQueue (TimeSliceClient* client)
     if (clients.contains (client))
     {
         client->nextCallTime = Time::getCurrentTime();
-        notify();
+        notifyWaitingWorkers();
     }
 }
 
@@ -105,20 +158,63 @@ bool TimeSliceThread::contains (const TimeSliceClient* c) const
     return std::any_of (clients.begin(), clients.end(), [=] (auto* registered) { return registered == c; });
 }
 
+TimeSliceThread::ClientStatistics TimeSliceThread::getClientStatistics (const TimeSliceClient* c) const
+{
+    const ScopedLock sl (listLock);
+
+    if (! clients.contains (const_cast<TimeSliceClient*> (c)))
+        return {};
+
+    ClientStatistics stats;
+    stats.numTimeSlices = c->numTimeSlices;
+    stats.totalLatenessMs = c->totalLatenessMs;
+    stats.maxLatenessMs = c->maxLatenessMs;
+    return stats;
+}
+
 //==============================================================================
-TimeSliceClient* TimeSliceThread::getNextClient (int index) const
+TimeSliceThread::Worker* TimeSliceThread::getWorkerCalling (const TimeSliceClient* client) const
+{
+    for (auto* w : workers)
+        if (w->clientBeingCalled == client)
+            return w;
+
+    return nullptr;
+}
+
+void TimeSliceThread::notifyWaitingWorkers()
+{
+    for (auto* w : workers)
+        if (w->isWaiting)
+            w->thread->notify();
+}
+
+TimeSliceClient* TimeSliceThread::getNextClient (Time now, Time& nextClientTime) const
 {
-    Time soonest;
     TimeSliceClient* client = nullptr;
+    int64 highestUrgency = 0;
+    nextClientTime = now + RelativeTime::milliseconds (500);
 
-    for (int i = clients.size(); --i >= 0;)
+    for (auto* c : clients)
     {
-        auto* c = clients.getUnchecked ((i + index) % clients.size());
+        if (c == nullptr || getWorkerCalling (c) != nullptr)
+            continue;
+
+        if (c->nextCallTime > now)
+        {
+            nextClientTime = jmin (nextClientTime, c->nextCallTime);
+            continue;
+        }
 
-        if (c != nullptr && (client == nullptr || c->nextCallTime < soonest))
+        // A client's priority grows the longer it's been kept waiting, so that busy
+        // clients with high priorities can delay the others, but can't starve them.
+        const auto urgency = (now - c->nextCallTime).inMilliseconds()
+                               + (int64) c->getTimeSlicePriority() * msPerPriorityLevel;
+
+        if (client == nullptr || urgency > highestUrgency)
         {
             client = c;
-            soonest = c->nextCallTime;
+            highestUrgency = urgency;
         }
     }
 
@@ -127,13 +223,33 @@ TimeSliceClient* TimeSliceThread::getNextClient (int index) const
 
 void TimeSliceThread::run()
 {
-    int index = 0;
+    for (auto* helper : helperThreads)
+        helper->startThread (getPriority());
+
+    runWorker (worker);
+
+    for (auto* helper : helperThreads)
+        helper->signalThreadShouldExit();
+
+    for (auto* helper : helperThreads)
+    {
+        helper->notify();
+        helper->waitForThreadToExit (-1);
+    }
+}
+
+void TimeSliceThread::runWorker (Worker& w)
+{
+    int numCallsSinceLastRest = 0;
 
-    while (! threadShouldExit())
+    while (! w.thread->threadShouldExit())
     {
         int timeToWait = 500;
 
         {
+            const ScopedLock sl (w.callbackLock);
+
+            auto now = Time::getCurrentTime();
             Time nextClientTime;
             int numClients = 0;
 
@@ -141,51 +257,260 @@ void TimeSliceThread::run()
                 const ScopedLock sl2 (listLock);
 
                 numClients = clients.size();
-                index = numClients > 0 ? ((index + 1) % numClients) : 0;
+                w.clientBeingCalled = getNextClient (now, nextClientTime);
 
-                if (auto* firstClient = getNextClient (index))
-                    nextClientTime = firstClient->nextCallTime;
+                // this must be set while the list is still locked, so that a client
+                // which becomes free from now on will wake this thread up
+                w.isWaiting = (w.clientBeingCalled == nullptr);
             }
 
-            if (numClients > 0)
+            if (auto* client = w.clientBeingCalled)
             {
-                auto now = Time::getCurrentTime();
+                const auto latenessMs = jmax ((int64) 0, (now - client->nextCallTime).inMilliseconds());
+                const int msUntilNextCall = client->useTimeSlice();
+
+                const ScopedLock sl2 (listLock);
 
-                if (nextClientTime > now)
+                if (msUntilNextCall >= 0)
                 {
-                    timeToWait = (int) jmin ((int64) 500, (nextClientTime - now).inMilliseconds());
+                    client->nextCallTime = now + RelativeTime::milliseconds (msUntilNextCall);
+                    client->numTimeSlices++;
+                    client->totalLatenessMs += latenessMs;
+                    client->maxLatenessMs = jmax (client->maxLatenessMs, latenessMs);
                 }
                 else
                 {
-                    timeToWait = index == 0 ? 1 : 0;
-
-                    const ScopedLock sl (callbackLock);
-
-                    {
-                        const ScopedLock sl2 (listLock);
-                        clientBeingCalled = getNextClient (index);
-                    }
-
-                    if (clientBeingCalled != nullptr)
-                    {
-                        const int msUntilNextCall = clientBeingCalled->useTimeSlice();
+                    clients.removeFirstMatchingValue (client);
+                }
 
-                        const ScopedLock sl2 (listLock);
+                w.clientBeingCalled = nullptr;
 
-                        if (msUntilNextCall >= 0)
-                            clientBeingCalled->nextCallTime = now + RelativeTime::milliseconds (msUntilNextCall);
-                        else
-                            clients.removeFirstMatchingValue (clientBeingCalled);
+                // the client is free again, so any thread that's idle may need to call it
+                if (msUntilNextCall >= 0)
+                    notifyWaitingWorkers();
 
-                        clientBeingCalled = nullptr;
-                    }
+                // rest briefly after every round of clients, so that clients which always
+                // want to be called again immediately can't hog the CPU
+                if (++numCallsSinceLastRest >= numClients)
+                {
+                    numCallsSinceLastRest = 0;
+                    timeToWait = 1;
                 }
+                else
+                {
+                    timeToWait = 0;
+                }
+            }
+            else if (numClients > 0)
+            {
+                timeToWait = (int) jmin ((int64) 500, (nextClientTime - now).inMilliseconds());
             }
         }
 
         if (timeToWait > 0)
-            wait (timeToWait);
+            w.thread->wait (timeToWait);
+
+        if (w.isWaiting)
+        {
+            const ScopedLock sl (listLock);
+            w.isWaiting = false;
+        }
     }
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class TimeSliceThreadTests final : public UnitTest
+{
+public:
+    TimeSliceThreadTests()
+        : UnitTest ("TimeSliceThread", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("A slow client doesn't hold up the others when there are several threads");
+        {
+            TimeSliceThread thread ("test", 2);
+            expectEquals (thread.getNumThreads(), 2);
+
+            TestClient slowClient (50), fastClient (0);
+            thread.addTimeSliceClient (&slowClient);
+            thread.addTimeSliceClient (&fastClient);
+            thread.startThread();
+
+            Thread::sleep (300);
+
+            thread.removeTimeSliceClient (&slowClient);
+            expect (! slowClient.isBeingCalled);
+
+            // with a single thread, the fast client would only get a handful of calls
+            expectGreaterThan (fastClient.numCalls.load(), 20);
+            expectGreaterThan (thread.getClientStatistics (&fastClient).numTimeSlices, (int64) 20);
+            expectEquals (thread.getClientStatistics (&slowClient).numTimeSlices, (int64) 0);
+
+            thread.stopThread (1000);
+        }
+
+        beginTest ("Clients with higher priorities are called first");
+        {
+            TimeSliceThread thread ("test");
+
+            Array<int> callOrder;
+            CriticalSection orderLock;
+
+            OneShotClient low (0, callOrder, orderLock), high (1, callOrder, orderLock), higher (2, callOrder, orderLock);
+            thread.addTimeSliceClient (&low);
+            thread.addTimeSliceClient (&high);
+            thread.addTimeSliceClient (&higher);
+            thread.startThread();
+
+            for (int i = 0; i < 100 && thread.getNumClients() > 0; ++i)
+                Thread::sleep (10);
+
+            thread.stopThread (1000);
+
+            const ScopedLock sl (orderLock);
+            expect (callOrder == Array<int> { 2, 1, 0 });
+        }
+
+        beginTest ("Busy clients with higher priorities don't starve the others");
+        {
+            TimeSliceThread thread ("test");
+
+            TestClient busyClient (0, 5, 0), idleClient (0);
+            thread.addTimeSliceClient (&busyClient);
+            thread.addTimeSliceClient (&idleClient);
+            thread.startThread();
+
+            Thread::sleep (300);
+            thread.stopThread (1000);
+
+            // the busy client always wants to be called again at once, so without aging
+            // the idle client would never be called
+            expectGreaterThan (busyClient.numCalls.load(), 20);
+            expectGreaterThan (idleClient.numCalls.load(), 2);
+        }
+
+        beginTest ("Adding a client again doesn't reset its statistics");
+        {
+            TimeSliceThread thread ("test");
+
+            TestClient client (0);
+            thread.addTimeSliceClient (&client);
+            thread.startThread();
+
+            for (int i = 0; i < 100 && client.numCalls.load() < 5; ++i)
+                Thread::sleep (10);
+
+            thread.addTimeSliceClient (&client);
+            expectGreaterOrEqual (thread.getClientStatistics (&client).numTimeSlices, (int64) 5);
+            expectEquals (thread.getNumClients(), 1);
+
+            thread.stopThread (1000);
+        }
+
+        beginTest ("Clients can remove themselves during their time slice");
+        {
+            for (auto removeAll : { false, true })
+            {
+                TimeSliceThread thread ("test", 2);
+
+                SelfRemovingClient client (thread, removeAll);
+                TestClient otherClient (0);
+                thread.addTimeSliceClient (&client);
+                thread.addTimeSliceClient (&otherClient);
+                thread.startThread();
+
+                for (int i = 0; i < 100 && client.numCalls.load() == 0; ++i)
+                    Thread::sleep (10);
+
+                for (int i = 0; i < 100 && thread.contains (&client); ++i)
+                    Thread::sleep (10);
+
+                expectEquals (client.numCalls.load(), 1);
+                expect (! thread.contains (&client));
+                expect (thread.contains (&otherClient) != removeAll);
+
+                expect (thread.stopThread (1000));
+            }
+        }
+    }
+
+private:
+    struct TestClient final : public TimeSliceClient
+    {
+        explicit TestClient (int msToBlockFor, int priorityToUse = 0, int msBetweenCalls = 1)
+            : blockTime (msToBlockFor), priority (priorityToUse), interval (msBetweenCalls)
+        {}
+
+        int getTimeSlicePriority() const override   { return priority; }
+
+        int useTimeSlice() override
+        {
+            isBeingCalled = true;
+            ++numCalls;
+
+            if (blockTime > 0)
+                Thread::sleep (blockTime);
+
+            isBeingCalled = false;
+            return interval;
+        }
+
+        const int blockTime, priority, interval;
+        std::atomic<int> numCalls { 0 };
+        std::atomic<bool> isBeingCalled { false };
+    };
+
+    struct SelfRemovingClient final : public TimeSliceClient
+    {
+        SelfRemovingClient (TimeSliceThread& threadToUse, bool shouldRemoveAll)
+            : thread (threadToUse), removeAll (shouldRemoveAll)
+        {}
+
+        int useTimeSlice() override
+        {
+            ++numCalls;
+
+            if (removeAll)
+                thread.removeAllClients();
+            else
+                thread.removeTimeSliceClient (this);
+
+            return 1;
+        }
+
+        TimeSliceThread& thread;
+        const bool removeAll;
+        std::atomic<int> numCalls { 0 };
+    };
+
+    struct OneShotClient final : public TimeSliceClient
+    {
+        OneShotClient (int priorityToUse, Array<int>& order, CriticalSection& lock)
+            : priority (priorityToUse), callOrder (order), orderLock (lock)
+        {}
+
+        int useTimeSlice() override
+        {
+            const ScopedLock sl (orderLock);
+            callOrder.add (priority);
+            return -1;
+        }
+
+        int getTimeSlicePriority() const override    { return priority; }
+
+        const int priority;
+        Array<int>& callOrder;
+        CriticalSection& orderLock;
+    };
+};
+
+static TimeSliceThreadTests timeSliceThreadTests;
+
+#endif
+
 } // namespace juce
@@ -63,10 +63,29 @@ public:
     */
     virtual int useTimeSlice() = 0;
 
+    /** Returns the priority of this client, relative to the other clients of its thread.
+
+        When several clients are due to be called, those with the highest priority are
+        given their time-slices first, so a client which must keep up with real-time playback
+        can return a higher value than one doing background work such as generating
+        thumbnails. Clients with equal priorities are called in order of how long they've
+        been waiting.
+
+        A client that is kept waiting gains one level of priority for every
+        TimeSliceThread::msPerPriorityLevel milliseconds past the time it asked to be
+        called, so clients with low priorities are delayed by busy clients with higher
+        ones, but never starved.
+
+        This is called whenever the thread chooses the next client, so it should be quick.
+        The default implementation returns 0.
+    */
+    virtual int getTimeSlicePriority() const        { return 0; }
+
 
 private:
     friend class TimeSliceThread;
     Time nextCallTime;
+    int64 numTimeSlices = 0, totalLatenessMs = 0, maxLatenessMs = 0;
 };
 
 
@@ -91,6 +110,18 @@ public:
     */
     explicit TimeSliceThread (const String& threadName);
 
+    /**
+        Creates a TimeSliceThread which shares its clients between several threads.
+
+        The clients are handed to whichever thread is free, so a client that takes a
+        long time to run won't hold up the others. A client is never called by more
+        than one thread at a time.
+
+        This object is the first of the threads, and the others are started and stopped
+        along with it, so use startThread() and stopThread() as usual.
+    */
+    TimeSliceThread (const String& threadName, int numThreadsToUse);
+
     /** Destructor.
 
         Deleting a Thread object that is running will only give the thread a
@@ -104,6 +135,7 @@ public:
     /** Adds a client to the list.
         The client's callbacks will start after the number of milliseconds specified
         by millisecondsBeforeStarting (and this may happen before this method has returned).
+        If the client is already in the list, this just reschedules its next callback.
     */
     void addTimeSliceClient (TimeSliceClient* clientToAdd, int millisecondsBeforeStarting = 0);
 
@@ -134,6 +166,40 @@ public:
     /** Returns true if the client is currently registered. */
     bool contains (const TimeSliceClient*) const;
 
+    /** Returns the number of threads that are calling the clients. */
+    int getNumThreads() const noexcept                  { return helperThreads.size() + 1; }
+
+    /** How long a client has to wait past its due time to gain one level of priority.
+        @see TimeSliceClient::getTimeSlicePriority
+    */
+    static constexpr int msPerPriorityLevel = 10;
+
+    //==============================================================================
+    /** Describes how promptly a client has been given its time-slices.
+
+        A time-slice is late if it starts after the time that the client asked to be
+        called again. A client whose time-slices keep being late is being starved by
+        the other clients.
+
+        @see getClientStatistics
+    */
+    struct ClientStatistics
+    {
+        /** The number of time-slices the client has been given. */
+        int64 numTimeSlices = 0;
+
+        /** The total amount by which the time-slices were late, in milliseconds. */
+        int64 totalLatenessMs = 0;
+
+        /** The most that any single time-slice was late, in milliseconds. */
+        int64 maxLatenessMs = 0;
+    };
+
+    /** Returns statistics about the time-slices a registered client has been given.
+        If the client isn't registered, this returns an empty set of statistics.
+    */
+    ClientStatistics getClientStatistics (const TimeSliceClient*) const;
+
     //==============================================================================
    #ifndef DOXYGEN
     void run() override;
@@ -141,11 +207,26 @@ public:
 
     //==============================================================================
 private:
-    CriticalSection callbackLock, listLock;
-    Array<TimeSliceClient*> clients;
-    TimeSliceClient* clientBeingCalled = nullptr;
+    struct Worker
+    {
+        Thread* thread = nullptr;
+        CriticalSection callbackLock;
+        TimeSliceClient* clientBeingCalled = nullptr;
+        bool isWaiting = false;
+    };
+
+    class HelperThread;
 
-    TimeSliceClient* getNextClient (int index) const;
+    CriticalSection listLock;
+    Array<TimeSliceClient*> clients;
+    Worker worker;
+    OwnedArray<HelperThread> helperThreads;
+    Array<Worker*> workers;
+
+    TimeSliceClient* getNextClient (Time now, Time& nextClientTime) const;
+    Worker* getWorkerCalling (const TimeSliceClient*) const;
+    void runWorker (Worker&);
+    void notifyWaitingWorkers();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TimeSliceThread)
 };
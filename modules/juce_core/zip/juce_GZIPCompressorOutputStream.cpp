@@ -112,6 +112,274 @@ private:
     JUCE_DECLARE_NON_COPYABLE (GZIPCompressorHelper)
 };
 
+//==============================================================================
+/*  Compresses independent blocks of input on a ThreadPool, in the same way as pigz.
+
+    Each block is deflated by its own raw deflate stream, primed with the last window's
+    worth of the previous block as a dictionary. All but the last block end with a sync
+    flush, which byte-aligns the output without marking it as final, so the compressed
+    blocks can simply be concatenated. The zlib or gzip wrapper is written around them
+    here, with the checksums of the blocks combined in order.
+*/
+class GZIPCompressorOutputStream::ParallelCompressorHelper
+{
+public:
+    ParallelCompressorHelper (ThreadPool& p, int compressionLevel, int windowBits, size_t blockSizeToUse)
+        : pool (p),
+          compLevel ((compressionLevel < 0 || compressionLevel > 9) ? -1 : compressionLevel),
+          blockSize (jmax ((size_t) 32768, blockSizeToUse)),
+          maxBlocksInFlight ((size_t) jmax (2, p.getNumThreads() * 2))
+    {
+        if (windowBits == 0)
+            windowBits = MAX_WBITS;
+
+        if (windowBits < 0)
+        {
+            format = Format::raw;
+            windowSizeBits = -windowBits;
+        }
+        else if (windowBits > MAX_WBITS)
+        {
+            format = Format::gzip;
+            windowSizeBits = windowBits - 16;
+        }
+        else
+        {
+            format = Format::zlib;
+            windowSizeBits = windowBits;
+        }
+
+        jassert (windowSizeBits >= 8 && windowSizeBits <= MAX_WBITS);
+        windowSizeBits = jlimit (9, (int) MAX_WBITS, windowSizeBits);
+
+        checksum = format == Format::zlib ? zlibNamespace::adler32 (0, nullptr, 0)
+                                          : zlibNamespace::crc32 (0, nullptr, 0);
+    }
+
+    ~ParallelCompressorHelper()
+    {
+        for (auto& block : pendingBlocks)
+            pool.removeJob (block.get(), true, -1);
+    }
+
+    bool write (const uint8* data, size_t dataSize, OutputStream& out)
+    {
+        // When you call flush() on a gzip stream, the stream is closed, and you can
+        // no longer continue to write data to it!
+        jassert (! finished);
+
+        while (dataSize > 0 && ! failed)
+        {
+            if (currentInput.getSize() != blockSize)
+                currentInput.setSize (blockSize);
+
+            auto numToCopy = jmin (dataSize, blockSize - currentInputSize);
+            memcpy (addBytesToPointer (currentInput.getData(), currentInputSize), data, numToCopy);
+            currentInputSize += numToCopy;
+            data += numToCopy;
+            dataSize -= numToCopy;
+
+            if (currentInputSize == blockSize)
+                submitBlock (false, out);
+        }
+
+        return ! failed;
+    }
+
+    void finish (OutputStream& out)
+    {
+        if (finished)
+            return;
+
+        finished = true;
+        submitBlock (true, out);
+
+        while (! (pendingBlocks.empty() || failed))
+            writeNextBlock (out);
+
+        if (failed)
+            return;
+
+        if (format == Format::gzip)
+        {
+            out.writeInt ((int) checksum);
+            out.writeInt ((int) (uint32) totalInputSize);
+        }
+        else if (format == Format::zlib)
+        {
+            out.writeIntBigEndian ((int) checksum);
+        }
+    }
+
+private:
+    enum class Format { raw, zlib, gzip };
+
+    struct BlockJob final : public ThreadPoolJob
+    {
+        BlockJob (const ParallelCompressorHelper& ownerIn, MemoryBlock&& inputIn, size_t inputSizeIn,
+                  MemoryBlock dictionaryIn, bool isLastBlockIn)
+            : ThreadPoolJob ("GZIP block"),
+              owner (ownerIn),
+              input (std::move (inputIn)),
+              dictionary (std::move (dictionaryIn)),
+              inputSize (inputSizeIn),
+              isLastBlock (isLastBlockIn)
+        {}
+
+        JobStatus runJob() override
+        {
+            using namespace zlibNamespace;
+
+            blockChecksum = owner.format == Format::zlib
+                              ? adler32 (adler32 (0, nullptr, 0), (const Bytef*) input.getData(), (z_uInt) inputSize)
+                              : crc32 (crc32 (0, nullptr, 0), (const Bytef*) input.getData(), (z_uInt) inputSize);
+
+            z_stream stream;
+            zerostruct (stream);
+
+            if (deflateInit2 (&stream, owner.compLevel, Z_DEFLATED, -owner.windowSizeBits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+                return jobHasFinished;
+
+            if (! dictionary.isEmpty())
+                deflateSetDictionary (&stream, (const Bytef*) dictionary.getData(), (z_uInt) dictionary.getSize());
+
+            stream.next_in  = static_cast<Bytef*> (input.getData());
+            stream.avail_in = (z_uInt) inputSize;
+
+            const auto flushMode = isLastBlock ? Z_FINISH : Z_SYNC_FLUSH;
+            output.setSize (inputSize + inputSize / 8 + 1024);
+
+            for (;;)
+            {
+                if (output.getSize() - outputSize < 256)
+                    output.setSize (output.getSize() * 2);
+
+                stream.next_out  = static_cast<Bytef*> (addBytesToPointer (output.getData(), outputSize));
+                stream.avail_out = (z_uInt) (output.getSize() - outputSize);
+
+                const auto result = deflate (&stream, flushMode);
+                outputSize = output.getSize() - stream.avail_out;
+
+                if (result == Z_STREAM_END)
+                {
+                    succeeded = true;
+                    break;
+                }
+
+                if (result != Z_OK && result != Z_BUF_ERROR)
+                    break;
+
+                if (! isLastBlock && stream.avail_in == 0 && stream.avail_out != 0)
+                {
+                    succeeded = true;
+                    break;
+                }
+            }
+
+            deflateEnd (&stream);
+            input.reset();
+            dictionary.reset();
+            return jobHasFinished;
+        }
+
+        const ParallelCompressorHelper& owner;
+        MemoryBlock input, dictionary, output;
+        size_t inputSize = 0, outputSize = 0;
+        zlibNamespace::uLong blockChecksum = 0;
+        const bool isLastBlock;
+        bool succeeded = false;
+    };
+
+    ThreadPool& pool;
+    const int compLevel;
+    const size_t blockSize, maxBlocksInFlight;
+    Format format = Format::zlib;
+    int windowSizeBits = MAX_WBITS;
+
+    std::deque<std::unique_ptr<BlockJob>> pendingBlocks;
+    MemoryBlock currentInput, dictionary;
+    size_t currentInputSize = 0;
+    uint64 totalInputSize = 0;
+    zlibNamespace::uLong checksum = 0;
+    bool headerWritten = false, finished = false, failed = false;
+
+    void submitBlock (bool isLastBlock, OutputStream& out)
+    {
+        // the tail of this block becomes the dictionary for the next one
+        MemoryBlock nextDictionary;
+
+        if (! isLastBlock)
+        {
+            const auto dictionarySize = jmin (currentInputSize, (size_t) 1 << windowSizeBits);
+            nextDictionary.append (addBytesToPointer (currentInput.getData(), currentInputSize - dictionarySize),
+                                   dictionarySize);
+        }
+
+        pendingBlocks.push_back (std::make_unique<BlockJob> (*this, std::move (currentInput), currentInputSize,
+                                                             std::move (dictionary), isLastBlock));
+        pool.addJob (pendingBlocks.back().get(), false);
+
+        dictionary = std::move (nextDictionary);
+        currentInput = {};
+        currentInputSize = 0;
+
+        while (pendingBlocks.size() >= maxBlocksInFlight && ! failed)
+            writeNextBlock (out);
+    }
+
+    void writeNextBlock (OutputStream& out)
+    {
+        auto& block = *pendingBlocks.front();
+        pool.waitForJobToFinish (&block, -1);
+
+        if (! block.succeeded || ! writeHeaderIfNeeded (out)
+             || (block.outputSize > 0 && ! out.write (block.output.getData(), block.outputSize)))
+        {
+            failed = true;
+            return;
+        }
+
+        using namespace zlibNamespace;
+
+        checksum = format == Format::zlib ? adler32_combine (checksum, block.blockChecksum, (z_off_t) block.inputSize)
+                                          : crc32_combine   (checksum, block.blockChecksum, (z_off_t) block.inputSize);
+        totalInputSize += block.inputSize;
+        pendingBlocks.pop_front();
+    }
+
+    bool writeHeaderIfNeeded (OutputStream& out)
+    {
+        if (std::exchange (headerWritten, true))
+            return true;
+
+        if (format == Format::gzip)
+        {
+            const uint8 header[] = { 0x1f, 0x8b, 8, 0, 0, 0, 0, 0,
+                                     (uint8) (compLevel == 9 ? 2 : (compLevel >= 0 && compLevel < 2 ? 4 : 0)),
+                                     0xff };
+            return out.write (header, sizeof (header));
+        }
+
+        if (format == Format::zlib)
+        {
+            const auto levelFlags = (compLevel >= 0 && compLevel < 2) ? 0
+                                  : (compLevel >= 0 && compLevel < 6)  ? 1
+                                  : (compLevel < 0 || compLevel == 6)  ? 2 : 3;
+
+            const auto cmf = (uint8) (((windowSizeBits - 8) << 4) | Z_DEFLATED);
+            auto flags = (uint8) (levelFlags << 6);
+            flags = (uint8) (flags + 31 - ((cmf * 256 + flags) % 31));
+
+            const uint8 header[] = { cmf, flags };
+            return out.write (header, sizeof (header));
+        }
+
+        return true;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (ParallelCompressorHelper)
+};
+
 //==============================================================================
 GZIPCompressorOutputStream::GZIPCompressorOutputStream (OutputStream& s, int compressionLevel, int windowBits)
    : GZIPCompressorOutputStream (&s, compressionLevel, false, windowBits)
@@ -125,6 +393,13 @@ GZIPCompressorOutputStream::GZIPCompressorOutputStream (OutputStream* out, int c
     jassert (out != nullptr);
 }
 
+GZIPCompressorOutputStream::GZIPCompressorOutputStream (OutputStream& s, ThreadPool& threadPoolToUse,
+                                                        int compressionLevel, int windowBits, size_t blockSizeBytes)
+   : destStream (&s, false),
+     parallelHelper (new ParallelCompressorHelper (threadPoolToUse, compressionLevel, windowBits, blockSizeBytes))
+{
+}
+
 GZIPCompressorOutputStream::~GZIPCompressorOutputStream()
 {
     flush();
@@ -132,7 +407,11 @@ GZIPCompressorOutputStream::~GZIPCompressorOutputStream()
 
 void GZIPCompressorOutputStream::flush()
 {
-    helper->finish (*destStream);
+    if (parallelHelper != nullptr)
+        parallelHelper->finish (*destStream);
+    else
+        helper->finish (*destStream);
+
     destStream->flush();
 }
 
@@ -140,6 +419,9 @@ bool GZIPCompressorOutputStream::write (const void* destBuffer, size_t howMany)
 {
     jassert (destBuffer != nullptr && (ssize_t) howMany >= 0);
 
+    if (parallelHelper != nullptr)
+        return parallelHelper->write (static_cast<const uint8*> (destBuffer), howMany, *destStream);
+
     return helper->write (static_cast<const uint8*> (destBuffer), howMany, *destStream);
 }
 
@@ -204,6 +486,58 @@ struct GZIPTests final : public UnitTest
                                 original.getData(),
                                 original.getDataSize()) == 0);
         }
+
+        beginTest ("Parallel GZIP");
+        ThreadPool pool (ThreadPoolOptions{}.withNumberOfThreads (3));
+
+        const std::pair<int, GZIPDecompressorInputStream::Format> formats[]
+        {
+            { 0,                                          GZIPDecompressorInputStream::zlibFormat },
+            { GZIPCompressorOutputStream::windowBitsGZIP, GZIPDecompressorInputStream::gzipFormat },
+            { GZIPCompressorOutputStream::windowBitsRaw,  GZIPDecompressorInputStream::deflateFormat },
+            { 11,                                         GZIPDecompressorInputStream::zlibFormat }
+        };
+
+        for (int i = 40; --i >= 0;)
+        {
+            const auto& format = formats[i % numElementsInArray (formats)];
+            MemoryOutputStream original, compressed, serialCompressed, uncompressed;
+
+            for (int j = rng.nextInt (i < 4 ? 10 : 40000); --j >= 0;)
+                original << (rng.nextBool() ? String (rng.nextInt (1000)) : String ("abcdefgh"));
+
+            const auto level = rng.nextInt (10);
+
+            {
+                GZIPCompressorOutputStream zipper (compressed, pool, level, format.first, (size_t) 32768 * (size_t) (1 + rng.nextInt (3)));
+                const auto* data = static_cast<const char*> (original.getData());
+
+                for (size_t pos = 0; pos < original.getDataSize();)
+                {
+                    auto numToWrite = jmin (original.getDataSize() - pos, (size_t) rng.nextInt (50000) + 1);
+                    expect (zipper.write (data + pos, numToWrite));
+                    pos += numToWrite;
+                }
+            }
+
+            {
+                GZIPCompressorOutputStream zipper (serialCompressed, level, format.first);
+                zipper << original.getMemoryBlock();
+            }
+
+            {
+                MemoryInputStream compressedInput (compressed.getData(), compressed.getDataSize(), false);
+                GZIPDecompressorInputStream unzipper (&compressedInput, false, format.second);
+
+                uncompressed << unzipper;
+            }
+
+            expect (uncompressed.getMemoryBlock() == original.getMemoryBlock());
+
+            // priming each block with its predecessor should keep the ratio close to the serial stream
+            if (level > 0 && original.getDataSize() > 100000)
+                expect ((double) compressed.getDataSize() < (double) serialCompressed.getDataSize() * 1.05 + 64);
+        }
     }
 };
 
@@ -71,6 +71,34 @@ public:
                                 bool deleteDestStreamWhenDestroyed = false,
                                 int windowBits = 0);
 
+    /** Creates a compression stream which compresses blocks of data in parallel.
+
+        The incoming data is split into blocks of blockSizeBytes, which are deflated
+        concurrently on the given ThreadPool. Each block is primed with the tail of the
+        previous one as its dictionary, so the compression ratio is close to that of the
+        single-threaded stream, and the result is still a single standard zlib, gzip or
+        raw deflate stream (depending on windowBits) that GZIPDecompressorInputStream or
+        any other decoder can read.
+
+        Only a couple of blocks per pool thread are held in memory at once: write() will
+        block and output finished blocks (in order) when that limit is reached.
+
+        @param destStream           the stream into which the compressed data will be written
+        @param threadPoolToUse      the pool on which blocks are compressed. This must outlive
+                                    the stream, and shouldn't be a pool whose jobs are waiting
+                                    for this stream, or it may deadlock
+        @param compressionLevel     how much to compress the data, as for the other constructors
+        @param windowBits           the zlib window size and format, as for the other constructors
+        @param blockSizeBytes       the number of bytes of input compressed by each job. Larger
+                                    blocks compress slightly better, smaller ones allow more
+                                    parallelism for small inputs. The minimum is 32KB.
+    */
+    GZIPCompressorOutputStream (OutputStream& destStream,
+                                ThreadPool& threadPoolToUse,
+                                int compressionLevel = -1,
+                                int windowBits = 0,
+                                size_t blockSizeBytes = 128 * 1024);
+
     /** Destructor. */
     ~GZIPCompressorOutputStream() override;
 
@@ -102,6 +130,9 @@ private:
     class GZIPCompressorHelper;
     std::unique_ptr<GZIPCompressorHelper> helper;
 
+    class ParallelCompressorHelper;
+    std::unique_ptr<ParallelCompressorHelper> parallelHelper;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GZIPCompressorOutputStream)
 };
 
@@ -143,34 +143,46 @@ struct ZipFile::ZipInputStream final : public InputStream
           zipEntryHolder (zei),
           inputStream (zf.inputStream)
     {
-        if (zf.inputSource != nullptr)
+        char buffer[30];
+
+        if (zf.sourceData != nullptr)
         {
-            streamToDelete.reset (file.inputSource->createInputStream());
-            inputStream = streamToDelete.get();
+            // When the whole archive is in memory, each stream can read from it directly,
+            // so streams for different entries can be used on different threads at once
+            inputStream = nullptr;
+
+            if (zei.streamOffset >= 0 && (size_t) zei.streamOffset + 30 <= zf.sourceDataSize)
+            {
+                memcpy (buffer, zf.sourceData + zei.streamOffset, 30);
+                setHeaderSize (buffer);
+            }
         }
         else
         {
-           #if JUCE_DEBUG
-            zf.streamCounter.numOpenStreams++;
-           #endif
-        }
-
-        char buffer[30];
+            if (zf.inputSource != nullptr)
+            {
+                streamToDelete.reset (file.inputSource->createInputStream());
+                inputStream = streamToDelete.get();
+            }
 
-        if (inputStream != nullptr
-             && inputStream->setPosition (zei.streamOffset)
-             && inputStream->read (buffer, 30) == 30
-             && ByteOrder::littleEndianInt (buffer) == 0x04034b50)
-        {
-            headerSize = 30 + ByteOrder::littleEndianShort (buffer + 26)
-                            + ByteOrder::littleEndianShort (buffer + 28);
+            if (inputStream != nullptr
+                 && inputStream->setPosition (zei.streamOffset)
+                 && inputStream->read (buffer, 30) == 30)
+            {
+                setHeaderSize (buffer);
+            }
         }
+
+       #if JUCE_DEBUG
+        if (streamToDelete == nullptr)
+            zf.streamCounter.numOpenStreams++;
+       #endif
     }
 
     ~ZipInputStream() override
     {
        #if JUCE_DEBUG
-        if (inputStream != nullptr && inputStream == file.inputStream)
+        if (streamToDelete == nullptr)
             file.streamCounter.numOpenStreams--;
        #endif
     }
@@ -187,6 +199,18 @@ struct ZipFile::ZipInputStream final : public InputStream
 
         howMany = (int) jmin ((int64) howMany, zipEntryHolder.compressedSize - pos);
 
+        if (file.sourceData != nullptr)
+        {
+            const auto start = zipEntryHolder.streamOffset + headerSize + pos;
+            const auto num = (int) jlimit ((int64) 0, (int64) howMany, (int64) file.sourceDataSize - start);
+
+            if (num > 0)
+                memcpy (buffer, file.sourceData + start, (size_t) num);
+
+            pos += num;
+            return num;
+        }
+
         if (inputStream == nullptr)
             return 0;
 
@@ -225,6 +249,13 @@ struct ZipFile::ZipInputStream final : public InputStream
     }
 
 private:
+    void setHeaderSize (const char* buffer)
+    {
+        if (ByteOrder::littleEndianInt (buffer) == 0x04034b50)
+            headerSize = 30 + ByteOrder::littleEndianShort (buffer + 26)
+                            + ByteOrder::littleEndianShort (buffer + 28);
+    }
+
     ZipFile& file;
     ZipEntryHolder zipEntryHolder;
     int64 pos = 0;
@@ -253,6 +284,18 @@ ZipFile::ZipFile (InputStream& stream)  : inputStream (&stream)
 
 ZipFile::ZipFile (const File& file)  : inputSource (new FileInputSource (file))
 {
+    mappedFile = std::make_unique<MemoryMappedFile> (file, MemoryMappedFile::readOnly);
+
+    if (mappedFile->getData() != nullptr)
+    {
+        sourceData = static_cast<const char*> (mappedFile->getData());
+        sourceDataSize = mappedFile->getSize();
+    }
+    else
+    {
+        mappedFile.reset();
+    }
+
     init();
 }
 
@@ -354,7 +397,18 @@ void ZipFile::init()
     std::unique_ptr<InputStream> toDelete;
     InputStream* in = inputStream;
 
-    if (inputSource != nullptr)
+    if (auto* memoryStream = dynamic_cast<MemoryInputStream*> (inputStream))
+    {
+        sourceData = static_cast<const char*> (memoryStream->getData());
+        sourceDataSize = memoryStream->getDataSize();
+    }
+
+    if (sourceData != nullptr)
+    {
+        in = new MemoryInputStream (sourceData, sourceDataSize, false);
+        toDelete.reset (in);
+    }
+    else if (inputSource != nullptr)
     {
         in = inputSource->createInputStream();
         toDelete.reset (in);
@@ -498,7 +552,16 @@ struct ZipFile::Builder::Item
 
     bool writeData (OutputStream& target, const int64 overallStartPosition)
     {
-        MemoryOutputStream compressedData ((size_t) file.getSize());
+        return compressData() && writeCompressedData (target, overallStartPosition);
+    }
+
+    /*  Reads and compresses this item's data into memory. This doesn't touch the
+        target stream, so different items may be compressed on different threads.
+    */
+    bool compressData()
+    {
+        compressedData.ensureSize ((size_t) jmax ((int64) 0, file.getSize()));
+        MemoryOutputStream out (compressedData, false);
 
         if (symbolicLink)
         {
@@ -507,30 +570,40 @@ struct ZipFile::Builder::Item
             uncompressedSize = relativePath.length();
 
             checksum = zlibNamespace::crc32 (0, (uint8_t*) relativePath.toRawUTF8(), (unsigned int) uncompressedSize);
-            compressedData << relativePath;
+            out << relativePath;
         }
         else if (compressionLevel > 0)
         {
-            GZIPCompressorOutputStream compressor (compressedData, compressionLevel,
+            GZIPCompressorOutputStream compressor (out, compressionLevel,
                                                    GZIPCompressorOutputStream::windowBitsRaw);
             if (! writeSource (compressor))
                 return false;
         }
         else
         {
-            if (! writeSource (compressedData))
+            if (! writeSource (out))
                 return false;
         }
 
-        compressedSize = (int64) compressedData.getDataSize();
+        out.flush();
+        compressedSize = (int64) out.getDataSize();
+        return true;
+    }
+
+    /*  Writes the local header and the data produced by compressData(), and then
+        releases that data.
+    */
+    bool writeCompressedData (OutputStream& target, const int64 overallStartPosition)
+    {
         headerStart = target.getPosition() - overallStartPosition;
 
         target.writeInt (0x04034b50);
         writeFlagsAndSizes (target);
-        target << storedPathname
-               << compressedData;
+        target << storedPathname;
 
-        return true;
+        const auto ok = target.write (compressedData.getData(), (size_t) compressedSize);
+        compressedData.reset();
+        return ok;
     }
 
     bool writeDirectoryEntry (OutputStream& target)
@@ -551,6 +624,7 @@ struct ZipFile::Builder::Item
 private:
     const File file;
     std::unique_ptr<InputStream> stream;
+    MemoryBlock compressedData;
     String storedPathname;
     Time fileTime;
     int64 compressedSize = 0, uncompressedSize = 0, headerStart = 0;
@@ -642,6 +716,72 @@ bool ZipFile::Builder::writeToStream (OutputStream& target, double* const progre
             return false;
     }
 
+    return writeDirectory (target, fileStart, progress);
+}
+
+bool ZipFile::Builder::writeToStream (OutputStream& target, double* const progress, ThreadPool& threadPoolToUse) const
+{
+    struct CompressionJob final : public ThreadPoolJob
+    {
+        explicit CompressionJob (Item& i) : ThreadPoolJob ("Zip compression"), item (i) {}
+
+        JobStatus runJob() override
+        {
+            succeeded = item.compressData();
+            return jobHasFinished;
+        }
+
+        Item& item;
+        bool succeeded = false;
+    };
+
+    OwnedArray<CompressionJob> jobs;
+
+    for (auto* item : items)
+        jobs.add (new CompressionJob (*item));
+
+    // Only a limited number of entries are compressed ahead of the writer, so that the
+    // amount of compressed data held in memory stays bounded.
+    const auto maxJobsInFlight = jmax (1, threadPoolToUse.getNumThreads() * 2);
+    int nextJobToStart = 0;
+
+    const auto startJobs = [&] (int lastJobToStart)
+    {
+        for (; nextJobToStart < jmin (jobs.size(), lastJobToStart + 1); ++nextJobToStart)
+            threadPoolToUse.addJob (jobs.getUnchecked (nextJobToStart), false);
+    };
+
+    const auto cancelRemainingJobs = [&] (int firstJob)
+    {
+        for (int i = firstJob; i < nextJobToStart; ++i)
+            threadPoolToUse.removeJob (jobs.getUnchecked (i), true, -1);
+    };
+
+    const auto fileStart = target.getPosition();
+    startJobs (maxJobsInFlight - 1);
+
+    for (int i = 0; i < jobs.size(); ++i)
+    {
+        auto* job = jobs.getUnchecked (i);
+        threadPoolToUse.waitForJobToFinish (job, -1);
+
+        if (progress != nullptr)
+            *progress = (i + 0.5) / items.size();
+
+        if (! (job->succeeded && job->item.writeCompressedData (target, fileStart)))
+        {
+            cancelRemainingJobs (i + 1);
+            return false;
+        }
+
+        startJobs (i + maxJobsInFlight);
+    }
+
+    return writeDirectory (target, fileStart, progress);
+}
+
+bool ZipFile::Builder::writeDirectory (OutputStream& target, int64 fileStart, double* const progress) const
+{
     auto directoryStart = target.getPosition();
 
     for (auto* item : items)
@@ -759,8 +899,105 @@ struct ZIPTests final : public UnitTest
             expectEquals (input->readEntireStreamAsString(), entryName);
         }
 
+        beginTest ("ZIP from a non-memory stream");
+        {
+            BufferedInputStream buffered (new MemoryInputStream (data, false), 16, true);
+            ZipFile streamZip (buffered);
+
+            expectEquals (streamZip.getNumEntries(), entryNames.size());
+
+            for (auto& entryName : entryNames)
+            {
+                std::unique_ptr<InputStream> input (streamZip.createStreamForEntry (*streamZip.getEntry (entryName)));
+                expectEquals (input->readEntireStreamAsString(), entryName);
+            }
+        }
+
         beginTest ("ZipSlip");
         runZipSlipTest();
+
+        beginTest ("Parallel compression");
+        runParallelCompressionTest();
+    }
+
+    void runParallelCompressionTest()
+    {
+        auto random = getRandom();
+        Array<MemoryBlock> contents;
+
+        for (int i = 0; i < 40; ++i)
+        {
+            MemoryOutputStream mo;
+
+            for (int j = random.nextInt (20000); --j >= 0;)
+                mo << random.nextInt (100) << ' ';
+
+            contents.add (mo.getMemoryBlock());
+        }
+
+        const auto createBuilder = [&]
+        {
+            auto builder = std::make_unique<ZipFile::Builder>();
+            const Time time (2024, 1, 2, 3, 4, 5);
+
+            for (int i = 0; i < contents.size(); ++i)
+                builder->addEntry (new MemoryInputStream (contents.getReference (i), false),
+                                   i % 10, "dir/entry" + String (i), time);
+
+            return builder;
+        };
+
+        MemoryOutputStream serial;
+        expect (createBuilder()->writeToStream (serial, nullptr));
+
+        ThreadPool pool (ThreadPoolOptions{}.withNumberOfThreads (4));
+        TemporaryFile tempFile (".zip");
+
+        {
+            FileOutputStream out (tempFile.getFile());
+            expect (out.openedOk());
+
+            double progress = 0.0;
+            expect (createBuilder()->writeToStream (out, &progress, pool));
+            expect (progress > 0.9);
+        }
+
+        MemoryBlock parallel;
+        expect (tempFile.getFile().loadFileAsData (parallel));
+        expect (parallel == serial.getMemoryBlock());
+
+        ZipFile zip (tempFile.getFile());
+        expectEquals (zip.getNumEntries(), contents.size());
+
+        std::atomic<int> numFailures { 0 };
+        WaitableEvent finished;
+        std::atomic<int> numRunning { 4 };
+
+        for (int t = 0; t < 4; ++t)
+        {
+            pool.addJob ([&, t]
+            {
+                for (int i = t; i < zip.getNumEntries() * 4; i += 3)
+                {
+                    const auto index = i % zip.getNumEntries();
+                    std::unique_ptr<InputStream> input (zip.createStreamForEntry (index));
+                    MemoryBlock block;
+
+                    if (input == nullptr
+                        || input->readIntoMemoryBlock (block) != contents.getReference (index).getSize()
+                        || block != contents.getReference (index))
+                    {
+                        ++numFailures;
+                    }
+                }
+
+                if (--numRunning == 0)
+                    finished.signal();
+            });
+        }
+
+        expect (finished.wait (30000));
+        expectEquals (numFailures.load(), 0);
     }
 };
 
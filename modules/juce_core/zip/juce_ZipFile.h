@@ -35,7 +35,18 @@ namespace juce
 class JUCE_API  ZipFile
 {
 public:
-    /** Creates a ZipFile to read a specific file. */
+    /** Creates a ZipFile to read a specific file.
+
+        Where possible, the file is memory-mapped for as long as this object exists, so
+        that entries can be read concurrently without reopening or seeking the file.
+
+        Because the mapping is held for the whole lifetime of the ZipFile, the file must
+        not be modified, truncated or replaced while this object exists: reading from a
+        mapping whose file has shrunk can crash the process (e.g. with SIGBUS on POSIX
+        systems). On Windows, the mapping also stops the file being deleted or renamed
+        until the ZipFile is destroyed. If the file might change underneath you, or you
+        need to keep it unlocked, use the constructor that takes a FileInputStream instead.
+    */
     explicit ZipFile (const File& file);
 
     //==============================================================================
@@ -132,7 +143,12 @@ public:
         Note that if the ZipFile was created with a user-supplied InputStream object,
         then all the streams which are created by this method will by trying to share
         the same source stream, so cannot be safely used on  multiple threads! (But if
-        you create the ZipFile from a File or InputSource, then it is safe to do this).
+        you create the ZipFile from a File, InputSource or MemoryInputStream, then it is
+        safe to do this).
+
+        When the ZipFile was created from a File (which gets memory-mapped) or from a
+        MemoryInputStream, the streams read directly from memory without any locking or
+        seeking, so reading many entries concurrently scales with the number of threads.
     */
     InputStream* createStreamForEntry (int index);
 
@@ -147,7 +163,12 @@ public:
         Note that if the ZipFile was created with a user-supplied InputStream object,
         then all the streams which are created by this method will by trying to share
         the same source stream, so cannot be safely used on  multiple threads! (But if
-        you create the ZipFile from a File or InputSource, then it is safe to do this).
+        you create the ZipFile from a File, InputSource or MemoryInputStream, then it is
+        safe to do this).
+
+        When the ZipFile was created from a File (which gets memory-mapped) or from a
+        MemoryInputStream, the streams read directly from memory without any locking or
+        seeking, so reading many entries concurrently scales with the number of threads.
     */
     InputStream* createStreamForEntry (const ZipEntry& entry);
 
@@ -246,11 +267,25 @@ public:
         */
         bool writeToStream (OutputStream& target, double* progress) const;
 
+        /** Generates the zip file, using a ThreadPool to compress the entries in parallel.
+
+            The entries are still written to the target stream in the order they were added,
+            and the result is identical to the output of the single-threaded version of this
+            method. Only a few entries per pool thread are compressed ahead of the one being
+            written, so the amount of memory used stays bounded.
+
+            This method blocks until the whole archive has been written. The pool must not
+            be the one that's running the calling thread's job, or it may deadlock.
+        */
+        bool writeToStream (OutputStream& target, double* progress, ThreadPool& threadPoolToUse) const;
+
         //==============================================================================
     private:
         struct Item;
         OwnedArray<Item> items;
 
+        bool writeDirectory (OutputStream&, int64 fileStart, double* progress) const;
+
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Builder)
     };
 
@@ -264,6 +299,9 @@ private:
     InputStream* inputStream = nullptr;
     std::unique_ptr<InputStream> streamToDelete;
     std::unique_ptr<InputSource> inputSource;
+    std::unique_ptr<MemoryMappedFile> mappedFile;
+    const char* sourceData = nullptr;
+    size_t sourceDataSize = 0;
 
    #if JUCE_DEBUG
     struct OpenStreamCounter
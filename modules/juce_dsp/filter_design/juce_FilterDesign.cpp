@@ -43,7 +43,7 @@ typename FIR::Coefficients<FloatType>::Ptr
 
     for (size_t i = 0; i <= order; ++i)
     {
-        if (i == order / 2)
+        if (2 * i == order)
         {
             c[i] = static_cast<FloatType> (normalisedFrequency * 2);
         }
@@ -0,0 +1,320 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+MatrixConvolution::MatrixConvolution() = default;
+MatrixConvolution::~MatrixConvolution() = default;
+
+//==============================================================================
+void MatrixConvolution::loadImpulseResponses (const std::vector<AudioBuffer<float>>& impulseResponses)
+{
+    responses.clear();
+    numInputs = (int) impulseResponses.size();
+    numOutputs = 0;
+    irSize = 0;
+
+    for (size_t input = 0; input < impulseResponses.size(); ++input)
+    {
+        const auto& buffer = impulseResponses[input];
+        numOutputs = jmax (numOutputs, buffer.getNumChannels());
+        irSize = jmax (irSize, buffer.getNumSamples());
+
+        for (int output = 0; output < buffer.getNumChannels(); ++output)
+        {
+            const auto* samples = buffer.getReadPointer (output);
+            auto length = buffer.getNumSamples();
+
+            while (length > 0 && exactlyEqual (samples[length - 1], 0.0f))
+                --length;
+
+            if (length > 0)
+                responses.push_back ({ input, (size_t) output, std::vector<float> (samples, samples + length) });
+        }
+    }
+
+    std::stable_sort (responses.begin(), responses.end(), [] (const Response& a, const Response& b)
+    {
+        return a.output < b.output;
+    });
+
+    firstResponseForOutput.assign ((size_t) numOutputs + 1, responses.size());
+
+    for (auto i = responses.size(); i > 0; --i)
+        firstResponseForOutput[responses[i - 1].output] = i - 1;
+
+    for (auto output = (size_t) numOutputs; output > 0; --output)
+        firstResponseForOutput[output - 1] = jmin (firstResponseForOutput[output - 1], firstResponseForOutput[output]);
+
+    if (fft != nullptr)
+        buildPartitions();
+}
+
+//==============================================================================
+void MatrixConvolution::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.maximumBlockSize > 0);
+
+    const auto order = jmax (1, roundToInt (std::log2 (nextPowerOfTwo ((int) spec.maximumBlockSize))));
+    blockSize = (size_t) 1 << order;
+    fft = std::make_unique<FFT> (order + 1);
+
+    numBins = blockSize + 1;
+    numGroups = (numBins + numLanes - 1) / numLanes;
+    fftBuffer.resize (blockSize * 4);
+
+    buildPartitions();
+}
+
+void MatrixConvolution::buildPartitions()
+{
+    size_t numChannels = 0;
+
+    for (auto& response : responses)
+    {
+        response.firstChannel = numChannels;
+        response.numPartitions = (response.samples.size() + blockSize - 1) / blockSize;
+        numChannels += 2 * response.numPartitions;
+    }
+
+    partitions = AudioBlock<Lanes> (partitionMemory, numChannels, numGroups);
+    partitions.clear();
+
+    for (auto& response : responses)
+    {
+        for (size_t partition = 0; partition < response.numPartitions; ++partition)
+        {
+            const auto start = partition * blockSize;
+            const auto channel = response.firstChannel + 2 * partition;
+
+            forwardTransform (response.samples.data() + start,
+                              jmin (blockSize, response.samples.size() - start),
+                              partitions.getChannelPointer (channel),
+                              partitions.getChannelPointer (channel + 1));
+        }
+    }
+
+    // The inputs need a spectrum for every partition of the longest response
+    numSlots = 1;
+
+    for (const auto& response : responses)
+        numSlots = jmax (numSlots, response.numPartitions);
+
+    inputWindows.setSize (jmax (1, numInputs), (int) blockSize * 2);
+    inputSpectra = AudioBlock<Lanes> (spectrumMemory, numSlots * (size_t) jmax (1, numInputs) * 2, numGroups);
+    accumulators = AudioBlock<Lanes> (accumulatorMemory, ((size_t) numOutputs + 1) * 2, numGroups);
+
+    reset();
+}
+
+void MatrixConvolution::reset() noexcept
+{
+    inputWindows.clear();
+    inputSpectra.clear();
+    accumulators.clear();
+    currentSlot = 0;
+    position = 0;
+}
+
+//==============================================================================
+MatrixConvolution::Lanes* MatrixConvolution::getInputSpectrum (size_t slot, size_t input, bool imag) const noexcept
+{
+    return inputSpectra.getChannelPointer ((slot * (size_t) numInputs + input) * 2 + (imag ? 1 : 0));
+}
+
+void MatrixConvolution::forwardTransform (const float* samples, size_t numSamples, Lanes* real, Lanes* imag) noexcept
+{
+    auto* data = fftBuffer.data();
+
+    FloatVectorOperations::copy (data, samples, numSamples);
+    FloatVectorOperations::clear (data + numSamples, blockSize * 2 - numSamples);
+    fft->performRealOnlyForwardTransform (data, true);
+
+    auto* rawReal = reinterpret_cast<float*> (real);
+    auto* rawImag = reinterpret_cast<float*> (imag);
+
+    for (size_t bin = 0; bin < numBins; ++bin)
+    {
+        rawReal[bin] = data[bin * 2];
+        rawImag[bin] = data[bin * 2 + 1];
+    }
+}
+
+void MatrixConvolution::inverseTransform (const Lanes* real, const Lanes* imag) noexcept
+{
+    auto* data = fftBuffer.data();
+    const auto* rawReal = reinterpret_cast<const float*> (real);
+    const auto* rawImag = reinterpret_cast<const float*> (imag);
+
+    for (size_t bin = 0; bin < numBins; ++bin)
+    {
+        data[bin * 2]     = rawReal[bin];
+        data[bin * 2 + 1] = rawImag[bin];
+    }
+
+    fft->performRealOnlyInverseTransform (data);
+}
+
+template <typename Lanes>
+static void multiplyAndAccumulate (Lanes* accumulatorReal, Lanes* accumulatorImag,
+                                   const Lanes* inputReal, const Lanes* inputImag,
+                                   const Lanes* responseReal, const Lanes* responseImag,
+                                   size_t numGroups) noexcept
+{
+    for (size_t i = 0; i < numGroups; ++i)
+    {
+        accumulatorReal[i] += inputReal[i] * responseReal[i] - inputImag[i] * responseImag[i];
+        accumulatorImag[i] += inputReal[i] * responseImag[i] + inputImag[i] * responseReal[i];
+    }
+}
+
+/*  At the start of each block, this sums the contributions from all the partitions
+    after the first, which only depend on the inputs of earlier blocks, so that they
+    don't need to be recalculated when the block arrives in several pieces.
+*/
+void MatrixConvolution::accumulateTails() noexcept
+{
+    for (size_t output = 0; output < (size_t) numOutputs; ++output)
+    {
+        auto* tailReal = accumulators.getChannelPointer (output * 2);
+        auto* tailImag = accumulators.getChannelPointer (output * 2 + 1);
+
+        accumulators.getSubsetChannelBlock (output * 2, 2).clear();
+
+        for (auto r = firstResponseForOutput[output]; r < firstResponseForOutput[output + 1]; ++r)
+        {
+            const auto& response = responses[r];
+
+            for (size_t partition = 1; partition < response.numPartitions; ++partition)
+            {
+                const auto slot = (currentSlot + numSlots - partition) % numSlots;
+                const auto channel = response.firstChannel + 2 * partition;
+
+                multiplyAndAccumulate (tailReal, tailImag,
+                                       getInputSpectrum (slot, response.input, false),
+                                       getInputSpectrum (slot, response.input, true),
+                                       partitions.getChannelPointer (channel),
+                                       partitions.getChannelPointer (channel + 1),
+                                       numGroups);
+            }
+        }
+    }
+}
+
+//==============================================================================
+void MatrixConvolution::processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output, bool isBypassed) noexcept
+{
+    jassert (input.getNumSamples() == output.getNumSamples());
+    jassert (fft != nullptr); // Make sure you call prepare() before processing!
+
+    const auto numSamples = output.getNumSamples();
+    const auto numOutputChannels = output.getNumChannels();
+
+    if (isBypassed || fft == nullptr)
+    {
+        if (input != output)
+        {
+            const auto numChannelsToCopy = jmin (input.getNumChannels(), numOutputChannels);
+
+            output.getSubsetChannelBlock (0, numChannelsToCopy).copyFrom (input.getSubsetChannelBlock (0, numChannelsToCopy));
+            output.getSubsetChannelBlock (numChannelsToCopy, numOutputChannels - numChannelsToCopy).clear();
+        }
+
+        return;
+    }
+
+    const auto numInputChannels = jmin ((size_t) numInputs, input.getNumChannels());
+    const auto numConvolvedChannels = jmin ((size_t) numOutputs, numOutputChannels);
+
+    auto* accumulatorReal = accumulators.getChannelPointer ((size_t) numOutputs * 2);
+    auto* accumulatorImag = accumulators.getChannelPointer ((size_t) numOutputs * 2 + 1);
+    const auto* result = fftBuffer.data() + blockSize;
+
+    for (size_t done = 0; done < numSamples;)
+    {
+        const auto numToDo = jmin (numSamples - done, blockSize - position);
+
+        // All the inputs are read before any of the outputs are written, so that the
+        // processing can be done in place
+        for (size_t channel = 0; channel < numInputChannels; ++channel)
+        {
+            auto* window = inputWindows.getWritePointer ((int) channel);
+
+            FloatVectorOperations::copy (window + blockSize + position, input.getChannelPointer (channel) + done, numToDo);
+            forwardTransform (window, blockSize * 2,
+                              getInputSpectrum (currentSlot, channel, false),
+                              getInputSpectrum (currentSlot, channel, true));
+        }
+
+        if (position == 0)
+            accumulateTails();
+
+        for (size_t channel = 0; channel < numConvolvedChannels; ++channel)
+        {
+            accumulators.getSubsetChannelBlock ((size_t) numOutputs * 2, 2)
+                        .copyFrom (accumulators.getSubsetChannelBlock (channel * 2, 2));
+
+            for (auto r = firstResponseForOutput[channel]; r < firstResponseForOutput[channel + 1]; ++r)
+            {
+                const auto& response = responses[r];
+
+                if (response.input < numInputChannels)
+                    multiplyAndAccumulate (accumulatorReal, accumulatorImag,
+                                           getInputSpectrum (currentSlot, response.input, false),
+                                           getInputSpectrum (currentSlot, response.input, true),
+                                           partitions.getChannelPointer (response.firstChannel),
+                                           partitions.getChannelPointer (response.firstChannel + 1),
+                                           numGroups);
+            }
+
+            inverseTransform (accumulatorReal, accumulatorImag);
+            FloatVectorOperations::copy (output.getChannelPointer (channel) + done, result + position, numToDo);
+        }
+
+        for (auto channel = numConvolvedChannels; channel < numOutputChannels; ++channel)
+            FloatVectorOperations::clear (output.getChannelPointer (channel) + done, numToDo);
+
+        position += numToDo;
+        done += numToDo;
+
+        if (position == blockSize)
+        {
+            // The second half of each window becomes the first half of the next one
+            for (size_t channel = 0; channel < numInputChannels; ++channel)
+            {
+                auto* window = inputWindows.getWritePointer ((int) channel);
+
+                FloatVectorOperations::copy (window, window + blockSize, blockSize);
+                FloatVectorOperations::clear (window + blockSize, blockSize);
+            }
+
+            currentSlot = (currentSlot + 1) % numSlots;
+            position = 0;
+        }
+    }
+}
+
+} // namespace juce::dsp
@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+/**
+    Convolves a set of input channels with a matrix of impulse responses, so that each
+    output channel is the sum of every input convolved with its own response.
+
+    This is the kind of processing used for ambisonic to binaural decoding, where each
+    ambisonic channel has a response for each ear, or for mixing a set of sources through
+    a multichannel room response. Doing it with one Convolution per response would
+    transform each input to the frequency domain once for every output, and each output
+    back once for every input. Instead, each input is transformed once per block, the
+    products with the responses are summed in the frequency domain, and each output is
+    transformed back once, so that the cost of the FFTs only depends on the number of
+    channels, not on the number of responses.
+
+    The responses are split into partitions the size of the block size passed to
+    prepare(), rounded up to a power of 2, and the processing has no latency. It's most
+    efficient when it's given blocks of that size; smaller blocks work, but they need
+    extra FFTs. Responses that are entirely silent are skipped, so a sparse matrix costs
+    less than a full one, and silence at the end of a response is trimmed.
+
+    Unlike Convolution, the responses are used exactly as they're given: they aren't
+    resampled, trimmed at the start or normalised, and they need to be at the sample rate
+    that will be used for processing. They're also loaded synchronously, so
+    loadImpulseResponses() and prepare() allocate memory, and mustn't be called on the
+    audio thread or at the same time as process().
+
+    @see Convolution
+
+    @tags{DSP}
+*/
+class JUCE_API  MatrixConvolution
+{
+public:
+    //==============================================================================
+    /** Creates a convolution with no impulse responses, which produces silence. */
+    MatrixConvolution();
+
+    /** Destructor. */
+    ~MatrixConvolution();
+
+    //==============================================================================
+    /** Sets the matrix of impulse responses.
+
+        There should be a buffer for each input channel, containing a channel for each
+        output, so that channel o of impulseResponses[i] is the response from input i to
+        output o. The buffers can have different lengths, and any missing channels are
+        treated as silent.
+
+        This can be called before or after prepare(). In the second case, the state of
+        the convolution is reset.
+    */
+    void loadImpulseResponses (const std::vector<AudioBuffer<float>>& impulseResponses);
+
+    /** Returns the number of input channels used by the current impulse responses. */
+    int getNumInputChannels() const noexcept            { return numInputs; }
+
+    /** Returns the number of output channels produced by the current impulse responses. */
+    int getNumOutputChannels() const noexcept           { return numOutputs; }
+
+    /** Returns the length of the longest of the current impulse responses. */
+    int getCurrentIRSize() const noexcept               { return irSize; }
+
+    /** Returns the number of impulse responses which aren't silent, and so need to be
+        processed.
+    */
+    int getNumActiveImpulseResponses() const noexcept   { return (int) responses.size(); }
+
+    //==============================================================================
+    /** Prepares the convolution for processing blocks of up to the given size. The
+        number of channels in the spec isn't used, as it comes from the responses.
+    */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the processing state, without changing the impulse responses. */
+    void reset() noexcept;
+
+    /** Processes a block of samples.
+
+        The first getNumInputChannels() channels of the input block are convolved into
+        the first getNumOutputChannels() channels of the output block. Any missing input
+        channels are treated as silent, and any extra output channels are cleared. The
+        input and output blocks can be the same.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        static_assert (std::is_same_v<typename ProcessContext::SampleType, float>,
+                       "MatrixConvolution only supports float data");
+
+        processSamples (context.getInputBlock(), context.getOutputBlock(), context.isBypassed);
+    }
+
+private:
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using Lanes = SIMDRegister<float>;
+   #else
+    using Lanes = float;
+   #endif
+
+    static constexpr size_t numLanes = sizeof (Lanes) / sizeof (float);
+
+    /*  A response that isn't silent. Its spectrum is stored as a pair of channels for
+        each partition, holding the real and imaginary parts.
+    */
+    struct Response
+    {
+        size_t input = 0, output = 0;
+        std::vector<float> samples;
+        size_t firstChannel = 0, numPartitions = 0;
+    };
+
+    void processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output, bool isBypassed) noexcept;
+    void buildPartitions();
+    void forwardTransform (const float* samples, size_t numSamples, Lanes* real, Lanes* imag) noexcept;
+    void inverseTransform (const Lanes* real, const Lanes* imag) noexcept;
+    void accumulateTails() noexcept;
+
+    Lanes* getInputSpectrum (size_t slot, size_t input, bool imag) const noexcept;
+
+    //==============================================================================
+    std::vector<Response> responses;
+    std::vector<size_t> firstResponseForOutput;
+    int numInputs = 0, numOutputs = 0, irSize = 0;
+
+    std::unique_ptr<FFT> fft;
+    size_t blockSize = 0, numBins = 0, numGroups = 0, numSlots = 0;
+    size_t currentSlot = 0, position = 0;
+
+    AudioBuffer<float> inputWindows;
+    std::vector<float> fftBuffer;
+    HeapBlock<char> partitionMemory, spectrumMemory, accumulatorMemory;
+    AudioBlock<Lanes> partitions, inputSpectra, accumulators;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MatrixConvolution)
+};
+
+} // namespace juce::dsp
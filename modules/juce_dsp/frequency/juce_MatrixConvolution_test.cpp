@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce::dsp
+{
+
+class MatrixConvolutionTests final : public UnitTest
+{
+public:
+    MatrixConvolutionTests()
+        : UnitTest ("MatrixConvolution", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        const auto impulseResponses = createImpulseResponses (random);
+        const auto input = createNoise (random, numInputs, numSamples);
+        const auto expected = convolve (input, impulseResponses);
+
+        beginTest ("The responses are counted and silent ones are skipped");
+        {
+            MatrixConvolution convolution;
+            convolution.loadImpulseResponses (impulseResponses);
+
+            expectEquals (convolution.getNumInputChannels(), numInputs);
+            expectEquals (convolution.getNumOutputChannels(), numOutputs);
+            expectEquals (convolution.getCurrentIRSize(), 1000);
+            expectEquals (convolution.getNumActiveImpulseResponses(), 4);
+        }
+
+        beginTest ("Processing blocks of random sizes matches a direct convolution");
+        {
+            MatrixConvolution convolution;
+            convolution.loadImpulseResponses (impulseResponses);
+            convolution.prepare ({ 44100.0, (uint32) maxBlockSize, (uint32) numInputs });
+
+            AudioBuffer<float> output (numInputs, numSamples);
+            output.clear();
+
+            for (int start = 0; start < numSamples;)
+            {
+                const auto num = jmin (numSamples - start, 1 + random.nextInt (maxBlockSize));
+
+                const auto inputBlock = AudioBlock<const float> (input).getSubBlock ((size_t) start, (size_t) num);
+                auto outputBlock = AudioBlock<float> (output).getSubBlock ((size_t) start, (size_t) num);
+                convolution.process (ProcessContextNonReplacing<float> (inputBlock, outputBlock));
+
+                start += num;
+            }
+
+            expectMatches (output, expected);
+
+            for (int i = 0; i < numSamples; ++i)
+                expectEquals (output.getSample (numOutputs, i), 0.0f);
+        }
+
+        beginTest ("Processing in place matches a direct convolution");
+        {
+            MatrixConvolution convolution;
+            convolution.prepare ({ 44100.0, (uint32) maxBlockSize, (uint32) numInputs });
+            convolution.loadImpulseResponses (impulseResponses);
+
+            auto buffer = input;
+
+            for (int start = 0; start < numSamples; start += maxBlockSize)
+            {
+                auto block = AudioBlock<float> (buffer).getSubBlock ((size_t) start, (size_t) jmin (maxBlockSize, numSamples - start));
+                convolution.process (ProcessContextReplacing<float> (block));
+            }
+
+            expectMatches (buffer, expected);
+        }
+
+        beginTest ("Resetting clears the state");
+        {
+            MatrixConvolution convolution;
+            convolution.loadImpulseResponses (impulseResponses);
+            convolution.prepare ({ 44100.0, (uint32) maxBlockSize, (uint32) numInputs });
+
+            auto buffer = createNoise (random, numInputs, maxBlockSize);
+            AudioBlock<float> block (buffer);
+            convolution.process (ProcessContextReplacing<float> (block));
+
+            convolution.reset();
+            block.clear();
+            convolution.process (ProcessContextReplacing<float> (block));
+
+            for (int channel = 0; channel < numInputs; ++channel)
+                expectEquals (buffer.getMagnitude (channel, 0, maxBlockSize), 0.0f);
+        }
+    }
+
+private:
+    static constexpr int numInputs = 3, numOutputs = 2, numSamples = 1500, maxBlockSize = 64;
+
+    static AudioBuffer<float> createNoise (Random& random, int numChannels, int length)
+    {
+        AudioBuffer<float> buffer (numChannels, length);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < length; ++i)
+                buffer.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+        return buffer;
+    }
+
+    // Responses of different lengths, with one that's silent and one that's missing
+    static std::vector<AudioBuffer<float>> createImpulseResponses (Random& random)
+    {
+        std::vector<AudioBuffer<float>> result;
+        result.push_back (createNoise (random, numOutputs, 300));
+        result.push_back (createNoise (random, numOutputs, 1000));
+        result.push_back (createNoise (random, 1, 37));
+
+        result[0].setSize (numOutputs, 301, true, true);
+        result[0].setSample (0, 300, 0.0f);
+        result[0].setSample (1, 300, 1.0f);
+        result[1].clear (1, 0, 1000);
+
+        for (auto& buffer : result)
+            buffer.applyGain (0.1f);
+
+        return result;
+    }
+
+    static AudioBuffer<float> convolve (const AudioBuffer<float>& input, const std::vector<AudioBuffer<float>>& impulseResponses)
+    {
+        AudioBuffer<float> output (numOutputs, input.getNumSamples());
+        output.clear();
+
+        for (int in = 0; in < numInputs; ++in)
+        {
+            const auto& ir = impulseResponses[(size_t) in];
+
+            for (int out = 0; out < ir.getNumChannels(); ++out)
+                for (int i = 0; i < input.getNumSamples(); ++i)
+                    for (int j = 0; j < jmin (i + 1, ir.getNumSamples()); ++j)
+                        output.addSample (out, i, ir.getSample (out, j) * input.getSample (in, i - j));
+        }
+
+        return output;
+    }
+
+    void expectMatches (const AudioBuffer<float>& actual, const AudioBuffer<float>& expected)
+    {
+        auto maxError = 0.0f;
+
+        for (int channel = 0; channel < numOutputs; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                maxError = jmax (maxError, std::abs (actual.getSample (channel, i) - expected.getSample (channel, i)));
+
+        expectLessThan (maxError, 1.0e-4f);
+    }
+};
+
+static MatrixConvolutionTests matrixConvolutionTests;
+
+} // namespace juce::dsp
@@ -60,6 +60,7 @@
 #include "processors/juce_Panner.cpp"
 #include "processors/juce_Oversampling.cpp"
 #include "processors/juce_BallisticsFilter.cpp"
+#include "processors/juce_DynamicsBlockProcessor.cpp"
 #include "processors/juce_LinkwitzRileyFilter.cpp"
 #include "processors/juce_DelayLine.cpp"
 #include "processors/juce_DryWetMixer.cpp"
@@ -69,6 +70,7 @@
 #include "maths/juce_LookupTable.cpp"
 #include "frequency/juce_FFT.cpp"
 #include "frequency/juce_Convolution.cpp"
+#include "frequency/juce_MatrixConvolution.cpp"
 #include "frequency/juce_Windowing.cpp"
 #include "filter_design/juce_FilterDesign.cpp"
 #include "widgets/juce_LadderFilter.cpp"
@@ -77,6 +79,8 @@
 #include "widgets/juce_Limiter.cpp"
 #include "widgets/juce_Phaser.cpp"
 #include "widgets/juce_Chorus.cpp"
+#include "widgets/juce_WavetableOscillatorBank.cpp"
+#include "widgets/juce_FDNReverb.cpp"
 
 #if JUCE_USE_SIMD
  #if JUCE_INTEL
@@ -95,6 +99,7 @@
 #if JUCE_UNIT_TESTS
  #include "maths/juce_Matrix_test.cpp"
  #include "maths/juce_LogRampedValue_test.cpp"
+ #include "maths/juce_LookupTable_test.cpp"
 
  #if JUCE_USE_SIMD
   #include "containers/juce_SIMDRegister_test.cpp"
@@ -103,6 +108,12 @@
  #include "containers/juce_AudioBlock_test.cpp"
  #include "frequency/juce_Convolution_test.cpp"
  #include "frequency/juce_FFT_test.cpp"
+ #include "frequency/juce_MatrixConvolution_test.cpp"
+ #include "processors/juce_DelayLine_test.cpp"
+ #include "processors/juce_DynamicsBlockProcessor_test.cpp"
  #include "processors/juce_FIRFilter_test.cpp"
+ #include "processors/juce_Oversampling_test.cpp"
  #include "processors/juce_ProcessorChain_test.cpp"
+ #include "widgets/juce_WavetableOscillatorBank_test.cpp"
+ #include "widgets/juce_FDNReverb_test.cpp"
 #endif
@@ -262,18 +262,22 @@ namespace util
 #include "processors/juce_DelayLine.h"
 #include "processors/juce_Oversampling.h"
 #include "processors/juce_BallisticsFilter.h"
+#include "processors/juce_DynamicsBlockProcessor.h"
 #include "processors/juce_LinkwitzRileyFilter.h"
 #include "processors/juce_DryWetMixer.h"
 #include "processors/juce_StateVariableTPTFilter.h"
 #include "frequency/juce_FFT.h"
 #include "frequency/juce_Convolution.h"
+#include "frequency/juce_MatrixConvolution.h"
 #include "frequency/juce_Windowing.h"
 #include "filter_design/juce_FilterDesign.h"
 #include "widgets/juce_Reverb.h"
+#include "widgets/juce_FDNReverb.h"
 #include "widgets/juce_Bias.h"
 #include "widgets/juce_Gain.h"
 #include "widgets/juce_WaveShaper.h"
 #include "widgets/juce_Oscillator.h"
+#include "widgets/juce_WavetableOscillatorBank.h"
 #include "widgets/juce_LadderFilter.h"
 #include "widgets/juce_Compressor.h"
 #include "widgets/juce_NoiseGate.h"
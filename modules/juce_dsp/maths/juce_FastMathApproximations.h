@@ -57,8 +57,7 @@ struct FastMathApproximations
     template <typename FloatType>
     static void cosh (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::cosh (values[i]);
+        processInBlocks (values, numValues, [] (FloatType x) { return FastMathApproximations::cosh (x); });
     }
 
     /** Provides a fast approximation of the function sinh(x) using a Pade approximant
@@ -85,8 +84,7 @@ struct FastMathApproximations
     template <typename FloatType>
     static void sinh (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::sinh (values[i]);
+        processInBlocks (values, numValues, [] (FloatType x) { return FastMathApproximations::sinh (x); });
     }
 
     /** Provides a fast approximation of the function tanh(x) using a Pade approximant
@@ -113,8 +111,7 @@ struct FastMathApproximations
     template <typename FloatType>
     static void tanh (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::tanh (values[i]);
+        processInBlocks (values, numValues, [] (FloatType x) { return FastMathApproximations::tanh (x); });
     }
 
     //==============================================================================
@@ -142,8 +139,7 @@ struct FastMathApproximations
     template <typename FloatType>
     static void cos (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::cos (values[i]);
+        processInBlocks (values, numValues, [] (FloatType x) { return FastMathApproximations::cos (x); });
     }
 
     /** Provides a fast approximation of the function sin(x) using a Pade approximant
@@ -170,8 +166,7 @@ struct FastMathApproximations
     template <typename FloatType>
     static void sin (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::sin (values[i]);
+        processInBlocks (values, numValues, [] (FloatType x) { return FastMathApproximations::sin (x); });
     }
 
     /** Provides a fast approximation of the function tan(x) using a Pade approximant
@@ -198,8 +193,7 @@ struct FastMathApproximations
     template <typename FloatType>
     static void tan (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::tan (values[i]);
+        processInBlocks (values, numValues, [] (FloatType x) { return FastMathApproximations::tan (x); });
     }
 
     //==============================================================================
@@ -226,8 +220,7 @@ struct FastMathApproximations
     template <typename FloatType>
     static void exp (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::exp (values[i]);
+        processInBlocks (values, numValues, [] (FloatType x) { return FastMathApproximations::exp (x); });
     }
 
     /** Provides a fast approximation of the function log(x+1) using a Pade approximant
@@ -253,8 +246,26 @@ struct FastMathApproximations
     template <typename FloatType>
     static void logNPlusOne (FloatType* values, size_t numValues) noexcept
     {
-        for (size_t i = 0; i < numValues; ++i)
-            values[i] = FastMathApproximations::logNPlusOne (values[i]);
+        processInBlocks (values, numValues, [] (FloatType x) { return FastMathApproximations::logNPlusOne (x); });
+    }
+
+private:
+    //==============================================================================
+    // Applies a function to an array in fixed-size groups, which the compiler can turn
+    // into vector instructions even at optimisation levels that won't vectorise a loop
+    // of unknown length.
+    template <typename FloatType, typename Function>
+    static void processInBlocks (FloatType* values, size_t numValues, Function function) noexcept
+    {
+        constexpr size_t groupSize = 32 / sizeof (FloatType);
+        const auto numInGroups = numValues - numValues % groupSize;
+
+        for (size_t i = 0; i < numInGroups; i += groupSize)
+            for (size_t j = 0; j < groupSize; ++j)
+                values[i + j] = function (values[i + j]);
+
+        for (size_t i = numInGroups; i < numValues; ++i)
+            values[i] = function (values[i]);
     }
 };
 
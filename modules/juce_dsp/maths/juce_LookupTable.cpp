@@ -68,6 +68,68 @@ void LookupTable<FloatType>::prepare() noexcept
     data.getReference (guardIndex) = data.getUnchecked (guardIndex - 1);
 }
 
+template <typename FloatType>
+void LookupTable<FloatType>::getUnchecked (const FloatType* indices, FloatType* output, size_t numValues) const noexcept
+{
+    jassert (isInitialised());  // Use the non-default constructor or call initialise() before first use
+
+    const auto* values = data.begin();
+
+    for (size_t i = 0; i < numValues; ++i)
+    {
+        const auto index = indices[i];
+        jassert (isPositiveAndBelow (index, FloatType (getNumPoints())));
+
+        const auto position = static_cast<int> (index);
+        const auto f = index - FloatType (position);
+        const auto x0 = values[position];
+
+        output[i] = x0 + f * (values[position + 1] - x0);
+    }
+}
+
+//==============================================================================
+template <typename FloatType>
+void LookupTableTransform<FloatType>::processUnchecked (const FloatType* input, FloatType* output, size_t numSamples) const noexcept
+{
+    processInChunks (input, output, numSamples, false);
+}
+
+template <typename FloatType>
+void LookupTableTransform<FloatType>::process (const FloatType* input, FloatType* output, size_t numSamples) const noexcept
+{
+    processInChunks (input, output, numSamples, true);
+}
+
+template <typename FloatType>
+void LookupTableTransform<FloatType>::processInChunks (const FloatType* input, FloatType* output,
+                                                       size_t numSamples, bool clipInput) const noexcept
+{
+    // The conversion of the inputs to table indices is done for a whole chunk at a
+    // time with vector operations, leaving only the table reads to be done per value
+    constexpr size_t chunkSize = 64;
+    FloatType indices[chunkSize];
+
+    for (size_t start = 0; start < numSamples; start += chunkSize)
+    {
+        const auto num = jmin (chunkSize, numSamples - start);
+
+        if (clipInput)
+        {
+            FloatVectorOperations::clip (indices, input + start, minInputValue, maxInputValue, num);
+            FloatVectorOperations::multiply (indices, scaler, num);
+        }
+        else
+        {
+            FloatVectorOperations::copyWithMultiply (indices, input + start, scaler, num);
+        }
+
+        FloatVectorOperations::add (indices, offset, num);
+
+        lookupTable.getUnchecked (indices, output + start, num);
+    }
+}
+
 template <typename FloatType>
 void LookupTableTransform<FloatType>::initialise (const std::function<FloatType (FloatType)>& functionToApproximate,
                                                   FloatType minInputValueToUse,
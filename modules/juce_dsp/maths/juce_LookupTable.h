@@ -105,6 +105,19 @@ public:
         return jmap (f, x0, x1);
     }
 
+    /** Calculates the approximated values for an array of indices without range checking.
+
+        This gives the same results as calling getUnchecked() for each index, but is
+        faster. The indices and output may point to the same array.
+
+        @param indices   The non-integer indices, which must be non-negative and less than numPoints.
+        @param output    The array that the approximated values are written to.
+        @param numValues The number of values to calculate.
+
+        @see getUnchecked
+    */
+    void getUnchecked (const FloatType* indices, FloatType* output, size_t numValues) const noexcept;
+
     //==============================================================================
     /** Calculates the approximated value for the given index with range checking.
 
@@ -264,24 +277,20 @@ public:
     FloatType operator() (FloatType index) const noexcept       { return processSample (index); }
 
     //==============================================================================
-    /** Processes an array of input values without range checking
+    /** Processes an array of input values without range checking.
+
+        The input and output may point to the same array.
         @see process
     */
-    void processUnchecked (const FloatType* input, FloatType* output, size_t numSamples) const noexcept
-    {
-        for (size_t i = 0; i < numSamples; ++i)
-            output[i] = processSampleUnchecked (input[i]);
-    }
+    void processUnchecked (const FloatType* input, FloatType* output, size_t numSamples) const noexcept;
 
     //==============================================================================
-    /** Processes an array of input values with range checking
+    /** Processes an array of input values with range checking.
+
+        The input and output may point to the same array.
         @see processUnchecked
     */
-    void process (const FloatType* input, FloatType* output, size_t numSamples) const noexcept
-    {
-        for (size_t i = 0; i < numSamples; ++i)
-            output[i] = processSample (input[i]);
-    }
+    void process (const FloatType* input, FloatType* output, size_t numSamples) const noexcept;
 
     //==============================================================================
     /** Calculates the maximum relative error of the approximation for the specified
@@ -314,6 +323,7 @@ public:
 private:
     //==============================================================================
     static double calculateRelativeDifference (double, double) noexcept;
+    void processInChunks (const FloatType* input, FloatType* output, size_t numSamples, bool clipInput) const noexcept;
 
     //==============================================================================
     LookupTable<FloatType> lookupTable;
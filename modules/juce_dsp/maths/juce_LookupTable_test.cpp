@@ -0,0 +1,126 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce::dsp
+{
+
+class LookupTableTests final : public UnitTest
+{
+public:
+    LookupTableTests()
+        : UnitTest ("LookupTable", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        Random random (1234);
+        std::vector<float> input (1000);
+
+        for (auto& x : input)
+            x = random.nextFloat() * 14.0f - 7.0f;
+
+        beginTest ("Processing arrays gives the same results as processing single values");
+        {
+            LookupTableTransform<float> transform ([] (float x) { return std::tanh (x); }, -5.0f, 5.0f, 512);
+            std::vector<float> output (input.size());
+
+            transform.process (input.data(), output.data(), input.size());
+
+            for (size_t i = 0; i < input.size(); ++i)
+                expectWithinAbsoluteError (output[i], transform.processSample (input[i]), 1.0e-6f);
+
+            std::vector<float> inRange (input.size());
+            FloatVectorOperations::clip (inRange.data(), input.data(), -5.0f, 5.0f, (int) input.size());
+
+            auto inPlace = inRange;
+            transform.processUnchecked (inPlace.data(), inPlace.data(), inPlace.size());
+
+            for (size_t i = 0; i < input.size(); ++i)
+                expectWithinAbsoluteError (inPlace[i], transform.processSampleUnchecked (inRange[i]), 1.0e-6f);
+        }
+
+        beginTest ("Fast approximations of arrays match the single value versions");
+        {
+            expectArrayMatches<float>  (input, [] (auto* v, size_t n) { FastMathApproximations::tanh (v, n); },
+                                               [] (float x)  { return FastMathApproximations::tanh (x); });
+            expectArrayMatches<double> (input, [] (auto* v, size_t n) { FastMathApproximations::tanh (v, n); },
+                                               [] (double x) { return FastMathApproximations::tanh (x); });
+            expectArrayMatches<float>  (input, [] (auto* v, size_t n) { FastMathApproximations::sin (v, n); },
+                                               [] (float x)  { return FastMathApproximations::sin (x); });
+            expectArrayMatches<float>  (input, [] (auto* v, size_t n) { FastMathApproximations::exp (v, n); },
+                                               [] (float x)  { return FastMathApproximations::exp (x); });
+        }
+
+        beginTest ("Oscillator blocks match processSample");
+        {
+            for (auto numPoints : { (size_t) 0, (size_t) 128 })
+            {
+                Oscillator<float> blockOscillator, sampleOscillator;
+
+                for (auto* o : { &blockOscillator, &sampleOscillator })
+                {
+                    o->initialise ([] (float x) { return std::sin (x); }, numPoints);
+                    o->prepare ({ 48000.0, 256, 2 });
+                    o->setFrequency (440.0f, true);
+                    o->setFrequency (1000.0f);
+                }
+
+                AudioBuffer<float> buffer (2, 256);
+                buffer.clear();
+
+                AudioBlock<float> block (buffer);
+                blockOscillator.process (ProcessContextReplacing<float> (block));
+
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                {
+                    const auto expected = sampleOscillator.processSample (0.0f);
+
+                    for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                        expectWithinAbsoluteError (buffer.getSample (channel, i), expected, 1.0e-5f);
+                }
+            }
+        }
+    }
+
+private:
+    template <typename FloatType, typename ArrayFunction, typename ValueFunction>
+    void expectArrayMatches (const std::vector<float>& input, ArrayFunction&& arrayFunction, ValueFunction&& valueFunction)
+    {
+        // An odd length, so that the values that don't fill a whole group are tested too
+        std::vector<FloatType> values (input.begin(), input.begin() + 999);
+        arrayFunction (values.data(), values.size());
+
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            const auto expected = valueFunction ((FloatType) input[i]);
+            expectWithinAbsoluteError (values[i], expected, (FloatType) 1.0e-6 * jmax ((FloatType) 1, std::abs (expected)));
+        }
+    }
+};
+
+static LookupTableTests lookupTableTests;
+
+} // namespace juce::dsp
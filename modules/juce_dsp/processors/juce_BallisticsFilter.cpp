@@ -106,6 +106,66 @@ SampleType BallisticsFilter<SampleType>::processSample (int channel, SampleType
     return result;
 }
 
+// Runs the filters for a group of channels side by side, so that their feedback
+// loops can overlap rather than each one waiting for the previous sample.
+template <size_t numChannels, bool squareInput, typename SampleType>
+static void processBallisticsGroup (const SampleType* const* inputChannels, SampleType* const* outputChannels,
+                                    SampleType* state, SampleType attack, SampleType release, int numSamples) noexcept
+{
+    SampleType y[numChannels];
+    std::copy (state, state + numChannels, y);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            const auto input = inputChannels[channel][i];
+            const auto x = squareInput ? input * input : std::abs (input);
+            y[channel] = x + (x > y[channel] ? attack : release) * (y[channel] - x);
+            outputChannels[channel][i] = y[channel];
+        }
+    }
+
+    std::copy (y, y + numChannels, state);
+}
+
+template <typename SampleType>
+void BallisticsFilter<SampleType>::processSamples (const SampleType* const* inputChannels, SampleType* const* outputChannels,
+                                                  int firstChannel, int numChannels, int numSamples) noexcept
+{
+    jassert (firstChannel >= 0 && (size_t) (firstChannel + numChannels) <= yold.size());
+
+    const auto isRMS = levelType == LevelCalculationType::RMS;
+    auto* state = yold.data() + firstChannel;
+    constexpr auto groupSize = (int) maxChannelsPerGroup;
+
+    for (int channel = 0; channel < numChannels;)
+    {
+        const auto* inputs = inputChannels + channel;
+        auto* outputs = outputChannels + channel;
+
+        if (numChannels - channel >= groupSize)
+        {
+            if (isRMS)  processBallisticsGroup<maxChannelsPerGroup, true>  (inputs, outputs, state + channel, cteAT, cteRL, numSamples);
+            else        processBallisticsGroup<maxChannelsPerGroup, false> (inputs, outputs, state + channel, cteAT, cteRL, numSamples);
+
+            channel += groupSize;
+        }
+        else
+        {
+            if (isRMS)  processBallisticsGroup<1, true>  (inputs, outputs, state + channel, cteAT, cteRL, numSamples);
+            else        processBallisticsGroup<1, false> (inputs, outputs, state + channel, cteAT, cteRL, numSamples);
+
+            ++channel;
+        }
+    }
+
+    if (isRMS)
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                outputChannels[channel][i] = std::sqrt (outputChannels[channel][i]);
+}
+
 template <typename SampleType>
 void BallisticsFilter<SampleType>::snapToZero() noexcept
 {
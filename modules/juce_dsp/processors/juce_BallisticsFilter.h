@@ -110,13 +110,19 @@ public:
             return;
         }
 
-        for (size_t channel = 0; channel < numChannels; ++channel)
+        for (size_t channel = 0; channel < numChannels; channel += maxChannelsPerGroup)
         {
-            auto* inputSamples  = inputBlock .getChannelPointer (channel);
-            auto* outputSamples = outputBlock.getChannelPointer (channel);
+            const SampleType* inputChannels[maxChannelsPerGroup];
+            SampleType* outputChannels[maxChannelsPerGroup];
+            const auto numChannelsInGroup = jmin (maxChannelsPerGroup, numChannels - channel);
 
-            for (size_t i = 0; i < numSamples; ++i)
-                outputSamples[i] = processSample ((int) channel, inputSamples[i]);
+            for (size_t i = 0; i < numChannelsInGroup; ++i)
+            {
+                inputChannels[i]  = inputBlock .getChannelPointer (channel + i);
+                outputChannels[i] = outputBlock.getChannelPointer (channel + i);
+            }
+
+            processSamples (inputChannels, outputChannels, (int) channel, (int) numChannelsInGroup, (int) numSamples);
         }
 
        #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
@@ -127,6 +133,20 @@ public:
     /** Processes one sample at a time on a given channel. */
     SampleType processSample (int channel, SampleType inputValue);
 
+    /** Processes a block of samples on a range of channels. This gives the same
+        results as calling processSample() for each sample, but is faster, especially
+        when several channels are processed together, as their filters can then run
+        in parallel. The inputs and outputs may point to the same data.
+
+        @param inputChannels    the input data for each channel
+        @param outputChannels   the output data for each channel
+        @param firstChannel     the index of the first channel's filter
+        @param numChannels      the number of channels to process
+        @param numSamples       the number of samples in each channel
+    */
+    void processSamples (const SampleType* const* inputChannels, SampleType* const* outputChannels,
+                         int firstChannel, int numChannels, int numSamples) noexcept;
+
     /** Ensure that the state variables are rounded to zero if the state
         variables are denormals. This is only needed if you are doing
         sample by sample processing.
@@ -135,6 +155,8 @@ public:
 
 private:
     //==============================================================================
+    static constexpr size_t maxChannelsPerGroup = 4;
+
     SampleType calculateLimitedCte (SampleType) const noexcept;
 
     //==============================================================================
@@ -84,11 +84,26 @@ template <typename SampleType, typename InterpolationType>
 void DelayLine<SampleType, InterpolationType>::setMaximumDelayInSamples (int maxDelayInSamples)
 {
     jassert (maxDelayInSamples >= 0);
+    requestedMaximumDelay = maxDelayInSamples;
     totalSize = jmax (4, maxDelayInSamples + 2);
+
+    if (usePowerOfTwoSize)
+        totalSize = nextPowerOfTwo (totalSize);
+
     bufferData.setSize ((int) bufferData.getNumChannels(), totalSize, false, false, true);
     reset();
 }
 
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::setUsingPowerOfTwoSize (bool shouldUsePowerOfTwoSize)
+{
+    if (usePowerOfTwoSize != shouldUsePowerOfTwoSize)
+    {
+        usePowerOfTwoSize = shouldUsePowerOfTwoSize;
+        setMaximumDelayInSamples (requestedMaximumDelay);
+    }
+}
+
 template <typename SampleType, typename InterpolationType>
 void DelayLine<SampleType, InterpolationType>::reset()
 {
@@ -105,7 +120,7 @@ template <typename SampleType, typename InterpolationType>
 void DelayLine<SampleType, InterpolationType>::pushSample (int channel, SampleType sample)
 {
     bufferData.setSample (channel, writePos[(size_t) channel], sample);
-    writePos[(size_t) channel] = (writePos[(size_t) channel] + totalSize - 1) % totalSize;
+    writePos[(size_t) channel] = wrap (writePos[(size_t) channel] - 1);
 }
 
 template <typename SampleType, typename InterpolationType>
@@ -117,11 +132,70 @@ SampleType DelayLine<SampleType, InterpolationType>::popSample (int channel, Sam
     auto result = interpolateSample (channel);
 
     if (updateReadPointer)
-        readPos[(size_t) channel] = (readPos[(size_t) channel] + totalSize - 1) % totalSize;
+        readPos[(size_t) channel] = wrap (readPos[(size_t) channel] - 1);
 
     return result;
 }
 
+//==============================================================================
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::readTaps (int channel, const SampleType* delaysInSamples,
+                                                         SampleType* destination, int numTaps) noexcept
+{
+    jassert (isPositiveAndBelow (channel, bufferData.getNumChannels()));
+
+    if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Thiran>)
+    {
+        const auto oldDelay = delay;
+
+        for (int i = 0; i < numTaps; ++i)
+            destination[i] = popSample (channel, delaysInSamples[i], false);
+
+        setDelay (oldDelay);
+    }
+    else
+    {
+        readInterpolated (delaysInSamples, destination, numTaps, [channel] (int) { return channel; });
+    }
+}
+
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::pushSamples (const SampleType* samples) noexcept
+{
+    auto* const* channels = bufferData.getArrayOfWritePointers();
+
+    for (size_t channel = 0; channel < writePos.size(); ++channel)
+    {
+        channels[channel][writePos[channel]] = samples[channel];
+        writePos[channel] = wrap (writePos[channel] - 1);
+    }
+}
+
+template <typename SampleType, typename InterpolationType>
+void DelayLine<SampleType, InterpolationType>::popSamples (const SampleType* delaysInSamples, SampleType* destination,
+                                                           bool updateReadPointer) noexcept
+{
+    const auto numChannels = (int) readPos.size();
+
+    if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Thiran>)
+    {
+        const auto oldDelay = delay;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            destination[channel] = popSample (channel, delaysInSamples[channel], false);
+
+        setDelay (oldDelay);
+    }
+    else
+    {
+        readInterpolated (delaysInSamples, destination, numChannels, [] (int tap) { return tap; });
+    }
+
+    if (updateReadPointer)
+        for (auto& pos : readPos)
+            pos = wrap (pos - 1);
+}
+
 //==============================================================================
 template class DelayLine<float,  DelayLineInterpolationTypes::None>;
 template class DelayLine<double, DelayLineInterpolationTypes::None>;
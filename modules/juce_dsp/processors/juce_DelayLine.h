@@ -84,6 +84,11 @@ namespace DelayLineInterpolationTypes
     Note: If you intend to change the delay in real time, you may want to smooth
     changes to the delay systematically using either a ramp or a low-pass filter.
 
+    When many delays are read at once, for example in a multi-tap delay or a
+    feedback delay network, the block methods readTaps(), pushSamples() and
+    popSamples() are much faster than calling popSample() repeatedly, as they split
+    the delays and compute the interpolation for many taps in one go.
+
     @see SmoothedValue, FirstOrderTPTFilter
 
     @tags{DSP}
@@ -120,11 +125,31 @@ public:
 
     /** Gets the maximum possible delay in samples.
 
-        For very short delay times, the result of getMaximumDelayInSamples() may
-        differ from the last value passed to setMaximumDelayInSamples().
+        For very short delay times, or when setUsingPowerOfTwoSize() is enabled, the
+        result of getMaximumDelayInSamples() may differ from the last value passed to
+        setMaximumDelayInSamples().
     */
     int getMaximumDelayInSamples() const noexcept       { return totalSize - 2; }
 
+    /** Rounds the size of the buffer up to a power of two, so that the read and write
+        positions can wrap around with a bitmask rather than a comparison.
+
+        This can make process() with a modulated delay a little faster, but it uses
+        more memory, and with many channels the buffers can end up competing for the
+        same cache lines, which makes it slower. It's disabled by default. Changing it
+        resizes and clears the delay line, so you should never call it from the audio
+        thread.
+
+        @see setMaximumDelayInSamples
+    */
+    void setUsingPowerOfTwoSize (bool shouldUsePowerOfTwoSize);
+
+    /** Returns true if the size of the buffer is rounded up to a power of two.
+
+        @see setUsingPowerOfTwoSize
+    */
+    bool isUsingPowerOfTwoSize() const noexcept         { return usePowerOfTwoSize; }
+
     /** Resets the internal state variables of the processor. */
     void reset();
 
@@ -158,6 +183,43 @@ public:
     */
     SampleType popSample (int channel, SampleType delayInSamples = -1, bool updateReadPointer = true);
 
+    //==============================================================================
+    /** Reads several taps from one channel of the delay line at once.
+
+        This is the same as calling popSample (channel, delaysInSamples[i], false) for
+        each tap, except that it doesn't change the delay set with setDelay(). Call
+        popSample() or popSamples() afterwards to move the read pointer on.
+
+        With Thiran interpolation, which is stateful, the taps are read one at a time.
+
+        @param channel              the channel to read
+        @param delaysInSamples      the fractional delay of each tap
+        @param destination          receives the value of each tap
+        @param numTaps              the number of taps to read
+
+        @see popSample
+    */
+    void readTaps (int channel, const SampleType* delaysInSamples, SampleType* destination, int numTaps) noexcept;
+
+    /** Pushes one sample into each channel of the delay line.
+
+        @param samples              one value for each channel
+    */
+    void pushSamples (const SampleType* samples) noexcept;
+
+    /** Pops one sample from each channel of the delay line, with a different delay for
+        each channel.
+
+        This is the same as calling popSample (channel, delaysInSamples[channel]) for
+        each channel, except that it doesn't change the delay set with setDelay().
+
+        @param delaysInSamples      the fractional delay for each channel
+        @param destination          receives one value for each channel
+        @param updateReadPointer    should be true unless you're going to read more
+                                    values before the next call to pushSamples()
+    */
+    void popSamples (const SampleType* delaysInSamples, SampleType* destination, bool updateReadPointer = true) noexcept;
+
     //==============================================================================
     /** Processes the input and output samples supplied in the processing context.
 
@@ -197,82 +259,224 @@ public:
         }
     }
 
-private:
-    //==============================================================================
-    SampleType interpolateSample (int channel)
+    /** Processes the input and output samples supplied in the processing context,
+        with a delay that changes on every sample.
+
+        The same delays are used for every channel. This is useful for effects like
+        vibrato or a chorus without feedback, and is much faster than calling
+        popSample() with a new delay for each sample. The delay set with setDelay()
+        isn't changed.
+
+        @param context              the processing context
+        @param delaysInSamples      the fractional delay for each sample in the block
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context, const SampleType* delaysInSamples) noexcept
     {
-        if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::None>)
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+        const auto numChannels = outputBlock.getNumChannels();
+        const auto numSamples  = (int) outputBlock.getNumSamples();
+
+        jassert (inputBlock.getNumChannels() == numChannels);
+        jassert (inputBlock.getNumChannels() == writePos.size());
+        jassert (inputBlock.getNumSamples()  == (size_t) numSamples);
+
+        if (context.isBypassed)
         {
-            auto index = (readPos[(size_t) channel] + delayInt) % totalSize;
-            return bufferData.getSample (channel, index);
+            outputBlock.copyFrom (inputBlock);
+            return;
         }
-        else if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Linear>)
+
+        if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Thiran>)
         {
-            auto index1 = readPos[(size_t) channel] + delayInt;
-            auto index2 = index1 + 1;
+            const auto oldDelay = delay;
 
-            if (index2 >= totalSize)
+            for (size_t channel = 0; channel < numChannels; ++channel)
             {
-                index1 %= totalSize;
-                index2 %= totalSize;
+                auto* inputSamples = inputBlock.getChannelPointer (channel);
+                auto* outputSamples = outputBlock.getChannelPointer (channel);
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    pushSample ((int) channel, inputSamples[i]);
+                    outputSamples[i] = popSample ((int) channel, delaysInSamples[i]);
+                }
             }
 
-            auto value1 = bufferData.getSample (channel, index1);
-            auto value2 = bufferData.getSample (channel, index2);
-
-            return value1 + delayFrac * (value2 - value1);
+            setDelay (oldDelay);
         }
-        else if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Lagrange3rd>)
+        else
         {
-            auto index1 = readPos[(size_t) channel] + delayInt;
-            auto index2 = index1 + 1;
-            auto index3 = index2 + 1;
-            auto index4 = index3 + 1;
+            int delayInts[chunkSize];
+            SampleType delayFracs[chunkSize];
 
-            if (index4 >= totalSize)
+            for (int start = 0; start < numSamples; start += chunkSize)
             {
-                index1 %= totalSize;
-                index2 %= totalSize;
-                index3 %= totalSize;
-                index4 %= totalSize;
+                const auto num = jmin (chunkSize, numSamples - start);
+                splitDelays (delaysInSamples + start, delayInts, delayFracs, num);
+
+                for (size_t channel = 0; channel < numChannels; ++channel)
+                {
+                    auto* inputSamples = inputBlock.getChannelPointer (channel) + start;
+                    auto* outputSamples = outputBlock.getChannelPointer (channel) + start;
+                    auto* samples = bufferData.getWritePointer ((int) channel);
+                    auto& write = writePos[channel];
+                    auto& read = readPos[channel];
+
+                    // Every value has to be read straight after its input is written, as
+                    // the longest delays read from the slot that's about to be overwritten
+                    for (int i = 0; i < num; ++i)
+                    {
+                        samples[write] = inputSamples[i];
+                        write = wrap (write - 1);
+
+                        outputSamples[i] = interpolateAt (samples, read + delayInts[i], delayFracs[i]);
+
+                        read = wrap (read - 1);
+                    }
+                }
             }
+        }
+    }
+
+private:
+    //==============================================================================
+    SampleType interpolateSample (int channel)
+    {
+        auto* samples = bufferData.getReadPointer (channel);
+        auto index = readPos[(size_t) channel] + delayInt;
 
-            auto* samples = bufferData.getReadPointer (channel);
+        if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Thiran>)
+        {
+            auto value1 = samples[wrap (index)];
+            auto value2 = samples[wrap (index + 1)];
 
-            auto value1 = samples[index1];
-            auto value2 = samples[index2];
-            auto value3 = samples[index3];
-            auto value4 = samples[index4];
+            auto output = approximatelyEqual (delayFrac, (SampleType) 0) ? value1 : value2 + alpha * (value1 - v[(size_t) channel]);
+            v[(size_t) channel] = output;
+
+            return output;
+        }
+        else
+        {
+            return interpolateAt (samples, index, delayFrac);
+        }
+    }
+
+    SampleType interpolateAt (const SampleType* samples, int index, SampleType frac) const noexcept
+    {
+        if constexpr (numPoints == 1)
+            return samples[wrap (index)];
+        else if constexpr (numPoints == 2)
+            return interpolateValues (samples[wrap (index)], samples[wrap (index + 1)], 0, 0, frac);
+        else
+            return interpolateValues (samples[wrap (index)],
+                                      samples[wrap (index + 1)],
+                                      samples[wrap (index + 2)],
+                                      samples[wrap (index + 3)],
+                                      frac);
+    }
 
-            auto d1 = delayFrac - 1.f;
-            auto d2 = delayFrac - 2.f;
-            auto d3 = delayFrac - 3.f;
+    /*  Brings a position back into the buffer. Positions are never more than one
+        buffer length out of range.
+    */
+    int wrap (int index) const noexcept
+    {
+        if (usePowerOfTwoSize)
+            return index & (totalSize - 1);
+
+        if (index < 0)
+            return index + totalSize;
+
+        return index >= totalSize ? index - totalSize : index;
+    }
+
+    static SampleType interpolateValues (SampleType value1, SampleType value2, SampleType value3, SampleType value4, SampleType frac) noexcept
+    {
+        if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::None>)
+        {
+            ignoreUnused (value2, value3, value4, frac);
+            return value1;
+        }
+        else if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Lagrange3rd>)
+        {
+            auto d1 = frac - 1.f;
+            auto d2 = frac - 2.f;
+            auto d3 = frac - 3.f;
 
             auto c1 = -d1 * d2 * d3 / 6.f;
             auto c2 = d2 * d3 * 0.5f;
             auto c3 = -d1 * d3 * 0.5f;
             auto c4 = d1 * d2 / 6.f;
 
-            return value1 * c1 + delayFrac * (value2 * c2 + value3 * c3 + value4 * c4);
+            return value1 * c1 + frac * (value2 * c2 + value3 * c3 + value4 * c4);
         }
-        else if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Thiran>)
+        else
+        {
+            ignoreUnused (value3, value4);
+            return value1 + frac * (value2 - value1);
+        }
+    }
+
+    /*  The same as setDelay() followed by updateInternalVariables(), for a block of
+        delays. This is written so that the compiler can vectorise it.
+    */
+    void splitDelays (const SampleType* delays, int* delayInts, SampleType* delayFracs, int num) const noexcept
+    {
+        const auto upperLimit = (SampleType) getMaximumDelayInSamples();
+
+        for (int i = 0; i < num; ++i)
         {
-            auto index1 = readPos[(size_t) channel] + delayInt;
-            auto index2 = index1 + 1;
+            const auto d = jlimit ((SampleType) 0, upperLimit, delays[i]);
+            auto integer = (int) d;
+            auto frac = d - (SampleType) integer;
 
-            if (index2 >= totalSize)
+            if constexpr (std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Lagrange3rd>)
             {
-                index1 %= totalSize;
-                index2 %= totalSize;
+                const auto shift = integer >= 1 ? 1 : 0;
+                integer -= shift;
+                frac += (SampleType) shift;
             }
 
-            auto value1 = bufferData.getSample (channel, index1);
-            auto value2 = bufferData.getSample (channel, index2);
+            delayInts[i] = integer;
+            delayFracs[i] = frac;
+        }
+    }
 
-            auto output = approximatelyEqual (delayFrac, (SampleType) 0) ? value1 : value2 + alpha * (value1 - v[(size_t) channel]);
-            v[(size_t) channel] = output;
+    /*  Reads a block of interpolated values in passes, so that only the gathering of
+        the samples is done one value at a time.
+    */
+    template <typename ChannelForTap>
+    void readInterpolated (const SampleType* delays, SampleType* destination, int num, ChannelForTap&& channelForTap) const noexcept
+    {
+        int delayInts[chunkSize];
+        SampleType delayFracs[chunkSize], values[(size_t) numPoints][chunkSize];
+        auto* const* channels = bufferData.getArrayOfReadPointers();
 
-            return output;
+        for (int start = 0; start < num; start += chunkSize)
+        {
+            const auto numInChunk = jmin (chunkSize, num - start);
+            splitDelays (delays + start, delayInts, delayFracs, numInChunk);
+
+            for (int i = 0; i < numInChunk; ++i)
+            {
+                const auto channel = (size_t) channelForTap (start + i);
+                const auto* samples = channels[channel];
+                const auto index = readPos[channel] + delayInts[i];
+
+                for (int point = 0; point < numPoints; ++point)
+                    values[point][i] = samples[wrap (index + point)];
+            }
+
+            for (int i = 0; i < numInChunk; ++i)
+            {
+                if constexpr (numPoints == 1)
+                    destination[start + i] = values[0][i];
+                else if constexpr (numPoints == 2)
+                    destination[start + i] = interpolateValues (values[0][i], values[1][i], 0, 0, delayFracs[i]);
+                else
+                    destination[start + i] = interpolateValues (values[0][i], values[1][i], values[2][i], values[3][i], delayFracs[i]);
+            }
         }
     }
 
@@ -307,8 +511,13 @@ private:
     std::vector<SampleType> v;
     std::vector<int> writePos, readPos;
     SampleType delay = 0.0, delayFrac = 0.0;
-    int delayInt = 0, totalSize = 4;
+    int delayInt = 0, totalSize = 4, requestedMaximumDelay = 0;
+    bool usePowerOfTwoSize = false;
     SampleType alpha = 0.0;
+
+    static constexpr int chunkSize = 64;
+    static constexpr int numPoints = std::is_same_v<InterpolationType, DelayLineInterpolationTypes::None>        ? 1
+                                   : std::is_same_v<InterpolationType, DelayLineInterpolationTypes::Lagrange3rd> ? 4 : 2;
 };
 
 } // namespace juce::dsp
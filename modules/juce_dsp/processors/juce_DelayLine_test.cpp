@@ -0,0 +1,200 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce::dsp
+{
+
+class DelayLineTests final : public UnitTest
+{
+public:
+    DelayLineTests()
+        : UnitTest ("DelayLine", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("The maximum delay is at least as long as requested");
+        {
+            for (auto requestedDelay : { 0, 1, 5, 100, 1000, 4094, 4095 })
+            {
+                DelayLine<float> delay (requestedDelay);
+                expectGreaterOrEqual (delay.getMaximumDelayInSamples(), requestedDelay);
+
+                if (requestedDelay >= 2)
+                    expectEquals (delay.getMaximumDelayInSamples(), requestedDelay);
+
+                delay.setUsingPowerOfTwoSize (true);
+                expectGreaterOrEqual (delay.getMaximumDelayInSamples(), requestedDelay);
+                expect (isPowerOfTwo (delay.getMaximumDelayInSamples() + 2));
+
+                delay.setUsingPowerOfTwoSize (false);
+                expectEquals (delay.getMaximumDelayInSamples(), jmax (2, requestedDelay));
+            }
+        }
+
+        beginTest ("Rounding the size up to a power of two doesn't change the output");
+        {
+            DelayLine<float, DelayLineInterpolationTypes::Lagrange3rd> reference (maxDelay), delay (maxDelay);
+            delay.setUsingPowerOfTwoSize (true);
+
+            for (auto* d : { &reference, &delay })
+                d->prepare ({ 44100.0, (uint32) numSamples, 1 });
+
+            auto random = getRandom();
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto input = random.nextFloat() * 2.0f - 1.0f;
+                const auto delayInSamples = random.nextFloat() * (float) maxDelay;
+
+                reference.pushSample (0, input);
+                delay.pushSample (0, input);
+
+                expectEquals (delay.popSample (0, delayInSamples), reference.popSample (0, delayInSamples));
+            }
+        }
+
+        runBlockTests<DelayLineInterpolationTypes::None>        ("no interpolation");
+        runBlockTests<DelayLineInterpolationTypes::Linear>      ("linear interpolation");
+        runBlockTests<DelayLineInterpolationTypes::Lagrange3rd> ("Lagrange interpolation");
+        runBlockTests<DelayLineInterpolationTypes::Thiran>      ("Thiran interpolation");
+    }
+
+private:
+    static constexpr int maxDelay = 100, numChannels = 3, numSamples = 300, numTaps = 70;
+
+    template <typename InterpolationType>
+    void runBlockTests (const String& interpolationName)
+    {
+        using Delay = DelayLine<float, InterpolationType>;
+
+        auto random = getRandom();
+        const auto createDelay = []
+        {
+            Delay delay (maxDelay);
+            delay.prepare ({ 44100.0, (uint32) numSamples, (uint32) numChannels });
+            delay.setDelay (10.0f);
+            return delay;
+        };
+
+        const auto randomDelay = [&] { return random.nextFloat() * (float) maxDelay; };
+
+        beginTest ("Pushing and popping all the channels at once matches single samples, with " + interpolationName);
+        {
+            auto reference = createDelay();
+            auto delay = createDelay();
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                float inputs[numChannels], delays[numChannels], outputs[numChannels];
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    inputs[channel] = random.nextFloat() * 2.0f - 1.0f;
+                    delays[channel] = randomDelay();
+                }
+
+                delay.pushSamples (inputs);
+                delay.popSamples (delays, outputs);
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    reference.pushSample (channel, inputs[channel]);
+                    expectWithinAbsoluteError (outputs[channel], reference.popSample (channel, delays[channel]), 1.0e-6f);
+                }
+            }
+
+            expectEquals (delay.getDelay(), 10.0f);
+        }
+
+        beginTest ("Reading many taps at once matches single reads, with " + interpolationName);
+        {
+            auto reference = createDelay();
+            auto delay = createDelay();
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto input = random.nextFloat() * 2.0f - 1.0f;
+                reference.pushSample (1, input);
+                delay.pushSample (1, input);
+
+                if (i % 50 == 49)
+                {
+                    float delays[numTaps], outputs[numTaps];
+
+                    for (auto& d : delays)
+                        d = randomDelay();
+
+                    delay.readTaps (1, delays, outputs, numTaps);
+
+                    for (int tap = 0; tap < numTaps; ++tap)
+                        expectWithinAbsoluteError (outputs[tap], reference.popSample (1, delays[tap], false), 1.0e-6f);
+
+                    reference.setDelay (10.0f);
+                }
+
+                reference.popSample (1);
+                delay.popSample (1);
+            }
+        }
+
+        beginTest ("Processing with a modulated delay matches single samples, with " + interpolationName);
+        {
+            auto reference = createDelay();
+            auto delay = createDelay();
+
+            AudioBuffer<float> buffer (numChannels, numSamples), expected (numChannels, numSamples);
+            std::vector<float> delays ((size_t) numSamples);
+
+            for (auto& d : delays)
+                d = randomDelay();
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    buffer.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    reference.pushSample (channel, buffer.getSample (channel, i));
+                    expected.setSample (channel, i, reference.popSample (channel, delays[(size_t) i]));
+                }
+            }
+
+            AudioBlock<float> block (buffer);
+            delay.process (ProcessContextReplacing<float> (block), delays.data());
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    expectWithinAbsoluteError (buffer.getSample (channel, i), expected.getSample (channel, i), 1.0e-6f);
+        }
+    }
+};
+
+static DelayLineTests delayLineTests;
+
+} // namespace juce::dsp
@@ -0,0 +1,428 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce::dsp::detail
+{
+
+//==============================================================================
+// Bit-twiddling log2/exp2 approximations, written as plain loops over arrays so
+// that they vectorise. The polynomials are minimax fits on [0, 1), accurate to
+// about 1e-5 for log2 and 3e-6 (relative) for exp2, which is far below anything
+// audible in a gain.
+template <typename FloatType> struct FastLog2Exp2Traits;
+
+template <> struct FastLog2Exp2Traits<float>
+{
+    using IntType = int32;
+    static constexpr int mantissaBits = 23, exponentBias = 127;
+};
+
+template <> struct FastLog2Exp2Traits<double>
+{
+    using IntType = int64;
+    static constexpr int mantissaBits = 52, exponentBias = 1023;
+};
+
+template <typename FloatType>
+static void fastLog2 (FloatType* values, int numValues) noexcept
+{
+    using Traits  = FastLog2Exp2Traits<FloatType>;
+    using IntType = typename Traits::IntType;
+
+    constexpr auto mantissaMask = (IntType (1) << Traits::mantissaBits) - 1;
+    constexpr auto one = IntType (Traits::exponentBias) << Traits::mantissaBits;
+
+    for (int i = 0; i < numValues; ++i)
+    {
+        IntType bits;
+        std::memcpy (&bits, values + i, sizeof (bits));
+
+        const auto exponent = (FloatType) ((bits >> Traits::mantissaBits) - Traits::exponentBias);
+
+        bits = (bits & mantissaMask) | one;
+        FloatType mantissa;
+        std::memcpy (&mantissa, &bits, sizeof (bits));
+
+        const auto t = mantissa - (FloatType) 1;
+        values[i] = exponent + t * ((FloatType) 1.44196565
+                             + t * ((FloatType) -0.709663295
+                             + t * ((FloatType) 0.417597507
+                             + t * ((FloatType) -0.196272029
+                             + t *  (FloatType) 0.0463864789))));
+    }
+}
+
+// The values passed to fastExp2 must be between -126 and 126.
+template <typename FloatType>
+static void fastExp2 (FloatType* values, int numValues) noexcept
+{
+    using Traits  = FastLog2Exp2Traits<FloatType>;
+    using IntType = typename Traits::IntType;
+
+    for (int i = 0; i < numValues; ++i)
+    {
+        const auto x = values[i];
+
+        // x + 127 is always positive, so truncating it rounds down
+        const auto whole = (IntType) (x + (FloatType) 127) - 127;
+
+        const auto f = x - (FloatType) whole;
+        const auto p = (FloatType) 1.0000026
+                     + f * ((FloatType) 0.693003807
+                     + f * ((FloatType) 0.241442811
+                     + f * ((FloatType) 0.0520114596
+                     + f *  (FloatType) 0.0135341328)));
+
+        IntType bits;
+        std::memcpy (&bits, &p, sizeof (bits));
+        bits += (IntType) ((std::make_unsigned_t<IntType>) whole << Traits::mantissaBits);
+        std::memcpy (values + i, &bits, sizeof (bits));
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void DynamicsBlockProcessor<SampleType>::setGainCurve (SampleType thresholdDecibels, SampleType newExponent,
+                                                       bool reduceAboveThreshold) noexcept
+{
+    threshold = Decibels::decibelsToGain (thresholdDecibels, static_cast<SampleType> (-200.0));
+    thresholdInverse = static_cast<SampleType> (1.0) / threshold;
+    exponent = newExponent;
+    reduceAbove = reduceAboveThreshold;
+}
+
+template <typename SampleType>
+void DynamicsBlockProcessor<SampleType>::setChannelLinking (bool shouldBeLinked) noexcept
+{
+    if (linked != shouldBeLinked)
+    {
+        linked = shouldBeLinked;
+        reset();
+    }
+}
+
+template <typename SampleType>
+void DynamicsBlockProcessor<SampleType>::setLookahead (SampleType newLookaheadMs) noexcept
+{
+    jassert (newLookaheadMs >= 0 && newLookaheadMs <= (SampleType) maximumLookaheadMs);
+
+    lookaheadMs = jlimit ((SampleType) 0, (SampleType) maximumLookaheadMs, newLookaheadMs);
+    updateLookahead();
+}
+
+template <typename SampleType>
+void DynamicsBlockProcessor<SampleType>::updateLookahead() noexcept
+{
+    const auto newLookaheadSamples = jmin (maxLookaheadSamples, roundToInt ((double) lookaheadMs * sampleRate / 1000.0));
+
+    if (newLookaheadSamples != lookaheadSamples)
+    {
+        lookaheadSamples = newLookaheadSamples;
+        reset();
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void DynamicsBlockProcessor<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+    jassert (spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+
+    envelopeFilter.prepare (spec);
+    rmsFilter.prepare (spec);
+
+    const auto numChannels = (int) spec.numChannels;
+    maxLookaheadSamples = (int) std::ceil (maximumLookaheadMs * sampleRate / 1000.0);
+
+    const auto delaySize = nextPowerOfTwo (maxLookaheadSamples + chunkSize);
+    delayMask = delaySize - 1;
+
+    delayBuffer.setSize (numChannels, delaySize);
+    peakLevels.setSize (numChannels, delaySize);
+    peakSuffixMaxima.setSize (numChannels, delaySize);
+    peakPrefixMaxima.resize ((size_t) numChannels);
+    scratch.setSize ((int) maxDetectorsPerGroup + 1, chunkSize);
+
+    lookaheadSamples = -1;
+    updateLookahead();
+}
+
+template <typename SampleType>
+void DynamicsBlockProcessor<SampleType>::reset() noexcept
+{
+    envelopeFilter.reset();
+    rmsFilter.reset();
+
+    delayBuffer.clear();
+    peakLevels.clear();
+    peakSuffixMaxima.clear();
+    std::fill (peakPrefixMaxima.begin(), peakPrefixMaxima.end(), SampleType());
+    delayWritePosition = 0;
+    peakWindowPosition = 0;
+}
+
+//==============================================================================
+template <typename SampleType>
+void DynamicsBlockProcessor<SampleType>::process (const AudioBlock<const SampleType>& inputBlock,
+                                                  const AudioBlock<SampleType>& outputBlock,
+                                                  const AudioBlock<const SampleType>& sidechainBlock) noexcept
+{
+    const auto numChannels = outputBlock.getNumChannels();
+    const auto numSamples  = outputBlock.getNumSamples();
+
+    jassert (inputBlock.getNumChannels() == numChannels);
+    jassert (inputBlock.getNumSamples()  == numSamples);
+    jassert (sidechainBlock.getNumChannels() > 0);
+    jassert (sidechainBlock.getNumSamples() >= numSamples);
+    jassert ((int) numChannels <= delayBuffer.getNumChannels());
+
+    // When the channels are linked, a single detector drives all of them
+    const auto numDetectors = linked ? (size_t) 1 : numChannels;
+    SampleType* levels[maxDetectorsPerGroup];
+
+    for (size_t start = 0; start < numSamples; start += (size_t) chunkSize)
+    {
+        const auto num = (int) jmin ((size_t) chunkSize, numSamples - start);
+
+        // The detectors are run in groups, so that their envelope filters can run in parallel
+        for (size_t firstDetector = 0; firstDetector < numDetectors; firstDetector += maxDetectorsPerGroup)
+        {
+            const auto numInGroup = jmin (maxDetectorsPerGroup, numDetectors - firstDetector);
+
+            for (size_t i = 0; i < numInGroup; ++i)
+            {
+                levels[i] = scratch.getWritePointer ((int) i);
+                rectify (firstDetector + i, sidechainBlock, start, num, levels[i]);
+            }
+
+            if (useRMSDetector)
+                rmsFilter.processSamples (levels, levels, (int) firstDetector, (int) numInGroup, num);
+
+            envelopeFilter.processSamples (levels, levels, (int) firstDetector, (int) numInGroup, num);
+
+            for (size_t i = 0; i < numInGroup; ++i)
+                computeGains (levels[i], num);
+
+            const auto firstChannel = linked ? (size_t) 0 : firstDetector;
+            const auto lastChannel  = linked ? numChannels : firstDetector + numInGroup;
+
+            for (auto channel = firstChannel; channel < lastChannel; ++channel)
+                applyGain (channel, inputBlock.getChannelPointer (channel) + start,
+                           outputBlock.getChannelPointer (channel) + start,
+                           levels[linked ? 0 : channel - firstDetector], num);
+        }
+
+        delayWritePosition = (delayWritePosition + num) & delayMask;
+
+        if (lookaheadSamples > 0)
+            peakWindowPosition = (peakWindowPosition + num) % (lookaheadSamples + 1);
+    }
+
+   #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+    envelopeFilter.snapToZero();
+    rmsFilter.snapToZero();
+   #endif
+}
+
+template <typename SampleType>
+void DynamicsBlockProcessor<SampleType>::processBypassed (const AudioBlock<const SampleType>& inputBlock,
+                                                          const AudioBlock<SampleType>& outputBlock) noexcept
+{
+    const auto numChannels = outputBlock.getNumChannels();
+    const auto numSamples  = outputBlock.getNumSamples();
+
+    jassert (inputBlock.getNumChannels() == numChannels);
+    jassert (inputBlock.getNumSamples()  == numSamples);
+    jassert ((int) numChannels <= delayBuffer.getNumChannels());
+
+    if (lookaheadSamples == 0)
+    {
+        outputBlock.copyFrom (inputBlock);
+        return;
+    }
+
+    for (size_t start = 0; start < numSamples; start += (size_t) chunkSize)
+    {
+        const auto num = (int) jmin ((size_t) chunkSize, numSamples - start);
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            applyGain (channel, inputBlock.getChannelPointer (channel) + start,
+                       outputBlock.getChannelPointer (channel) + start, nullptr, num);
+
+        delayWritePosition = (delayWritePosition + num) & delayMask;
+    }
+}
+
+template <typename SampleType>
+void DynamicsBlockProcessor<SampleType>::rectify (size_t detector, const AudioBlock<const SampleType>& sidechainBlock,
+                                                  size_t startSample, int numSamples, SampleType* levels) noexcept
+{
+    const auto numSidechainChannels = sidechainBlock.getNumChannels();
+
+    if (linked)
+    {
+        auto* channelLevels = scratch.getWritePointer ((int) maxDetectorsPerGroup);
+        FloatVectorOperations::abs (levels, sidechainBlock.getChannelPointer (0) + startSample, numSamples);
+
+        for (size_t channel = 1; channel < numSidechainChannels; ++channel)
+        {
+            FloatVectorOperations::abs (channelLevels, sidechainBlock.getChannelPointer (channel) + startSample, numSamples);
+            FloatVectorOperations::max (levels, levels, channelLevels, numSamples);
+        }
+    }
+    else
+    {
+        FloatVectorOperations::abs (levels, sidechainBlock.getChannelPointer (detector % numSidechainChannels) + startSample, numSamples);
+    }
+
+    if (lookaheadSamples > 0)
+        slidingMaximum (detector, levels, numSamples);
+}
+
+template <typename SampleType>
+void DynamicsBlockProcessor<SampleType>::slidingMaximum (size_t detector, SampleType* levels, int numSamples) noexcept
+{
+    // This is the van Herk/Gil-Werman algorithm. Time is split into windows of the
+    // same length as the lookahead window, and for each of them we keep the running
+    // maximum from its start, and once it's complete, the maxima from each sample to
+    // its end. Any window of that length then spans the end of one and the start of
+    // the next, so its maximum is the larger of those two values. That's three
+    // comparisons per sample, whatever the lookahead time.
+    const auto windowLength = lookaheadSamples + 1;
+    auto* history = peakLevels.getWritePointer ((int) detector);
+    auto* suffixMaxima = peakSuffixMaxima.getWritePointer ((int) detector);
+    auto prefixMaximum = peakPrefixMaxima[detector];
+    auto windowPosition = peakWindowPosition;
+
+    for (int start = 0; start < numSamples;)
+    {
+        const auto num = jmin (numSamples - start, windowLength - windowPosition);
+        const auto position = delayWritePosition + start;
+
+        if (windowPosition == 0)
+            prefixMaximum = SampleType();
+
+        for (int i = 0; i < num; ++i)
+        {
+            const auto level = levels[start + i];
+            history[(position + i) & delayMask] = level;
+            prefixMaximum = jmax (prefixMaximum, level);
+            levels[start + i] = jmax (prefixMaximum, suffixMaxima[(position + i + 1 - windowLength) & delayMask]);
+        }
+
+        start += num;
+        windowPosition += num;
+
+        if (windowPosition == windowLength)
+        {
+            // This window is complete, so work out its suffix maxima. Its last sample
+            // spans exactly this window, so its maximum is just the prefix maximum.
+            auto suffixMaximum = SampleType();
+
+            for (int i = position + num - 1; i > position + num - 1 - windowLength; --i)
+            {
+                suffixMaximum = jmax (suffixMaximum, history[i & delayMask]);
+                suffixMaxima[i & delayMask] = suffixMaximum;
+            }
+
+            levels[start - 1] = prefixMaximum;
+            windowPosition = 0;
+        }
+    }
+
+    peakPrefixMaxima[detector] = prefixMaximum;
+}
+
+template <typename SampleType>
+void DynamicsBlockProcessor<SampleType>::computeGains (SampleType* levelsAndGains, int numSamples) noexcept
+{
+    SampleType gains[chunkSize];
+    constexpr auto smallestLevel = static_cast<SampleType> (1.0e-30);
+
+    for (int i = 0; i < numSamples; ++i)
+        gains[i] = jmax (smallestLevel, levelsAndGains[i] * thresholdInverse);
+
+    // gain = (level / threshold) ^ exponent
+    fastLog2 (gains, numSamples);
+    FloatVectorOperations::multiply (gains, exponent, numSamples);
+    FloatVectorOperations::clip (gains, gains, static_cast<SampleType> (-126.0), static_cast<SampleType> (126.0), numSamples);
+    fastExp2 (gains, numSamples);
+
+    const auto unity = static_cast<SampleType> (1.0);
+
+    if (reduceAbove)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            levelsAndGains[i] = levelsAndGains[i] < threshold ? unity : gains[i];
+    }
+    else
+    {
+        for (int i = 0; i < numSamples; ++i)
+            levelsAndGains[i] = levelsAndGains[i] > threshold ? unity : gains[i];
+    }
+}
+
+template <typename SampleType>
+void DynamicsBlockProcessor<SampleType>::applyGain (size_t channel, const SampleType* input, SampleType* output,
+                                                    const SampleType* gains, int numSamples) noexcept
+{
+    // Without any gains, the audio is only delayed
+    const auto scale = [gains] (SampleType* dest, const SampleType* src, int offset, int num)
+    {
+        if (gains != nullptr)
+            FloatVectorOperations::multiply (dest, src, gains + offset, num);
+        else
+            FloatVectorOperations::copy (dest, src, num);
+    };
+
+    if (lookaheadSamples == 0)
+    {
+        scale (output, input, 0, numSamples);
+        return;
+    }
+
+    // The input is written before the output is read, so they can be the same buffer
+    auto* delayed = delayBuffer.getWritePointer ((int) channel);
+    const auto delaySize = delayMask + 1;
+
+    const auto numBeforeWrap = jmin (numSamples, delaySize - delayWritePosition);
+    FloatVectorOperations::copy (delayed + delayWritePosition, input, numBeforeWrap);
+    FloatVectorOperations::copy (delayed, input + numBeforeWrap, numSamples - numBeforeWrap);
+
+    const auto readPosition = (delayWritePosition - lookaheadSamples) & delayMask;
+    const auto numBeforeReadWrap = jmin (numSamples, delaySize - readPosition);
+    scale (output, delayed + readPosition, 0, numBeforeReadWrap);
+    scale (output + numBeforeReadWrap, delayed, numBeforeReadWrap, numSamples - numBeforeReadWrap);
+}
+
+//==============================================================================
+template class DynamicsBlockProcessor<float>;
+template class DynamicsBlockProcessor<double>;
+
+} // namespace juce::dsp::detail
@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce::dsp::detail
+{
+
+/**
+    The block-based engine shared by the Compressor, NoiseGate and Limiter classes.
+
+    It runs the envelope detection and gain computation over short chunks of samples
+    rather than one sample at a time, which lets the compiler vectorise the expensive
+    parts (the level-to-gain curve is evaluated with fast log2/exp2 approximations
+    instead of std::pow). On top of that it adds channel linking, external sidechain
+    inputs and a lookahead delay.
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class DynamicsBlockProcessor
+{
+public:
+    //==============================================================================
+    /** The largest lookahead time that can be set, in milliseconds. */
+    static constexpr double maximumLookaheadMs = 20.0;
+
+    //==============================================================================
+    /** Constructor. */
+    DynamicsBlockProcessor() = default;
+
+    //==============================================================================
+    /** Sets the curve used to turn the detected level into a gain.
+
+        When the level is on the side of the threshold given by reduceAboveThreshold,
+        the gain is (level / threshold) ^ exponent, otherwise it's 1.
+    */
+    void setGainCurve (SampleType thresholdDecibels, SampleType exponent, bool reduceAboveThreshold) noexcept;
+
+    /** Enables an RMS detector ahead of the envelope filter. */
+    void setRMSDetectorEnabled (bool shouldBeEnabled) noexcept      { useRMSDetector = shouldBeEnabled; }
+
+    /** Returns the envelope filter, so that its times can be set. */
+    BallisticsFilter<SampleType>& getEnvelopeFilter() noexcept      { return envelopeFilter; }
+
+    /** Returns the RMS detector that runs before the envelope filter when it's enabled. */
+    BallisticsFilter<SampleType>& getRMSFilter() noexcept           { return rmsFilter; }
+
+    /** When linking is on, all the channels are driven by the loudest one, so the
+        gain is the same on every channel and the stereo image doesn't shift.
+    */
+    void setChannelLinking (bool shouldBeLinked) noexcept;
+
+    /** Sets the lookahead time in milliseconds, up to maximumLookaheadMs.
+
+        The audio is delayed by this amount, and the detector looks at the peak level
+        over the lookahead window, so that the gain has already come down by the time
+        a transient reaches the output.
+    */
+    void setLookahead (SampleType newLookaheadMs) noexcept;
+
+    /** Returns the latency added by the lookahead. */
+    int getLatencyInSamples() const noexcept                        { return lookaheadSamples; }
+
+    //==============================================================================
+    /** Initialises the processor. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state variables of the processor. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Processes a block. The sidechain block drives the detector: channel n of the
+        output is controlled by channel (n % numSidechainChannels) of the sidechain,
+        or by all of them when the channels are linked. The sidechain may be the input
+        block itself.
+    */
+    void process (const AudioBlock<const SampleType>& inputBlock,
+                  const AudioBlock<SampleType>& outputBlock,
+                  const AudioBlock<const SampleType>& sidechainBlock) noexcept;
+
+    /** Passes a block through the lookahead delay without changing its level, for when
+        the processor is bypassed, so that the latency stays the same.
+    */
+    void processBypassed (const AudioBlock<const SampleType>& inputBlock,
+                          const AudioBlock<SampleType>& outputBlock) noexcept;
+
+private:
+    //==============================================================================
+    static constexpr int chunkSize = 64;
+    static constexpr size_t maxDetectorsPerGroup = 4;
+
+    void updateLookahead() noexcept;
+    void rectify (size_t detector, const AudioBlock<const SampleType>& sidechainBlock,
+                  size_t startSample, int numSamples, SampleType* levels) noexcept;
+    void slidingMaximum (size_t detector, SampleType* levels, int numSamples) noexcept;
+    void computeGains (SampleType* levelsAndGains, int numSamples) noexcept;
+    void applyGain (size_t channel, const SampleType* input, SampleType* output,
+                    const SampleType* gains, int numSamples) noexcept;
+
+    //==============================================================================
+    BallisticsFilter<SampleType> envelopeFilter, rmsFilter;
+
+    SampleType threshold = 1, thresholdInverse = 1, exponent = 0;
+    bool reduceAbove = true, useRMSDetector = false, linked = false;
+
+    double sampleRate = 44100.0;
+    SampleType lookaheadMs = 0;
+    int lookaheadSamples = 0;
+
+    // The lookahead delay, and the recent levels and their running maxima for each detector
+    AudioBuffer<SampleType> delayBuffer, peakLevels, peakSuffixMaxima;
+    std::vector<SampleType> peakPrefixMaxima;
+    int maxLookaheadSamples = 0, delayMask = 0, delayWritePosition = 0, peakWindowPosition = 0;
+
+    AudioBuffer<SampleType> scratch;
+};
+
+} // namespace juce::dsp::detail
@@ -0,0 +1,282 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce::dsp
+{
+
+class DynamicsProcessorTests final : public UnitTest
+{
+public:
+    DynamicsProcessorTests()
+        : UnitTest ("Dynamics processors", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        const auto input = makeTestSignal();
+
+        beginTest ("Compressor blocks match processSample");
+        {
+            Compressor<float> blockCompressor, sampleCompressor;
+
+            for (auto* c : { &blockCompressor, &sampleCompressor })
+            {
+                c->setThreshold (-20.0f);
+                c->setRatio (4.0f);
+                c->setAttack (5.0f);
+                c->setRelease (50.0f);
+                c->prepare ({ sampleRate, (uint32) numSamples, (uint32) numChannels });
+            }
+
+            expectBlocksMatchSamples (blockCompressor, sampleCompressor, input);
+        }
+
+        beginTest ("NoiseGate blocks match processSample");
+        {
+            NoiseGate<float> blockGate, sampleGate;
+
+            for (auto* g : { &blockGate, &sampleGate })
+            {
+                g->setThreshold (-30.0f);
+                g->setRatio (5.0f);
+                g->setAttack (2.0f);
+                g->setRelease (80.0f);
+                g->prepare ({ sampleRate, (uint32) numSamples, (uint32) numChannels });
+            }
+
+            expectBlocksMatchSamples (blockGate, sampleGate, input);
+        }
+
+        beginTest ("Linked channels get the same gain");
+        {
+            Compressor<float> compressor;
+            compressor.setThreshold (-20.0f);
+            compressor.setRatio (8.0f);
+            compressor.setChannelLinking (true);
+            compressor.prepare ({ sampleRate, (uint32) numSamples, (uint32) numChannels });
+
+            auto output = input;
+            AudioBlock<float> block (output);
+            compressor.process (ProcessContextReplacing<float> (block));
+
+            for (int i = 0; i < numSamples; i += 7)
+            {
+                const auto gain = output.getSample (0, i) / input.getSample (0, i);
+
+                for (int channel = 1; channel < numChannels; ++channel)
+                    expectWithinAbsoluteError (output.getSample (channel, i) / input.getSample (channel, i), gain, 1.0e-4f);
+            }
+        }
+
+        beginTest ("A sidechain drives the gain");
+        {
+            Compressor<float> compressor;
+            compressor.setThreshold (-20.0f);
+            compressor.setRatio (10.0f);
+            compressor.prepare ({ sampleRate, (uint32) numSamples, (uint32) numChannels });
+
+            AudioBuffer<float> output (numChannels, numSamples), sidechain (1, numSamples);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                FloatVectorOperations::fill (output.getWritePointer (channel), 0.01f, numSamples);
+
+            FloatVectorOperations::fill (sidechain.getWritePointer (0), 1.0f, numSamples);
+
+            AudioBlock<float> block (output);
+            compressor.process (ProcessContextReplacing<float> (block), AudioBlock<const float> (sidechain));
+
+            // 20 dB over the threshold at 10:1 should give 18 dB of gain reduction on every channel
+            for (int channel = 0; channel < numChannels; ++channel)
+                expectWithinAbsoluteError (Decibels::gainToDecibels (output.getSample (channel, numSamples - 1) / 0.01f),
+                                           -18.0f, 0.01f);
+        }
+
+        beginTest ("Lookahead uses the peak level over the lookahead time");
+        {
+            // With instant attack and release, the detected level is just the peak level
+            Compressor<float> compressor;
+            compressor.setThreshold (-20.0f);
+            compressor.setRatio (4.0f);
+            compressor.setAttack (0.0f);
+            compressor.setRelease (0.0f);
+            compressor.setLookahead (3.0f);
+            compressor.prepare ({ sampleRate, (uint32) numSamples, (uint32) numChannels });
+
+            const auto latency = compressor.getLatencyInSamples();
+            const auto threshold = Decibels::decibelsToGain (-20.0f);
+
+            auto output = input;
+            AudioBlock<float> block (output);
+            Random random (42);
+
+            for (size_t start = 0; start < (size_t) numSamples;)
+            {
+                const auto num = jmin ((size_t) random.nextInt ({ 1, 300 }), (size_t) numSamples - start);
+                auto subBlock = block.getSubBlock (start, num);
+                compressor.process (ProcessContextReplacing<float> (subBlock));
+                start += num;
+            }
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                for (int i = latency; i < numSamples; ++i)
+                {
+                    auto peak = 0.0f;
+
+                    for (int j = i - latency; j <= i; ++j)
+                        peak = jmax (peak, std::abs (input.getSample (channel, j)));
+
+                    const auto gain = peak < threshold ? 1.0f : std::pow (peak / threshold, 0.25f - 1.0f);
+                    expectWithinAbsoluteError (output.getSample (channel, i), input.getSample (channel, i - latency) * gain, 1.0e-4f);
+                }
+            }
+        }
+
+        beginTest ("Lookahead catches transients");
+        {
+            constexpr auto stepPosition = 1000;
+            const auto threshold = Decibels::decibelsToGain (-12.0f);
+
+            AudioBuffer<float> step (1, numSamples);
+            step.clear();
+
+            for (int i = stepPosition; i < numSamples; ++i)
+                step.setSample (0, i, 1.0f);
+
+            const auto getOutputPeak = [&] (float lookaheadMs, int& latency)
+            {
+                Compressor<float> compressor;
+                compressor.setThreshold (-12.0f);
+                compressor.setRatio (1000.0f);
+                compressor.setAttack (0.5f);
+                compressor.setLookahead (lookaheadMs);
+                compressor.prepare ({ sampleRate, (uint32) numSamples, 1 });
+                latency = compressor.getLatencyInSamples();
+
+                auto output = step;
+                AudioBlock<float> block (output);
+                compressor.process (ProcessContextReplacing<float> (block));
+
+                expectEquals (output.getSample (0, stepPosition + latency - 1), 0.0f);
+                return output.getMagnitude (0, 0, numSamples);
+            };
+
+            int latency = 0;
+            expectGreaterThan (getOutputPeak (0.0f, latency), 2.0f * threshold);
+            expectEquals (latency, 0);
+
+            expectLessThan (getOutputPeak (5.0f, latency), 1.01f * threshold);
+            expectEquals (latency, roundToInt (0.005 * sampleRate));
+        }
+
+        beginTest ("Bypassed audio is delayed by the lookahead");
+        {
+            const auto expectDelayedWhenBypassed = [&] (auto& processor)
+            {
+                processor.setLookahead (3.0f);
+                processor.prepare ({ sampleRate, (uint32) numSamples, (uint32) numChannels });
+
+                const auto latency = processor.getLatencyInSamples();
+                expectGreaterThan (latency, 0);
+
+                auto output = input;
+                AudioBlock<float> block (output);
+                Random random (42);
+
+                for (size_t start = 0; start < (size_t) numSamples;)
+                {
+                    const auto num = jmin ((size_t) random.nextInt ({ 1, 300 }), (size_t) numSamples - start);
+                    auto subBlock = block.getSubBlock (start, num);
+                    ProcessContextReplacing<float> context (subBlock);
+                    context.isBypassed = true;
+                    processor.process (context);
+                    start += num;
+                }
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                    for (int i = latency; i < numSamples; ++i)
+                        expectEquals (output.getSample (channel, i), input.getSample (channel, i - latency));
+            };
+
+            Compressor<float> compressor;
+            expectDelayedWhenBypassed (compressor);
+
+            NoiseGate<float> gate;
+            expectDelayedWhenBypassed (gate);
+
+            Limiter<float> limiter;
+            expectDelayedWhenBypassed (limiter);
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int numChannels = 3, numSamples = 4800;
+
+    static AudioBuffer<float> makeTestSignal()
+    {
+        AudioBuffer<float> buffer (numChannels, numSamples);
+        Random random (1234);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                // Noise with a slowly varying level, so the detectors attack and release
+                const auto level = 0.5f + 0.49f * std::sin ((float) (i * (channel + 1)) * 0.003f);
+                buffer.setSample (channel, i, level * (random.nextFloat() * 2.0f - 1.0f) + 0.001f);
+            }
+        }
+
+        return buffer;
+    }
+
+    template <typename Processor>
+    void expectBlocksMatchSamples (Processor& blockProcessor, Processor& sampleProcessor, const AudioBuffer<float>& input)
+    {
+        auto output = input;
+        AudioBlock<float> block (output);
+
+        for (size_t start = 0; start < (size_t) numSamples; start += 500)
+        {
+            auto subBlock = block.getSubBlock (start, jmin ((size_t) 500, (size_t) numSamples - start));
+            blockProcessor.process (ProcessContextReplacing<float> (subBlock));
+        }
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto expected = sampleProcessor.processSample (channel, input.getSample (channel, i));
+                expectWithinAbsoluteError (output.getSample (channel, i), expected, 1.0e-4f);
+            }
+        }
+    }
+};
+
+static DynamicsProcessorTests dynamicsProcessorTests;
+
+} // namespace juce::dsp
@@ -526,6 +526,404 @@ private:
 };
 
 
+//==============================================================================
+/** Oversampling stage class performing N times oversampling with FIR filters
+    designed with the Kaiser window method. The filters are split into N phases,
+    so that the zeros inserted when upsampling and the samples thrown away when
+    downsampling are never computed. The filters are linear phase, or can be
+    converted to minimum phase to reduce the latency.
+
+    The linear phase filters have an even order, so every Nth tap either side of
+    the centre is zero. Those taps are skipped, which makes one of the phases a
+    plain delay. The orders are also chosen so that the latency is a whole number
+    of samples at the stage's input rate.
+
+    Groups of channels are processed together, one in each lane of a SIMDRegister.
+    With a single channel most of each register is wasted, so for factors of 2 the
+    linear phase stages are only about as fast as the half-band FIR stages, and the
+    minimum phase stages, which have no zero taps, are slower than them. From two
+    channels upwards these stages are faster.
+*/
+template <typename SampleType>
+struct OversamplingPolyphaseFIR final : public Oversampling<SampleType>::OversamplingStage
+{
+    using ParentType = typename Oversampling<SampleType>::OversamplingStage;
+
+   #if JUCE_USE_SIMD
+    using Lanes = SIMDRegister<SampleType>;
+   #else
+    using Lanes = SampleType;
+   #endif
+
+    static constexpr size_t numLanes = sizeof (Lanes) / sizeof (SampleType);
+
+    OversamplingPolyphaseFIR (size_t numChans,
+                              size_t newFactor,
+                              bool useMinimumPhase,
+                              SampleType normalisedTransitionWidthUp,
+                              SampleType stopbandAmplitudedBUp,
+                              SampleType normalisedTransitionWidthDown,
+                              SampleType stopbandAmplitudedBDown)
+        : ParentType (numChans, newFactor),
+          numGroups ((numChans + numLanes - 1) / numLanes)
+    {
+        jassert (newFactor >= 2);
+
+        // The orders are even, so that the zero taps fall on whole samples. With linear
+        // phase they are also chosen so that the latency is a whole number of samples
+        // at the original sample rate, which avoids compensating a fractional delay
+        auto orderUp   = getFilterOrder (normalisedTransitionWidthUp,   stopbandAmplitudedBUp);
+        auto orderDown = getFilterOrder (normalisedTransitionWidthDown, stopbandAmplitudedBDown);
+
+        if (! useMinimumPhase)
+            while (((orderUp + orderDown) / 2) % newFactor != 0)
+                orderDown += 2;
+
+        const auto firUp   = designFilter (orderUp,   stopbandAmplitudedBUp,   useMinimumPhase);
+        const auto firDown = designFilter (orderDown, stopbandAmplitudedBDown, useMinimumPhase);
+
+        // The delay of a linear phase filter is exactly half its order, which keeps
+        // rounding errors from turning a whole number of samples into a fractional one
+        latency = static_cast<SampleType> (useMinimumPhase ? getDelayAtDC (firUp) + getDelayAtDC (firDown)
+                                                           : static_cast<double> (orderUp + orderDown) / 2.0);
+
+        // Phase p of the upsampling filter produces output samples p, p + N, p + 2N...
+        // from the original samples, and is scaled by N to make up for the zeros that
+        // would have been inserted between them
+        numTapsUp = (firUp.size() + newFactor - 1) / newFactor;
+        coefficientsUp = AudioBlock<Lanes> (coefficientsUpMemory, 1, numTapsUp * newFactor);
+        splitIntoPhases (firUp, (double) newFactor, numTapsUp, coefficientsUp.getChannelPointer (0), nonZeroTapsUp);
+
+        // Each output of the downsampling filter is the sum of N phases, where phase q
+        // uses taps q, q + N, q + 2N... of the filter
+        numTapsPerPhaseDown = (firDown.size() + newFactor - 1) / newFactor;
+        numTapsDown = numTapsPerPhaseDown * newFactor;
+        coefficientsDown = AudioBlock<Lanes> (coefficientsDownMemory, 1, numTapsDown);
+        splitIntoPhases (firDown, 1.0, numTapsPerPhaseDown, coefficientsDown.getChannelPointer (0), nonZeroTapsDown);
+
+        // The states are stored twice over, so that the most recent samples can always
+        // be read from one contiguous block without having to shift them along
+        stateUp   = AudioBlock<Lanes> (stateUpMemory,   numGroups, 2 * numTapsUp);
+        stateDown = AudioBlock<Lanes> (stateDownMemory, numGroups, 2 * numTapsDown);
+
+        positionUp  .resize (static_cast<int> (numGroups));
+        positionDown.resize (static_cast<int> (numGroups));
+    }
+
+    //==============================================================================
+    SampleType getLatencyInSamples() const override
+    {
+        return latency;
+    }
+
+    void reset() override
+    {
+        ParentType::reset();
+
+        stateUp.clear();
+        stateDown.clear();
+
+        positionUp.fill (0);
+        positionDown.fill (0);
+    }
+
+    void processSamplesUp (const AudioBlock<const SampleType>& inputBlock) override
+    {
+        jassert (inputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
+        jassert (inputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+
+        // Initialization
+        const auto numPhases = ParentType::factor;
+        const auto numSamples = inputBlock.getNumSamples();
+        const auto* coeffs = coefficientsUp.getChannelPointer (0);
+
+        // Processing
+        for (size_t group = 0; group * numLanes < inputBlock.getNumChannels(); ++group)
+        {
+            const auto firstChannel = group * numLanes;
+            const auto numGroupChannels = jmin (numLanes, inputBlock.getNumChannels() - firstChannel);
+
+            const SampleType* samples[numLanes];
+            SampleType* bufferSamples[numLanes];
+
+            for (size_t lane = 0; lane < numGroupChannels; ++lane)
+            {
+                samples[lane] = inputBlock.getChannelPointer (firstChannel + lane);
+                bufferSamples[lane] = ParentType::buffer.getWritePointer (static_cast<int> (firstChannel + lane));
+            }
+
+            auto* state = stateUp.getChannelPointer (group);
+            auto pos = positionUp.getUnchecked (static_cast<int> (group));
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                // Input
+                pos = (pos == 0 ? numTapsUp : pos) - 1;
+                pushSamples (state, pos, numTapsUp, samples, numGroupChannels, i);
+
+                // Convolution, one output for each phase
+                for (size_t phase = 0; phase < numPhases; ++phase)
+                {
+                    const auto taps = nonZeroTapsUp[phase];
+                    const auto out = dotProduct (state + pos + taps.getStart(),
+                                                 coeffs + phase * numTapsUp + taps.getStart(),
+                                                 taps.getLength(), 1);
+                    const auto* rawOut = reinterpret_cast<const SampleType*> (&out);
+
+                    for (size_t lane = 0; lane < numGroupChannels; ++lane)
+                        bufferSamples[lane][i * numPhases + phase] = rawOut[lane];
+                }
+            }
+
+            positionUp.setUnchecked (static_cast<int> (group), pos);
+        }
+    }
+
+    void processSamplesDown (AudioBlock<SampleType>& outputBlock) override
+    {
+        jassert (outputBlock.getNumChannels() <= static_cast<size_t> (ParentType::buffer.getNumChannels()));
+        jassert (outputBlock.getNumSamples() * ParentType::factor <= static_cast<size_t> (ParentType::buffer.getNumSamples()));
+
+        // Initialization
+        const auto numPhases = ParentType::factor;
+        const auto numSamples = outputBlock.getNumSamples();
+        const auto* coeffs = coefficientsDown.getChannelPointer (0);
+
+        // Processing
+        for (size_t group = 0; group * numLanes < outputBlock.getNumChannels(); ++group)
+        {
+            const auto firstChannel = group * numLanes;
+            const auto numGroupChannels = jmin (numLanes, outputBlock.getNumChannels() - firstChannel);
+
+            const SampleType* bufferSamples[numLanes];
+            SampleType* samples[numLanes];
+
+            for (size_t lane = 0; lane < numGroupChannels; ++lane)
+            {
+                bufferSamples[lane] = ParentType::buffer.getReadPointer (static_cast<int> (firstChannel + lane));
+                samples[lane] = outputBlock.getChannelPointer (firstChannel + lane);
+            }
+
+            auto* state = stateDown.getChannelPointer (group);
+            auto pos = positionDown.getUnchecked (static_cast<int> (group));
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                // Only the outputs that are kept are computed, so after the first input
+                // sample of each group of N, the others just go into the state
+                for (size_t phase = 0; phase < numPhases; ++phase)
+                {
+                    pos = (pos == 0 ? numTapsDown : pos) - 1;
+                    pushSamples (state, pos, numTapsDown, bufferSamples, numGroupChannels, i * numPhases + phase);
+
+                    if (phase == 0)
+                    {
+                        Lanes out (static_cast<SampleType> (0));
+
+                        for (size_t q = 0; q < numPhases; ++q)
+                        {
+                            const auto taps = nonZeroTapsDown[q];
+                            out += dotProduct (state + pos + q + taps.getStart() * numPhases,
+                                               coeffs + q * numTapsPerPhaseDown + taps.getStart(),
+                                               taps.getLength(), numPhases);
+                        }
+
+                        const auto* rawOut = reinterpret_cast<const SampleType*> (&out);
+
+                        for (size_t lane = 0; lane < numGroupChannels; ++lane)
+                            samples[lane][i] = rawOut[lane];
+                    }
+                }
+            }
+
+            positionDown.setUnchecked (static_cast<int> (group), pos);
+        }
+    }
+
+private:
+    //==============================================================================
+    /*  The order that FilterDesign::designFIRLowpassKaiserMethod would choose, raised
+        to the next even number.
+    */
+    static size_t getFilterOrder (SampleType normalisedTransitionWidth, SampleType stopbandAmplitudedB)
+    {
+        const auto order = FilterDesign<SampleType>::designFIRLowpassKaiserMethod (static_cast<SampleType> (0.25), 1.0,
+                                                                                   normalisedTransitionWidth,
+                                                                                   stopbandAmplitudedB)->getFilterOrder();
+        return order + order % 2;
+    }
+
+    std::vector<double> designFilter (size_t order, SampleType stopbandAmplitudedB, bool useMinimumPhase) const
+    {
+        const auto numPhases = ParentType::factor;
+        const auto cutoff = static_cast<SampleType> (0.5 / static_cast<double> (numPhases));
+        const auto coeffs = FilterDesign<SampleType>::designFIRLowpassWindowMethod (cutoff, 1.0, order,
+                                                                                    WindowingFunction<SampleType>::kaiser,
+                                                                                    getKaiserBeta (stopbandAmplitudedB));
+
+        const auto* raw = coeffs->getRawCoefficients();
+        std::vector<double> fir (raw, raw + coeffs->getFilterOrder() + 1);
+
+        // The cutoff is at 1/N of the Nyquist frequency, so the ideal response is zero at
+        // every Nth tap either side of the centre. Making these exactly zero lets them
+        // be skipped
+        const auto centre = fir.size() / 2;
+
+        for (auto i = centre % numPhases; i < fir.size(); i += numPhases)
+            if (i != centre)
+                fir[i] = 0.0;
+
+        // Normalise the gain at DC
+        const auto sum = std::accumulate (fir.begin(), fir.end(), 0.0);
+
+        for (auto& c : fir)
+            c /= sum;
+
+        return useMinimumPhase ? makeMinimumPhase (fir) : fir;
+    }
+
+    /*  Finds the minimum phase filter with the same magnitude response, using the
+        real cepstrum. The FFT is much longer than the filter, to keep the aliasing of
+        the cepstrum low.
+    */
+    static std::vector<double> makeMinimumPhase (const std::vector<double>& fir)
+    {
+        const auto order = jmax (8, (int) std::ceil (std::log2 ((double) fir.size())) + 4);
+        const auto size = (size_t) 1 << order;
+
+        FFT fft (order);
+        std::vector<Complex<float>> input (size), output (size);
+
+        for (size_t i = 0; i < fir.size(); ++i)
+            input[i] = { static_cast<float> (fir[i]), 0.0f };
+
+        fft.perform (input.data(), output.data(), false);
+
+        for (size_t i = 0; i < size; ++i)
+            input[i] = { std::log (jmax (std::abs (output[i]), 1.0e-7f)), 0.0f };
+
+        fft.perform (input.data(), output.data(), true);
+
+        // Fold the anti-causal part of the cepstrum onto the causal part
+        std::fill (input.begin(), input.end(), Complex<float>());
+        input[0] = output[0];
+        input[size / 2] = output[size / 2];
+
+        for (size_t i = 1; i < size / 2; ++i)
+            input[i] = 2.0f * output[i];
+
+        fft.perform (input.data(), output.data(), false);
+
+        for (size_t i = 0; i < size; ++i)
+            input[i] = std::exp (output[i]);
+
+        fft.perform (input.data(), output.data(), true);
+
+        std::vector<double> result (fir.size());
+
+        for (size_t i = 0; i < result.size(); ++i)
+            result[i] = static_cast<double> (output[i].real());
+
+        return result;
+    }
+
+    // The same window parameter that FilterDesign::designFIRLowpassKaiserMethod uses
+    static SampleType getKaiserBeta (SampleType amplitudedB)
+    {
+        if (amplitudedB < -50)
+            return static_cast<SampleType> (0.1102 * (-amplitudedB - 8.7));
+
+        if (amplitudedB <= -21)
+            return static_cast<SampleType> (0.5842 * std::pow (-amplitudedB - 21, 0.4) + 0.07886 * (-amplitudedB - 21));
+
+        return 0;
+    }
+
+    /*  Stores tap p + kN of the filter as coefficient k of phase p, and finds the range
+        of taps in each phase which aren't zero.
+    */
+    void splitIntoPhases (const std::vector<double>& fir, double gain, size_t numTapsPerPhase,
+                          Lanes* destination, std::vector<Range<size_t>>& nonZeroTaps) const
+    {
+        const auto numPhases = ParentType::factor;
+        nonZeroTaps.assign (numPhases, {});
+
+        for (size_t phase = 0; phase < numPhases; ++phase)
+        {
+            auto start = numTapsPerPhase, end = (size_t) 0;
+
+            for (size_t tap = 0; tap < numTapsPerPhase; ++tap)
+            {
+                const auto index = tap * numPhases + phase;
+                const auto value = index < fir.size() ? fir[index] * gain : 0.0;
+                destination[phase * numTapsPerPhase + tap] = Lanes (static_cast<SampleType> (value));
+
+                if (! exactlyEqual (value, 0.0))
+                {
+                    start = jmin (start, tap);
+                    end = tap + 1;
+                }
+            }
+
+            nonZeroTaps[phase] = { jmin (start, end), end };
+        }
+    }
+
+    static double getDelayAtDC (const std::vector<double>& fir)
+    {
+        double sum = 0, weightedSum = 0;
+
+        for (size_t i = 0; i < fir.size(); ++i)
+        {
+            sum += fir[i];
+            weightedSum += fir[i] * static_cast<double> (i);
+        }
+
+        return weightedSum / sum;
+    }
+
+    static void pushSamples (Lanes* state, size_t pos, size_t numTaps,
+                             const SampleType* const* samples, size_t numGroupChannels, size_t index) noexcept
+    {
+        auto* first  = reinterpret_cast<SampleType*> (state + pos);
+        auto* second = reinterpret_cast<SampleType*> (state + pos + numTaps);
+
+        for (size_t lane = 0; lane < numGroupChannels; ++lane)
+            first[lane] = second[lane] = samples[lane][index];
+    }
+
+    static Lanes dotProduct (const Lanes* samples, const Lanes* coeffs, size_t numTaps, size_t stride) noexcept
+    {
+        // Two accumulators keep more multiplications in flight at once
+        Lanes sum1 (static_cast<SampleType> (0)), sum2 (static_cast<SampleType> (0));
+        size_t k = 0;
+
+        for (; k + 1 < numTaps; k += 2)
+        {
+            sum1 += samples[k * stride]       * coeffs[k];
+            sum2 += samples[(k + 1) * stride] * coeffs[k + 1];
+        }
+
+        if (k < numTaps)
+            sum1 += samples[k * stride] * coeffs[k];
+
+        return sum1 + sum2;
+    }
+
+    //==============================================================================
+    size_t numGroups, numTapsUp = 0, numTapsDown = 0, numTapsPerPhaseDown = 0;
+    SampleType latency = 0;
+    std::vector<Range<size_t>> nonZeroTapsUp, nonZeroTapsDown;
+
+    HeapBlock<char> coefficientsUpMemory, coefficientsDownMemory, stateUpMemory, stateDownMemory;
+    AudioBlock<Lanes> coefficientsUp, coefficientsDown, stateUp, stateDown;
+    Array<size_t> positionUp, positionDown;
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OversamplingPolyphaseFIR)
+};
+
+
 //==============================================================================
 template <typename SampleType>
 Oversampling<SampleType>::Oversampling (size_t newNumChannels)
@@ -565,7 +963,7 @@ Oversampling<SampleType>::Oversampling (size_t newNumChannels, size_t newFactor,
                                   twDown, gaindBStartDown + gaindBFactorDown * (float) n);
         }
     }
-    else if (newType == FilterType::filterHalfBandFIREquiripple)
+    else
     {
         for (size_t n = 0; n < newFactor; ++n)
         {
@@ -577,7 +975,7 @@ Oversampling<SampleType>::Oversampling (size_t newNumChannels, size_t newFactor,
             auto gaindBFactorUp   = (isMaximumQuality ? 10.0f  : 8.0f);
             auto gaindBFactorDown = (isMaximumQuality ? 10.0f  : 8.0f);
 
-            addOversamplingStage (FilterType::filterHalfBandFIREquiripple,
+            addOversamplingStage (newType,
                                   twUp, gaindBStartUp + gaindBFactorUp * (float) n,
                                   twDown, gaindBStartDown + gaindBFactorDown * (float) n);
         }
@@ -604,6 +1002,35 @@ void Oversampling<SampleType>::addOversamplingStage (FilterType type,
                                                      float normalisedTransitionWidthDown,
                                                      float stopbandAmplitudedBDown)
 {
+    addOversamplingStage (type, 2,
+                          normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
+                          normalisedTransitionWidthDown, stopbandAmplitudedBDown);
+}
+
+template <typename SampleType>
+void Oversampling<SampleType>::addOversamplingStage (FilterType type,
+                                                     size_t stageFactor,
+                                                     float normalisedTransitionWidthUp,
+                                                     float stopbandAmplitudedBUp,
+                                                     float normalisedTransitionWidthDown,
+                                                     float stopbandAmplitudedBDown)
+{
+    if (type == FilterType::filterPolyphaseFIR || type == FilterType::filterPolyphaseFIRMinimumPhase)
+    {
+        jassert (stageFactor >= 2);
+
+        stages.add (new OversamplingPolyphaseFIR<SampleType> (numChannels, stageFactor,
+                                                              type == FilterType::filterPolyphaseFIRMinimumPhase,
+                                                              normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
+                                                              normalisedTransitionWidthDown, stopbandAmplitudedBDown));
+
+        factorOversampling *= stageFactor;
+        return;
+    }
+
+    // The half-band filters can only oversample by a factor of 2!
+    jassert (stageFactor == 2);
+
     if (type == FilterType::filterHalfBandPolyphaseIIR)
     {
         stages.add (new Oversampling2TimesPolyphaseIIR<SampleType> (numChannels,
@@ -34,6 +34,16 @@ namespace juce::dsp
     oversampling, using multiple stages, with polyphase allpass IIR filters or FIR
     filters, and latency compensation.
 
+    Other factors, such as 3 or 6 times, can be built from polyphase FIR stages,
+    which can oversample by any integer factor:
+
+    @code
+    Oversampling<float> oversampling (2);
+    oversampling.clearOversamplingStages();
+    oversampling.addOversamplingStage (Oversampling<float>::filterPolyphaseFIR, 3, 0.05f, -90.0f, 0.06f, -75.0f);
+    oversampling.addOversamplingStage (Oversampling<float>::filterPolyphaseFIR, 2, 0.10f, -80.0f, 0.12f, -65.0f);
+    @endcode
+
     The principle of oversampling is to increase the sample rate of a given
     non-linear process to prevent it from creating aliasing. Oversampling works
     by upsampling the input signal N times, processing the upsampled signal
@@ -43,7 +53,9 @@ namespace juce::dsp
     Choose between FIR or IIR filtering depending on your needs in terms of
     latency and phase distortion. With FIR filters the phase is linear but the
     latency is maximised. With IIR filtering the phase is compromised around the
-    Nyquist frequency but the latency is minimised.
+    Nyquist frequency but the latency is minimised. Minimum phase FIR filters sit
+    in between, with the same magnitude response as the linear phase ones but a
+    much lower latency.
 
     @see FilterDesign.
 
@@ -58,6 +70,8 @@ public:
     {
         filterHalfBandFIREquiripple = 0,
         filterHalfBandPolyphaseIIR,
+        filterPolyphaseFIR,                 /**< Linear phase FIR filters, which can be used for any integer factor. */
+        filterPolyphaseFIRMinimumPhase,     /**< Minimum phase FIR filters, which can be used for any integer factor. */
         numFilterTypes
     };
 
@@ -169,6 +183,21 @@ public:
                                float normalisedTransitionWidthUp,   float stopbandAmplitudedBUp,
                                float normalisedTransitionWidthDown, float stopbandAmplitudedBDown);
 
+    /** Adds a new oversampling stage to the Oversampling class, multiplying the
+        current oversampling factor by the given factor.
+
+        The half-band filter types can only be used with a factor of 2, but the
+        polyphase FIR types can use any factor. Their filters only compute the samples
+        that aren't thrown away, and process several channels at once using SIMD
+        instructions. The transition widths are relative to the oversampled rate, so
+        the transition is centred on 0.5 / factor.
+
+        @see addOversamplingStage, clearOversamplingStages
+    */
+    void addOversamplingStage (FilterType, size_t factor,
+                               float normalisedTransitionWidthUp,   float stopbandAmplitudedBUp,
+                               float normalisedTransitionWidthDown, float stopbandAmplitudedBDown);
+
     /** Adds a new "dummy" oversampling stage, which does nothing to the signal. Using
         one can be useful if your application features a customisable oversampling factor
         and if you want to select the current one from an OwnedArray without changing
@@ -0,0 +1,182 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+class OversamplingTests final : public UnitTest
+{
+public:
+    OversamplingTests()
+        : UnitTest ("Oversampling", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr size_t blockSize = 480, numBlocks = 20;
+        constexpr size_t numChannels = 5;
+
+        const auto createOversampling = [&] (auto type)
+        {
+            auto oversampling = std::make_unique<Oversampling<double>> (numChannels);
+            oversampling->clearOversamplingStages();
+            oversampling->addOversamplingStage (type, 3, 0.05f, -90.0f, 0.06f, -75.0f);
+            oversampling->addOversamplingStage (type, 2, 0.10f, -80.0f, 0.12f, -65.0f);
+            oversampling->initProcessing (blockSize);
+            return oversampling;
+        };
+
+        const auto linearPhase  = createOversampling (Oversampling<double>::filterPolyphaseFIR);
+        const auto minimumPhase = createOversampling (Oversampling<double>::filterPolyphaseFIRMinimumPhase);
+
+        beginTest ("Polyphase FIR stages can be used for non-power-of-two factors");
+        {
+            expectEquals ((int) linearPhase->getOversamplingFactor(), 6);
+            expectGreaterThan (minimumPhase->getLatencyInSamples(), 0.0);
+            expectLessThan (minimumPhase->getLatencyInSamples(), linearPhase->getLatencyInSamples() * 0.5);
+        }
+
+        beginTest ("Polyphase FIR stages don't change low frequencies, apart from the latency");
+        {
+            for (auto* oversampling : { linearPhase.get(), minimumPhase.get() })
+            {
+                oversampling->setUsingIntegerLatency (true);
+                oversampling->initProcessing (blockSize);
+
+                const auto input = createSines (numChannels, blockSize * numBlocks, sampleRate);
+                AudioBuffer<double> output (numChannels, (int) (blockSize * numBlocks));
+
+                for (size_t start = 0; start < blockSize * numBlocks; start += blockSize)
+                {
+                    auto inputBlock = AudioBlock<const double> (input).getSubBlock (start, blockSize);
+                    auto outputBlock = AudioBlock<double> (output).getSubBlock (start, blockSize);
+
+                    const auto upsampled = oversampling->processSamplesUp (inputBlock);
+                    expectEquals ((int) upsampled.getNumSamples(), (int) blockSize * 6);
+                    oversampling->processSamplesDown (outputBlock);
+                }
+
+                // Skip the start, while the filters are filling up. The latency of the
+                // second stage is a fraction of an input sample, so the output has been
+                // through the fractional delay too, and only its gain is checked here
+                for (size_t channel = 0; channel < numChannels; ++channel)
+                    expectWithinAbsoluteError (getMagnitude (output, (int) channel, 1000, getFrequency (channel), sampleRate), 1.0, 1.0e-3);
+            }
+        }
+
+        beginTest ("Linear phase polyphase FIR stages delay by a whole number of samples");
+        {
+            Oversampling<double> oversampling (numChannels);
+            oversampling.clearOversamplingStages();
+            oversampling.addOversamplingStage (Oversampling<double>::filterPolyphaseFIR, 3, 0.05f, -90.0f, 0.06f, -75.0f);
+            oversampling.initProcessing (blockSize);
+
+            const auto latency = roundToInt (oversampling.getLatencyInSamples());
+            expectWithinAbsoluteError (oversampling.getLatencyInSamples(), (double) latency, 1.0e-9);
+
+            oversampling.setUsingIntegerLatency (true);
+            expectWithinAbsoluteError (oversampling.getLatencyInSamples(), (double) latency, 1.0e-9);
+
+            const auto input = createSines (numChannels, blockSize * numBlocks, sampleRate);
+            AudioBuffer<double> output (numChannels, (int) (blockSize * numBlocks));
+
+            for (size_t start = 0; start < blockSize * numBlocks; start += blockSize)
+            {
+                auto inputBlock = AudioBlock<const double> (input).getSubBlock (start, blockSize);
+                auto outputBlock = AudioBlock<double> (output).getSubBlock (start, blockSize);
+
+                oversampling.processSamplesUp (inputBlock);
+                oversampling.processSamplesDown (outputBlock);
+            }
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+                for (int i = 1000; i < output.getNumSamples(); ++i)
+                    expectWithinAbsoluteError (output.getSample ((int) channel, i), input.getSample ((int) channel, i - latency), 1.0e-4);
+        }
+
+        beginTest ("Polyphase FIR stages remove the images when upsampling");
+        {
+            for (auto* oversampling : { linearPhase.get(), minimumPhase.get() })
+            {
+                oversampling->reset();
+
+                const auto input = createSines (numChannels, blockSize, sampleRate);
+                const auto upsampled = oversampling->processSamplesUp (AudioBlock<const double> (input));
+
+                AudioBuffer<double> copy ((int) numChannels, (int) upsampled.getNumSamples());
+                upsampled.copyTo (copy);
+
+                for (size_t channel = 0; channel < numChannels; ++channel)
+                {
+                    const auto frequency = getFrequency (channel);
+                    const auto wanted = getMagnitude (copy, (int) channel, 1000, frequency, sampleRate * 6);
+
+                    expectWithinAbsoluteError (wanted, 1.0, 1.0e-3);
+
+                    for (auto image : { sampleRate - frequency, sampleRate + frequency, sampleRate * 2 - frequency })
+                        expectLessThan (getMagnitude (copy, (int) channel, 1000, image, sampleRate * 6), 1.0e-4);
+                }
+            }
+        }
+    }
+
+private:
+    // All the frequencies used are multiples of this
+    static constexpr double baseFrequency = 500.0;
+
+    static double getFrequency (size_t channel)
+    {
+        return baseFrequency * (double) (channel + 1);
+    }
+
+    static AudioBuffer<double> createSines (size_t numChannels, size_t numSamples, double sampleRate)
+    {
+        AudioBuffer<double> buffer ((int) numChannels, (int) numSamples);
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            for (size_t i = 0; i < numSamples; ++i)
+                buffer.setSample ((int) channel, (int) i, std::sin (MathConstants<double>::twoPi * getFrequency (channel) * (double) i / sampleRate));
+
+        return buffer;
+    }
+
+    static double getMagnitude (const AudioBuffer<double>& buffer, int channel, int start, double frequency, double sampleRate)
+    {
+        // Only whole numbers of cycles are measured, so there's no leakage between frequencies
+        const auto period = roundToInt (sampleRate / baseFrequency);
+        const auto length = ((buffer.getNumSamples() - start) / period) * period;
+        std::complex<double> sum;
+
+        for (int i = 0; i < length; ++i)
+            sum += buffer.getSample (channel, start + i) * std::polar (1.0, -MathConstants<double>::twoPi * frequency * i / sampleRate);
+
+        return std::abs (sum) * 2.0 / length;
+    }
+};
+
+static OversamplingTests oversamplingTests;
+
+} // namespace juce::dsp
@@ -64,6 +64,18 @@ void Compressor<SampleType>::setRelease (SampleType newRelease)
     update();
 }
 
+template <typename SampleType>
+void Compressor<SampleType>::setLookahead (SampleType newLookahead)
+{
+    dynamics.setLookahead (newLookahead);
+}
+
+template <typename SampleType>
+void Compressor<SampleType>::setChannelLinking (bool shouldBeLinked)
+{
+    dynamics.setChannelLinking (shouldBeLinked);
+}
+
 //==============================================================================
 template <typename SampleType>
 void Compressor<SampleType>::prepare (const ProcessSpec& spec)
@@ -73,7 +85,7 @@ void Compressor<SampleType>::prepare (const ProcessSpec& spec)
 
     sampleRate = spec.sampleRate;
 
-    envelopeFilter.prepare (spec);
+    dynamics.prepare (spec);
 
     update();
     reset();
@@ -82,7 +94,7 @@ void Compressor<SampleType>::prepare (const ProcessSpec& spec)
 template <typename SampleType>
 void Compressor<SampleType>::reset()
 {
-    envelopeFilter.reset();
+    dynamics.reset();
 }
 
 //==============================================================================
@@ -90,7 +102,7 @@ template <typename SampleType>
 SampleType Compressor<SampleType>::processSample (int channel, SampleType inputValue)
 {
     // Ballistics filter with peak rectifier
-    auto env = envelopeFilter.processSample (channel, inputValue);
+    auto env = dynamics.getEnvelopeFilter().processSample (channel, inputValue);
 
     // VCA
     auto gain = (env < threshold) ? static_cast<SampleType> (1.0)
@@ -107,8 +119,9 @@ void Compressor<SampleType>::update()
     thresholdInverse = static_cast<SampleType> (1.0) / threshold;
     ratioInverse     = static_cast<SampleType> (1.0) / ratio;
 
-    envelopeFilter.setAttackTime (attackTime);
-    envelopeFilter.setReleaseTime (releaseTime);
+    dynamics.setGainCurve (thresholddB, ratioInverse - static_cast<SampleType> (1.0), true);
+    dynamics.getEnvelopeFilter().setAttackTime (attackTime);
+    dynamics.getEnvelopeFilter().setReleaseTime (releaseTime);
 }
 
 //==============================================================================
@@ -0,0 +1,377 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce::dsp
+{
+
+//==============================================================================
+template <typename SampleType>
+static void writeToFDNRing (SampleType* ring, int mask, int position, const SampleType* source, int numSamples) noexcept
+{
+    const auto numBeforeWrap = jmin (numSamples, mask + 1 - position);
+
+    FloatVectorOperations::copy (ring + position, source, numBeforeWrap);
+    FloatVectorOperations::copy (ring, source + numBeforeWrap, numSamples - numBeforeWrap);
+}
+
+template <typename SampleType>
+static void readFromFDNRing (SampleType* destination, const SampleType* ring, int mask, int position, SampleType gain, int numSamples) noexcept
+{
+    position &= mask;
+    const auto numBeforeWrap = jmin (numSamples, mask + 1 - position);
+
+    FloatVectorOperations::copyWithMultiply (destination, ring + position, gain, numBeforeWrap);
+    FloatVectorOperations::copyWithMultiply (destination + numBeforeWrap, ring, gain, numSamples - numBeforeWrap);
+}
+
+//==============================================================================
+template <typename SampleType>
+FDNReverb<SampleType>::FDNReverb (int numDelayLines)
+    : numLines (numDelayLines)
+{
+    // The number of delay lines must be a power of 2, so that they can be mixed with a Hadamard matrix
+    jassert (isPowerOfTwo (numDelayLines) && numDelayLines >= 4 && numDelayLines <= 64);
+
+    setParameters (parameters);
+}
+
+//==============================================================================
+template <typename SampleType>
+void FDNReverb<SampleType>::setParameters (const Parameters& newParams)
+{
+    parameters = newParams;
+    updateParameters();
+}
+
+template <typename SampleType>
+void FDNReverb<SampleType>::updateParameters() noexcept
+{
+    const auto frozen = parameters.freezeMode >= 0.5f;
+    const auto wet = (SampleType) (jlimit (0.0f, 1.0f, parameters.wetLevel) * wetScaleFactor);
+    const auto width = (SampleType) jlimit (0.0f, 1.0f, parameters.width);
+
+    roomScale.setTargetValue ((SampleType) (0.25f + 0.75f * jlimit (0.0f, 1.0f, parameters.roomSize)));
+    dryGain  .setTargetValue ((SampleType) (jlimit (0.0f, 1.0f, parameters.dryLevel) * dryScaleFactor));
+    wetGain1 .setTargetValue ((SampleType) 0.5 * wet * ((SampleType) 1 + width));
+    wetGain2 .setTargetValue ((SampleType) 0.5 * wet * ((SampleType) 1 - width));
+
+    dampingCoefficient = frozen ? (SampleType) 1 : (SampleType) (1.0f - 0.8f * jlimit (0.0f, 1.0f, parameters.damping));
+    inputGain = frozen ? (SampleType) 0 : (SampleType) (1.0 / std::sqrt ((double) numLines));
+    modulationSamples = (SampleType) (jlimit (0.0f, 1.0f, parameters.modulationDepth) * maxModulationSeconds * sampleRate);
+
+    // Each line gets a slightly different rate, so that they don't move together
+    lfoIncrements.resize ((size_t) numLines);
+
+    for (int line = 0; line < numLines; ++line)
+    {
+        const auto rate = (double) jmax (0.0f, parameters.modulationRate) * (0.7 + 0.6 * line / numLines);
+        lfoIncrements[(size_t) line] = MathConstants<double>::twoPi * rate / sampleRate;
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void FDNReverb<SampleType>::prepare (const ProcessSpec& spec)
+{
+    sampleRate = spec.sampleRate;
+
+    // The delays are spread out so that their lengths have no common factors, which
+    // would make some frequencies ring. The random generator is seeded, so that every
+    // instance sounds the same.
+    Random random (0x7e4b);
+
+    baseDelays.resize ((size_t) numLines);
+
+    for (int line = 0; line < numLines; ++line)
+    {
+        const auto position = ((double) line + 0.5 * random.nextDouble()) / numLines;
+        baseDelays[(size_t) line] = (SampleType) (maxDelaySeconds * std::pow (0.5, position) * sampleRate);
+    }
+
+    // Chunks can't be longer than the shortest delay in the feedback loop
+    jassert (maxDelaySeconds * 0.5 * 0.25 * sampleRate > chunkSize + 2);
+
+    const auto maxFeedbackDelay = maxDelaySeconds * sampleRate + 2.0 * maxModulationSeconds * sampleRate;
+    feedbackMask = nextPowerOfTwo ((int) std::ceil (maxFeedbackDelay) + chunkSize + 2) - 1;
+    feedbackBuffer.setSize (numLines, feedbackMask + 1);
+
+    // Each diffusion step is half as long as the one before, and each of its
+    // channels is delayed by a different amount within the step's range, with a
+    // random change of polarity. The normalisation of the Hadamard matrix that
+    // follows is folded into the polarity.
+    const auto normalisation = 1.0 / std::sqrt ((double) numLines);
+
+    diffusionDelays.resize ((size_t) (numLines * numDiffusionSteps));
+    diffusionSigns .resize ((size_t) (numLines * numDiffusionSteps));
+
+    for (int step = 0; step < numDiffusionSteps; ++step)
+    {
+        const auto range = diffusionSeconds * std::pow (0.5, step) * sampleRate;
+
+        for (int line = 0; line < numLines; ++line)
+        {
+            const auto index = (size_t) (step * numLines + line);
+            diffusionDelays[index] = (int) std::floor (range * (line + random.nextDouble()) / numLines) + 1;
+            diffusionSigns[index] = (SampleType) (random.nextBool() ? normalisation : -normalisation);
+        }
+    }
+
+    diffusionMask = nextPowerOfTwo ((int) std::ceil (diffusionSeconds * sampleRate) + chunkSize + 2) - 1;
+    diffusionBuffer.setSize (numLines * numDiffusionSteps, diffusionMask + 1);
+
+    workBuffer   .setSize (numLines, chunkSize);
+    delayedBuffer.setSize (numLines, chunkSize);
+    mixBuffer    .setSize (numMixChannels, chunkSize);
+
+    currentDelays.resize ((size_t) numLines);
+    gains        .resize ((size_t) numLines);
+    dampingState .resize ((size_t) numLines);
+    lfoPhases    .resize ((size_t) numLines);
+
+    for (auto* value : { &roomScale, &dryGain, &wetGain1, &wetGain2 })
+        value->reset (sampleRate, 0.05);
+
+    updateParameters();
+    reset();
+}
+
+template <typename SampleType>
+void FDNReverb<SampleType>::reset() noexcept
+{
+    diffusionBuffer.clear();
+    feedbackBuffer.clear();
+    diffusionWritePos = feedbackWritePos = 0;
+
+    std::fill (dampingState.begin(), dampingState.end(), (SampleType) 0);
+
+    for (auto* value : { &roomScale, &dryGain, &wetGain1, &wetGain2 })
+        value->setCurrentAndTargetValue (value->getTargetValue());
+
+    // The modulation of each line starts at a different phase
+    for (size_t line = 0; line < lfoPhases.size(); ++line)
+    {
+        lfoPhases[line] = MathConstants<double>::twoPi * (double) line / numLines;
+        currentDelays[line] = baseDelays[line] * roomScale.getCurrentValue()
+                                + (SampleType) (1.0 + std::sin (lfoPhases[line])) * modulationSamples;
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void FDNReverb<SampleType>::updateDecayGains() noexcept
+{
+    if (parameters.freezeMode >= 0.5f)
+    {
+        std::fill (gains.begin(), gains.end(), (SampleType) 1);
+        return;
+    }
+
+    // Each line loses 60 dB over the decay time, in proportion to its length
+    const auto decayPerSample = -3.0 * std::log (10.0) / (jmax (0.01, (double) parameters.decayTime) * sampleRate);
+    const auto scale = (double) roomScale.getCurrentValue();
+
+    for (size_t line = 0; line < gains.size(); ++line)
+        gains[line] = (SampleType) std::exp (decayPerSample * scale * (double) baseDelays[line]);
+}
+
+template <typename SampleType>
+void FDNReverb<SampleType>::hadamard (SampleType* const* lines, int numSamples) const noexcept
+{
+    for (int stride = 1; stride < numLines; stride *= 2)
+    {
+        for (int start = 0; start < numLines; start += 2 * stride)
+        {
+            for (auto line = start; line < start + stride; ++line)
+            {
+                auto* a = lines[line];
+                auto* b = lines[line + stride];
+
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const auto x = a[i], y = b[i];
+                    a[i] = x + y;
+                    b[i] = x - y;
+                }
+            }
+        }
+    }
+}
+
+template <typename SampleType>
+void FDNReverb<SampleType>::render (const AudioBlock<const SampleType>& input, const AudioBlock<SampleType>& output) noexcept
+{
+    const auto numSamples = (int) output.getNumSamples();
+    const auto stereoOutput = output.getNumChannels() > 1;
+
+    const auto* inputLeft  = input.getChannelPointer (0);
+    const auto* inputRight = input.getChannelPointer (input.getNumChannels() - 1);
+    auto* outputLeft  = output.getChannelPointer (0);
+    auto* outputRight = output.getChannelPointer (output.getNumChannels() - 1);
+
+    const auto* wetLeft  = mixBuffer.getReadPointer (wetLeftChannel);
+    const auto* wetRight = mixBuffer.getReadPointer (wetRightChannel);
+
+    updateDecayGains();
+
+    for (int start = 0; start < numSamples; start += chunkSize)
+    {
+        const auto num = jmin (chunkSize, numSamples - start);
+        renderChunk (inputLeft + start, inputRight + start, num);
+
+        for (int i = 0; i < num; ++i)
+        {
+            const auto left = inputLeft[start + i], right = inputRight[start + i];
+            const auto dry = dryGain.getNextValue();
+            const auto wet1 = wetGain1.getNextValue();
+            const auto wet2 = wetGain2.getNextValue();
+
+            if (stereoOutput)
+            {
+                outputLeft [start + i] = left  * dry + wetLeft[i]  * wet1 + wetRight[i] * wet2;
+                outputRight[start + i] = right * dry + wetRight[i] * wet1 + wetLeft[i]  * wet2;
+            }
+            else
+            {
+                outputLeft[start + i] = (left + right) * (SampleType) 0.5 * dry
+                                          + (wetLeft[i] + wetRight[i]) * (SampleType) 0.5 * (wet1 + wet2);
+            }
+        }
+    }
+}
+
+template <typename SampleType>
+void FDNReverb<SampleType>::renderChunk (const SampleType* inputLeft, const SampleType* inputRight, int numSamples) noexcept
+{
+    auto* const* work = workBuffer.getArrayOfWritePointers();
+    auto* const* delayed = delayedBuffer.getArrayOfWritePointers();
+
+    // The input is spread across all the lines, alternating between left and right
+    for (int line = 0; line < numLines; ++line)
+        FloatVectorOperations::copyWithMultiply (work[line], (line & 1) == 0 ? inputLeft : inputRight, inputGain, numSamples);
+
+    // Diffusion. There's no feedback here, so the whole chunk can be written before
+    // any of it is read back.
+    for (int step = 0; step < numDiffusionSteps; ++step)
+    {
+        for (int line = 0; line < numLines; ++line)
+        {
+            const auto index = step * numLines + line;
+            auto* ring = diffusionBuffer.getWritePointer (index);
+
+            writeToFDNRing (ring, diffusionMask, diffusionWritePos, work[line], numSamples);
+            readFromFDNRing (work[line], ring, diffusionMask, diffusionWritePos - diffusionDelays[(size_t) index],
+                             diffusionSigns[(size_t) index], numSamples);
+        }
+
+        hadamard (work, numSamples);
+    }
+
+    diffusionWritePos = (diffusionWritePos + numSamples) & diffusionMask;
+
+    // The modulated delays. The modulation is slow enough for the delays to be
+    // ramped linearly across each chunk.
+    const auto scale = roomScale.skip (numSamples);
+
+    for (int line = 0; line < numLines; ++line)
+    {
+        const auto l = (size_t) line;
+        lfoPhases[l] = std::fmod (lfoPhases[l] + lfoIncrements[l] * numSamples, MathConstants<double>::twoPi);
+
+        const auto startDelay = currentDelays[l];
+        const auto endDelay = baseDelays[l] * scale + (SampleType) (1.0 + std::sin (lfoPhases[l])) * modulationSamples;
+        const auto delayIncrement = (endDelay - startDelay) / (SampleType) numSamples;
+        currentDelays[l] = endDelay;
+
+        const auto* ring = feedbackBuffer.getReadPointer (line);
+        auto* destination = delayed[line];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto delay = startDelay + delayIncrement * (SampleType) (i + 1);
+            const auto delayInt = (int) delay;
+            const auto delayFrac = delay - (SampleType) delayInt;
+            const auto position = feedbackWritePos + i - delayInt;
+
+            const auto value1 = ring[position & feedbackMask];
+            const auto value2 = ring[(position - 1) & feedbackMask];
+            destination[i] = value1 + delayFrac * (value2 - value1);
+        }
+    }
+
+    // The even lines go to the left, the odd ones to the right
+    auto* wetLeft  = mixBuffer.getWritePointer (wetLeftChannel);
+    auto* wetRight = mixBuffer.getWritePointer (wetRightChannel);
+
+    FloatVectorOperations::copy (wetLeft, delayed[0], numSamples);
+    FloatVectorOperations::copy (wetRight, delayed[1], numSamples);
+
+    for (int line = 2; line < numLines; line += 2)
+    {
+        FloatVectorOperations::add (wetLeft, delayed[line], numSamples);
+        FloatVectorOperations::add (wetRight, delayed[line + 1], numSamples);
+    }
+
+    // Damping
+    for (int line = 0; line < numLines; ++line)
+    {
+        auto* samples = delayed[line];
+        auto z = dampingState[(size_t) line];
+
+        for (int i = 0; i < numSamples; ++i)
+            samples[i] = z += dampingCoefficient * (samples[i] - z);
+
+        dampingState[(size_t) line] = z;
+    }
+
+    // A Householder matrix, which reflects the lines in the plane perpendicular to
+    // (1, 1, 1...), then the decay, and the diffused input
+    auto* sum = mixBuffer.getWritePointer (sumChannel);
+    FloatVectorOperations::copy (sum, delayed[0], numSamples);
+
+    for (int line = 1; line < numLines; ++line)
+        FloatVectorOperations::add (sum, delayed[line], numSamples);
+
+    FloatVectorOperations::multiply (sum, (SampleType) 2 / (SampleType) numLines, numSamples);
+
+    for (int line = 0; line < numLines; ++line)
+    {
+        auto* samples = delayed[line];
+
+        FloatVectorOperations::subtract (samples, sum, numSamples);
+        FloatVectorOperations::multiply (samples, gains[(size_t) line], numSamples);
+        FloatVectorOperations::add (samples, work[line], numSamples);
+
+        writeToFDNRing (feedbackBuffer.getWritePointer (line), feedbackMask, feedbackWritePos, samples, numSamples);
+    }
+
+    feedbackWritePos = (feedbackWritePos + numSamples) & feedbackMask;
+}
+
+//==============================================================================
+template class FDNReverb<float>;
+template class FDNReverb<double>;
+
+} // namespace juce::dsp
@@ -0,0 +1,165 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce::dsp
+{
+
+/**
+    An algorithmic reverb built on a feedback delay network.
+
+    The input is spread across a number of channels, which pass through a chain of
+    diffusion steps (short delays followed by a Hadamard mix) to build up the echo
+    density quickly. They then feed a network of delay lines whose outputs are
+    damped, mixed with a Householder matrix and fed back into each other. The
+    delays in the feedback loop are slowly modulated, which avoids the metallic
+    ringing of static networks.
+
+    The audio is processed in short chunks, which are never longer than the delays
+    in the feedback loop. This means that each delay line can be read and written a
+    whole chunk at a time, and that the mixing matrices can be applied with
+    FloatVectorOperations, rather than one sample and one line at a time. Larger
+    networks sound smoother, at a proportional cost.
+
+    Mono and stereo inputs and outputs are supported.
+
+    @see Reverb
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class FDNReverb
+{
+public:
+    //==============================================================================
+    /** Holds the parameters being used by an FDNReverb. */
+    struct Parameters
+    {
+        float roomSize        = 0.5f;     /**< Room size, 0 to 1.0, where 1.0 is big, 0 is small. */
+        float decayTime       = 2.0f;     /**< The time in seconds for the tail to decay by 60 dB. */
+        float damping         = 0.5f;     /**< Damping of high frequencies, 0 to 1.0, where 0 is none. */
+        float modulationDepth = 0.5f;     /**< Depth of the delay modulation, 0 to 1.0. */
+        float modulationRate  = 0.5f;     /**< Average rate of the delay modulation, in Hz. */
+        float wetLevel        = 0.33f;    /**< Wet level, 0 to 1.0 */
+        float dryLevel        = 0.4f;     /**< Dry level, 0 to 1.0 */
+        float width           = 1.0f;     /**< Reverb width, 0 to 1.0, where 1.0 is very wide. */
+        float freezeMode      = 0.0f;     /**< Freeze mode - values < 0.5 are "normal" mode, values > 0.5
+                                               put the reverb into a continuous feedback loop. */
+    };
+
+    //==============================================================================
+    /** Creates a reverb with the given number of delay lines in its network. This
+        must be a power of 2, between 4 and 64.
+    */
+    explicit FDNReverb (int numDelayLines = 16);
+
+    /** Returns the number of delay lines in the network. */
+    int getNumDelayLines() const noexcept               { return numLines; }
+
+    //==============================================================================
+    /** Returns the reverb's current parameters. */
+    const Parameters& getParameters() const noexcept    { return parameters; }
+
+    /** Applies a new set of parameters to the reverb.
+        Note that this doesn't attempt to lock the reverb, so if you call this in parallel with
+        the process method, you may get artifacts.
+    */
+    void setParameters (const Parameters& newParams);
+
+    //==============================================================================
+    /** Initialises the reverb. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the reverb's internal state. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Applies the reverb to a mono or stereo block. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        static_assert (std::is_same_v<typename ProcessContext::SampleType, SampleType>,
+                       "The sample-type of the reverb must match the sample-type supplied to this process callback");
+
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock = context.getOutputBlock();
+
+        jassert (inputBlock.getNumSamples() == outputBlock.getNumSamples());
+        jassert (isPositiveAndNotGreaterThan (inputBlock.getNumChannels(), (size_t) 2));
+        jassert (isPositiveAndNotGreaterThan (outputBlock.getNumChannels(), (size_t) 2));
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
+                    outputBlock.getSingleChannelBlock (channel)
+                               .copyFrom (inputBlock.getSingleChannelBlock (jmin (channel, inputBlock.getNumChannels() - 1)));
+
+            return;
+        }
+
+        render (inputBlock, outputBlock);
+    }
+
+private:
+    //==============================================================================
+    static constexpr int numDiffusionSteps = 4, chunkSize = 64;
+    static constexpr double maxDelaySeconds = 0.15, maxModulationSeconds = 0.001, diffusionSeconds = 0.03;
+    static constexpr float wetScaleFactor = 2.0f, dryScaleFactor = 2.0f;
+
+    enum MixChannel
+    {
+        sumChannel,
+        wetLeftChannel,
+        wetRightChannel,
+        numMixChannels
+    };
+
+    void render (const AudioBlock<const SampleType>& input, const AudioBlock<SampleType>& output) noexcept;
+    void renderChunk (const SampleType* inputLeft, const SampleType* inputRight, int numSamples) noexcept;
+    void updateParameters() noexcept;
+    void updateDecayGains() noexcept;
+    void hadamard (SampleType* const* lines, int numSamples) const noexcept;
+
+    //==============================================================================
+    const int numLines;
+
+    Parameters parameters;
+    double sampleRate = 44100.0;
+
+    AudioBuffer<SampleType> diffusionBuffer, feedbackBuffer, workBuffer, delayedBuffer, mixBuffer;
+    int diffusionMask = 0, feedbackMask = 0, diffusionWritePos = 0, feedbackWritePos = 0;
+
+    std::vector<int> diffusionDelays;
+    std::vector<SampleType> diffusionSigns, baseDelays, currentDelays, gains, dampingState;
+    std::vector<double> lfoPhases, lfoIncrements;
+
+    SmoothedValue<SampleType> roomScale, dryGain, wetGain1, wetGain2;
+    SampleType dampingCoefficient = 0, modulationSamples = 0, inputGain = 1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FDNReverb)
+};
+
+} // namespace juce::dsp
@@ -0,0 +1,174 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce::dsp
+{
+
+class FDNReverbTests final : public UnitTest
+{
+public:
+    FDNReverbTests()
+        : UnitTest ("FDNReverb", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int numSamples = 96000, blockSize = 500;
+
+        FDNReverb<float>::Parameters parameters;
+        parameters.decayTime = 1.0f;
+        parameters.damping = 0.0f;
+        parameters.dryLevel = 0.0f;
+        parameters.wetLevel = 1.0f;
+
+        const auto createReverb = [&] (int numLines)
+        {
+            auto reverb = std::make_unique<FDNReverb<float>> (numLines);
+            reverb->setParameters (parameters);
+            reverb->prepare ({ sampleRate, (uint32) blockSize, 2 });
+            return reverb;
+        };
+
+        const auto process = [&] (FDNReverb<float>& reverb, AudioBuffer<float>& buffer)
+        {
+            AudioBlock<float> block (buffer);
+
+            for (size_t start = 0; start < block.getNumSamples(); start += blockSize)
+            {
+                auto subBlock = block.getSubBlock (start, jmin ((size_t) blockSize, block.getNumSamples() - start));
+                reverb.process (ProcessContextReplacing<float> (subBlock));
+            }
+        };
+
+        const auto getLevel = [] (const AudioBuffer<float>& buffer, double startTime, double endTime)
+        {
+            const auto start = (int) (startTime * sampleRate);
+            return Decibels::gainToDecibels (buffer.getRMSLevel (0, start, (int) (endTime * sampleRate) - start));
+        };
+
+        beginTest ("The tail decays at the requested rate");
+        {
+            for (auto numLines : { 4, 16, 64 })
+            {
+                auto reverb = createReverb (numLines);
+
+                AudioBuffer<float> buffer (2, numSamples);
+                buffer.clear();
+                buffer.setSample (0, 0, 1.0f);
+                buffer.setSample (1, 0, 1.0f);
+                process (*reverb, buffer);
+
+                // With a decay time of 1 second, the tail should lose 30 dB in half a second
+                const auto decay = getLevel (buffer, 0.3, 0.4) - getLevel (buffer, 0.8, 0.9);
+                expectWithinAbsoluteError (decay, 30.0f, 4.0f);
+            }
+        }
+
+        beginTest ("Freezing keeps the tail going");
+        {
+            auto reverb = createReverb (16);
+
+            AudioBuffer<float> buffer (2, numSamples);
+            fillWithNoise (buffer, 0, 4800);
+            process (*reverb, buffer);
+
+            auto frozenParameters = parameters;
+            frozenParameters.freezeMode = 1.0f;
+            reverb->setParameters (frozenParameters);
+
+            fillWithNoise (buffer, 0, numSamples);
+            process (*reverb, buffer);
+
+            // No new input gets in, and nothing decays
+            expectWithinAbsoluteError (getLevel (buffer, 0.2, 0.3) - getLevel (buffer, 1.8, 1.9), 0.0f, 3.0f);
+        }
+
+        beginTest ("Resetting clears the tail");
+        {
+            auto reverb = createReverb (16);
+
+            AudioBuffer<float> buffer (2, numSamples);
+            fillWithNoise (buffer, 0, numSamples);
+            process (*reverb, buffer);
+
+            reverb->reset();
+            buffer.clear();
+            process (*reverb, buffer);
+
+            expectEquals (buffer.getMagnitude (0, numSamples), 0.0f);
+        }
+
+        beginTest ("The width controls the correlation of the outputs");
+        {
+            for (auto width : { 0.0f, 1.0f })
+            {
+                auto widthParameters = parameters;
+                widthParameters.width = width;
+
+                auto reverb = createReverb (16);
+                reverb->setParameters (widthParameters);
+                reverb->reset();
+
+                AudioBuffer<float> buffer (2, numSamples);
+                fillWithNoise (buffer, 0, numSamples);
+                process (*reverb, buffer);
+
+                double product = 0.0, left = 0.0, right = 0.0;
+
+                for (int i = numSamples / 2; i < numSamples; ++i)
+                {
+                    product += buffer.getSample (0, i) * buffer.getSample (1, i);
+                    left    += square (buffer.getSample (0, i));
+                    right   += square (buffer.getSample (1, i));
+                }
+
+                const auto correlation = product / std::sqrt (left * right);
+
+                if (exactlyEqual (width, 0.0f))
+                    expectWithinAbsoluteError (correlation, 1.0, 1.0e-6);
+                else
+                    expectLessThan (std::abs (correlation), 0.5);
+            }
+        }
+    }
+
+private:
+    void fillWithNoise (AudioBuffer<float>& buffer, int start, int num)
+    {
+        auto random = getRandom();
+
+        buffer.clear();
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            for (int i = start; i < start + num; ++i)
+                buffer.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+    }
+};
+
+static FDNReverbTests fdnReverbTests;
+
+} // namespace juce::dsp
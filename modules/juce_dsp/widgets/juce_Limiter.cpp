@@ -41,6 +41,19 @@ void Limiter<SampleType>::setRelease (SampleType newRelease)
     update();
 }
 
+template <typename SampleType>
+void Limiter<SampleType>::setLookahead (SampleType newLookahead)
+{
+    secondStageCompressor.setLookahead (newLookahead);
+}
+
+template <typename SampleType>
+void Limiter<SampleType>::setChannelLinking (bool shouldBeLinked)
+{
+    firstStageCompressor.setChannelLinking (shouldBeLinked);
+    secondStageCompressor.setChannelLinking (shouldBeLinked);
+}
+
 //==============================================================================
 template <typename SampleType>
 void Limiter<SampleType>::prepare (const ProcessSpec& spec)
@@ -47,6 +47,23 @@ public:
     /** Sets the release time in milliseconds of the limiter.*/
     void setRelease (SampleType newRelease);
 
+    /** Sets the lookahead time in milliseconds of the limiter, up to 20 ms.
+
+        This lets the limiter catch the start of a transient, rather than relying on
+        the clipper. It adds latency, which you can find with getLatencyInSamples().
+
+        Only the second, brickwall stage looks ahead. The stages run one after the
+        other, so a lookahead on the gentler first stage would double the latency, for
+        little benefit.
+    */
+    void setLookahead (SampleType newLookahead);
+
+    /** Enables or disables channel linking, so that all the channels get the same gain. */
+    void setChannelLinking (bool shouldBeLinked);
+
+    /** Returns the latency added by the lookahead, in samples. */
+    int getLatencyInSamples() const noexcept        { return secondStageCompressor.getLatencyInSamples(); }
+
     //==============================================================================
     /** Initialises the processor. */
     void prepare (const ProcessSpec& spec);
@@ -69,7 +86,8 @@ public:
 
         if (context.isBypassed)
         {
-            outputBlock.copyFrom (inputBlock);
+            // The audio still goes through the lookahead delay, so the latency doesn't change
+            secondStageCompressor.process (context);
             return;
         }
 
@@ -32,9 +32,11 @@ NoiseGate<SampleType>::NoiseGate()
 {
     update();
 
-    RMSFilter.setLevelCalculationType (BallisticsFilterLevelCalculationType::RMS);
-    RMSFilter.setAttackTime  (static_cast<SampleType> (0.0));
-    RMSFilter.setReleaseTime (static_cast<SampleType> (50.0));
+    auto& rmsFilter = dynamics.getRMSFilter();
+    rmsFilter.setLevelCalculationType (BallisticsFilterLevelCalculationType::RMS);
+    rmsFilter.setAttackTime  (static_cast<SampleType> (0.0));
+    rmsFilter.setReleaseTime (static_cast<SampleType> (50.0));
+    dynamics.setRMSDetectorEnabled (true);
 }
 
 template <typename SampleType>
@@ -67,6 +69,18 @@ void NoiseGate<SampleType>::setRelease (SampleType newRelease)
     update();
 }
 
+template <typename SampleType>
+void NoiseGate<SampleType>::setLookahead (SampleType newLookahead)
+{
+    dynamics.setLookahead (newLookahead);
+}
+
+template <typename SampleType>
+void NoiseGate<SampleType>::setChannelLinking (bool shouldBeLinked)
+{
+    dynamics.setChannelLinking (shouldBeLinked);
+}
+
 //==============================================================================
 template <typename SampleType>
 void NoiseGate<SampleType>::prepare (const ProcessSpec& spec)
@@ -76,8 +90,7 @@ void NoiseGate<SampleType>::prepare (const ProcessSpec& spec)
 
     sampleRate = spec.sampleRate;
 
-    RMSFilter.prepare (spec);
-    envelopeFilter.prepare (spec);
+    dynamics.prepare (spec);
 
     update();
     reset();
@@ -86,8 +99,7 @@ void NoiseGate<SampleType>::prepare (const ProcessSpec& spec)
 template <typename SampleType>
 void NoiseGate<SampleType>::reset()
 {
-    RMSFilter.reset();
-    envelopeFilter.reset();
+    dynamics.reset();
 }
 
 //==============================================================================
@@ -95,10 +107,10 @@ template <typename SampleType>
 SampleType NoiseGate<SampleType>::processSample (int channel, SampleType sample)
 {
     // RMS ballistics filter
-    auto env = RMSFilter.processSample (channel, sample);
+    auto env = dynamics.getRMSFilter().processSample (channel, sample);
 
     // Ballistics filter
-    env = envelopeFilter.processSample (channel, env);
+    env = dynamics.getEnvelopeFilter().processSample (channel, env);
 
     // VCA
     auto gain = (env > threshold) ? static_cast<SampleType> (1.0)
@@ -115,8 +127,9 @@ void NoiseGate<SampleType>::update()
     thresholdInverse = static_cast<SampleType> (1.0) / threshold;
     currentRatio = ratio;
 
-    envelopeFilter.setAttackTime  (attackTime);
-    envelopeFilter.setReleaseTime (releaseTime);
+    dynamics.setGainCurve (thresholddB, currentRatio - static_cast<SampleType> (1.0), false);
+    dynamics.getEnvelopeFilter().setAttackTime  (attackTime);
+    dynamics.getEnvelopeFilter().setReleaseTime (releaseTime);
 }
 
 //==============================================================================
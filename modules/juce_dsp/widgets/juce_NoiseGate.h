@@ -53,6 +53,24 @@ public:
     /** Sets the release time in milliseconds of the noise-gate.*/
     void setRelease (SampleType newRelease);
 
+    /** Sets the lookahead time in milliseconds of the noise-gate, up to 20 ms.
+
+        The audio is delayed by the lookahead time, so that the gain can react to a
+        transient before it reaches the output. This adds latency, which you can find
+        with getLatencyInSamples(). It only applies to the process() methods, not to
+        processSample().
+    */
+    void setLookahead (SampleType newLookahead);
+
+    /** Enables or disables channel linking. When the channels are linked, they're all
+        driven by the loudest one, so that they get the same gain. This only applies
+        to the process() methods, not to processSample().
+    */
+    void setChannelLinking (bool shouldBeLinked);
+
+    /** Returns the latency added by the lookahead, in samples. */
+    int getLatencyInSamples() const noexcept        { return dynamics.getLatencyInSamples(); }
+
     //==============================================================================
     /** Initialises the processor. */
     void prepare (const ProcessSpec& spec);
@@ -64,29 +82,36 @@ public:
     /** Processes the input and output samples supplied in the processing context. */
     template <typename ProcessContext>
     void process (const ProcessContext& context) noexcept
+    {
+        process (context, context.getInputBlock());
+    }
+
+    /** Processes the input and output samples supplied in the processing context,
+        using a separate block to drive the detector.
+
+        Each output channel is controlled by the sidechain channel with the same index,
+        wrapping round if the sidechain has fewer channels (so a mono sidechain controls
+        every channel), or by the loudest sidechain channel when the channels are linked.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context, const AudioBlock<const SampleType>& sidechainBlock) noexcept
     {
         const auto& inputBlock = context.getInputBlock();
         auto& outputBlock      = context.getOutputBlock();
-        const auto numChannels = outputBlock.getNumChannels();
-        const auto numSamples  = outputBlock.getNumSamples();
+        [[maybe_unused]] const auto numChannels = outputBlock.getNumChannels();
+        [[maybe_unused]] const auto numSamples  = outputBlock.getNumSamples();
 
         jassert (inputBlock.getNumChannels() == numChannels);
         jassert (inputBlock.getNumSamples() == numSamples);
 
         if (context.isBypassed)
         {
-            outputBlock.copyFrom (inputBlock);
+            // The audio still goes through the lookahead delay, so the latency doesn't change
+            dynamics.processBypassed (inputBlock, outputBlock);
             return;
         }
 
-        for (size_t channel = 0; channel < numChannels; ++channel)
-        {
-            auto* inputSamples  = inputBlock .getChannelPointer (channel);
-            auto* outputSamples = outputBlock.getChannelPointer (channel);
-
-            for (size_t i = 0; i < numSamples; ++i)
-                outputSamples[i] = processSample ((int) channel, inputSamples[i]);
-        }
+        dynamics.process (inputBlock, outputBlock, sidechainBlock);
     }
 
     /** Performs the processing operation on a single sample at a time. */
@@ -98,7 +123,7 @@ private:
 
     //==============================================================================
     SampleType threshold, thresholdInverse, currentRatio;
-    BallisticsFilter<SampleType> envelopeFilter, RMSFilter;
+    detail::DynamicsBlockProcessor<SampleType> dynamics;
 
     double sampleRate = 44100.0;
     SampleType thresholddB = -100, ratio = 10.0, attackTime = 1.0, releaseTime = 100.0;
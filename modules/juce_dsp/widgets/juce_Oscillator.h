@@ -140,98 +140,73 @@ public:
         if (context.isBypassed)
             context.getOutputBlock().clear();
 
+        // The waveform is calculated once into the ramp buffer, and then added to each channel
+        auto* buffer = rampBuffer.getRawDataPointer();
+
         if (frequency.isSmoothing())
         {
-            auto* buffer = rampBuffer.getRawDataPointer();
-
             for (size_t i = 0; i < len; ++i)
                 buffer[i] = phase.advance (baseIncrement * frequency.getNextValue())
                               - MathConstants<NumericType>::pi;
-
-            if (! context.isBypassed)
-            {
-                size_t ch;
-
-                if (context.usesSeparateInputAndOutputBlocks())
-                {
-                    for (ch = 0; ch < jmin (numChannels, inputChannels); ++ch)
-                    {
-                        auto* dst = outBlock.getChannelPointer (ch);
-                        auto* src = inBlock.getChannelPointer (ch);
-
-                        for (size_t i = 0; i < len; ++i)
-                            dst[i] = src[i] + generator (buffer[i]);
-                    }
-                }
-                else
-                {
-                    for (ch = 0; ch < jmin (numChannels, inputChannels); ++ch)
-                    {
-                        auto* dst = outBlock.getChannelPointer (ch);
-
-                        for (size_t i = 0; i < len; ++i)
-                            dst[i] += generator (buffer[i]);
-                    }
-                }
-
-                for (; ch < numChannels; ++ch)
-                {
-                    auto* dst = outBlock.getChannelPointer (ch);
-
-                    for (size_t i = 0; i < len; ++i)
-                        dst[i] = generator (buffer[i]);
-                }
-            }
         }
         else
         {
             auto freq = baseIncrement * frequency.getNextValue();
-            auto p = phase;
 
             if (context.isBypassed)
             {
                 frequency.skip (static_cast<int> (len));
-                p.advance (freq * static_cast<NumericType> (len));
+                phase.advance (freq * static_cast<NumericType> (len));
+                return;
+            }
+
+            for (size_t i = 0; i < len; ++i)
+                buffer[i] = phase.advance (freq) - MathConstants<NumericType>::pi;
+        }
+
+        if (context.isBypassed)
+            return;
+
+        if (lookupTable != nullptr)
+        {
+            lookupTable->process (buffer, buffer, len);
+        }
+        else
+        {
+            for (size_t i = 0; i < len; ++i)
+                buffer[i] = generator (buffer[i]);
+        }
+
+        size_t ch;
+
+        if (context.usesSeparateInputAndOutputBlocks())
+        {
+            for (ch = 0; ch < jmin (numChannels, inputChannels); ++ch)
+            {
+                auto* dst = outBlock.getChannelPointer (ch);
+                auto* src = inBlock.getChannelPointer (ch);
+
+                for (size_t i = 0; i < len; ++i)
+                    dst[i] = src[i] + buffer[i];
             }
-            else
+        }
+        else
+        {
+            for (ch = 0; ch < jmin (numChannels, inputChannels); ++ch)
             {
-                size_t ch;
-
-                if (context.usesSeparateInputAndOutputBlocks())
-                {
-                    for (ch = 0; ch < jmin (numChannels, inputChannels); ++ch)
-                    {
-                        p = phase;
-                        auto* dst = outBlock.getChannelPointer (ch);
-                        auto* src = inBlock.getChannelPointer (ch);
-
-                        for (size_t i = 0; i < len; ++i)
-                            dst[i] = src[i] + generator (p.advance (freq) - MathConstants<NumericType>::pi);
-                    }
-                }
-                else
-                {
-                    for (ch = 0; ch < jmin (numChannels, inputChannels); ++ch)
-                    {
-                        p = phase;
-                        auto* dst = outBlock.getChannelPointer (ch);
-
-                        for (size_t i = 0; i < len; ++i)
-                            dst[i] += generator (p.advance (freq) - MathConstants<NumericType>::pi);
-                    }
-                }
-
-                for (; ch < numChannels; ++ch)
-                {
-                    p = phase;
-                    auto* dst = outBlock.getChannelPointer (ch);
-
-                    for (size_t i = 0; i < len; ++i)
-                        dst[i] = generator (p.advance (freq) - MathConstants<NumericType>::pi);
-                }
+                auto* dst = outBlock.getChannelPointer (ch);
+
+                for (size_t i = 0; i < len; ++i)
+                    dst[i] += buffer[i];
             }
+        }
+
+        for (; ch < numChannels; ++ch)
+        {
+            auto* dst = outBlock.getChannelPointer (ch);
 
-            phase = p;
+            for (size_t i = 0; i < len; ++i)
+                dst[i] = buffer[i];
         }
     }
 
@@ -0,0 +1,466 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+//==============================================================================
+// These let the rendering code be written once for both SIMDRegisters and plain
+// numbers, for platforms without SIMD support.
+#if JUCE_USE_SIMD
+template <typename Type>
+static SIMDRegister<Type> wrapWavetablePhase (SIMDRegister<Type> phase) noexcept
+{
+    using Lanes = SIMDRegister<Type>;
+    const auto wrapped = phase - Lanes::truncate (phase);
+    return wrapped + (Lanes::expand ((Type) 1) & Lanes::lessThan (wrapped, Lanes::expand ((Type) 0)));
+}
+
+template <typename Type> static Type getWavetableLane (SIMDRegister<Type> lanes, size_t index) noexcept     { return lanes.get (index); }
+template <typename Type> static void setWavetableLane (SIMDRegister<Type>& lanes, size_t index, Type value) noexcept   { lanes.set (index, value); }
+template <typename Type> static Type sumWavetableLanes (SIMDRegister<Type> lanes) noexcept    { return lanes.sum(); }
+#endif
+
+template <typename Type> static Type wrapWavetablePhase (Type phase) noexcept          { return phase - std::floor (phase); }
+template <typename Type> static Type getWavetableLane (Type value, size_t) noexcept     { return value; }
+template <typename Type> static void setWavetableLane (Type& lanes, size_t, Type value) noexcept   { lanes = value; }
+template <typename Type> static Type sumWavetableLanes (Type value) noexcept            { return value; }
+
+//==============================================================================
+template <typename SampleType>
+WavetableOscillatorBank<SampleType>::WavetableOscillatorBank()
+{
+    setNumVoices (1);
+}
+
+template <typename SampleType>
+WavetableOscillatorBank<SampleType>::WavetableOscillatorBank (const std::function<SampleType (SampleType)>& function,
+                                                              size_t newTableSize)
+    : WavetableOscillatorBank()
+{
+    initialise (function, newTableSize);
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::initialise (const std::function<SampleType (SampleType)>& function,
+                                                      size_t newTableSize)
+{
+    jassert (isPowerOfTwo (newTableSize) && newTableSize >= 8);
+
+    std::vector<SampleType> singleCycle (newTableSize);
+
+    for (size_t i = 0; i < newTableSize; ++i)
+        singleCycle[i] = function (MathConstants<SampleType>::twoPi * (SampleType) i / (SampleType) newTableSize
+                                     - MathConstants<SampleType>::pi);
+
+    buildTables (std::move (singleCycle));
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::initialise (const SampleType* singleCycle, size_t numSamples)
+{
+    jassert (isPowerOfTwo (numSamples) && numSamples >= 8);
+
+    buildTables ({ singleCycle, singleCycle + numSamples });
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::buildTables (std::vector<SampleType> singleCycle)
+{
+    tableSize = singleCycle.size();
+
+    // Linear interpolation is only accurate for harmonics well below the table's own
+    // Nyquist frequency, so the lowest table holds a quarter of the table size, and
+    // each table above it holds half as many harmonics as the one before.
+    maxHarmonic = (int) tableSize / 4;
+    numTables = 1;
+
+    while ((maxHarmonic >> numTables) > 0)
+        ++numTables;
+
+    const auto stride = tableSize + 2;
+    tables.assign (stride * (size_t) numTables, {});
+
+    FFT fft (roundToInt (std::log2 ((double) tableSize)));
+    std::vector<Complex<float>> spectrum (tableSize), bandLimited (tableSize), result (tableSize);
+
+    for (size_t i = 0; i < tableSize; ++i)
+        bandLimited[i] = { (float) singleCycle[i], 0.0f };
+
+    fft.perform (bandLimited.data(), spectrum.data(), false);
+
+    for (int index = 0; index < numTables; ++index)
+    {
+        const auto numHarmonics = (size_t) (maxHarmonic >> index);
+
+        std::fill (bandLimited.begin(), bandLimited.end(), Complex<float>());
+        bandLimited[0] = spectrum[0];
+
+        for (size_t harmonic = 1; harmonic <= numHarmonics; ++harmonic)
+        {
+            bandLimited[harmonic] = spectrum[harmonic];
+            bandLimited[tableSize - harmonic] = spectrum[tableSize - harmonic];
+        }
+
+        fft.perform (bandLimited.data(), result.data(), true);
+
+        auto* table = tables.data() + stride * (size_t) index;
+
+        for (size_t i = 0; i < tableSize; ++i)
+            table[i] = (SampleType) result[i].real();
+
+        // Two extra points let the interpolation run off the end without wrapping
+        table[tableSize]     = table[0];
+        table[tableSize + 1] = table[1];
+    }
+
+    for (int voice = 0; voice < numVoices; ++voice)
+        updateIncrement (voice);
+}
+
+template <typename SampleType>
+int WavetableOscillatorBank<SampleType>::getTableIndex (SampleType increment) const noexcept
+{
+    // Use the table with the most harmonics that all stay below Nyquist
+    const auto numHarmonicsAllowed = (SampleType) 0.5 / jmax (std::abs (increment), std::numeric_limits<SampleType>::min());
+    int index = 0;
+
+    while (index < numTables - 1 && (SampleType) (maxHarmonic >> index) > numHarmonicsAllowed)
+        ++index;
+
+    return index;
+}
+
+//==============================================================================
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::setNumVoices (int newNumVoices)
+{
+    jassert (newNumVoices > 0);
+
+    numVoices = jmax (1, newNumVoices);
+    numGroups = ((size_t) numVoices + numLanes - 1) / numLanes;
+
+    frequencies.assign ((size_t) numVoices, (SampleType) 440);
+    gains.assign ((size_t) numVoices, (SampleType) 1);
+    pans.assign ((size_t) numVoices, (SampleType) 0);
+
+    // The lanes past the last voice are left silent
+    state = AudioBlock<Lanes> (stateMemory, numStateChannels, numGroups);
+    state.clear();
+
+    modulationPointers.resize (numGroups * numLanes * 2);
+
+    for (int voice = 0; voice < numVoices; ++voice)
+    {
+        updateIncrement (voice);
+        updateGains (voice);
+    }
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::setFrequency (int voice, SampleType newFrequencyHz) noexcept
+{
+    jassert (isPositiveAndBelow (voice, numVoices));
+
+    frequencies[(size_t) voice] = newFrequencyHz;
+    updateIncrement (voice);
+}
+
+template <typename SampleType>
+SampleType WavetableOscillatorBank<SampleType>::getFrequency (int voice) const noexcept
+{
+    jassert (isPositiveAndBelow (voice, numVoices));
+    return frequencies[(size_t) voice];
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::setPhase (int voice, SampleType newPhase) noexcept
+{
+    jassert (isPositiveAndBelow (voice, numVoices));
+
+    const auto v = (size_t) voice;
+    setWavetableLane (state.getChannelPointer (phaseChannel)[v / numLanes], v % numLanes,
+                      wrapWavetablePhase (newPhase / MathConstants<SampleType>::twoPi));
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::setGain (int voice, SampleType newGain) noexcept
+{
+    jassert (isPositiveAndBelow (voice, numVoices));
+
+    gains[(size_t) voice] = newGain;
+    updateGains (voice);
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::setPan (int voice, SampleType newPan) noexcept
+{
+    jassert (isPositiveAndBelow (voice, numVoices));
+    jassert (newPan >= (SampleType) -1 && newPan <= (SampleType) 1);
+
+    pans[(size_t) voice] = jlimit ((SampleType) -1, (SampleType) 1, newPan);
+    updateGains (voice);
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::updateIncrement (int voice) noexcept
+{
+    const auto v = (size_t) voice;
+    setWavetableLane (state.getChannelPointer (incrementChannel)[v / numLanes], v % numLanes,
+                      (SampleType) (frequencies[v] / sampleRate));
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::updateGains (int voice) noexcept
+{
+    const auto v = (size_t) voice;
+    const auto group = v / numLanes, lane = v % numLanes;
+    const auto angle = (pans[v] + (SampleType) 1) * MathConstants<SampleType>::pi / (SampleType) 4;
+
+    setWavetableLane (state.getChannelPointer (monoGainChannel)[group],  lane, gains[v]);
+    setWavetableLane (state.getChannelPointer (leftGainChannel)[group],  lane, gains[v] * std::cos (angle));
+    setWavetableLane (state.getChannelPointer (rightGainChannel)[group], lane, gains[v] * std::sin (angle));
+}
+
+//==============================================================================
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0);
+
+    sampleRate = spec.sampleRate;
+    maximumBlockSize = (size_t) spec.maximumBlockSize;
+
+    scratch = AudioBlock<Lanes> (scratchMemory, numScratchChannels, maximumBlockSize);
+    silence.assign (maximumBlockSize, {});
+
+    for (int voice = 0; voice < numVoices; ++voice)
+        updateIncrement (voice);
+
+    reset();
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::reset() noexcept
+{
+    state.getSingleChannelBlock (phaseChannel).clear();
+}
+
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::advance (size_t numSamples) noexcept
+{
+    auto* phases = state.getChannelPointer (phaseChannel);
+    const auto* increments = state.getChannelPointer (incrementChannel);
+
+    for (size_t group = 0; group < numGroups; ++group)
+        phases[group] = wrapWavetablePhase (phases[group] + increments[group] * (SampleType) numSamples);
+}
+
+//==============================================================================
+template <typename SampleType>
+void WavetableOscillatorBank<SampleType>::render (const AudioBlock<SampleType>& output,
+                                                  const AudioBlock<const SampleType>& frequencyModulation,
+                                                  const AudioBlock<const SampleType>& phaseModulation) noexcept
+{
+    jassert (isInitialised());
+    jassert (maximumBlockSize > 0); // you need to call prepare() first!
+
+    const auto frequencyModulated = frequencyModulation.getNumChannels() > 0;
+    const auto phaseModulated     = phaseModulation.getNumChannels() > 0;
+
+    // The modulation blocks need a channel for each voice, and must be at least as
+    // long as the output
+    jassert (! frequencyModulated || (frequencyModulation.getNumChannels() >= (size_t) numVoices
+                                       && frequencyModulation.getNumSamples() >= output.getNumSamples()));
+    jassert (! phaseModulated || (phaseModulation.getNumChannels() >= (size_t) numVoices
+                                   && phaseModulation.getNumSamples() >= output.getNumSamples()));
+
+    const auto stereo = output.getNumChannels() > 1;
+
+    if (output.getNumChannels() == 0 || ! isInitialised() || maximumBlockSize == 0)
+    {
+        advance (output.getNumSamples());
+        return;
+    }
+
+    auto* frequencyPointers = modulationPointers.data();
+    auto* phasePointers = frequencyPointers + numGroups * numLanes;
+
+    for (size_t start = 0; start < output.getNumSamples(); start += maximumBlockSize)
+    {
+        const auto numSamples = jmin (maximumBlockSize, output.getNumSamples() - start);
+
+        for (size_t voice = 0; voice < numGroups * numLanes; ++voice)
+        {
+            const auto isVoice = voice < (size_t) numVoices;
+
+            frequencyPointers[voice] = frequencyModulated && isVoice ? frequencyModulation.getChannelPointer (voice) + start
+                                                                     : silence.data();
+            phasePointers[voice]     = phaseModulated && isVoice ? phaseModulation.getChannelPointer (voice) + start
+                                                                 : silence.data();
+        }
+
+        scratch.getSubsetChannelBlock (firstOutputChannel, 2).getSubBlock (0, numSamples).clear();
+
+        const auto* gainsToCheck = state.getChannelPointer (monoGainChannel);
+
+        for (size_t group = 0; group < numGroups; ++group)
+        {
+            auto isSilent = true;
+
+            for (size_t lane = 0; lane < numLanes; ++lane)
+                isSilent = isSilent && exactlyEqual (getWavetableLane (gainsToCheck[group], lane), (SampleType) 0);
+
+            if (isSilent)
+            {
+                auto& phase = state.getChannelPointer (phaseChannel)[group];
+                phase = wrapWavetablePhase (phase + state.getChannelPointer (incrementChannel)[group] * (SampleType) numSamples);
+                continue;
+            }
+
+            const auto* groupFrequency = frequencyPointers + group * numLanes;
+            const auto* groupPhase = phasePointers + group * numLanes;
+
+            if (frequencyModulated && phaseModulated)  renderGroup<true,  true>  (group, numSamples, stereo, groupFrequency, groupPhase);
+            else if (frequencyModulated)               renderGroup<true,  false> (group, numSamples, stereo, groupFrequency, groupPhase);
+            else if (phaseModulated)                   renderGroup<false, true>  (group, numSamples, stereo, groupFrequency, groupPhase);
+            else                                       renderGroup<false, false> (group, numSamples, stereo, groupFrequency, groupPhase);
+        }
+
+        for (size_t channel = 0; channel < (stereo ? 2 : 1); ++channel)
+        {
+            const auto* src = scratch.getChannelPointer (channel);
+            auto* dst = output.getChannelPointer (channel) + start;
+
+            for (size_t i = 0; i < numSamples; ++i)
+                dst[i] += sumWavetableLanes (src[i]);
+        }
+    }
+}
+
+template <typename SampleType>
+template <bool frequencyModulated, bool phaseModulated>
+void WavetableOscillatorBank<SampleType>::renderGroup (size_t group, size_t numSamples, bool stereo,
+                                                       const SampleType* const* frequencyModulation,
+                                                       const SampleType* const* phaseModulation) noexcept
+{
+    const auto stride = tableSize + 2;
+    const SampleType* laneTables[numLanes];
+
+    auto phase = state.getChannelPointer (phaseChannel)[group];
+    const auto increment = state.getChannelPointer (incrementChannel)[group];
+
+    for (size_t lane = 0; lane < numLanes; ++lane)
+        laneTables[lane] = tables.data() + stride * (size_t) getTableIndex (getWavetableLane (increment, lane));
+
+    auto* positions   = scratch.getChannelPointer (positionChannel);
+    auto* lowerValues = scratch.getChannelPointer (lowerChannel);
+    auto* upperValues = scratch.getChannelPointer (upperChannel);
+    auto* modulation  = scratch.getChannelPointer (modulationChannel);
+
+    // Reading and writing the lanes of a register one at a time is slow, so the
+    // rendering is split into passes. The first and last work on whole registers,
+    // and the table lookups in between work on the same memory as plain numbers.
+    auto* rawPositions   = reinterpret_cast<SampleType*> (positions);
+    auto* rawLowerValues = reinterpret_cast<SampleType*> (lowerValues);
+    auto* rawUpperValues = reinterpret_cast<SampleType*> (upperValues);
+    auto* rawModulation  = reinterpret_cast<SampleType*> (modulation);
+
+    const auto size = (SampleType) tableSize;
+
+    if constexpr (frequencyModulated)
+    {
+        const auto hzToIncrement = (SampleType) (1.0 / sampleRate);
+
+        for (size_t lane = 0; lane < numLanes; ++lane)
+            for (size_t i = 0; i < numSamples; ++i)
+                rawModulation[i * numLanes + lane] = frequencyModulation[lane][i];
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            positions[i] = phase;
+            phase = wrapWavetablePhase (phase + increment + modulation[i] * hzToIncrement);
+        }
+    }
+    else
+    {
+        // Without frequency modulation, each sample's phase can be worked out directly,
+        // which avoids a long chain of dependent operations
+        for (size_t i = 0; i < numSamples; ++i)
+            positions[i] = phase + increment * (SampleType) i;
+
+        phase = wrapWavetablePhase (phase + increment * (SampleType) numSamples);
+    }
+
+    if constexpr (phaseModulated)
+    {
+        const auto radiansToCycles = (SampleType) 1 / MathConstants<SampleType>::twoPi;
+
+        for (size_t lane = 0; lane < numLanes; ++lane)
+            for (size_t i = 0; i < numSamples; ++i)
+                rawModulation[i * numLanes + lane] = phaseModulation[lane][i];
+
+        for (size_t i = 0; i < numSamples; ++i)
+            positions[i] += modulation[i] * radiansToCycles;
+    }
+
+    for (size_t i = 0; i < numSamples; ++i)
+        positions[i] = wrapWavetablePhase (positions[i]) * size;
+
+    state.getChannelPointer (phaseChannel)[group] = phase;
+
+    for (size_t i = 0; i < numSamples * numLanes; i += numLanes)
+    {
+        for (size_t lane = 0; lane < numLanes; ++lane)
+        {
+            const auto position = rawPositions[i + lane];
+            const auto index = (int) position;
+
+            rawPositions[i + lane]   = position - (SampleType) index;
+            rawLowerValues[i + lane] = laneTables[lane][index];
+            rawUpperValues[i + lane] = laneTables[lane][index + 1];
+        }
+    }
+
+    const auto firstGain  = state.getChannelPointer (stereo ? leftGainChannel : monoGainChannel)[group];
+    const auto secondGain = state.getChannelPointer (rightGainChannel)[group];
+    auto* firstOutput  = scratch.getChannelPointer (firstOutputChannel);
+    auto* secondOutput = scratch.getChannelPointer (secondOutputChannel);
+
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        const auto sample = lowerValues[i] + (upperValues[i] - lowerValues[i]) * positions[i];
+        firstOutput[i] += sample * firstGain;
+
+        if (stereo)
+            secondOutput[i] += sample * secondGain;
+    }
+}
+
+//==============================================================================
+template class WavetableOscillatorBank<float>;
+template class WavetableOscillatorBank<double>;
+
+} // namespace juce::dsp
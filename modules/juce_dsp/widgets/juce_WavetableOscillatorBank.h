@@ -0,0 +1,253 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+/**
+    A bank of band-limited wavetable oscillators that all play the same waveform.
+
+    Unlike Oscillator, which calls a function for every sample, the waveform is
+    rendered once into a set of tables, one per octave, each containing only the
+    harmonics that can be played in that octave without aliasing. Each voice reads
+    from the table that suits its frequency, using linear interpolation.
+
+    The voices are processed in groups, with one voice in each lane of a
+    SIMDRegister, and are mixed together into a mono or stereo output, with a
+    separate gain and pan for each voice. This makes it practical to run hundreds of
+    oscillators at once, e.g. for supersaw or pad sounds.
+
+    Each voice can also be given a per-sample frequency and phase modulation signal,
+    which is passed to the process() call.
+
+    The tables are band-limited using the single-precision FFT class, so a
+    WavetableOscillatorBank<double> still only holds its waveform to float precision.
+
+    @see Oscillator
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class WavetableOscillatorBank
+{
+public:
+    //==============================================================================
+    /** Creates an uninitialised oscillator bank. Call initialise before first use. */
+    WavetableOscillatorBank();
+
+    /** Creates an oscillator bank with a periodic input function (-pi..pi), which
+        is sampled into a table of the given size. The size must be a power of 2.
+    */
+    WavetableOscillatorBank (const std::function<SampleType (SampleType)>& function,
+                             size_t tableSize = 2048);
+
+    /** Returns true if the waveform has been initialised. */
+    bool isInitialised() const noexcept             { return ! tables.empty(); }
+
+    /** Initialises the waveform with a periodic function (-pi..pi), which is sampled
+        into a table of the given size. The size must be a power of 2.
+
+        This allocates memory and builds the tables, so don't call it from the audio
+        thread.
+    */
+    void initialise (const std::function<SampleType (SampleType)>& function,
+                     size_t tableSize = 2048);
+
+    /** Initialises the waveform with one cycle of a signal. The number of samples
+        must be a power of 2, and becomes the size of the tables.
+
+        This allocates memory and builds the tables, so don't call it from the audio
+        thread.
+    */
+    void initialise (const SampleType* singleCycle, size_t numSamples);
+
+    /** Returns the number of samples in each table. */
+    size_t getTableSize() const noexcept            { return tableSize; }
+
+    /** Returns the number of band-limited tables, one per octave. */
+    int getNumTables() const noexcept               { return numTables; }
+
+    //==============================================================================
+    /** Sets the number of voices. Any previous voice settings are lost.
+
+        This allocates memory, so don't call it from the audio thread.
+    */
+    void setNumVoices (int newNumVoices);
+
+    /** Returns the number of voices. */
+    int getNumVoices() const noexcept               { return numVoices; }
+
+    /** Sets the frequency of a voice in Hz. */
+    void setFrequency (int voice, SampleType newFrequencyHz) noexcept;
+
+    /** Returns the frequency of a voice in Hz. */
+    SampleType getFrequency (int voice) const noexcept;
+
+    /** Sets the current phase of a voice in radians, where 0 is the start of the cycle. */
+    void setPhase (int voice, SampleType newPhase) noexcept;
+
+    /** Sets the linear gain of a voice. Voices with a gain of 0 cost very little. */
+    void setGain (int voice, SampleType newGain) noexcept;
+
+    /** Sets the position of a voice in the stereo field, from -1 (left) to 1 (right).
+        A constant-power pan law is used.
+    */
+    void setPan (int voice, SampleType newPan) noexcept;
+
+    //==============================================================================
+    /** Called before processing starts. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the phases of all the voices to 0. */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Adds the output of all the voices to the buffers supplied in the processing
+        context.
+
+        If the output block has one channel, the voices are mixed to mono and their
+        pan is ignored. Otherwise they are mixed into the first two channels.
+
+        If the context is bypassed, the input is passed through unchanged and the
+        voices' phases are advanced without being rendered.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        process (context, {}, {});
+    }
+
+    /** Adds the output of all the voices to the buffers supplied in the processing
+        context, applying some modulation.
+
+        @param context              the processing context
+        @param frequencyModulation  either an empty block, or a block with a channel for
+                                    each voice, containing a value in Hz to add to the
+                                    voice's frequency at each sample. Negative frequencies
+                                    are allowed, so this can be used for through-zero FM.
+        @param phaseModulation      either an empty block, or a block with a channel for
+                                    each voice, containing an offset in radians to add to
+                                    the voice's phase at each sample.
+
+        The table used for each voice is chosen once per block from its unmodulated
+        frequency, so very deep frequency modulation can alias.
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context,
+                  const AudioBlock<const SampleType>& frequencyModulation,
+                  const AudioBlock<const SampleType>& phaseModulation) noexcept
+    {
+        static_assert (std::is_same_v<typename ProcessContext::SampleType, SampleType>,
+                       "The sample-type of the oscillator bank must match the sample-type supplied to this process callback");
+
+        auto&& outBlock = context.getOutputBlock();
+        auto&& inBlock  = context.getInputBlock();
+        const auto numSamples = outBlock.getNumSamples();
+
+        if (context.usesSeparateInputAndOutputBlocks())
+        {
+            const auto numInputChannels = jmin (inBlock.getNumChannels(), outBlock.getNumChannels());
+
+            outBlock.getSubsetChannelBlock (0, numInputChannels).copyFrom (inBlock.getSubsetChannelBlock (0, numInputChannels));
+
+            if (numInputChannels < outBlock.getNumChannels())
+                outBlock.getSubsetChannelBlock (numInputChannels, outBlock.getNumChannels() - numInputChannels).clear();
+        }
+
+        if (context.isBypassed)
+        {
+            advance (numSamples);
+            return;
+        }
+
+        render (outBlock, frequencyModulation, phaseModulation);
+    }
+
+private:
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using Lanes = SIMDRegister<SampleType>;
+   #else
+    using Lanes = SampleType;
+   #endif
+
+    static constexpr size_t numLanes = sizeof (Lanes) / sizeof (SampleType);
+
+    enum StateChannel
+    {
+        phaseChannel,
+        incrementChannel,
+        monoGainChannel,
+        leftGainChannel,
+        rightGainChannel,
+        numStateChannels
+    };
+
+    enum ScratchChannel
+    {
+        firstOutputChannel,
+        secondOutputChannel,
+        positionChannel,
+        lowerChannel,
+        upperChannel,
+        modulationChannel,
+        numScratchChannels
+    };
+
+    void buildTables (std::vector<SampleType> singleCycle);
+    int getTableIndex (SampleType increment) const noexcept;
+    void updateIncrement (int voice) noexcept;
+    void updateGains (int voice) noexcept;
+    void advance (size_t numSamples) noexcept;
+    void render (const AudioBlock<SampleType>& output,
+                 const AudioBlock<const SampleType>& frequencyModulation,
+                 const AudioBlock<const SampleType>& phaseModulation) noexcept;
+
+    template <bool frequencyModulated, bool phaseModulated>
+    void renderGroup (size_t group, size_t numSamples, bool stereo,
+                      const SampleType* const* frequencyModulation,
+                      const SampleType* const* phaseModulation) noexcept;
+
+    //==============================================================================
+    std::vector<SampleType> tables;
+    size_t tableSize = 0;
+    int numTables = 0, maxHarmonic = 0;
+
+    int numVoices = 0;
+    size_t numGroups = 0;
+    std::vector<SampleType> frequencies, gains, pans;
+
+    HeapBlock<char> stateMemory, scratchMemory;
+    AudioBlock<Lanes> state, scratch;
+    std::vector<SampleType> silence;
+    std::vector<const SampleType*> modulationPointers;
+
+    double sampleRate = 44100.0;
+    size_t maximumBlockSize = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WavetableOscillatorBank)
+};
+
+} // namespace juce::dsp
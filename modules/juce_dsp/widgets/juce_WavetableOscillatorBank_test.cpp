@@ -0,0 +1,229 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2022 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 7 End-User License
+   Agreement and JUCE Privacy Policy.
+
+   End User License Agreement: www.juce.com/juce-7-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+class WavetableOscillatorBankTests final : public UnitTest
+{
+public:
+    WavetableOscillatorBankTests()
+        : UnitTest ("WavetableOscillatorBank", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int blockSize = 256;
+        const auto sine = [] (double x) { return std::sin (x); };
+        const auto saw  = [] (double x) { return x / MathConstants<double>::pi; };
+
+        beginTest ("A sine wave is reproduced accurately");
+        {
+            WavetableOscillatorBank<double> bank (sine);
+            bank.setFrequency (0, 1000.0);
+            bank.prepare ({ sampleRate, (uint32) blockSize, 1 });
+
+            Oscillator<double> reference (sine);
+            reference.setFrequency (1000.0, true);
+            reference.prepare ({ sampleRate, 1000, 1 });
+
+            const auto output = render (bank, 1, 1000);
+
+            AudioBuffer<double> expected (1, 1000);
+            expected.clear();
+            AudioBlock<double> expectedBlock (expected);
+            reference.process (ProcessContextReplacing<double> (expectedBlock));
+
+            for (int i = 0; i < output.getNumSamples(); ++i)
+                expectWithinAbsoluteError (output.getSample (0, i), expected.getSample (0, i), 1.0e-4);
+        }
+
+        beginTest ("The tables don't contain harmonics above Nyquist");
+        {
+            WavetableOscillatorBank<double> bank (saw);
+            bank.prepare ({ sampleRate, (uint32) blockSize, 1 });
+
+            // The 5th harmonic of 5 kHz would alias to 23 kHz
+            bank.setFrequency (0, 5000.0);
+            const auto output = render (bank, 1, 4800);
+
+            const auto fundamental = getMagnitude (output, 5000.0, sampleRate);
+            expectGreaterThan (fundamental, 0.5);
+            expectLessThan (getMagnitude (output, 23000.0, sampleRate), fundamental * 1.0e-3);
+
+            // At lower frequencies, more harmonics are kept
+            bank.setFrequency (0, 500.0);
+            bank.reset();
+            const auto lowOutput = render (bank, 1, 4800);
+            expectGreaterThan (getMagnitude (lowOutput, 15000.0, sampleRate), getMagnitude (lowOutput, 500.0, sampleRate) / 80.0);
+        }
+
+        beginTest ("Voices are mixed and panned");
+        {
+            constexpr int numVoices = 5;
+            WavetableOscillatorBank<float> bank ([] (float x) { return std::sin (x); });
+            bank.setNumVoices (numVoices);
+            bank.prepare ({ sampleRate, (uint32) blockSize, 2 });
+
+            for (int voice = 0; voice < numVoices; ++voice)
+            {
+                bank.setFrequency (voice, 100.0f * (float) (voice + 1));
+                bank.setGain (voice, 0.1f);
+                bank.setPan (voice, voice == numVoices - 1 ? 1.0f : -1.0f);
+            }
+
+            const auto output = render (bank, 2, 1000);
+
+            for (int i = 0; i < output.getNumSamples(); ++i)
+            {
+                const auto time = (double) i / sampleRate;
+                double left = 0.0;
+
+                for (int voice = 0; voice < numVoices - 1; ++voice)
+                    left += 0.1 * std::sin (MathConstants<double>::twoPi * 100.0 * (voice + 1) * time - MathConstants<double>::pi);
+
+                const auto right = 0.1 * std::sin (MathConstants<double>::twoPi * 500.0 * time - MathConstants<double>::pi);
+
+                expectWithinAbsoluteError ((double) output.getSample (0, i), left, 1.0e-4);
+                expectWithinAbsoluteError ((double) output.getSample (1, i), right, 1.0e-4);
+            }
+
+            bank.reset();
+            const auto mono = render (bank, 1, 1000);
+
+            for (int i = 0; i < mono.getNumSamples(); ++i)
+                expectWithinAbsoluteError (mono.getSample (0, i), output.getSample (0, i) + output.getSample (1, i), 1.0e-4f);
+        }
+
+        beginTest ("Frequency and phase modulation are sample-accurate");
+        {
+            WavetableOscillatorBank<double> modulated (sine), unmodulated (sine);
+
+            for (auto* bank : { &modulated, &unmodulated })
+            {
+                bank->setNumVoices (2);
+                bank->setPan (0, -1.0);
+                bank->setPan (1, 1.0);
+                bank->prepare ({ sampleRate, (uint32) blockSize, 2 });
+            }
+
+            modulated.setFrequency (0, 400.0);
+            modulated.setFrequency (1, 1000.0);
+            unmodulated.setFrequency (0, 500.0);
+            unmodulated.setFrequency (1, 1000.0);
+            unmodulated.setPhase (1, MathConstants<double>::pi);
+
+            constexpr int numSamples = 600;
+            AudioBuffer<double> frequencyModulation (2, numSamples), phaseModulation (2, numSamples);
+            frequencyModulation.clear();
+            phaseModulation.clear();
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                frequencyModulation.setSample (0, i, 100.0);
+                phaseModulation.setSample (1, i, MathConstants<double>::pi);
+            }
+
+            AudioBuffer<double> output (2, numSamples), expected (2, numSamples);
+            output.clear();
+            expected.clear();
+
+            AudioBlock<double> outputBlock (output), expectedBlock (expected);
+            modulated.process (ProcessContextReplacing<double> (outputBlock),
+                               AudioBlock<const double> (frequencyModulation),
+                               AudioBlock<const double> (phaseModulation));
+            unmodulated.process (ProcessContextReplacing<double> (expectedBlock));
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    expectWithinAbsoluteError (output.getSample (channel, i), expected.getSample (channel, i), 1.0e-6);
+        }
+
+        beginTest ("Bypassing leaves the output untouched and advances the phase");
+        {
+            WavetableOscillatorBank<double> bypassed (sine), running (sine);
+
+            for (auto* bank : { &bypassed, &running })
+            {
+                bank->setFrequency (0, 1000.0);
+                bank->prepare ({ sampleRate, (uint32) blockSize, 1 });
+            }
+
+            constexpr int numSamples = 100;
+            AudioBuffer<double> output (1, numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+                output.setSample (0, i, (double) i);
+
+            AudioBlock<double> outputBlock (output);
+            ProcessContextReplacing<double> context (outputBlock);
+            context.isBypassed = true;
+            bypassed.process (context);
+
+            for (int i = 0; i < numSamples; ++i)
+                expectEquals (output.getSample (0, i), (double) i);
+
+            render (running, 1, numSamples);
+            const auto bypassedOutput = render (bypassed, 1, numSamples);
+            const auto runningOutput  = render (running, 1, numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+                expectWithinAbsoluteError (bypassedOutput.getSample (0, i), runningOutput.getSample (0, i), 1.0e-9);
+        }
+    }
+
+private:
+    template <typename SampleType>
+    static AudioBuffer<SampleType> render (WavetableOscillatorBank<SampleType>& bank, int numChannels, int numSamples)
+    {
+        AudioBuffer<SampleType> buffer (numChannels, numSamples);
+        buffer.clear();
+
+        // Use uneven block sizes to check that the phase carries on between blocks
+        for (int start = 0, blockSize = 1; start < numSamples; start += blockSize, blockSize = blockSize * 3 + 1)
+        {
+            AudioBlock<SampleType> block (buffer);
+            auto subBlock = block.getSubBlock ((size_t) start, (size_t) jmin (blockSize, numSamples - start));
+            bank.process (ProcessContextReplacing<SampleType> (subBlock));
+        }
+
+        return buffer;
+    }
+
+    static double getMagnitude (const AudioBuffer<double>& buffer, double frequency, double sampleRate)
+    {
+        std::complex<double> sum;
+
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            sum += buffer.getSample (0, i) * std::polar (1.0, -MathConstants<double>::twoPi * frequency * i / sampleRate);
+
+        return std::abs (sum) * 2.0 / buffer.getNumSamples();
+    }
+};
+
+static WavetableOscillatorBankTests wavetableOscillatorBankTests;
+
+} // namespace juce::dsp
@@ -86,18 +86,14 @@ public:
             if (! atoms.isEmpty())
             {
                 auto& lastAtom = atoms.getReference (atoms.size() - 1);
+                auto& first = other.atoms.getReference (0);
 
-                if (! CharacterFunctions::isWhitespace (lastAtom.atomText.getLastCharacter()))
+                if (canBeJoined (lastAtom, first))
                 {
-                    auto& first = other.atoms.getReference (0);
-
-                    if (! CharacterFunctions::isWhitespace (first.atomText[0]))
-                    {
-                        lastAtom.atomText += first.atomText;
-                        lastAtom.numChars = (uint16) (lastAtom.numChars + first.numChars);
-                        lastAtom.width = font.getStringWidthFloat (lastAtom.getText (passwordChar));
-                        ++i;
-                    }
+                    lastAtom.atomText += first.atomText;
+                    lastAtom.numChars = (uint16) (lastAtom.numChars + first.numChars);
+                    lastAtom.width = font.getStringWidthFloat (lastAtom.getText (passwordChar));
+                    ++i;
                 }
             }
 
@@ -108,6 +104,8 @@ public:
                 atoms.add (other.atoms.getReference (i));
                 ++i;
             }
+
+            totalLength += other.totalLength;
         }
     }
 
@@ -127,6 +125,8 @@ public:
                     section2->atoms.add (atoms.getUnchecked (j));
 
                 atoms.removeRange (i, atoms.size());
+                section2->totalLength = totalLength - index;
+                totalLength = index;
                 break;
             }
 
@@ -147,6 +147,8 @@ public:
                     section2->atoms.add (atoms.getUnchecked (j));
 
                 atoms.removeRange (i + 1, atoms.size());
+                section2->totalLength = totalLength - indexToBreakAt;
+                totalLength = indexToBreakAt;
                 break;
             }
 
@@ -156,6 +158,52 @@ public:
         return section2;
     }
 
+    // true if the two atoms would have been a single atom if their text had been parsed together
+    static bool canBeJoined (const TextAtom& first, const TextAtom& second) noexcept
+    {
+        if (first.isNewLine() || second.isNewLine())
+            return false;
+
+        return first.isWhitespace() == second.isWhitespace();
+    }
+
+    // moves all the atoms from the given index onwards into a new section
+    UniformTextSection* splitAtAtom (int atomIndexToBreakAt)
+    {
+        auto* section2 = new UniformTextSection ({}, font, colour, passwordChar);
+        section2->atoms.ensureStorageAllocated (atoms.size() - atomIndexToBreakAt);
+
+        for (int j = atomIndexToBreakAt; j < atoms.size(); ++j)
+        {
+            auto& atom = atoms.getReference (j);
+            section2->atoms.add (atom);
+            section2->totalLength += atom.numChars;
+        }
+
+        atoms.removeRange (atomIndexToBreakAt, atoms.size());
+        totalLength -= section2->totalLength;
+        return section2;
+    }
+
+    // returns the index of the atom which starts at the given character index, or -1
+    int findAtomStartingAt (int charIndex) const noexcept
+    {
+        int index = 0;
+
+        for (int i = 0; i < atoms.size(); ++i)
+        {
+            if (index == charIndex)
+                return i;
+
+            index += atoms.getReference (i).numChars;
+
+            if (index > charIndex)
+                break;
+        }
+
+        return -1;
+    }
+
     void appendAllText (MemoryOutputStream& mo) const
     {
         for (auto& atom : atoms)
@@ -187,12 +235,7 @@ public:
 
     int getTotalLength() const noexcept
     {
-        int total = 0;
-
-        for (auto& atom : atoms)
-            total += atom.numChars;
-
-        return total;
+        return totalLength;
     }
 
     void setFont (const Font& newFont, const juce_wchar passwordCharToUse)
@@ -214,6 +257,8 @@ public:
     juce_wchar passwordChar;
 
 private:
+    int totalLength = 0;
+
     void initialiseAtoms (const String& textToParse)
     {
         auto text = textToParse.getCharPointer();
@@ -266,6 +311,7 @@ private:
             atom.width = (atom.isNewLine() ? 0.0f : font.getStringWidthFloat (atom.getText (passwordChar)));
             atom.numChars = (uint16) numChars;
             atoms.add (atom);
+            totalLength += (int) numChars;
         }
     }
 
@@ -276,7 +322,21 @@ private:
 struct TextEditor::Iterator
 {
     Iterator (const TextEditor& ed)
-      : sections (ed.sections),
+      : Iterator (ed, 0, 0, 0, 0.0f)
+    {
+        lineHeight = ed.currentFont.getHeight();
+    }
+
+    /*  Creates an iterator that starts at the beginning of a paragraph, i.e. at the first
+        atom after a newline. Because nothing before a newline affects the layout of the
+        text that follows it, this produces the same results as iterating from the top.
+    */
+    Iterator (const TextEditor& ed, int sectionToStartAt, int atomToStartAt, int textIndex, float y)
+      : indexInText (textIndex),
+        lineY (y),
+        sections (ed.sections),
+        sectionIndex (sectionToStartAt),
+        atomIndex (atomToStartAt),
         justification (ed.justification),
         bottomRight ((float) ed.getMaximumTextWidth(), (float) ed.getMaximumTextHeight()),
         wordWrapWidth ((float) ed.getWordWrapWidth()),
@@ -286,15 +346,13 @@ struct TextEditor::Iterator
     {
         jassert (wordWrapWidth > 0);
 
-        if (! sections.isEmpty())
+        if (isPositiveAndBelow (sectionIndex, sections.size()))
         {
             currentSection = sections.getUnchecked (sectionIndex);
 
             if (currentSection != nullptr)
                 beginNewLine();
         }
-
-        lineHeight = ed.currentFont.getHeight();
     }
 
     Iterator (const Iterator&) = default;
@@ -335,7 +393,7 @@ struct TextEditor::Iterator
                 {
                     // handle the case where the last atom in a section is actually part of the same
                     // word as the first atom of the next section...
-                    float right = atomRight + lastAtom.width;
+                    float right = (atom == nullptr || atom->isNewLine() ? 0.0f : atomRight) + lastAtom.width;
                     float lineHeight2 = lineHeight;
                     float maxDescent2 = maxDescent;
 
@@ -740,6 +798,317 @@ private:
 };
 
 
+//==============================================================================
+/*  Keeps track of where each paragraph (i.e. each run of text that ends in a newline)
+    starts, along with the height and width of its laid-out text.
+
+    Nothing before a newline affects the layout of the text that follows it, so after
+    an edit only the paragraphs that were touched need laying out again, and an Iterator
+    can be started at the paragraph that contains the index or y position of interest,
+    rather than at the top of the document.
+*/
+struct TextEditor::LayoutCache
+{
+    explicit LayoutCache (const TextEditor& ed)  : owner (ed) {}
+
+    /*  Must be called when anything changes the size of the existing atoms. */
+    void invalidate()           { paragraphsNeedRebuilding = true; }
+
+    /*  Must be called whenever sections are added, removed, split or merged. */
+    void sectionsChanged()      { sectionStartsNeedUpdating = true; }
+
+    /*  Must be called after some text has been inserted or removed, once the sections
+        have been updated. The range is given in terms of the old text.
+    */
+    void textReplaced (int start, int numRemoved, int numInserted)
+    {
+        if (paragraphsNeedRebuilding || paragraphs.empty())
+        {
+            paragraphsNeedRebuilding = true;
+            return;
+        }
+
+        updateSectionStarts();
+
+        const auto first = findParagraphContaining (start);
+        const auto last  = findParagraphContaining (start + numRemoved);
+        const auto regionStart = paragraphs[(size_t) first].start;
+        const auto regionEnd = paragraphs[(size_t) last].start + paragraphs[(size_t) last].length
+                                 + numInserted - numRemoved;
+
+        auto replacements = scanParagraphs (regionStart, regionEnd, last == (int) paragraphs.size() - 1);
+
+        if (replacements.empty())
+        {
+            paragraphsNeedRebuilding = true;
+            return;
+        }
+
+        for (auto i = (size_t) last + 1; i < paragraphs.size(); ++i)
+            paragraphs[i].start += numInserted - numRemoved;
+
+        paragraphs.erase (paragraphs.begin() + first, paragraphs.begin() + last + 1);
+        paragraphs.insert (paragraphs.begin() + first, replacements.begin(), replacements.end());
+        firstParagraphWithInvalidTop = jmin (firstParagraphWithInvalidTop, first);
+    }
+
+    /*  Returns an iterator which will reach the given character index after the fewest steps. */
+    Iterator getIteratorForIndex (int index)
+    {
+        update();
+        auto paragraph = skipEmptyLastParagraph (findParagraphContaining (index));
+        layOutParagraphs (paragraph);
+        return createIterator (paragraph, paragraphs[(size_t) paragraph].top);
+    }
+
+    /*  Returns an iterator which will reach the given y position after the fewest steps. */
+    Iterator getIteratorForY (float y)
+    {
+        update();
+        const auto paragraph = findParagraphForY (y);
+        return createIterator (paragraph, paragraphs[(size_t) paragraph].top);
+    }
+
+    /*  Returns the range of text that covers the lines between two y positions. */
+    Range<int> getTextRangeBetween (float top, float bottom)
+    {
+        update();
+        const auto& first = paragraphs[(size_t) findParagraphForY (top)];
+        const auto& last  = paragraphs[(size_t) findParagraphForY (bottom)];
+        return { first.start, last.start + last.length };
+    }
+
+    /*  Returns the same result as Iterator::getTextRight(). */
+    int getTextRight()
+    {
+        update();
+        layOutParagraphs ((int) paragraphs.size() - 1);
+
+        float right = 0.0f;
+
+        for (auto& p : paragraphs)
+            right = jmax (right, p.right);
+
+        return roundToInt (right);
+    }
+
+private:
+    struct Paragraph
+    {
+        int start = 0, length = 0;
+        float top = 0, height = 0, right = 0;
+        bool needsLayout = true;
+    };
+
+    struct LayoutParameters
+    {
+        explicit LayoutParameters (const TextEditor& ed)
+            : wordWrapWidth ((float) ed.getWordWrapWidth()),
+              maxTextWidth ((float) ed.getMaximumTextWidth()),
+              firstLineHeight (ed.currentFont.getHeight()),
+              lineSpacing (ed.lineSpacing),
+              justification (ed.justification.getFlags()),
+              passwordCharacter (ed.passwordCharacter)
+        {}
+
+        auto tie() const { return std::tie (wordWrapWidth, maxTextWidth, firstLineHeight, lineSpacing, justification, passwordCharacter); }
+        bool operator!= (const LayoutParameters& other) const  { return tie() != other.tie(); }
+
+        float wordWrapWidth, maxTextWidth, firstLineHeight, lineSpacing;
+        int justification;
+        juce_wchar passwordCharacter;
+    };
+
+    const TextEditor& owner;
+    std::vector<Paragraph> paragraphs;
+    std::vector<int> sectionStarts;
+    std::optional<LayoutParameters> parameters;
+    int firstParagraphWithInvalidTop = 0;
+    bool paragraphsNeedRebuilding = true, sectionStartsNeedUpdating = true;
+
+    void update()
+    {
+        updateSectionStarts();
+
+        if (paragraphsNeedRebuilding)
+        {
+            paragraphsNeedRebuilding = false;
+            paragraphs = scanParagraphs (0, owner.getTotalNumChars(), true);
+            firstParagraphWithInvalidTop = 0;
+        }
+
+        const LayoutParameters newParameters (owner);
+
+        if (! parameters.has_value() || *parameters != newParameters)
+        {
+            parameters = newParameters;
+
+            for (auto& p : paragraphs)
+                p.needsLayout = true;
+
+            firstParagraphWithInvalidTop = 0;
+        }
+    }
+
+    void updateSectionStarts()
+    {
+        if (std::exchange (sectionStartsNeedUpdating, false))
+        {
+            sectionStarts.resize ((size_t) owner.sections.size());
+            int index = 0;
+
+            for (int i = 0; i < owner.sections.size(); ++i)
+            {
+                sectionStarts[(size_t) i] = index;
+                index += owner.sections.getUnchecked (i)->getTotalLength();
+            }
+        }
+    }
+
+    // Finds the section and atom that begin at a given character index
+    bool findAtom (int textIndex, int& sectionIndex, int& atomIndex) const
+    {
+        auto found = std::upper_bound (sectionStarts.begin(), sectionStarts.end(), textIndex);
+        sectionIndex = jmax (0, (int) std::distance (sectionStarts.begin(), found) - 1);
+        atomIndex = 0;
+
+        if (sectionIndex >= owner.sections.size())
+            return true;
+
+        auto* section = owner.sections.getUnchecked (sectionIndex);
+        const auto offset = textIndex - sectionStarts[(size_t) sectionIndex];
+
+        if (offset == section->getTotalLength())
+        {
+            ++sectionIndex;
+            return true;
+        }
+
+        atomIndex = section->findAtomStartingAt (offset);
+        return atomIndex >= 0;
+    }
+
+    std::vector<Paragraph> scanParagraphs (int start, int end, bool includeEmptyLastParagraph) const
+    {
+        std::vector<Paragraph> result;
+        int sectionIndex = 0, atomIndex = 0;
+
+        if (! findAtom (start, sectionIndex, atomIndex))
+        {
+            jassertfalse;
+            return result;
+        }
+
+        Paragraph current;
+        current.start = start;
+        auto index = start;
+
+        while (index < end && sectionIndex < owner.sections.size())
+        {
+            auto* section = owner.sections.getUnchecked (sectionIndex);
+
+            if (atomIndex >= section->atoms.size())
+            {
+                ++sectionIndex;
+                atomIndex = 0;
+                continue;
+            }
+
+            auto& atom = section->atoms.getReference (atomIndex++);
+            index += atom.numChars;
+
+            if (atom.isNewLine())
+            {
+                current.length = index - current.start;
+                result.push_back (current);
+                current.start = index;
+            }
+        }
+
+        current.length = index - current.start;
+
+        if (current.length > 0 || includeEmptyLastParagraph)
+            result.push_back (current);
+
+        return result;
+    }
+
+    int findParagraphContaining (int index) const
+    {
+        auto found = std::upper_bound (paragraphs.begin(), paragraphs.end(), index,
+                                       [] (int i, const Paragraph& p) { return i < p.start; });
+
+        return jmax (0, (int) std::distance (paragraphs.begin(), found) - 1);
+    }
+
+    int findParagraphForY (float y)
+    {
+        layOutParagraphs ((int) paragraphs.size() - 1);
+
+        auto found = std::upper_bound (paragraphs.begin(), paragraphs.end(), y,
+                                       [] (float v, const Paragraph& p) { return v < p.top; });
+
+        return skipEmptyLastParagraph (jmax (0, (int) std::distance (paragraphs.begin(), found) - 1));
+    }
+
+    // An empty paragraph can only come after a final newline, and has no atoms to start
+    // an iterator on, so the search has to begin in the paragraph before it.
+    int skipEmptyLastParagraph (int paragraph) const
+    {
+        return (paragraph > 0 && paragraphs[(size_t) paragraph].length == 0) ? paragraph - 1 : paragraph;
+    }
+
+    Iterator createIterator (int paragraph, float top) const
+    {
+        const auto& p = paragraphs[(size_t) paragraph];
+        int sectionIndex = 0, atomIndex = 0;
+
+        if (paragraph == 0 || ! findAtom (p.start, sectionIndex, atomIndex))
+        {
+            jassert (paragraph == 0);
+            return Iterator (owner);
+        }
+
+        return Iterator (owner, sectionIndex, atomIndex, p.start, top);
+    }
+
+    void layOutParagraphs (int lastParagraphNeeded)
+    {
+        for (; firstParagraphWithInvalidTop <= lastParagraphNeeded; ++firstParagraphWithInvalidTop)
+        {
+            auto& p = paragraphs[(size_t) firstParagraphWithInvalidTop];
+
+            if (firstParagraphWithInvalidTop > 0)
+            {
+                auto& previous = paragraphs[(size_t) firstParagraphWithInvalidTop - 1];
+                p.top = previous.top + previous.height;
+            }
+
+            if (p.needsLayout)
+            {
+                p.needsLayout = false;
+                p.height = p.right = 0.0f;
+
+                if (p.length > 0)
+                {
+                    // The paragraph is measured from a y position of zero, so that its height doesn't
+                    // pick up any rounding errors from its position, which may change with later edits
+                    auto i = createIterator (firstParagraphWithInvalidTop, 0.0f);
+                    const auto end = p.start + p.length;
+
+                    while (i.next() && i.indexInText < end)
+                        p.right = jmax (p.right, i.atomRight);
+
+                    p.height = i.lineY;
+                }
+            }
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE (LayoutCache)
+};
+
+
 //==============================================================================
 struct TextEditor::InsertAction final : public UndoableAction
 {
@@ -932,6 +1301,7 @@ namespace TextEditorDefs
 //==============================================================================
 TextEditor::TextEditor (const String& name, juce_wchar passwordChar)
     : Component (name),
+      layoutCache (std::make_unique<LayoutCache> (*this)),
       passwordCharacter (passwordChar)
 {
     setMouseCursor (MouseCursor::IBeamCursor);
@@ -1099,6 +1469,7 @@ void TextEditor::applyFontToAllText (const Font& newFont, bool changeCurrentFont
         uts->colour = overallColour;
     }
 
+    layoutCache->invalidate();
     coalesceSimilarSections();
     checkLayout();
     scrollToMakeSureCursorIsVisible();
@@ -1353,7 +1724,7 @@ void TextEditor::repaintText (Range<int> range)
             return;
         }
 
-        Iterator i (*this);
+        auto i = layoutCache->getIteratorForIndex (range.getStart());
 
         Point<float> anchor;
         auto lh = currentFont.getHeight();
@@ -1467,9 +1838,13 @@ Point<int> TextEditor::getTextOffset() const noexcept
 RectangleList<int> TextEditor::getTextBounds (Range<int> textRange) const
 {
     RectangleList<int> boundingBox;
-    Iterator i (*this);
 
-    while (i.next())
+    if (getWordWrapWidth() <= 0)
+        return boundingBox;
+
+    auto i = layoutCache->getIteratorForIndex (textRange.getStart());
+
+    while (i.next() && i.indexInText < textRange.getEnd())
     {
         if (textRange.intersects ({ i.indexInText,
                                     i.indexInText + i.atom->numChars }))
@@ -1506,9 +1881,9 @@ void TextEditor::checkLayout()
 {
     if (getWordWrapWidth() > 0)
     {
-        const auto textBottom = Iterator (*this).getTotalTextHeight() + topIndent;
+        const auto textBottom = layoutCache->getIteratorForIndex (getTotalNumChars()).getTotalTextHeight() + topIndent;
         const auto textRight = jmax (viewport->getMaximumVisibleWidth(),
-                                     Iterator (*this).getTextRight() + leftIndent + rightEdgeSpace);
+                                     layoutCache->getTextRight() + leftIndent + rightEdgeSpace);
 
         textHolder->setSize (textRight, textBottom);
         viewport->setScrollBarsShown (scrollbarVisible && multiline && textBottom > viewport->getMaximumVisibleHeight(),
@@ -1725,7 +2100,8 @@ void TextEditor::drawContent (Graphics& g)
             clip.setY (roundToInt ((float) clip.getY() - yOffset));
         }
 
-        Iterator i (*this);
+        const auto visibleRange = layoutCache->getTextRangeBetween ((float) clip.getY(), (float) clip.getBottom());
+        auto i = layoutCache->getIteratorForIndex (visibleRange.getStart());
         Colour selectedTextColour;
 
         if (! selection.isEmpty())
@@ -1734,10 +2110,15 @@ void TextEditor::drawContent (Graphics& g)
 
             g.setColour (findColour (highlightColourId).withMultipliedAlpha (hasKeyboardFocus (true) ? 1.0f : 0.5f));
 
-            auto boundingBox = getTextBounds (selection);
-            boundingBox.offsetAll (-getTextOffset());
+            const auto visibleSelection = selection.getIntersectionWith (visibleRange);
 
-            g.fillPath (boundingBox.toPath(), transform);
+            if (! visibleSelection.isEmpty())
+            {
+                auto boundingBox = getTextBounds (visibleSelection);
+                boundingBox.offsetAll (-getTextOffset());
+
+                g.fillPath (boundingBox.toPath(), transform);
+            }
         }
 
         const UniformTextSection* lastSection = nullptr;
@@ -1760,7 +2141,7 @@ void TextEditor::drawContent (Graphics& g)
 
         for (auto& underlinedSection : underlinedSections)
         {
-            Iterator i2 (*this);
+            auto i2 = layoutCache->getIteratorForIndex (visibleRange.getStart());
 
             while (i2.next() && i2.lineY < (float) clip.getBottom())
             {
@@ -2339,6 +2720,7 @@ void TextEditor::insert (const String& text, int insertIndex, const Font& font,
             repaintText ({ insertIndex, getTotalNumChars() }); // must do this before and after changing the data, in case
                                                                // a line gets moved due to word wrap
 
+            const auto oldNumChars = getTotalNumChars();
             int index = 0;
             int nextIndex = 0;
 
@@ -2367,6 +2749,7 @@ void TextEditor::insert (const String& text, int insertIndex, const Font& font,
 
             coalesceSimilarSections();
             totalNumChars = -1;
+            layoutCache->textReplaced (insertIndex, 0, getTotalNumChars() - oldNumChars);
             valueTextNeedsUpdating = true;
 
             checkLayout();
@@ -2379,6 +2762,7 @@ void TextEditor::insert (const String& text, int insertIndex, const Font& font,
 
 void TextEditor::reinsert (int insertIndex, const OwnedArray<UniformTextSection>& sectionsToInsert)
 {
+    const auto oldNumChars = getTotalNumChars();
     int index = 0;
     int nextIndex = 0;
 
@@ -2413,6 +2797,7 @@ void TextEditor::reinsert (int insertIndex, const OwnedArray<UniformTextSection>
 
     coalesceSimilarSections();
     totalNumChars = -1;
+    layoutCache->textReplaced (insertIndex, 0, getTotalNumChars() - oldNumChars);
     valueTextNeedsUpdating = true;
 }
 
@@ -2472,6 +2857,7 @@ void TextEditor::remove (Range<int> range, UndoManager* const um, const int care
         }
         else
         {
+            const auto oldNumChars = getTotalNumChars();
             auto remainingRange = range;
 
             for (int i = 0; i < sections.size(); ++i)
@@ -2497,6 +2883,7 @@ void TextEditor::remove (Range<int> range, UndoManager* const um, const int care
 
             coalesceSimilarSections();
             totalNumChars = -1;
+            layoutCache->textReplaced (range.getStart(), oldNumChars - getTotalNumChars(), 0);
             valueTextNeedsUpdating = true;
 
             checkLayout();
@@ -2579,7 +2966,7 @@ void TextEditor::getCharPosition (int index, Point<float>& anchor, float& lineHe
     }
     else
     {
-        Iterator i (*this);
+        auto i = layoutCache->getIteratorForIndex (index);
 
         if (sections.isEmpty())
         {
@@ -2597,7 +2984,7 @@ int TextEditor::indexAtPosition (const float x, const float y) const
 {
     if (getWordWrapWidth() > 0)
     {
-        for (Iterator i (*this); i.next();)
+        for (auto i = layoutCache->getIteratorForY (y); i.next();)
         {
             if (y < i.lineY + (i.lineHeight * lineSpacing))
             {
@@ -2670,10 +3057,16 @@ void TextEditor::splitSection (const int sectionIndex, const int charToSplitAt)
 
     sections.insert (sectionIndex + 1,
                      sections.getUnchecked (sectionIndex)->split (charToSplitAt));
+
+    layoutCache->sectionsChanged();
 }
 
 void TextEditor::coalesceSimilarSections()
 {
+    // Sections are kept to a limited number of atoms, so that an edit never has to split,
+    // copy or merge more than a small part of a long document.
+    constexpr int maxAtomsPerSection = 256;
+
     for (int i = 0; i < sections.size() - 1; ++i)
     {
         auto* s1 = sections.getUnchecked (i);
@@ -2682,11 +3075,54 @@ void TextEditor::coalesceSimilarSections()
         if (s1->font == s2->font
              && s1->colour == s2->colour)
         {
-            s1->append (*s2);
-            sections.remove (i + 1);
-            --i;
+            if (s1->atoms.size() + s2->atoms.size() <= maxAtomsPerSection)
+            {
+                s1->append (*s2);
+                sections.remove (i + 1);
+                --i;
+            }
+            else if (! (s1->atoms.isEmpty() || s2->atoms.isEmpty())
+                      && UniformTextSection::canBeJoined (s1->atoms.getReference (s1->atoms.size() - 1),
+                                                          s2->atoms.getReference (0)))
+            {
+                // a word or run of whitespace that straddles the two sections still needs to be joined up
+                std::unique_ptr<UniformTextSection> remainder (s2->splitAtAtom (1));
+                s1->append (*s2);
+
+                if (remainder->atoms.isEmpty())
+                {
+                    sections.remove (i + 1);
+                    --i;
+                }
+                else
+                {
+                    sections.set (i + 1, remainder.release());
+                }
+            }
+        }
+    }
+
+    for (int i = sections.size(); --i >= 0;)
+    {
+        auto* section = sections.getUnchecked (i);
+
+        if (section->atoms.size() > maxAtomsPerSection)
+        {
+            // split the chunks off the end, so that each split only has to move the atoms in that chunk
+            Array<UniformTextSection*> chunks;
+
+            while (section->atoms.size() > maxAtomsPerSection)
+            {
+                const auto numToMove = jmin (section->atoms.size() - maxAtomsPerSection, maxAtomsPerSection / 2);
+                chunks.add (section->splitAtAtom (section->atoms.size() - numToMove));
+            }
+
+            std::reverse (chunks.begin(), chunks.end());
+            sections.insertArray (i + 1, chunks.begin(), chunks.size());
         }
     }
+
+    layoutCache->sectionsChanged();
 }
 
 //==============================================================================
@@ -2774,4 +3210,115 @@ std::unique_ptr<AccessibilityHandler> TextEditor::createAccessibilityHandler()
     return std::make_unique<EditorAccessibilityHandler> (*this);
 }
 
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct TextEditorLayoutTests final : public UnitTest
+{
+    TextEditorLayoutTests()
+        : UnitTest ("TextEditor layout", UnitTestCategories::gui)
+    {}
+
+    static String createRandomText (Random& r, int numWords)
+    {
+        const char* words[] = { "a", "bb", "lorem", "ipsum", "supercalifragilisticexpialidocious", " ", "  ", "\n", "\n\n", "\t" };
+        String result;
+
+        for (int i = 0; i < numWords; ++i)
+        {
+            result << words[r.nextInt (numElementsInArray (words))];
+
+            if (r.nextInt (3) == 0)
+                result << " ";
+        }
+
+        return result;
+    }
+
+    // Compares the layout of an editor that has been edited with one that has laid out the same text from scratch
+    void expectSameLayout (TextEditor& edited, const String& expectedText)
+    {
+        TextEditor fresh;
+        fresh.setMultiLine (true, true);
+        fresh.setSize (edited.getWidth(), edited.getHeight());
+        fresh.setText (expectedText, false);
+
+        // make sure both editors are scrolled to the top
+        for (auto* editor : { &edited, &fresh })
+            if (auto* viewport = dynamic_cast<Viewport*> (editor->getChildComponent (0)))
+                viewport->setViewPosition (0, 0);
+
+        expectEquals (edited.getTotalNumChars(), expectedText.length());
+        expect (edited.getText() == expectedText);
+        expectEquals (edited.getTextHeight(), fresh.getTextHeight());
+        expectEquals (edited.getTextWidth(), fresh.getTextWidth());
+
+        auto r = getRandom();
+
+        for (int i = 0; i < 20; ++i)
+        {
+            const auto index = r.nextInt (expectedText.length() + 1);
+            expect (edited.getCaretRectangleForCharIndex (index) == fresh.getCaretRectangleForCharIndex (index));
+
+            const Point<int> point (r.nextInt (edited.getWidth()), r.nextInt (jmax (1, edited.getTextHeight())));
+            expectEquals (edited.getTextIndexAt (point), fresh.getTextIndexAt (point));
+
+            const auto range = Range<int>::between (index, r.nextInt (expectedText.length() + 1));
+            const auto editedBounds = edited.getTextBounds (range), freshBounds = fresh.getTextBounds (range);
+            expectEquals (editedBounds.getNumRectangles(), freshBounds.getNumRectangles());
+            expect (editedBounds.getBounds() == freshBounds.getBounds());
+        }
+    }
+
+    void runTest() override
+    {
+        auto r = getRandom();
+
+        beginTest ("Edits only re-lay out the paragraphs they touch");
+        {
+            TextEditor editor;
+            editor.setMultiLine (true, true);
+            editor.setSize (150, 100);
+
+            auto text = createRandomText (r, 2000);
+            editor.setText (text, false);
+            expectSameLayout (editor, text);
+
+            for (int i = 0; i < 30; ++i)
+            {
+                const auto range = Range<int>::withStartAndLength (r.nextInt (text.length() + 1), r.nextInt (4) == 0 ? r.nextInt (200) : 0)
+                                     .getIntersectionWith ({ 0, text.length() });
+                const auto newText = createRandomText (r, r.nextInt (5));
+
+                editor.setHighlightedRegion (range);
+                editor.insertTextAtCaret (newText);
+                text = text.substring (0, range.getStart()) + newText + text.substring (range.getEnd());
+
+                expectSameLayout (editor, text);
+
+                if (i % 10 == 0)
+                {
+                    editor.setSize (100 + r.nextInt (200), 100);
+                    expectSameLayout (editor, text);
+                }
+            }
+
+            for (int i = 0; i < 10; ++i)
+            {
+                editor.undo();
+                editor.redo();
+                editor.undo();
+            }
+
+            expectSameLayout (editor, editor.getText());
+        }
+    }
+};
+
+static TextEditorLayoutTests textEditorLayoutTests;
+
+#endif
+
 } // namespace juce
@@ -767,6 +767,7 @@ private:
     //==============================================================================
     JUCE_PUBLIC_IN_DLL_BUILD (class UniformTextSection)
     struct Iterator;
+    struct LayoutCache;
     struct TextHolderComponent;
     struct TextEditorViewport;
     struct InsertAction;
@@ -820,6 +821,7 @@ private:
     mutable int totalNumChars = 0;
     int caretPosition = 0;
     OwnedArray<UniformTextSection> sections;
+    std::unique_ptr<LayoutCache> layoutCache;
     String textToShowWhenEmpty;
     Colour colourForTextWhenEmpty;
     juce_wchar passwordCharacter;
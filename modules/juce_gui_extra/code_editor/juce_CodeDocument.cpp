@@ -414,7 +414,7 @@ void CodeDocument::Position::setLineAndIndex (const int newLineNum, const int ne
 
             auto& l = *owner->lines.getUnchecked (line);
             indexInLine = l.lineLengthWithoutNewLines;
-            characterPos = l.lineStartInFile + indexInLine;
+            characterPos = owner->getLineStart (line) + indexInLine;
         }
         else
         {
@@ -427,7 +427,7 @@ void CodeDocument::Position::setLineAndIndex (const int newLineNum, const int ne
             else
                 indexInLine = 0;
 
-            characterPos = l.lineStartInFile + indexInLine;
+            characterPos = owner->getLineStart (line) + indexInLine;
         }
     }
 }
@@ -452,13 +452,14 @@ void CodeDocument::Position::setPosition (const int newPosition)
                 for (int i = lineStart; i < lineEnd; ++i)
                 {
                     auto& l = *owner->lines.getUnchecked (i);
-                    auto index = newPosition - l.lineStartInFile;
+                    auto start = owner->getLineStart (i);
+                    auto index = newPosition - start;
 
                     if (index >= 0 && (index < l.lineLength || i == lineEnd - 1))
                     {
                         line = i;
                         indexInLine = jmin (l.lineLengthWithoutNewLines, index);
-                        characterPos = l.lineStartInFile + indexInLine;
+                        characterPos = start + indexInLine;
                     }
                 }
 
@@ -468,7 +469,7 @@ void CodeDocument::Position::setPosition (const int newPosition)
             {
                 auto midIndex = (lineStart + lineEnd + 1) / 2;
 
-                if (newPosition >= owner->lines.getUnchecked (midIndex)->lineStartInFile)
+                if (newPosition >= owner->getLineStart (midIndex))
                     lineStart = midIndex;
                 else
                     lineEnd = midIndex;
@@ -615,7 +616,7 @@ String CodeDocument::getTextBetween (const Position& start, const Position& end)
 int CodeDocument::getNumCharacters() const noexcept
 {
     if (auto* lastLine = lines.getLast())
-        return lastLine->lineStartInFile + lastLine->lineLength;
+        return getLineStart (lines.size() - 1) + lastLine->lineLength;
 
     return 0;
 }
@@ -869,11 +870,46 @@ void CodeDocument::checkLastLineStatus()
     if (lastLine != nullptr && lastLine->endsWithLineBreak())
     {
         // check that there's an empty line at the end if the preceding one ends in a newline..
-        lines.add (new CodeDocumentLine (StringRef(), StringRef(), 0, 0,
-                                         lastLine->lineStartInFile + lastLine->lineLength));
+        auto newLineStart = getLineStart (lines.size() - 1) + lastLine->lineLength;
+        lines.add (new CodeDocumentLine (StringRef(), StringRef(), 0, 0, 0));
+        setLineStart (lines.size() - 1, newLineStart);
     }
 }
 
+//==============================================================================
+/*  Rather than updating the start of every following line after each edit, the lines from
+    firstLineToOffset onwards store their start without the most recent change in length,
+    which is held in lineStartOffset. When the next edit happens, only the lines between
+    the old and new edit positions need to be brought up-to-date, so repeated edits in the
+    same part of the document take constant time.
+*/
+int CodeDocument::getLineStart (int lineIndex) const noexcept
+{
+    auto start = lines.getUnchecked (lineIndex)->lineStartInFile;
+    return lineIndex >= firstLineToOffset ? start + lineStartOffset : start;
+}
+
+void CodeDocument::setLineStart (int lineIndex, int newStart) noexcept
+{
+    lines.getUnchecked (lineIndex)->lineStartInFile = lineIndex >= firstLineToOffset ? newStart - lineStartOffset
+                                                                                    : newStart;
+}
+
+void CodeDocument::moveLineStartOffsetTo (int newFirstLineToOffset) noexcept
+{
+    if (lineStartOffset != 0)
+    {
+        for (int i = jmin (firstLineToOffset, newFirstLineToOffset),
+                 end = jmin (lines.size(), jmax (firstLineToOffset, newFirstLineToOffset)); i < end; ++i)
+        {
+            lines.getUnchecked (i)->lineStartInFile += (i < newFirstLineToOffset ? lineStartOffset
+                                                                                  : -lineStartOffset);
+        }
+    }
+
+    firstLineToOffset = newFirstLineToOffset;
+}
+
 //==============================================================================
 void CodeDocument::addListener    (CodeDocument::Listener* l)   { listeners.add (l); }
 void CodeDocument::removeListener (CodeDocument::Listener* l)   { listeners.remove (l); }
@@ -924,6 +960,7 @@ void CodeDocument::insert (const String& text, const int insertPos, const bool u
 
             auto* firstLine = lines[firstAffectedLine];
             auto textInsideOriginalLine = text;
+            int lineStart = 0, originalLength = 0;
 
             if (firstLine != nullptr)
             {
@@ -931,29 +968,38 @@ void CodeDocument::insert (const String& text, const int insertPos, const bool u
                 textInsideOriginalLine = firstLine->line.substring (0, index)
                                          + textInsideOriginalLine
                                          + firstLine->line.substring (index);
+
+                lineStart = getLineStart (firstAffectedLine);
+                originalLength = firstLine->lineLength;
+
+                if (firstLine->lineLength == maximumLineLength)
+                    maximumLineLength = -1;
             }
 
-            maximumLineLength = -1;
             Array<CodeDocumentLine*> newLines;
             CodeDocumentLine::createLines (newLines, textInsideOriginalLine);
             jassert (newLines.size() > 0);
 
-            auto* newFirstLine = newLines.getUnchecked (0);
-            newFirstLine->lineStartInFile = firstLine != nullptr ? firstLine->lineStartInFile : 0;
-            lines.set (firstAffectedLine, newFirstLine);
+            // the lines after the ones being inserted just need to be moved along by the length of the new text
+            moveLineStartOffsetTo (firstAffectedLine + 1);
+            lines.set (firstAffectedLine, newLines.getUnchecked (0));
 
             if (newLines.size() > 1)
                 lines.insertArray (firstAffectedLine + 1, newLines.getRawDataPointer() + 1, newLines.size() - 1);
 
-            int lineStart = newFirstLine->lineStartInFile;
-
-            for (int i = firstAffectedLine; i < lines.size(); ++i)
+            for (auto* l : newLines)
             {
-                auto& l = *lines.getUnchecked (i);
-                l.lineStartInFile = lineStart;
-                lineStart += l.lineLength;
+                l->lineStartInFile = lineStart;
+                lineStart += l->lineLength;
+                originalLength -= l->lineLength;
+
+                if (maximumLineLength >= 0)
+                    maximumLineLength = jmax (maximumLineLength, l->lineLength);
             }
 
+            firstLineToOffset += newLines.size() - 1;
+            lineStartOffset -= originalLength;
+
             checkLastLineStatus();
             auto newTextLength = text.length();
 
@@ -1013,11 +1059,18 @@ void CodeDocument::remove (const int startPos, const int endPos, const bool undo
         Position startPosition (*this, startPos);
         Position endPosition (*this, endPos);
 
-        maximumLineLength = -1;
         auto firstAffectedLine = startPosition.getLineNumber();
         auto endLine = endPosition.getLineNumber();
         auto& firstLine = *lines.getUnchecked (firstAffectedLine);
 
+        for (int i = firstAffectedLine; i <= endLine; ++i)
+            if (lines.getUnchecked (i)->lineLength == maximumLineLength)
+                maximumLineLength = -1;
+
+        // the lines after the ones being removed just need to be moved back by the length of the text
+        moveLineStartOffsetTo (firstAffectedLine + 1);
+        lineStartOffset -= endPosition.getPosition() - startPosition.getPosition();
+
         if (firstAffectedLine == endLine)
         {
             firstLine.line = firstLine.line.substring (0, startPosition.getIndexInLine())
@@ -1036,12 +1089,8 @@ void CodeDocument::remove (const int startPos, const int endPos, const bool undo
             lines.removeRange (firstAffectedLine + 1, numLinesToRemove);
         }
 
-        for (int i = firstAffectedLine + 1; i < lines.size(); ++i)
-        {
-            auto& l = *lines.getUnchecked (i);
-            auto& previousLine = *lines.getUnchecked (i - 1);
-            l.lineStartInFile = previousLine.lineStartInFile + previousLine.lineLength;
-        }
+        if (maximumLineLength >= 0)
+            maximumLineLength = jmax (maximumLineLength, firstLine.lineLength);
 
         checkLastLineStatus();
         auto totalChars = getNumCharacters();
@@ -1287,6 +1336,58 @@ struct CodeDocumentTest final : public UnitTest
                 expectEquals (p3.getIndexInLine(), d.getLine (d.getNumLines() - 1).length(), comment3);
             }
         }
+
+        {
+            beginTest ("Line positions after random edits");
+
+            auto r = getRandom();
+            const char* fragments[] = { "a", "bc ", "\n", "\r\n", "\n\n", "\t" };
+
+            auto createRandomText = [&] (int numFragments)
+            {
+                String result;
+
+                for (int i = 0; i < numFragments; ++i)
+                    result << fragments[r.nextInt (numElementsInArray (fragments))];
+
+                return result;
+            };
+
+            CodeDocument d;
+            d.replaceAllContent (createRandomText (500));
+            int start = 0;
+
+            for (int i = 0; i < 200; ++i)
+            {
+                // keep the edits in the same area for a while, then jump elsewhere
+                const auto numChars = d.getNumCharacters();
+                start = (i % 10 == 0) ? r.nextInt (numChars + 1)
+                                      : jlimit (0, numChars, start + r.nextInt (21) - 10);
+
+                if (r.nextBool())
+                    d.insertText (start, createRandomText (r.nextInt (4)));
+                else
+                    d.deleteSection (start, jmin (numChars, start + r.nextInt (20)));
+
+                CodeDocument fresh;
+                fresh.replaceAllContent (d.getAllContent());
+
+                expectEquals (d.getNumCharacters(), fresh.getNumCharacters());
+                expectEquals (d.getNumLines(), fresh.getNumLines());
+                expectEquals (d.getMaximumLineLength(), fresh.getMaximumLineLength());
+
+                for (int pos = 0; pos <= fresh.getNumCharacters(); pos += 7)
+                {
+                    const CodeDocument::Position p1 (d, pos), p2 (fresh, pos);
+                    expectEquals (p1.getLineNumber(), p2.getLineNumber());
+                    expectEquals (p1.getIndexInLine(), p2.getIndexInLine());
+                }
+
+                for (int line = 0; line < fresh.getNumLines(); line += 3)
+                    expectEquals (CodeDocument::Position (d, line, 0).getPosition(),
+                                  CodeDocument::Position (fresh, line, 0).getPosition());
+            }
+        }
     }
 };
 
@@ -36,7 +36,9 @@ class CodeDocumentLine;
     When using a CodeEditorComponent, it takes one of these as its source object.
 
     The CodeDocument stores its content as an array of lines, which makes it
-    quick to insert and delete.
+    quick to insert and delete. The start positions of the lines are kept up-to-date
+    lazily, so that a run of edits in the same area of a long document doesn't have
+    to touch every line that follows it.
 
     @see CodeEditorComponent
 
@@ -437,6 +439,7 @@ private:
     UndoManager undoManager;
     int currentActionIndex = 0, indexOfSavedState = -1;
     int maximumLineLength = -1;
+    int firstLineToOffset = 0, lineStartOffset = 0;
     ListenerList<Listener> listeners;
     String newLineChars { "\r\n" };
 
@@ -444,6 +447,10 @@ private:
     void remove (int startPos, int endPos, bool undoable);
     void checkLastLineStatus();
 
+    int getLineStart (int lineIndex) const noexcept;
+    void setLineStart (int lineIndex, int newStart) noexcept;
+    void moveLineStartOffsetTo (int newFirstLineToOffset) noexcept;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CodeDocument)
 };
 
@@ -60,7 +60,7 @@ private:
 
         int getTotalNumCharacters() const override
         {
-            return codeEditorComponent.document.getAllContent().length();
+            return codeEditorComponent.document.getNumCharacters();
         }
 
         Range<int> getSelection() const override
@@ -354,10 +354,31 @@ class CodeEditorComponent::Pimpl   : public Timer,
                                      public CodeDocument::Listener
 {
 public:
-    Pimpl (CodeEditorComponent& ed) : owner (ed) {}
+    Pimpl (CodeEditorComponent& ed) : owner (ed), backgroundTokeniser (ed) {}
+
+    void tokeniseInBackground()          { backgroundTokeniser.startTimer (10); }
 
 private:
+    //==============================================================================
+    /*  Works through the rest of the document in short slices between other events, so that
+        by the time the user scrolls somewhere, there's already a tokeniser position nearby
+        to start from.
+    */
+    struct BackgroundTokeniser final : public Timer
+    {
+        explicit BackgroundTokeniser (CodeEditorComponent& ed) : owner (ed) {}
+
+        void timerCallback() override
+        {
+            if (owner.updateCachedIterators (owner.document.getNumLines(), 5))
+                stopTimer();
+        }
+
+        CodeEditorComponent& owner;
+    };
+
     CodeEditorComponent& owner;
+    BackgroundTokeniser backgroundTokeniser;
 
     void timerCallback() override        { owner.newTransaction(); }
     void handleAsyncUpdate() override    { owner.rebuildLineTokens(); }
@@ -372,11 +393,13 @@ private:
 
     void codeDocumentTextInserted (const String& newText, int pos) override
     {
+        owner.invalidateCachedIterators (pos, 0, newText.length());
         owner.codeDocumentChanged (pos, pos + newText.length());
     }
 
     void codeDocumentTextDeleted (int start, int end) override
     {
+        owner.invalidateCachedIterators (start, end - start, 0);
         owner.codeDocumentChanged (start, end);
     }
 
@@ -472,6 +495,7 @@ CodeEditorComponent::CodeEditorComponent (CodeDocument& doc, CodeTokeniser* cons
     document.addListener (pimpl.get());
 
     lookAndFeelChanged();
+    pimpl->tokeniseInBackground();
 }
 
 CodeEditorComponent::~CodeEditorComponent()
@@ -656,7 +680,7 @@ void CodeEditorComponent::codeDocumentChanged (const int startIndex, const int e
     const CodeDocument::Position affectedTextStart (document, startIndex);
     const CodeDocument::Position affectedTextEnd (document, endIndex);
 
-    retokenise (startIndex, endIndex);
+    rebuildLineTokensAsync();
 
     updateCaretPosition();
     columnToTryToMaintain = -1;
@@ -673,12 +697,9 @@ void CodeEditorComponent::codeDocumentChanged (const int startIndex, const int e
     updateScrollBars();
 }
 
-void CodeEditorComponent::retokenise (int startIndex, [[maybe_unused]] int endIndex)
+void CodeEditorComponent::retokenise (int startIndex, int endIndex)
 {
-    const CodeDocument::Position affectedTextStart (document, startIndex);
-
-    clearCachedIterators (affectedTextStart.getLineNumber());
-
+    invalidateCachedIterators (startIndex, endIndex - startIndex, endIndex - startIndex);
     rebuildLineTokensAsync();
 }
 
@@ -1730,12 +1751,78 @@ void CodeEditorComponent::clearCachedIterators (const int firstLineToBeInvalid)
             break;
 
     cachedIterators.removeRange (jmax (0, i - 1), cachedIterators.size());
+    pimpl->tokeniseInBackground();
 }
 
-void CodeEditorComponent::updateCachedIterators (int maxLineNum)
+void CodeEditorComponent::invalidateCachedIterators (int startIndex, int numCharsRemoved, int numCharsInserted)
+{
+    // The token boundaries that were found after the edited text can't be trusted any more, but
+    // they'll still be correct if tokenising the new text happens to land on one of them again,
+    // so they're kept until the re-tokenisation either reaches or passes them.
+    const auto oldEnd = startIndex + numCharsRemoved;
+    const auto delta = numCharsInserted - numCharsRemoved;
+    const auto numChars = document.getNumCharacters();
+    Array<int> positions;
+
+    auto addPosition = [&] (int oldPosition)
+    {
+        if (oldPosition >= oldEnd && oldPosition + delta < numChars)
+            positions.add (oldPosition + delta);
+    };
+
+    // If an earlier edit is still being re-tokenised, the cached iterators and the pending positions
+    // come from two tokenisations that haven't converged yet, so they can't be mixed.
+    if (positionsToResync.isEmpty())
+    {
+        for (auto& t : cachedIterators)
+            addPosition (t.getPosition());
+
+        // these are kept in reverse order, so that the ones that have been passed can be removed from the end
+        std::reverse (positions.begin(), positions.end());
+    }
+    else
+    {
+        for (auto p : positionsToResync)
+            addPosition (p);
+    }
+
+    positionsToResync.swapWith (positions);
+
+    clearCachedIterators (CodeDocument::Position (document, startIndex).getLineNumber());
+}
+
+bool CodeEditorComponent::resyncCachedIterators (int position)
+{
+    while (! positionsToResync.isEmpty() && positionsToResync.getLast() < position)
+        positionsToResync.removeLast();
+
+    if (positionsToResync.isEmpty() || positionsToResync.getLast() != position)
+        return false;
+
+    // The new tokenisation has converged with the old one, so the rest of the old positions can be re-used
+    positionsToResync.removeLast();
+
+    for (int i = positionsToResync.size(); --i >= 0;)
+    {
+        const auto p = positionsToResync.getUnchecked (i);
+        const CodeDocument::Iterator t (CodeDocument::Position (document, p));
+
+        if (t.getPosition() != p)
+            break;
+
+        cachedIterators.add (t);
+    }
+
+    positionsToResync.clearQuick();
+    return true;
+}
+
+bool CodeEditorComponent::updateCachedIterators (int maxLineNum, uint32 maxMillisecondsToSpend)
 {
     const int maxNumCachedPositions = 5000;
     const int linesBetweenCachedSources = jmax (10, document.getNumLines() / maxNumCachedPositions);
+    const auto startTime = Time::getMillisecondCounter();
+    const auto numChars = document.getNumCharacters();
 
     if (cachedIterators.size() == 0)
         cachedIterators.add (CodeDocument::Iterator (document));
@@ -1746,9 +1833,12 @@ void CodeEditorComponent::updateCachedIterators (int maxLineNum)
         {
             const auto last = cachedIterators.getLast();
 
-            if (last.getLine() >= maxLineNum)
+            if (last.getLine() >= maxLineNum || last.isEOF() || last.getPosition() >= numChars)
                 break;
 
+            if (Time::getMillisecondCounter() - startTime >= maxMillisecondsToSpend)
+                return false;
+
             cachedIterators.add (CodeDocument::Iterator (last));
             auto& t = cachedIterators.getReference (cachedIterators.size() - 1);
             const int targetLine = jmin (maxLineNum, last.getLine() + linesBetweenCachedSources);
@@ -1757,30 +1847,26 @@ void CodeEditorComponent::updateCachedIterators (int maxLineNum)
             {
                 codeTokeniser->readNextToken (t);
 
-                if (t.getLine() >= targetLine)
+                // (resyncing may add more iterators to the array, so t mustn't be used after it)
+                if (resyncCachedIterators (t.getPosition()) || t.getLine() >= targetLine
+                     || t.isEOF() || t.getPosition() >= numChars)
                     break;
-
-                if (t.isEOF())
-                    return;
             }
         }
     }
+
+    return true;
 }
 
 void CodeEditorComponent::getIteratorForPosition (int position, CodeDocument::Iterator& source)
 {
     if (codeTokeniser != nullptr)
     {
-        for (int i = cachedIterators.size(); --i >= 0;)
-        {
-            auto& t = cachedIterators.getReference (i);
+        auto found = std::upper_bound (cachedIterators.begin(), cachedIterators.end(), position,
+                                       [] (int p, const CodeDocument::Iterator& t) { return p < t.getPosition(); });
 
-            if (t.getPosition() <= position)
-            {
-                source = t;
-                break;
-            }
-        }
+        if (found != cachedIterators.begin())
+            source = *(found - 1);
 
         while (source.getPosition() < position)
         {
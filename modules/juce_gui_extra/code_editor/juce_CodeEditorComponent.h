@@ -448,8 +448,11 @@ private:
     void codeDocumentChanged (int start, int end);
 
     Array<CodeDocument::Iterator> cachedIterators;
+    Array<int> positionsToResync;
     void clearCachedIterators (int firstLineToBeInvalid);
-    void updateCachedIterators (int maxLineNum);
+    void invalidateCachedIterators (int startIndex, int numCharsRemoved, int numCharsInserted);
+    bool updateCachedIterators (int maxLineNum, uint32 maxMillisecondsToSpend = std::numeric_limits<uint32>::max());
+    bool resyncCachedIterators (int position);
     void getIteratorForPosition (int position, CodeDocument::Iterator&);
 
     void moveLineDelta (int delta, bool selecting);